@@ -19,6 +19,13 @@ endif()
 
 message(STATUS "Setting sizeof(integer_t) to ${INTEGER_T_SIZE}")
 
+# Option to build profiling counters and timers on hot paths
+# (see include/tchecker/utils/profiling.hh)
+option(TCHECKER_PROFILING "Enable profiling counters and timers" OFF)
+if (TCHECKER_PROFILING)
+    message(STATUS "Building TChecker with profiling counters and timers")
+endif()
+
 #
 # Check if "flag" is accepted by the current CXX compiler. If the flag is
 # supported its value is assigned to the variable "var"; else "var" is asigned
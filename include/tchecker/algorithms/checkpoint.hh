@@ -0,0 +1,295 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_CHECKPOINT_HH
+#define TCHECKER_ALGORITHMS_CHECKPOINT_HH
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "tchecker/utils/serialization.hh"
+
+/*!
+ \file checkpoint.hh
+ \brief Checkpoints (on-disk snapshots) of running algorithms, and resume from
+ checkpoints
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \class checkpoint_t
+ \brief Periodic checkpoints of algorithms
+ \note Algorithms call due() at each iteration of their main loop, and save()
+ when due() returns true. The clock is only read every TICKS iterations, as for
+ progress reports (see tchecker::algorithms::progress_t).
+ A checkpoint file starts with a header that identifies the algorithm and the
+ configuration of the run (options and model). Resuming from a checkpoint with
+ another algorithm or another configuration is rejected
+ */
+class checkpoint_t {
+public:
+  /*!
+   \brief Constructor
+   \param filename : checkpoint file (empty string to disable checkpoints)
+   \param period : minimal time between two checkpoints, in seconds
+   \param resume_filename : checkpoint file to resume from (empty string to
+   start from initial states)
+   \param configuration : description of the run (options and model)
+   */
+  checkpoint_t(std::string const & filename, double period, std::string const & resume_filename,
+               std::string const & configuration);
+
+  /*!
+   \brief Check if a checkpoint is due
+   \return true if checkpoints are enabled and at least period seconds have
+   elapsed since the last checkpoint, false otherwise
+   */
+  inline bool due()
+  {
+    if (_filename.empty() || (++_ticks % TICKS) != 0)
+      return false;
+    return std::chrono::steady_clock::now() >= _next_checkpoint;
+  }
+
+  /*!
+   \brief Accessor
+   \return true if the next run of an algorithm should resume from a checkpoint
+   file, false otherwise
+   */
+  inline bool resuming() const { return !_resume_filename.empty() && !_resumed; }
+
+  /*!
+   \brief Save a checkpoint
+   \param algorithm : name of the algorithm
+   \param save : function that writes the state of the algorithm to a stream
+   \post a checkpoint with a header and the output of save has been written to
+   the checkpoint file. The file is replaced atomically: an interrupted save
+   leaves the previous checkpoint untouched
+   \throw std::runtime_error : if the checkpoint file cannot be written
+   */
+  void save(std::string const & algorithm, std::function<void(std::ostream &)> const & save);
+
+  /*!
+   \brief Load a checkpoint
+   \param algorithm : name of the algorithm
+   \param load : function that reads the state of the algorithm from a stream
+   \pre resuming() (checked by assertion)
+   \post the checkpoint in the resume file has been passed to load, and
+   resuming() is false
+   \throw std::runtime_error : if the resume file cannot be read, if it is not a
+   checkpoint of algorithm with the same configuration, or if load fails
+   */
+  void load(std::string const & algorithm, std::function<void(std::istream &)> const & load);
+
+private:
+  static constexpr unsigned long TICKS = 1024; /*!< Number of calls to due() between two clock readings */
+
+  std::string _filename;                                               /*!< Checkpoint file */
+  std::chrono::steady_clock::duration _period;                         /*!< Minimal time between two checkpoints */
+  std::string _resume_filename;                                        /*!< Resume file */
+  std::uint64_t _fingerprint;                                          /*!< Fingerprint of the configuration */
+  bool _resumed;                                                       /*!< Resume file has been loaded */
+  std::chrono::time_point<std::chrono::steady_clock> _next_checkpoint; /*!< Time of next checkpoint */
+  unsigned long _ticks;                                                /*!< Number of calls to due() */
+};
+
+namespace details {
+
+/*!
+ \brief Checkpoints (nullptr if disabled)
+ */
+extern tchecker::algorithms::checkpoint_t * checkpoint;
+
+} // end of namespace details
+
+/*!
+ \brief Accessor
+ \return the checkpoints of algorithms, nullptr if checkpoints and resume are
+ disabled
+ */
+inline tchecker::algorithms::checkpoint_t * checkpoint() { return tchecker::algorithms::details::checkpoint; }
+
+/*!
+ \brief Set the checkpoints of algorithms
+ \param checkpoint : checkpoints, nullptr to disable checkpoints and resume
+ \post checkpoint is used by all subsequent runs of algorithms
+ */
+void set_checkpoint(std::shared_ptr<tchecker::algorithms::checkpoint_t> const & checkpoint);
+
+/*!
+ \brief Type of map from nodes of a graph to their index in a checkpoint
+ \tparam GRAPH : type of graph
+ */
+template <class GRAPH>
+using node_index_t = std::unordered_map<typename GRAPH::node_sptr_t::shared_object_t const *, std::uint64_t>;
+
+/*!
+ \brief Save a graph
+ \tparam GRAPH : type of graph, should provide methods save_node(os, n) and
+ save_edge(os, e) that write the contents of a node and an edge
+ \param os : output stream
+ \param graph : a graph
+ \post the nodes of graph and their outgoing edges have been written to os
+ \return map from the nodes of graph to their index in os
+ */
+template <class GRAPH>
+tchecker::algorithms::node_index_t<GRAPH> save_graph(std::ostream & os, GRAPH const & graph)
+{
+  tchecker::algorithms::node_index_t<GRAPH> index;
+  std::vector<typename GRAPH::node_sptr_t> nodes;
+
+  for (typename GRAPH::node_sptr_t const & n : graph.nodes()) {
+    index.emplace(n.ptr(), nodes.size());
+    nodes.push_back(n);
+  }
+
+  tchecker::serialization::write(os, static_cast<std::uint64_t>(nodes.size()));
+  for (typename GRAPH::node_sptr_t const & n : nodes)
+    graph.save_node(os, n);
+
+  for (typename GRAPH::node_sptr_t const & n : nodes) {
+    std::uint64_t count = 0;
+    for (auto && e : graph.outgoing_edges(n)) {
+      (void)e;
+      ++count;
+    }
+    tchecker::serialization::write(os, count);
+    for (auto && e : graph.outgoing_edges(n)) {
+      tchecker::serialization::write(os, index.at(graph.edge_tgt(e).ptr()));
+      graph.save_edge(os, e);
+    }
+  }
+
+  return index;
+}
+
+/*!
+ \brief Load a graph
+ \tparam GRAPH : type of graph, should provide methods load_node(is) that reads
+ a node and adds it to the graph, and load_edge(is, src, tgt) that reads an edge
+ and adds it to the graph from src to tgt
+ \param is : input stream
+ \param graph : a graph
+ \pre graph is empty
+ \post the nodes and edges written by tchecker::algorithms::save_graph have been
+ read from is and added to graph
+ \return the nodes of graph, by index
+ \throw std::runtime_error : if is does not contain a graph saved by
+ tchecker::algorithms::save_graph
+ */
+template <class GRAPH> std::vector<typename GRAPH::node_sptr_t> load_graph(std::istream & is, GRAPH & graph)
+{
+  std::vector<typename GRAPH::node_sptr_t> nodes;
+
+  std::uint64_t const nodes_count = tchecker::serialization::read<std::uint64_t>(is);
+  for (std::uint64_t i = 0; i < nodes_count; ++i)
+    nodes.push_back(graph.load_node(is));
+
+  for (typename GRAPH::node_sptr_t const & n : nodes) {
+    std::uint64_t const count = tchecker::serialization::read<std::uint64_t>(is);
+    for (std::uint64_t i = 0; i < count; ++i) {
+      std::uint64_t const tgt = tchecker::serialization::read<std::uint64_t>(is);
+      if (tgt >= nodes.size())
+        throw std::runtime_error("Invalid node index in checkpoint");
+      graph.load_edge(is, n, nodes[tgt]);
+    }
+  }
+
+  return nodes;
+}
+
+/*!
+ \brief Restore a waiting container
+ \tparam WAITING : type of waiting container
+ \param waiting : an empty waiting container
+ \param elements : elements in the order in which they should be removed from
+ waiting
+ \post elements have been inserted in waiting. The waiting containers that
+ remove elements in insertion order (queues) or in reverse insertion order
+ (stacks), or w.r.t. a priority, are restored exactly. Other containers are
+ restored in some order
+ */
+template <class WAITING>
+void restore_waiting(WAITING & waiting, std::vector<typename WAITING::element_t> const & elements)
+{
+  for (auto const & n : elements)
+    waiting.insert(n);
+  if (waiting.empty() || waiting.first() == elements.front())
+    return;
+  waiting.clear();
+  for (auto it = elements.rbegin(); it != elements.rend(); ++it)
+    waiting.insert(*it);
+}
+
+/*!
+ \brief Save a waiting container
+ \tparam WAITING : type of waiting container
+ \tparam NODE : type of nodes
+ \param os : output stream
+ \param waiting : a waiting container
+ \param index : map from nodes to their index (see
+ tchecker::algorithms::save_graph)
+ \post the indices of the nodes in waiting have been written to os, in the order
+ in which they are removed from waiting. waiting has been restored (see
+ tchecker::algorithms::restore_waiting)
+ */
+template <class WAITING, class NODE>
+void save_waiting(std::ostream & os, WAITING & waiting, std::unordered_map<NODE const *, std::uint64_t> const & index)
+{
+  std::vector<typename WAITING::element_t> elements;
+  while (!waiting.empty()) {
+    elements.push_back(waiting.first());
+    waiting.remove_first();
+  }
+
+  tchecker::serialization::write(os, static_cast<std::uint64_t>(elements.size()));
+  for (auto const & n : elements)
+    tchecker::serialization::write(os, index.at(n.ptr()));
+
+  tchecker::algorithms::restore_waiting(waiting, elements);
+}
+
+/*!
+ \brief Load a waiting container
+ \tparam WAITING : type of waiting container
+ \tparam NODE_SPTR : type of nodes
+ \param is : input stream
+ \param waiting : an empty waiting container
+ \param nodes : nodes by index (see tchecker::algorithms::load_graph)
+ \post the nodes written by tchecker::algorithms::save_waiting have been read
+ from is and inserted in waiting
+ \throw std::runtime_error : if is does not contain a saved waiting container
+ */
+template <class WAITING, class NODE_SPTR>
+void load_waiting(std::istream & is, WAITING & waiting, std::vector<NODE_SPTR> const & nodes)
+{
+  std::vector<typename WAITING::element_t> elements;
+  std::uint64_t const count = tchecker::serialization::read<std::uint64_t>(is);
+  for (std::uint64_t i = 0; i < count; ++i) {
+    std::uint64_t const n = tchecker::serialization::read<std::uint64_t>(is);
+    if (n >= nodes.size())
+      throw std::runtime_error("Invalid node index in checkpoint");
+    elements.push_back(nodes[n]);
+  }
+  tchecker::algorithms::restore_waiting(waiting, elements);
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_CHECKPOINT_HH
@@ -9,13 +9,17 @@
 #define TCHECKER_ALGORITHMS_COUVREUR_SCC_ALGORITHM_HH
 
 #include <cassert>
+#include <cstdint>
 #include <stack>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/checkpoint.hh"
 #include "tchecker/algorithms/couvreur_scc/graph.hh"
 #include "tchecker/algorithms/couvreur_scc/stats.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/basictypes.hh"
 
 /*!
  \file algorithm.hh
@@ -109,25 +113,43 @@ public:
    each transition in ts.
    \return statistics on the run
    \note if labels is empty, graph is the full state-space of ts
+   \note if a resume file has been set (see tchecker::algorithms::checkpoint),
+   graph, the stacks and the statistics are loaded from the resume file, and the
+   search continues from the loaded stacks, then from the next initial state
    */
   tchecker::algorithms::couvscc::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels)
   {
     tchecker::algorithms::couvscc::stats_t stats;
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
 
     stats.set_start_time();
 
     _count = 0;
+    _initial = 0;
 
-    std::vector<typename TS::sst_t> sst;
-    ts.initial(sst);
-    for (auto && [status, s, t] : sst) {
-      auto && [is_new_node, initial_node] = graph.add_node(s);
-      initial_node->initial(true);
-      couv_dfs(initial_node, ts, graph, labels, stats);
-      if (stats.cycle())
-        break;
+    if (checkpoint != nullptr && checkpoint->resuming()) {
+      checkpoint->load("couvscc", [&](std::istream & is) { load_checkpoint(is, graph, stats); });
+      couv_dfs(ts, graph, labels, stats);
+      ++_initial;
     }
 
+    if (!stats.cycle()) {
+      std::vector<typename TS::sst_t> sst;
+      ts.initial(sst);
+      for (; _initial < sst.size(); ++_initial) {
+        auto && [status, s, t] = sst[_initial];
+        auto && [is_new_node, initial_node] = graph.add_node(s);
+        initial_node->initial(true);
+        couv_dfs(initial_node, ts, graph, labels, stats);
+        if (stats.cycle())
+          break;
+      }
+    }
+
+    if (tchecker::algorithms::progress() != nullptr)
+      tchecker::algorithms::progress()->report("couvscc", stats.visited_states(), stats.visited_transitions(), _todo.size(),
+                                               graph.nodes_count(), true);
+
     stats.stored_states() = graph.nodes_count();
 
     empty_stacks();
@@ -154,7 +176,29 @@ private:
                 tchecker::algorithms::couvscc::stats_t & stats)
   {
     push(n, ts, graph, stats);
+    couv_dfs(ts, graph, labels, stats);
+  }
+
+  /*!
+   \brief DFS loop of Couvreur's algorithm from the current stacks
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param stats : statistics on the run
+   \post the DFS search in Couvreur's algorithm has been performed until the
+   todo stack is empty, or an accepting cycle has been found
+  */
+  void couv_dfs(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels, tchecker::algorithms::couvscc::stats_t & stats)
+  {
+    tchecker::algorithms::progress_t * progress = tchecker::algorithms::progress();
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
+
     while (!_todo.empty()) {
+      if (progress != nullptr && progress->due())
+        progress->report("couvscc", stats.visited_states(), stats.visited_transitions(), _todo.size(), graph.nodes_count());
+      if (checkpoint != nullptr && checkpoint->due())
+        checkpoint->save("couvscc", [&](std::ostream & os) { save_checkpoint(os, graph, stats); });
+
       auto && [n, succ] = _todo.top();
       if (succ.empty()) {
         if (_roots.top().n == n)
@@ -250,14 +294,13 @@ private:
   std::deque<node_sptr_t> expand_node(node_sptr_t & n, TS & ts, GRAPH & graph, tchecker::algorithms::couvscc::stats_t & stats)
   {
     std::deque<node_sptr_t> next_nodes;
-    std::vector<typename TS::sst_t> v;
-    ts.next(n->state_ptr(), v);
-    for (auto && [status, s, t] : v) {
-      ++stats.visited_transitions();
-      auto && [new_node, nextn] = graph.add_node(s);
-      graph.add_edge(n, nextn, *t);
-      next_nodes.push_back(nextn);
-    }
+    ts.for_each_next(n->state_ptr(), tchecker::STATE_OK,
+                     [&](tchecker::state_status_t status, typename TS::state_t const & s, typename TS::transition_t const & t) {
+                       ++stats.visited_transitions();
+                       auto && [new_node, nextn] = graph.add_node(s);
+                       graph.add_edge(n, nextn, *t);
+                       next_nodes.push_back(nextn);
+                     });
     return next_nodes;
   }
 
@@ -307,8 +350,111 @@ private:
       _active.pop();
   }
 
+  /*!
+   \brief Save the state of the algorithm
+   \param os : output stream
+   \param graph : a graph
+   \param stats : statistics
+   \post graph (with DFS numbers and current flags), the stacks, the DFS number
+   counter, the index of the current initial state, and the number of visited
+   states and transitions in stats have been written to os
+   */
+  void save_checkpoint(std::ostream & os, GRAPH const & graph, tchecker::algorithms::couvscc::stats_t const & stats)
+  {
+    tchecker::algorithms::node_index_t<GRAPH> const index = tchecker::algorithms::save_graph(os, graph);
+
+    tchecker::serialization::write(os, _count);
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(_initial));
+
+    std::vector<todo_stack_entry_t> todo;
+    for (std::stack<todo_stack_entry_t> s = _todo; !s.empty(); s.pop())
+      todo.push_back(s.top());
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(todo.size()));
+    for (auto it = todo.rbegin(); it != todo.rend(); ++it) {
+      tchecker::serialization::write(os, index.at(it->n.ptr()));
+      tchecker::serialization::write(os, static_cast<std::uint64_t>(it->succ.size()));
+      for (node_sptr_t const & t : it->succ)
+        tchecker::serialization::write(os, index.at(t.ptr()));
+    }
+
+    std::vector<roots_stack_entry_t> roots;
+    for (std::stack<roots_stack_entry_t> s = _roots; !s.empty(); s.pop())
+      roots.push_back(s.top());
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(roots.size()));
+    for (auto it = roots.rbegin(); it != roots.rend(); ++it) {
+      tchecker::serialization::write(os, index.at(it->n.ptr()));
+      std::vector<boost::dynamic_bitset<>::block_type> blocks(it->labels.num_blocks());
+      boost::to_block_range(it->labels, blocks.begin());
+      tchecker::serialization::write(os, static_cast<std::uint64_t>(it->labels.size()));
+      tchecker::serialization::write(os, blocks.data(), blocks.size());
+    }
+
+    std::vector<node_sptr_t> active;
+    for (std::stack<node_sptr_t> s = _active; !s.empty(); s.pop())
+      active.push_back(s.top());
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(active.size()));
+    for (auto it = active.rbegin(); it != active.rend(); ++it)
+      tchecker::serialization::write(os, index.at(it->ptr()));
+
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_states()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_transitions()));
+  }
+
+  /*!
+   \brief Load the state of the algorithm
+   \param is : input stream
+   \param graph : an empty graph
+   \param stats : statistics
+   \pre the stacks are empty
+   \post graph, the stacks, the DFS number counter, the index of the current
+   initial state and the number of visited states and transitions in stats have
+   been read from is (see save_checkpoint)
+   \throw std::runtime_error : if is does not contain a saved state
+   */
+  void load_checkpoint(std::istream & is, GRAPH & graph, tchecker::algorithms::couvscc::stats_t & stats)
+  {
+    std::vector<node_sptr_t> const nodes = tchecker::algorithms::load_graph(is, graph);
+    auto read_node = [&]() -> node_sptr_t const & {
+      std::uint64_t const n = tchecker::serialization::read<std::uint64_t>(is);
+      if (n >= nodes.size())
+        throw std::runtime_error("Invalid node index in checkpoint");
+      return nodes[n];
+    };
+
+    _count = tchecker::serialization::read<unsigned int>(is);
+    _initial = tchecker::serialization::read<std::uint64_t>(is);
+
+    std::uint64_t const todo = tchecker::serialization::read<std::uint64_t>(is);
+    for (std::uint64_t i = 0; i < todo; ++i) {
+      node_sptr_t const & n = read_node();
+      std::deque<node_sptr_t> succ;
+      std::uint64_t const succ_count = tchecker::serialization::read<std::uint64_t>(is);
+      for (std::uint64_t j = 0; j < succ_count; ++j)
+        succ.push_back(read_node());
+      _todo.push(todo_stack_entry_t{n, std::move(succ)});
+    }
+
+    std::uint64_t const roots = tchecker::serialization::read<std::uint64_t>(is);
+    for (std::uint64_t i = 0; i < roots; ++i) {
+      node_sptr_t const & n = read_node();
+      boost::dynamic_bitset<> labels{tchecker::serialization::read<std::uint64_t>(is)};
+      std::vector<boost::dynamic_bitset<>::block_type> blocks(labels.num_blocks());
+      tchecker::serialization::read(is, blocks.data(), blocks.size());
+      boost::from_block_range(blocks.begin(), blocks.end(), labels);
+      _roots.push(roots_stack_entry_t{n, labels});
+    }
+
+    std::uint64_t const active = tchecker::serialization::read<std::uint64_t>(is);
+    for (std::uint64_t i = 0; i < active; ++i)
+      _active.push(read_node());
+
+    stats.visited_states() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.visited_transitions() = tchecker::serialization::read<std::uint64_t>(is);
+  }
+
 private:
   unsigned int _count;                    /*!< DFS number counter */
+  std::size_t _initial;                   /*!< Index of the initial state being explored */
   std::stack<todo_stack_entry_t> _todo;   /*!< todo stack */
   std::stack<roots_stack_entry_t> _roots; /*!< roots stack */
   std::stack<node_sptr_t> _active;        /*!< active stack */
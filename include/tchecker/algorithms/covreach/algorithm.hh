@@ -14,11 +14,17 @@
  */
 
 #include <iterator>
+#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/algorithms/checkpoint.hh"
+#include "tchecker/algorithms/memory_limit.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/algorithms/stop.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/waiting/factory.hh"
 
@@ -44,11 +50,15 @@ enum covering_t {
  tchecker::graph::subsumption::graph_t, and nodes of type GRAPH::shared_node_t
  should have a method state_ptr() that yields a pointer to the corresponding
  state in TS.
+ \tparam WAITING : type of waiting container, should implement the interface of
+ tchecker::waiting::waiting_t over GRAPH::node_sptr_t. Methods of WAITING are
+ called without virtual dispatch when WAITING is a final class (see
+ tchecker::waiting::static_dispatch)
  \note For correctness of the algorithm, the covering relation over nodes in GRAPH
  should be a trace inclusion, and it should be irreflexive: a node should not
  cover itself
 */
-template <class TS, class GRAPH> class algorithm_t {
+template <class TS, class GRAPH, class WAITING = tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t>> class algorithm_t {
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
@@ -76,46 +86,103 @@ public:
   tchecker::algorithms::covreach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                                               enum tchecker::waiting::policy_t policy)
   {
+    static_assert(std::is_same_v<WAITING, tchecker::waiting::waiting_t<node_sptr_t>>,
+                  "waiting containers built from a policy require dynamic dispatch");
     std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    return run_from_initial_states<COVERING>(ts, graph, labels, *waiting);
+  }
+
+  /*!
+   \brief Build a covering reachability graph of a transition system from its
+   initial states, using a given waiting container
+   \tparam COVERING : type of covering (see run)
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param waiting : an empty waiting container, that should support removal of
+   elements (see tchecker::waiting::fast_remove_waiting_t)
+   \post graph is a covering reachability graph of ts built from its initial
+   states, until a state that satisfies labels is reached if any, or until the
+   entire state-space has been exhausted (see run).
+   The order in which the nodes of ts are visited depends on the policy
+   implemented by waiting.
+   \return Statistics on the run
+   \note if labels is empty, the algorithm explores the entire state-space
+   \note if a resume file has been set (see tchecker::algorithms::checkpoint),
+   graph, waiting and the statistics are loaded from the resume file instead of
+   being built from the initial states of ts
+  */
+  template <enum tchecker::algorithms::covreach::covering_t COVERING = tchecker::algorithms::covreach::COVERING_FULL>
+  tchecker::algorithms::covreach::stats_t run_from_initial_states(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                                                                  WAITING & waiting)
+  {
     tchecker::algorithms::covreach::stats_t stats;
     std::vector<node_sptr_t> nodes, covered_nodes;
+    tchecker::algorithms::progress_t * progress = tchecker::algorithms::progress();
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
+    tchecker::algorithms::memory_guard_t memory_guard{tchecker::algorithms::memory_limit()};
 
     stats.set_start_time();
 
-    expand_initial_nodes(ts, graph, nodes, stats);
-    for (node_sptr_t const & n : nodes)
-      waiting->insert(n);
-    nodes.clear();
+    if (checkpoint != nullptr && checkpoint->resuming())
+      checkpoint->load("covreach", [&](std::istream & is) { load_checkpoint(is, graph, waiting, stats); });
+    else {
+      expand_initial_nodes(ts, graph, nodes, stats);
+      for (node_sptr_t const & n : nodes)
+        waiting.insert(n);
+      nodes.clear();
+    }
 
-    while (!waiting->empty()) {
-      node_sptr_t node = waiting->first();
-      waiting->remove_first();
+    while (!waiting.empty()) {
+      if (checkpoint != nullptr && checkpoint->due())
+        checkpoint->save("covreach", [&](std::ostream & os) { save_checkpoint(os, graph, waiting, stats); });
+
+      if (tchecker::algorithms::stop_requested() || !memory_guard.check(ts, graph)) {
+        stats.stopped() = true;
+        break;
+      }
+
+      node_sptr_t node = waiting.first();
+      waiting.remove_first();
 
       ++stats.visited_states();
 
+      if (progress != nullptr && progress->due())
+        progress->report("covreach", stats.visited_states(), stats.visited_transitions(), waiting.size(), graph.nodes_count());
+
       if (accepting(node, ts, labels)) {
         node->final(true);
         stats.reachable() = true;
         break;
       }
 
-      expand_next_nodes(node, ts, graph, nodes, stats);
+      expand_next_nodes(node, ts, graph, nodes, memory_guard.store_edges(), stats);
 
       for (node_sptr_t const & next_node : nodes) {
-        waiting->insert(next_node);
+        waiting.insert(next_node);
         if constexpr (COVERING == tchecker::algorithms::covreach::COVERING_FULL) {
           remove_covered_nodes(graph, next_node, covered_nodes, stats);
           for (node_sptr_t const & covered_node : covered_nodes)
-            waiting->remove(covered_node);
+            waiting.remove(covered_node);
           covered_nodes.clear();
         }
       }
       nodes.clear();
     }
 
-    waiting->clear();
+    if (progress != nullptr)
+      progress->report("covreach", stats.visited_states(), stats.visited_transitions(), waiting.size(), graph.nodes_count(),
+                       true);
+
+    if constexpr (tchecker::waiting::is_fast_remove_waiting<WAITING>::value) {
+      stats.waiting_removed() = waiting.removed();
+      stats.waiting_compactions() = waiting.compactions();
+    }
+
+    waiting.clear();
 
     stats.stored_states() = graph.nodes_count();
+    stats.memory_degradation() = memory_guard.degradation();
 
     stats.set_end_time();
 
@@ -158,34 +225,39 @@ public:
    \param ts : a transition system
    \param graph : a subsumption graph
    \param next_nodes : nodes container
+   \param store_edges : whether edges shall be created
    \param stats : statistics
    \post A node has been created in the graph for each successor of node that
    is maximal in graph. An actual edge has been created from node to each
-   maximal successor. All maximal successors have been added to next_nodes.
+   maximal successor if store_edges is true. All maximal successors have been
+   added to next_nodes.
    For each successor node that is not maximal, a subsumption edge has been
-   created from node to a covering node.
+   created from node to a covering node if store_edges is true.
    All covered successor nodes have been counted in stats.
    */
   void expand_next_nodes(typename GRAPH::node_sptr_t const & node, TS & ts, GRAPH & graph,
-                         std::vector<typename GRAPH::node_sptr_t> & next_nodes, tchecker::algorithms::covreach::stats_t & stats)
+                         std::vector<typename GRAPH::node_sptr_t> & next_nodes, bool store_edges,
+                         tchecker::algorithms::covreach::stats_t & stats)
   {
-    std::vector<typename TS::sst_t> sst;
     typename GRAPH::node_sptr_t covering_node;
 
-    ts.next(node->state_ptr(), sst);
-    for (auto && [status, s, t] : sst) {
-      ++stats.visited_transitions();
-      typename GRAPH::node_sptr_t next_node = graph.add_node(s);
-      if (graph.is_covered(next_node, covering_node)) {
-        graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
-        graph.remove_node(next_node);
-        ++stats.covered_states();
-      }
-      else {
-        graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
-        next_nodes.push_back(next_node);
-      }
-    }
+    ts.for_each_next(
+        node->state_ptr(), tchecker::STATE_OK,
+        [&](tchecker::state_status_t status, typename TS::state_t const & s, typename TS::transition_t const & t) {
+          ++stats.visited_transitions();
+          typename GRAPH::node_sptr_t next_node = graph.add_node(s);
+          if (graph.is_covered(next_node, covering_node)) {
+            if (store_edges)
+              graph.add_edge(node, covering_node, tchecker::graph::subsumption::EDGE_SUBSUMPTION, *t);
+            graph.remove_node(next_node);
+            ++stats.covered_states();
+          }
+          else {
+            if (store_edges)
+              graph.add_edge(node, next_node, tchecker::graph::subsumption::EDGE_ACTUAL, *t);
+            next_nodes.push_back(next_node);
+          }
+        });
   }
 
   /*!
@@ -226,7 +298,43 @@ public:
    */
   bool accepting(node_sptr_t const & n, TS & ts, boost::dynamic_bitset<> const & labels)
   {
-    return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
+    return !labels.none() && ts.satisfies(n->state_ptr(), labels) && ts.is_valid_final(n->state_ptr());
+  }
+
+  /*!
+   \brief Save the state of the algorithm
+   \param os : output stream
+   \param graph : a subsumption graph
+   \param waiting : a waiting container
+   \param stats : statistics
+   \post graph, waiting and the number of visited states, visited transitions
+   and covered states in stats have been written to os
+   */
+  void save_checkpoint(std::ostream & os, GRAPH const & graph, WAITING & waiting,
+                       tchecker::algorithms::covreach::stats_t const & stats)
+  {
+    tchecker::algorithms::save_waiting(os, waiting, tchecker::algorithms::save_graph(os, graph));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_states()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_transitions()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.covered_states()));
+  }
+
+  /*!
+   \brief Load the state of the algorithm
+   \param is : input stream
+   \param graph : an empty subsumption graph
+   \param waiting : an empty waiting container
+   \param stats : statistics
+   \post graph, waiting and the number of visited states, visited transitions
+   and covered states in stats have been read from is (see save_checkpoint)
+   \throw std::runtime_error : if is does not contain a saved state
+   */
+  void load_checkpoint(std::istream & is, GRAPH & graph, WAITING & waiting, tchecker::algorithms::covreach::stats_t & stats)
+  {
+    tchecker::algorithms::load_waiting(is, waiting, tchecker::algorithms::load_graph(is, graph));
+    stats.visited_states() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.visited_transitions() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.covered_states() = tchecker::serialization::read<std::uint64_t>(is);
   }
 };
 
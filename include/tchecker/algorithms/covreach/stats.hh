@@ -83,6 +83,32 @@ public:
   */
   unsigned long stored_states() const;
 
+  /*!
+   \brief Accessor
+   \return A reference to the number of nodes removed from the waiting container
+   before being visited
+   */
+  unsigned long & waiting_removed();
+
+  /*!
+   \brief Accessor
+   \return The number of nodes removed from the waiting container before being
+   visited
+  */
+  unsigned long waiting_removed() const;
+
+  /*!
+   \brief Accessor
+   \return A reference to the number of compactions of the waiting container
+   */
+  unsigned long & waiting_compactions();
+
+  /*!
+   \brief Accessor
+   \return The number of compactions of the waiting container
+  */
+  unsigned long waiting_compactions() const;
+
   /*!
    \brief Accessor
    \return A reference to the reachable state flag
@@ -107,6 +133,8 @@ private:
   unsigned long _visited_transitions; /*!< Number of visited transitions */
   unsigned long _covered_states;      /*!< Number of covered states */
   unsigned long _stored_states;       /*!< Number of stored states */
+  unsigned long _waiting_removed;     /*!< Number of nodes removed from the waiting container */
+  unsigned long _waiting_compactions; /*!< Number of compactions of the waiting container */
   bool _reachable;                    /*!< Reachability of satisfying state */
 };
 
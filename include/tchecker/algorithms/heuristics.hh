@@ -0,0 +1,148 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_HEURISTICS_HH
+#define TCHECKER_ALGORITHMS_HEURISTICS_HH
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/syncprod/system.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/waiting/priority.hh"
+#include "tchecker/waiting/random_stack.hh"
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file heuristics.hh
+ \brief Heuristics for guided search of states with given labels
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \class labels_heuristics_t
+ \brief Heuristics estimating how far a tuple of locations is from satisfying a
+ set of labels
+ */
+class labels_heuristics_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of processes
+   \param labels : searched labels
+   \pre labels has size system.labels_count()
+   \post distances to the locations carrying labels have been computed for
+   every location of system
+   \note this does not keep a reference on system
+   */
+  labels_heuristics_t(tchecker::syncprod::system_t const & system, boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Accessor
+   \return value of distance() for tuples of locations that cannot reach the
+   searched labels
+   */
+  inline std::size_t infinity() const { return _infinity; }
+
+  /*!
+   \brief Distance to the searched labels
+   \param vloc : tuple of locations
+   \return maximum over the searched labels l of the minimal number of edges a
+   process needs to take from its location in vloc to a location with label l,
+   infinity() if some searched label cannot be reached, 0 if there is no
+   searched label
+   \note the distance ignores synchronizations, guards and invariants
+   */
+  std::size_t distance(tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Number of processes not in target locations
+   \param vloc : tuple of locations
+   \return number of processes that have a location with a searched label, but
+   whose location in vloc has no searched label
+   */
+  std::size_t processes_not_in_target(tchecker::vloc_t const & vloc) const;
+
+  /*!
+   \brief Accessor
+   \return bound on the values of processes_not_in_target() plus 1
+   */
+  inline std::size_t processes_bound() const { return _processes_bound; }
+
+private:
+  std::vector<std::vector<std::size_t>> _distance; /*!< Map : searched label x loc id -> distance */
+  boost::dynamic_bitset<> _target;                 /*!< Map : loc id -> has a searched label */
+  boost::dynamic_bitset<> _has_target;             /*!< Map : process id -> has a location with a searched label */
+  std::size_t _infinity;                           /*!< Distance for unreachable labels */
+  std::size_t _processes_bound;                    /*!< Bound on the number of processes not in target */
+};
+
+/*!
+ \brief Check if a search order is guided by heuristics
+ \param search_order : search order
+ \return true if search_order is "best", "astar" or "random", false otherwise
+ */
+bool guided_search_order(std::string const & search_order);
+
+/*!
+ \brief Factory of waiting containers for guided search orders
+ \tparam T : type of waiting elements, should be a pointer to a node with a
+ method state() that yields a state with a method vloc()
+ \tparam FAST_REMOVE : true if the waiting container should implement fast
+ removal of elements (then T should point to a type deriving from
+ tchecker::waiting::element_t)
+ \param search_order : search order
+ \param heuristics : heuristics on labels
+ \pre guided_search_order(search_order)
+ \return a newly allocated empty waiting container that implements:
+ - a greedy best-first search ordered by heuristics distance first and number
+ of processes not in target locations second if search_order is "best"
+ - an A* search ordered by depth plus heuristics distance (ties broken by the
+ number of processes not in target locations) if search_order is "astar"
+ - a random-restart depth-first search if search_order is "random"
+ \throw std::invalid_argument : if the precondition is not satisfied
+ \note the returned container keeps a shared pointer on heuristics
+ */
+template <class T, bool FAST_REMOVE>
+tchecker::waiting::waiting_t<T> * guided_waiting_factory(std::string const & search_order,
+                                                         std::shared_ptr<tchecker::algorithms::labels_heuristics_t const> const & heuristics)
+{
+  using priority_queue_t =
+      std::conditional_t<FAST_REMOVE, tchecker::waiting::fast_remove_priority_queue_t<T>, tchecker::waiting::priority_queue_t<T>>;
+  using random_stack_t =
+      std::conditional_t<FAST_REMOVE, tchecker::waiting::fast_remove_random_stack_t<T>, tchecker::waiting::random_stack_t<T>>;
+
+  if (search_order == "best")
+    return new priority_queue_t{[heuristics](T const & t, std::size_t) -> std::size_t {
+      tchecker::vloc_t const & vloc = t->state().vloc();
+      return heuristics->distance(vloc) * heuristics->processes_bound() + heuristics->processes_not_in_target(vloc);
+    }};
+  else if (search_order == "astar")
+    return new priority_queue_t{[heuristics](T const & t, std::size_t depth) -> std::size_t {
+      tchecker::vloc_t const & vloc = t->state().vloc();
+      return (depth + heuristics->distance(vloc)) * heuristics->processes_bound() + heuristics->processes_not_in_target(vloc);
+    }};
+  else if (search_order == "random")
+    return new random_stack_t{};
+  throw std::invalid_argument("Unknown guided search order: " + search_order);
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_HEURISTICS_HH
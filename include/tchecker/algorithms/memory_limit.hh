@@ -0,0 +1,212 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_MEMORY_LIMIT_HH
+#define TCHECKER_ALGORITHMS_MEMORY_LIMIT_HH
+
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/pool.hh"
+
+/*!
+ \file memory_limit.hh
+ \brief Memory limit on algorithms, with graceful degradation
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \brief Steps of degradation of an algorithm running under a memory limit
+ \note Steps are ordered: each step implies the previous ones
+ */
+enum memory_degradation_t {
+  MEMORY_NO_DEGRADATION, /*!< Full exploration */
+  MEMORY_DROP_EDGES,     /*!< Edges have been removed from the graph, and new edges are not stored */
+  MEMORY_COLLECT,        /*!< Unused nodes, edges, states and transitions are collected for reuse */
+  MEMORY_EXHAUSTED,      /*!< Exploration has been stopped (partial result) */
+};
+
+/*!
+ \brief Output operator
+ \param os : output stream
+ \param degradation : degradation step
+ \post degradation has been output to os
+ \return os after output
+ */
+std::ostream & operator<<(std::ostream & os, enum tchecker::algorithms::memory_degradation_t degradation);
+
+/*!
+ \class memory_limit_t
+ \brief Memory limit on the pools and hashtables used by algorithms
+ \note Memory is measured as tchecker::pools_memsize() +
+ tchecker::hashtables_memsize(), i.e. the memory used by states, transitions,
+ nodes and edges and by the tables that store them. Algorithms start degrading
+ (see tchecker::algorithms::memory_degradation_t) when this measure reaches the
+ threshold, and stop when it reaches the limit
+ */
+class memory_limit_t {
+public:
+  /*!
+   \brief Constructor
+   \param limit : memory limit in bytes
+   \pre limit > 0
+   \post the degradation threshold is 90% of limit
+   \throw std::invalid_argument : if limit is 0
+   */
+  explicit memory_limit_t(std::size_t limit);
+
+  /*!
+   \brief Accessor
+   \return memory limit in bytes
+   */
+  inline std::size_t limit() const { return _limit; }
+
+  /*!
+   \brief Accessor
+   \return memory threshold (in bytes) above which algorithms degrade
+   */
+  inline std::size_t threshold() const { return _threshold; }
+
+  /*!
+   \brief Accessor
+   \return memory currently used by pools and hashtables, in bytes
+   \note Constant time
+   */
+  static inline std::size_t memsize() { return tchecker::pools_memsize() + tchecker::hashtables_memsize(); }
+
+private:
+  std::size_t _limit;     /*!< Memory limit */
+  std::size_t _threshold; /*!< Degradation threshold */
+};
+
+/*!
+ \brief Parse a memory size
+ \param s : a string
+ \return the number of bytes denoted by s: a positive integer followed by an
+ optional unit K, M or G (powers of 1024)
+ \throw std::invalid_argument : if s is not a memory size
+ */
+std::size_t parse_memory_size(std::string const & s);
+
+namespace details {
+
+/*!
+ \brief Memory limit (nullptr if disabled)
+ */
+extern tchecker::algorithms::memory_limit_t * memory_limit;
+
+} // end of namespace details
+
+/*!
+ \brief Accessor
+ \return the memory limit of algorithms, nullptr if memory is not limited
+ */
+inline tchecker::algorithms::memory_limit_t const * memory_limit() { return tchecker::algorithms::details::memory_limit; }
+
+/*!
+ \brief Set the memory limit of algorithms
+ \param memory_limit : a memory limit, nullptr to disable the limit
+ \post memory_limit is used by all subsequent runs of algorithms
+ */
+void set_memory_limit(std::shared_ptr<tchecker::algorithms::memory_limit_t> const & memory_limit);
+
+/*!
+ \class memory_guard_t
+ \brief Graceful degradation of one run of an algorithm under the memory limit
+ \note Algorithms call check() at each iteration of their main loop. The memory
+ is only measured every TICKS iterations. Above the threshold, the run degrades
+ in steps: first, all the edges of the graph are dropped and new edges are not
+ stored anymore (see store_edges()). Then, unused nodes, edges, states and
+ transitions are collected each time the pools have grown, so that their memory
+ is reused instead of allocating new blocks. Finally, the run is stopped when
+ the pools have grown beyond the limit
+ */
+class memory_guard_t {
+public:
+  /*!
+   \brief Constructor
+   \param memory_limit : a memory limit (nullptr if memory is not limited)
+   */
+  explicit memory_guard_t(tchecker::algorithms::memory_limit_t const * memory_limit)
+      : _memory_limit(memory_limit), _degradation(tchecker::algorithms::MEMORY_NO_DEGRADATION), _collected_memsize(0),
+        _ticks(0)
+  {
+  }
+
+  /*!
+   \brief Check memory and degrade the run if needed
+   \tparam TS : type of transition system, should have a method collect()
+   \tparam GRAPH : type of graph, should have methods clear_edges() and collect()
+   \param ts : transition system explored by the run
+   \param graph : graph built by the run
+   \return false if the run should stop because memory is exhausted, true
+   otherwise
+   \post the run has been degraded by one step if memory is above the
+   threshold
+   */
+  template <class TS, class GRAPH> inline bool check(TS & ts, GRAPH & graph)
+  {
+    if (_memory_limit == nullptr || (++_ticks % TICKS) != 0)
+      return true;
+
+    std::size_t const memsize = tchecker::algorithms::memory_limit_t::memsize();
+    if (memsize < _memory_limit->threshold())
+      return true;
+
+    if (_degradation < tchecker::algorithms::MEMORY_DROP_EDGES) {
+      graph.clear_edges();
+      _degradation = tchecker::algorithms::MEMORY_DROP_EDGES;
+      return true;
+    }
+
+    if (memsize <= _collected_memsize) // no new block since last collection
+      return true;
+
+    if (memsize >= _memory_limit->limit() && _degradation == tchecker::algorithms::MEMORY_COLLECT) {
+      _degradation = tchecker::algorithms::MEMORY_EXHAUSTED;
+      return false;
+    }
+
+    graph.collect();
+    ts.collect();
+    _degradation = tchecker::algorithms::MEMORY_COLLECT;
+    _collected_memsize = tchecker::algorithms::memory_limit_t::memsize();
+    return true;
+  }
+
+  /*!
+   \brief Accessor
+   \return true if the run shall store edges, false if edges are dropped
+   */
+  inline bool store_edges() const { return _degradation < tchecker::algorithms::MEMORY_DROP_EDGES; }
+
+  /*!
+   \brief Accessor
+   \return current degradation step of the run
+   */
+  inline enum tchecker::algorithms::memory_degradation_t degradation() const { return _degradation; }
+
+private:
+  static constexpr unsigned long TICKS = 256; /*!< Number of calls to check() between two measures */
+
+  tchecker::algorithms::memory_limit_t const * _memory_limit;   /*!< Memory limit */
+  enum tchecker::algorithms::memory_degradation_t _degradation; /*!< Current degradation step */
+  std::size_t _collected_memsize;                              /*!< Memory measured after last collection */
+  unsigned long _ticks;                                        /*!< Number of calls to check() */
+};
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_MEMORY_LIMIT_HH
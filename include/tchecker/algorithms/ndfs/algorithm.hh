@@ -9,6 +9,7 @@
 #define TCHECKER_ALGORITHMS_NDFS_ALGORITHM_HH
 
 #include <cassert>
+#include <cstdint>
 #include <deque>
 #include <iterator>
 #include <stack>
@@ -16,8 +17,11 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/checkpoint.hh"
 #include "tchecker/algorithms/ndfs/graph.hh"
 #include "tchecker/algorithms/ndfs/stats.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/basictypes.hh"
 
 /*!
  \file algorithm.hh
@@ -105,24 +109,40 @@ public:
    each transition in ts.
    \return statistics on the run
    \note if labels is empty, graph is the full state-space of ts
+   \note if a resume file has been set (see tchecker::algorithms::checkpoint),
+   graph, the blue DFS stack and the statistics are loaded from the resume file,
+   and the search continues from the loaded stack. Initial nodes that have
+   already been visited are not white, hence they are not visited again
    */
   tchecker::algorithms::ndfs::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels)
   {
     tchecker::algorithms::ndfs::stats_t stats;
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
 
     stats.set_start_time();
 
-    std::vector<typename TS::sst_t> sst;
-    ts.initial(sst);
-    for (auto && [status, s, t] : sst) {
-      auto && [is_new_node, initial_node] = graph.add_node(s);
-      initial_node->initial(true);
-      if (initial_node->color() == tchecker::algorithms::ndfs::WHITE)
-        dfs_blue(ts, graph, labels, stats, initial_node);
-      if (stats.cycle())
-        break;
+    if (checkpoint != nullptr && checkpoint->resuming()) {
+      std::stack<blue_stack_entry_t> stack;
+      checkpoint->load("ndfs", [&](std::istream & is) { load_checkpoint(is, graph, stack, stats); });
+      dfs_blue(ts, graph, labels, stats, stack);
     }
 
+    if (!stats.cycle()) {
+      std::vector<typename TS::sst_t> sst;
+      ts.initial(sst);
+      for (auto && [status, s, t] : sst) {
+        auto && [is_new_node, initial_node] = graph.add_node(s);
+        initial_node->initial(true);
+        if (initial_node->color() == tchecker::algorithms::ndfs::WHITE)
+          dfs_blue(ts, graph, labels, stats, initial_node);
+        if (stats.cycle())
+          break;
+      }
+    }
+
+    if (tchecker::algorithms::progress() != nullptr)
+      report_progress(graph, stats, 0, true);
+
     stats.stored_states() = graph.nodes_count();
 
     stats.set_end_time();
@@ -131,6 +151,22 @@ public:
   }
 
 private:
+  /*!
+   \brief Output a progress report
+   \param graph : a graph
+   \param stats : statistics
+   \param stack_size : size of the current DFS stack
+   \param terminated : true if the algorithm has terminated
+   \pre progress reports are enabled (see tchecker::algorithms::progress)
+   */
+  void report_progress(GRAPH & graph, tchecker::algorithms::ndfs::stats_t const & stats, std::size_t stack_size,
+                       bool terminated = false)
+  {
+    tchecker::algorithms::progress()->report("ndfs", stats.visited_states_blue() + stats.visited_states_red(),
+                                             stats.visited_transitions_blue() + stats.visited_transitions_red(), stack_size,
+                                             graph.nodes_count(), terminated);
+  }
+
   /*!
    \brief Adds successor nodes to the graph
    \param ts : a transition system
@@ -143,13 +179,12 @@ private:
   std::deque<node_sptr_t> expand_node(TS & ts, GRAPH & graph, node_sptr_t & n)
   {
     std::deque<node_sptr_t> next_nodes;
-    std::vector<typename TS::sst_t> v;
-    ts.next(n->state_ptr(), v);
-    for (auto && [status, s, t] : v) {
-      auto && [new_node, nextn] = graph.add_node(s);
-      graph.add_edge(n, nextn, *t);
-      next_nodes.push_back(nextn);
-    }
+    ts.for_each_next(n->state_ptr(), tchecker::STATE_OK,
+                     [&](tchecker::state_status_t status, typename TS::state_t const & s, typename TS::transition_t const & t) {
+                       auto && [new_node, nextn] = graph.add_node(s);
+                       graph.add_edge(n, nextn, *t);
+                       next_nodes.push_back(nextn);
+                     });
     return next_nodes;
   }
 
@@ -193,7 +228,29 @@ private:
     stack.push(blue_stack_entry_t{n, expand_node(ts, graph, n), true});
     ++stats.visited_states_blue();
 
+    dfs_blue(ts, graph, labels, stats, stack);
+  }
+
+  /*!
+   \brief Blue DFS from a stack
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param stats : statistics
+   \param stack : blue DFS stack
+   \post the blue DFS has been run until stack is empty, or a cycle has been found
+  */
+  void dfs_blue(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels, tchecker::algorithms::ndfs::stats_t & stats,
+                std::stack<blue_stack_entry_t> & stack)
+  {
+    tchecker::algorithms::progress_t * progress = tchecker::algorithms::progress();
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
+
     while (!stack.empty()) {
+      if (progress != nullptr && progress->due())
+        report_progress(graph, stats, stack.size());
+      if (checkpoint != nullptr && checkpoint->due())
+        checkpoint->save("ndfs", [&](std::ostream & os) { save_checkpoint(os, graph, stack, stats); });
       auto && [s, succ, allred] = stack.top();
       if (succ.empty()) {
         if (allred)
@@ -237,7 +294,7 @@ private:
    */
   bool accepting(node_sptr_t const & n, TS & ts, boost::dynamic_bitset<> const & labels) const
   {
-    return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr()));
+    return !labels.none() && ts.satisfies(n->state_ptr(), labels);
   }
 
   /*!
@@ -293,11 +350,14 @@ private:
                node_sptr_t & n)
   {
     std::stack<red_stack_entry_t> stack;
+    tchecker::algorithms::progress_t * progress = tchecker::algorithms::progress();
 
     stack.push(red_stack_entry_t{n, graph.outgoing_edges(n)});
     ++stats.visited_states_red();
 
     while (!stack.empty()) {
+      if (progress != nullptr && progress->due())
+        report_progress(graph, stats, stack.size());
       red_stack_entry_t & top = stack.top();
       if (!top.has_successor())
         stack.pop();
@@ -316,6 +376,77 @@ private:
       }
     }
   }
+
+  /*!
+   \brief Save the state of the algorithm
+   \param os : output stream
+   \param graph : a graph
+   \param stack : blue DFS stack
+   \param stats : statistics
+   \pre the red DFS stack is empty
+   \post graph (with node colors), stack and the number of visited states and
+   transitions in stats have been written to os
+   */
+  void save_checkpoint(std::ostream & os, GRAPH const & graph, std::stack<blue_stack_entry_t> const & stack,
+                       tchecker::algorithms::ndfs::stats_t const & stats)
+  {
+    tchecker::algorithms::node_index_t<GRAPH> const index = tchecker::algorithms::save_graph(os, graph);
+
+    std::vector<blue_stack_entry_t> entries;
+    for (std::stack<blue_stack_entry_t> s = stack; !s.empty(); s.pop())
+      entries.push_back(s.top());
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(entries.size()));
+    for (auto it = entries.rbegin(); it != entries.rend(); ++it) {
+      tchecker::serialization::write(os, index.at(it->n.ptr()));
+      tchecker::serialization::write(os, static_cast<std::uint8_t>(it->allred));
+      tchecker::serialization::write(os, static_cast<std::uint64_t>(it->succ.size()));
+      for (node_sptr_t const & t : it->succ)
+        tchecker::serialization::write(os, index.at(t.ptr()));
+    }
+
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_states_blue()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_transitions_blue()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_states_red()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_transitions_red()));
+  }
+
+  /*!
+   \brief Load the state of the algorithm
+   \param is : input stream
+   \param graph : an empty graph
+   \param stack : an empty blue DFS stack
+   \param stats : statistics
+   \post graph, stack and the number of visited states and transitions in stats
+   have been read from is (see save_checkpoint)
+   \throw std::runtime_error : if is does not contain a saved state
+   */
+  void load_checkpoint(std::istream & is, GRAPH & graph, std::stack<blue_stack_entry_t> & stack,
+                       tchecker::algorithms::ndfs::stats_t & stats)
+  {
+    std::vector<node_sptr_t> const nodes = tchecker::algorithms::load_graph(is, graph);
+    auto read_node = [&]() -> node_sptr_t const & {
+      std::uint64_t const n = tchecker::serialization::read<std::uint64_t>(is);
+      if (n >= nodes.size())
+        throw std::runtime_error("Invalid node index in checkpoint");
+      return nodes[n];
+    };
+
+    std::uint64_t const entries = tchecker::serialization::read<std::uint64_t>(is);
+    for (std::uint64_t i = 0; i < entries; ++i) {
+      node_sptr_t const & n = read_node();
+      bool const allred = (tchecker::serialization::read<std::uint8_t>(is) != 0);
+      std::deque<node_sptr_t> succ;
+      std::uint64_t const succ_count = tchecker::serialization::read<std::uint64_t>(is);
+      for (std::uint64_t j = 0; j < succ_count; ++j)
+        succ.push_back(read_node());
+      stack.push(blue_stack_entry_t{n, std::move(succ), allred});
+    }
+
+    stats.visited_states_blue() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.visited_transitions_blue() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.visited_states_red() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.visited_transitions_red() = tchecker::serialization::read<std::uint64_t>(is);
+  }
 };
 
 } // namespace ndfs
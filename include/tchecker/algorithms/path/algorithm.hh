@@ -14,6 +14,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "tchecker/graph/frozen_graph.hh"
 #include "tchecker/utils/iterator.hh"
 
 /*!
@@ -186,6 +187,125 @@ private:
   }
 };
 
+/*!
+ \class algorithm_t
+ \brief Finite path extraction algorithm over frozen graphs
+ \tparam GRAPH : type of original graph, see tchecker::graph::frozen::graph_t
+ \note Same search as the algorithm on GRAPH (same order on nodes and edges,
+ hence same path), but the depth-first search runs over the arrays of indices
+ of the frozen graph, and visited nodes are stored in a bit vector
+ */
+template <class GRAPH> class algorithm_t<tchecker::graph::frozen::graph_t<GRAPH>> {
+public:
+  /*!
+   \brief Type of pointer to node
+  */
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Typoe of pointer to edge
+  */
+  using edge_sptr_t = typename GRAPH::edge_sptr_t;
+
+  /*!
+   \brief Extract a finite sequence from a frozen graph
+   \param g : a frozen graph
+   \param filter_first : predicate on nodes
+   \param filter_last : predicate on nodes
+   \param filter_edge : predicate on edges
+   \return a finite sequence of edges from g, all satisfying filter_edge, and that leads
+   to a node satisfying filter_first, to a node satisfying filter_last if any,
+   an empty sequence otherwise
+  */
+  std::vector<edge_sptr_t> run(tchecker::graph::frozen::graph_t<GRAPH> const & g,
+                               std::function<bool(node_sptr_t)> && filter_first,
+                               std::function<bool(node_sptr_t)> && filter_last, std::function<bool(edge_sptr_t)> && filter_edge)
+  {
+    std::vector<bool> visited(g.nodes_count(), false);
+    std::vector<tchecker::graph::frozen::edge_index_t> seq;
+    for (tchecker::graph::frozen::node_index_t n = 0; n < g.nodes_count(); ++n) {
+      if (!filter_first(g.node(n)))
+        continue;
+      if (find_sequence(g, n, filter_last, filter_edge, visited, seq)) {
+        std::vector<edge_sptr_t> edges;
+        edges.reserve(seq.size());
+        for (tchecker::graph::frozen::edge_index_t e : seq)
+          edges.push_back(g.edge(e));
+        return edges;
+      }
+    }
+    return std::vector<edge_sptr_t>{};
+  }
+
+private:
+  /*!
+   \brief Waiting stack entry for depth-first search: current and past-the-end
+   outgoing edges of a node
+  */
+  using dfs_entry_t = std::pair<tchecker::graph::frozen::edge_index_t, tchecker::graph::frozen::edge_index_t>;
+
+  /*!
+   \brief Depth-first search from n to a node satisfying last
+   \param g : a frozen graph
+   \param n : a node index
+   \param filter_last : predicate on nodes
+   \param filter_edge : predicate on edges
+   \param visited : nodes that have already been visited
+   \param seq : sequence of edges
+   \return true if a non-empty finite sequence of edges from g, all satisfying
+   filter_edge, leads from n to a node satisfying filter_last, false otherwise
+   \post seq is the sequence of edges from n to a node satisfying filter_last if
+   any, and empty otherwise. All nodes visited during the search have been marked
+   in visited
+   \note nodes in visited are not explored
+  */
+  bool find_sequence(tchecker::graph::frozen::graph_t<GRAPH> const & g, tchecker::graph::frozen::node_index_t n,
+                     std::function<bool(node_sptr_t)> & filter_last, std::function<bool(edge_sptr_t)> & filter_edge,
+                     std::vector<bool> & visited, std::vector<tchecker::graph::frozen::edge_index_t> & seq)
+  {
+    seq.clear();
+
+    // as for non-frozen graphs, empty sequences are not reported
+    if (filter_last(g.node(n)))
+      return false;
+
+    std::vector<dfs_entry_t> waiting;
+
+    waiting.push_back(g.outgoing_edges(n));
+    visited[n] = true;
+
+    while (!waiting.empty()) {
+      dfs_entry_t & top = waiting.back();
+      if (top.first == top.second) {
+        waiting.pop_back();
+        if (!seq.empty())
+          seq.pop_back();
+        continue;
+      }
+
+      tchecker::graph::frozen::edge_index_t e = top.first++;
+
+      if (!filter_edge(g.edge(e)))
+        continue;
+
+      tchecker::graph::frozen::node_index_t nextn = g.edge_tgt(e);
+
+      if (visited[nextn])
+        continue;
+
+      seq.push_back(e);
+
+      if (filter_last(g.node(nextn)))
+        return true;
+
+      waiting.push_back(g.outgoing_edges(nextn));
+      visited[nextn] = true;
+    }
+
+    return false;
+  }
+};
+
 } // namespace finite
 
 } // namespace path
@@ -0,0 +1,124 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_PROGRESS_HH
+#define TCHECKER_ALGORITHMS_PROGRESS_HH
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+
+/*!
+ \file progress.hh
+ \brief Periodic progress reports for algorithms
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \brief Format of progress reports
+ */
+enum progress_format_t {
+  PROGRESS_TEXT, /*!< Human-readable lines */
+  PROGRESS_JSON, /*!< JSON lines (one JSON object per line) */
+};
+
+/*!
+ \class progress_t
+ \brief Periodic progress reporter
+ \note Algorithms call due() at each iteration of their main loop, and report()
+ when due() returns true. The clock is only read every TICKS iterations so the
+ overhead of due() is an increment and a test most of the time
+ */
+class progress_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   \param format : format of reports
+   \param period : minimal time between two reports, in seconds
+   \note this keeps a reference on os
+   */
+  progress_t(std::ostream & os, enum tchecker::algorithms::progress_format_t format, double period);
+
+  /*!
+   \brief Check if a report is due
+   \return true if at least period seconds have elapsed since the last report,
+   false otherwise
+   */
+  inline bool due()
+  {
+    if ((++_ticks % TICKS) != 0)
+      return false;
+    return std::chrono::steady_clock::now() >= _next_report;
+  }
+
+  /*!
+   \brief Output a report
+   \param algorithm : name of the running algorithm
+   \param visited_states : number of visited states
+   \param visited_transitions : number of visited transitions
+   \param waiting : number of nodes in the waiting container (or stack)
+   \param stored_nodes : number of nodes stored in the graph
+   \param terminated : true if the algorithm has terminated
+   \post a report with states per second since the last report, memory used by
+   pools (see tchecker::pools_memsize) and resident set size has been output
+   */
+  void report(char const * algorithm, unsigned long visited_states, unsigned long visited_transitions, std::size_t waiting,
+              std::size_t stored_nodes, bool terminated = false);
+
+private:
+  static constexpr unsigned long TICKS = 1024; /*!< Number of calls to due() between two clock readings */
+
+  std::ostream & _os;                                               /*!< Output stream */
+  enum tchecker::algorithms::progress_format_t _format;             /*!< Format of reports */
+  std::chrono::steady_clock::duration _period;                      /*!< Minimal time between two reports */
+  std::chrono::time_point<std::chrono::steady_clock> _start;        /*!< Creation time */
+  std::chrono::time_point<std::chrono::steady_clock> _last_report;  /*!< Time of last report */
+  std::chrono::time_point<std::chrono::steady_clock> _next_report;  /*!< Time of next report */
+  unsigned long _last_visited_states;                               /*!< Visited states at last report */
+  unsigned long _ticks;                                             /*!< Number of calls to due() */
+};
+
+namespace details {
+
+/*!
+ \brief Progress reporter (nullptr if disabled)
+ */
+extern tchecker::algorithms::progress_t * progress;
+
+} // end of namespace details
+
+/*!
+ \brief Accessor
+ \return the progress reporter of algorithms, nullptr if progress reports are
+ disabled
+ */
+inline tchecker::algorithms::progress_t * progress() { return tchecker::algorithms::details::progress; }
+
+/*!
+ \brief Set the progress reporter of algorithms
+ \param progress : a progress reporter, nullptr to disable progress reports
+ \post progress is used by all subsequent runs of algorithms
+ */
+void set_progress(std::shared_ptr<tchecker::algorithms::progress_t> const & progress);
+
+/*!
+ \brief Accessor
+ \return current resident set size in kilobytes, maximum resident set size if
+ the current one is not available, -1 if an error occurred
+ */
+long current_rss();
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_PROGRESS_HH
@@ -9,9 +9,14 @@
 #define TCHECKER_ALGORITHMS_REACH_ALGORITHM_HH
 
 #include <memory>
+#include <type_traits>
 
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/algorithms/checkpoint.hh"
+#include "tchecker/algorithms/memory_limit.hh"
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/algorithms/stop.hh"
 #include "tchecker/algorithms/reach/stats.hh"
 #include "tchecker/basictypes.hh"
 #include "tchecker/waiting/factory.hh"
@@ -35,8 +40,12 @@ namespace reach {
  tchecker::graph::reachability_graph_t, and nodes of type GRAPH::shared_node_t
  should have a method state_ptr() that yields a pointer to the corresponding
  state in TS
+ \tparam WAITING : type of waiting container, should implement the interface of
+ tchecker::waiting::waiting_t over GRAPH::node_sptr_t. Methods of WAITING are
+ called without virtual dispatch when WAITING is a final class (see
+ tchecker::waiting::static_dispatch)
  */
-template <class TS, class GRAPH> class algorithm_t {
+template <class TS, class GRAPH, class WAITING = tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t>> class algorithm_t {
 public:
   using node_sptr_t = typename GRAPH::node_sptr_t;
 
@@ -58,22 +67,52 @@ public:
   tchecker::algorithms::reach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
                                            enum tchecker::waiting::policy_t policy)
   {
+    static_assert(std::is_same_v<WAITING, tchecker::waiting::waiting_t<node_sptr_t>>,
+                  "waiting containers built from a policy require dynamic dispatch");
     std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::waiting::factory<node_sptr_t>(policy)};
+    return run_from_initial_states(ts, graph, labels, *waiting);
+  }
 
+  /*!
+   \brief Build a reachability graph of a transition system from its initial
+   states, using a given waiting container
+   \param ts : a transition system
+   \param graph : a graph
+   \param labels : accepting labels
+   \param waiting : an empty waiting container
+   \post graph is built from a traversal of ts starting from its initial states,
+   until a state that satisfies labels is reached (if any).
+   A node is created for each reachable state in ts, and an edge is created for
+   each transition in ts. The order in which the nodes of ts are visited depends
+   on the policy implemented by waiting
+   \return statistics on the run
+   \note if labels is empty, graph is the full reachability graph of ts
+   \note if a resume file has been set (see tchecker::algorithms::checkpoint),
+   graph, waiting and the statistics are loaded from the resume file instead of
+   being built from the initial states of ts
+   */
+  tchecker::algorithms::reach::stats_t run_from_initial_states(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
+                                                               WAITING & waiting)
+  {
     tchecker::algorithms::reach::stats_t stats;
 
     stats.set_start_time();
 
-    std::vector<typename TS::sst_t> sst;
-    ts.initial(sst);
-    for (auto && [status, s, t] : sst) {
-      auto && [is_new_node, initial_node] = graph.add_node(s);
-      initial_node->initial(true);
-      if (is_new_node)
-        waiting->insert(initial_node);
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
+    if (checkpoint != nullptr && checkpoint->resuming())
+      checkpoint->load("reach", [&](std::istream & is) { load_checkpoint(is, graph, waiting, stats); });
+    else {
+      std::vector<typename TS::sst_t> sst;
+      ts.initial(sst);
+      for (auto && [status, s, t] : sst) {
+        auto && [is_new_node, initial_node] = graph.add_node(s);
+        initial_node->initial(true);
+        if (is_new_node)
+          waiting.insert(initial_node);
+      }
     }
 
-    run_from_waiting(ts, graph, labels, *waiting, stats);
+    run_from_waiting(ts, graph, labels, waiting, stats);
 
     stats.set_end_time();
 
@@ -97,7 +136,7 @@ public:
   nodes in waiting
   */
   tchecker::algorithms::reach::stats_t run(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
-                                           tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t> & waiting)
+                                           WAITING & waiting)
   {
     tchecker::algorithms::reach::stats_t stats;
 
@@ -126,35 +165,54 @@ private:
   set in stats.
   */
   void run_from_waiting(TS & ts, GRAPH & graph, boost::dynamic_bitset<> const & labels,
-                        tchecker::waiting::waiting_t<typename GRAPH::node_sptr_t> & waiting,
+                        WAITING & waiting,
                         tchecker::algorithms::reach::stats_t & stats)
   {
-    std::vector<typename TS::sst_t> sst;
+    tchecker::algorithms::progress_t * progress = tchecker::algorithms::progress();
+    tchecker::algorithms::checkpoint_t * checkpoint = tchecker::algorithms::checkpoint();
+    tchecker::algorithms::memory_guard_t memory_guard{tchecker::algorithms::memory_limit()};
 
     while (!waiting.empty()) {
+      if (checkpoint != nullptr && checkpoint->due())
+        checkpoint->save("reach", [&](std::ostream & os) { save_checkpoint(os, graph, waiting, stats); });
+
+      if (tchecker::algorithms::stop_requested() || !memory_guard.check(ts, graph)) {
+        stats.stopped() = true;
+        break;
+      }
+
       node_sptr_t node = waiting.first();
       waiting.remove_first();
 
       ++stats.visited_states();
 
+      if (progress != nullptr && progress->due())
+        progress->report("reach", stats.visited_states(), stats.visited_transitions(), waiting.size(), graph.nodes_count());
+
       if (accepting(node, ts, labels)) {
         node->final(true);
         stats.reachable() = true;
         break;
       }
 
-      ts.next(node->state_ptr(), sst);
-      for (auto && [status, s, t] : sst) {
-        auto && [is_new_node, next_node] = graph.add_node(s);
-        if (is_new_node)
-          waiting.insert(next_node);
-        graph.add_edge(node, next_node, *t);
+      ts.for_each_next(node->state_ptr(), tchecker::STATE_OK,
+                       [&](tchecker::state_status_t status, typename TS::state_t const & s,
+                           typename TS::transition_t const & t) {
+                         auto && [is_new_node, next_node] = graph.add_node(s);
+                         if (is_new_node)
+                           waiting.insert(next_node);
+                         if (memory_guard.store_edges())
+                           graph.add_edge(node, next_node, *t);
 
-        ++stats.visited_transitions();
-      }
-      sst.clear();
+                         ++stats.visited_transitions();
+                       });
     }
 
+    stats.memory_degradation() = memory_guard.degradation();
+
+    if (progress != nullptr)
+      progress->report("reach", stats.visited_states(), stats.visited_transitions(), waiting.size(), graph.nodes_count(), true);
+
     waiting.clear();
   }
 
@@ -168,7 +226,41 @@ private:
    */
   bool accepting(node_sptr_t const & n, TS & ts, boost::dynamic_bitset<> const & labels)
   {
-    return !labels.none() && labels.is_subset_of(ts.labels(n->state_ptr())) && ts.is_valid_final(n->state_ptr());
+    return !labels.none() && ts.satisfies(n->state_ptr(), labels) && ts.is_valid_final(n->state_ptr());
+  }
+
+  /*!
+   \brief Save the state of the algorithm
+   \param os : output stream
+   \param graph : a graph
+   \param waiting : a waiting container
+   \param stats : statistics
+   \post graph, waiting and the number of visited states and transitions in stats
+   have been written to os
+   */
+  void save_checkpoint(std::ostream & os, GRAPH const & graph, WAITING & waiting,
+                       tchecker::algorithms::reach::stats_t const & stats)
+  {
+    tchecker::algorithms::save_waiting(os, waiting, tchecker::algorithms::save_graph(os, graph));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_states()));
+    tchecker::serialization::write(os, static_cast<std::uint64_t>(stats.visited_transitions()));
+  }
+
+  /*!
+   \brief Load the state of the algorithm
+   \param is : input stream
+   \param graph : an empty graph
+   \param waiting : an empty waiting container
+   \param stats : statistics
+   \post graph, waiting and the number of visited states and transitions in stats
+   have been read from is (see save_checkpoint)
+   \throw std::runtime_error : if is does not contain a saved state
+   */
+  void load_checkpoint(std::istream & is, GRAPH & graph, WAITING & waiting, tchecker::algorithms::reach::stats_t & stats)
+  {
+    tchecker::algorithms::load_waiting(is, waiting, tchecker::algorithms::load_graph(is, graph));
+    stats.visited_states() = tchecker::serialization::read<std::uint64_t>(is);
+    stats.visited_transitions() = tchecker::serialization::read<std::uint64_t>(is);
   }
 };
 
@@ -12,6 +12,8 @@
 #include <map>
 #include <string>
 
+#include "tchecker/algorithms/memory_limit.hh"
+
 /*!
  \file stats.hh
  \brief Statistics for algorithms
@@ -27,6 +29,11 @@ namespace algorithms {
  */
 class stats_t {
 public:
+  /*!
+   \brief Constructor
+   */
+  stats_t();
+
   /*!
    \brief Set starting time
   */
@@ -62,16 +69,48 @@ public:
   */
   long max_rss() const;
 
+  /*!
+   \brief Accessor
+   \return Reference to the stopped flag
+   */
+  bool & stopped();
+
+  /*!
+   \brief Accessor
+   \return true if the algorithm has been stopped before completion (see
+   tchecker::algorithms::request_stop), false otherwise
+   */
+  bool stopped() const;
+
+  /*!
+   \brief Accessor
+   \return Reference to the degradation step under the memory limit
+   */
+  enum tchecker::algorithms::memory_degradation_t & memory_degradation();
+
+  /*!
+   \brief Accessor
+   \return degradation step reached under the memory limit (see
+   tchecker::algorithms::memory_guard_t)
+   */
+  enum tchecker::algorithms::memory_degradation_t memory_degradation() const;
+
   /*!
    \brief Extract statistics as attributes (key, value)
    \param m : attributes map
-   \post Starting time, ending time and running time have been added to m
+   \post Starting time, ending time and running time have been added to m, as
+   well as profiling counters if TChecker is built with profiling (see
+   tchecker/utils/profiling.hh), the stopped flag if the algorithm has been
+   stopped, and the degradation step if the algorithm has been degraded under
+   the memory limit
   */
   void attributes(std::map<std::string, std::string> & m) const;
 
 private:
-  std::chrono::time_point<std::chrono::steady_clock> _start_time; /*!< Start time */
-  std::chrono::time_point<std::chrono::steady_clock> _end_time;   /*!< End time */
+  std::chrono::time_point<std::chrono::steady_clock> _start_time;      /*!< Start time */
+  std::chrono::time_point<std::chrono::steady_clock> _end_time;        /*!< End time */
+  bool _stopped;                                                       /*!< Stopped before completion */
+  enum tchecker::algorithms::memory_degradation_t _memory_degradation; /*!< Degradation under memory limit */
 };
 
 } // end of namespace algorithms
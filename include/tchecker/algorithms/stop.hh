@@ -0,0 +1,56 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ALGORITHMS_STOP_HH
+#define TCHECKER_ALGORITHMS_STOP_HH
+
+#include <atomic>
+
+/*!
+ \file stop.hh
+ \brief Cooperative stop of running algorithms
+ */
+
+namespace tchecker {
+
+namespace algorithms {
+
+namespace details {
+
+/*!
+ \brief Stop flag
+ */
+inline std::atomic<bool> stop{false};
+
+} // end of namespace details
+
+/*!
+ \brief Accessor
+ \return true if running algorithms have been asked to stop, false otherwise
+ \note Algorithms check this flag at each iteration of their main loop, and
+ return their current statistics, marked as stopped, when it is set
+ */
+inline bool stop_requested() { return tchecker::algorithms::details::stop.load(std::memory_order_relaxed); }
+
+/*!
+ \brief Ask running algorithms to stop
+ \post stop_requested() returns true
+ \note This function can be called from any thread
+ */
+inline void request_stop() { tchecker::algorithms::details::stop.store(true, std::memory_order_relaxed); }
+
+/*!
+ \brief Clear the stop flag
+ \post stop_requested() returns false
+ */
+inline void clear_stop() { tchecker::algorithms::details::stop.store(false, std::memory_order_relaxed); }
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ALGORITHMS_STOP_HH
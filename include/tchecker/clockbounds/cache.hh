@@ -0,0 +1,209 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_CLOCKBOUNDS_CACHE_HH
+#define TCHECKER_CLOCKBOUNDS_CACHE_HH
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/syncprod/vloc.hh"
+
+/*!
+ \file cache.hh
+ \brief Caches of local clock bounds for tuples of locations
+ */
+
+namespace tchecker {
+
+namespace clockbounds {
+
+namespace details {
+
+/*!
+ \class vloc_bounds_cache_t
+ \brief Direct-mapped cache from tuples of locations to clock bound maps
+ \note Each entry of the cache consists in a tuple of locations and a fixed
+ number of clock bound maps. A tuple of locations is mapped to the entry at
+ index its hash value modulo the size of the cache. An entry is overwritten by
+ the last tuple of locations mapped to it
+ */
+class vloc_bounds_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param clock_nb : number of clocks
+   \param maps_nb : number of clock bound maps per entry
+   \param size : number of entries
+   \pre size is a power of 2 (checked by assertion)
+   */
+  vloc_bounds_cache_t(tchecker::clock_id_t clock_nb, std::size_t maps_nb, std::size_t size);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  vloc_bounds_cache_t(tchecker::clockbounds::details::vloc_bounds_cache_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  vloc_bounds_cache_t(tchecker::clockbounds::details::vloc_bounds_cache_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~vloc_bounds_cache_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::clockbounds::details::vloc_bounds_cache_t &
+  operator=(tchecker::clockbounds::details::vloc_bounds_cache_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::clockbounds::details::vloc_bounds_cache_t &
+  operator=(tchecker::clockbounds::details::vloc_bounds_cache_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return number of lookups that found their tuple of locations in the cache
+   */
+  inline unsigned long hits() const { return _hits; }
+
+  /*!
+   \brief Accessor
+   \return number of lookups that did not find their tuple of locations in the
+   cache
+   */
+  inline unsigned long misses() const { return _misses; }
+
+  /*!
+   \brief Clear
+   \post the cache is empty (hits and misses counters are not reset)
+   */
+  void clear();
+
+protected:
+  /*!
+   \brief Lookup
+   \param vloc : tuple of locations
+   \param found : lookup result
+   \return index of the entry for vloc
+   \post found is true if the entry at the returned index contains clock bound
+   maps for vloc, and false otherwise. In the latter case, the entry now has
+   key vloc and its clock bound maps shall be updated
+   */
+  std::size_t lookup(tchecker::vloc_t const & vloc, bool & found);
+
+  /*!
+   \brief Accessor
+   \param entry : entry index
+   \param i : map index
+   \pre entry < size and i < number of maps per entry (checked by assertion)
+   \return i-th clock bound map in entry
+   */
+  tchecker::clockbounds::map_t * map(std::size_t entry, std::size_t i) const;
+
+private:
+  tchecker::clock_id_t _clock_nb;                    /*!< Number of clocks */
+  std::size_t _maps_nb;                              /*!< Number of clock bound maps per entry */
+  std::size_t _mask;                                 /*!< Mask to compute entry index from hash value */
+  std::vector<std::vector<tchecker::loc_id_t>> _keys; /*!< Tuples of locations */
+  std::vector<bool> _valid;                          /*!< Valid entries */
+  std::vector<tchecker::clockbounds::map_t *> _maps; /*!< Clock bound maps */
+  unsigned long _hits;                               /*!< Number of hits */
+  unsigned long _misses;                             /*!< Number of misses */
+};
+
+} // end of namespace details
+
+/*!
+ \brief Default number of entries in caches of clock bounds
+ */
+std::size_t const DEFAULT_CACHE_SIZE = 4096;
+
+/*!
+ \class local_lu_cache_t
+ \brief Cache of local LU clock bounds for tuples of locations
+ */
+class local_lu_cache_t : public tchecker::clockbounds::details::vloc_bounds_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param clock_bounds : local LU clock bounds map
+   \param size : number of entries
+   \pre size is a power of 2 (checked by assertion)
+   \note this keeps a shared pointer on clock_bounds
+   */
+  local_lu_cache_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds,
+                   std::size_t size = tchecker::clockbounds::DEFAULT_CACHE_SIZE);
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \param L : clock lower-bound map
+   \param U : clock upper-bound map
+   \post L and U point to the local lower-bound and upper-bound maps for vloc
+   \note L and U are valid until the next call to bounds() or clear()
+   */
+  void bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t const *& L,
+              tchecker::clockbounds::map_t const *& U);
+
+  /*!
+   \brief Accessor
+   \return local LU clock bounds map
+   */
+  inline std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & local_lu_map() const { return _clock_bounds; }
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< Local LU clock bounds map */
+};
+
+/*!
+ \class local_m_cache_t
+ \brief Cache of local M clock bounds for tuples of locations
+ */
+class local_m_cache_t : public tchecker::clockbounds::details::vloc_bounds_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param clock_bounds : local M clock bounds map
+   \param size : number of entries
+   \pre size is a power of 2 (checked by assertion)
+   \note this keeps a shared pointer on clock_bounds
+   */
+  local_m_cache_t(std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & clock_bounds,
+                  std::size_t size = tchecker::clockbounds::DEFAULT_CACHE_SIZE);
+
+  /*!
+   \brief Accessor
+   \param vloc : tuple of locations
+   \return pointer to the local M map for vloc
+   \note the returned map is valid until the next call to bounds() or clear()
+   */
+  tchecker::clockbounds::map_t const * bounds(tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Accessor
+   \return local M clock bounds map
+   */
+  inline std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & local_m_map() const { return _clock_bounds; }
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_m_map_t const> _clock_bounds; /*!< Local M clock bounds map */
+};
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_CLOCKBOUNDS_CACHE_HH
@@ -398,6 +398,22 @@ void reset_to_sum(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker:
  */
 void open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim);
 
+/*!
+ \brief Free a clock
+ \param dbm : a dbm
+ \param dim : dimension of dbm
+ \param x : clock
+ \pre dbm is not nullptr (checked by assertion)
+ dbm is a dim*dim array of difference bounds
+ dbm is consistent (checked by assertion)
+ dbm is tight (checked by assertion)
+ dbm is positive (checked by assertion)
+ 0 < x < dim (checked by assertion)
+ \post all constraints on clock x have been removed from dbm, except x >= 0.
+ dbm is tight.
+ */
+void free_clock(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x);
+
 /*!
  \brief Intersection
  \param dbm : a dbm
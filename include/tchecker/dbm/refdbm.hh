@@ -8,6 +8,9 @@
 #ifndef TCHECKER_REFDBM_HH
 #define TCHECKER_REFDBM_HH
 
+#include <functional>
+#include <string>
+
 #include <boost/dynamic_bitset/dynamic_bitset.hpp>
 
 #include "tchecker/basictypes.hh"
@@ -720,6 +723,22 @@ std::ostream & output_matrix(std::ostream & os, tchecker::dbm::db_t const * rdbm
  */
 std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * rdbm, tchecker::reference_clock_variables_t const & r);
 
+/*!
+ \brief Output a DBM with reference clocks as a conjunction of constraints
+ \param os : output stream
+ \param rdbm : a DBM
+ \param rdim : dimension of rdbm
+ \param clock_name : map from clock IDs to strings
+ \pre rdbm is not nullptr (checked by assertion)
+ rdbm is a rdim*rdim array of difference bounds
+ clock_name maps any clock ID in [0,rdim) to a name
+ \post the relevant constraints in rdbm have been output to os, as
+ output(os, rdbm, r) for reference clocks r named by clock_name
+ \return os after output
+ */
+std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * rdbm, tchecker::clock_id_t rdim,
+                      std::function<std::string(tchecker::clock_id_t)> clock_name);
+
 /*!
  \brief Lexical ordering over DBMs with reference clocks
  \param rdbm1 : first DBM
@@ -0,0 +1,622 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_GRAPH_BINARY_CERTIFICATE_HH
+#define TCHECKER_GRAPH_BINARY_CERTIFICATE_HH
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/graph/subsumption_graph.hh"
+#include "tchecker/refzg/zone.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/zg/zone.hh"
+
+/*!
+ \file binary_certificate.hh
+ \brief Compact binary format for certificate graphs over zone graphs
+ \note A binary certificate is a file that consists of a header
+ (tchecker::graph::binary::header_t) followed by sections. The header gives the
+ offset and size of each section (see tchecker::graph::binary::section_id_t):
+ - a string table (process, location, label, event, variable names),
+ - the tables of processes, locations, labels, events and edges of the system,
+ - fixed-width node records: flags, tuple of locations, integer valuation and
+ zone (DBM) of each node,
+ - CSR arrays of edges: for each node, the range of its outgoing edges, then,
+ for each edge, its target node, its tuple of edge identifiers and its type.
+ Nodes are numbered 0..nodes-1 and edges are numbered 0..edges-1 in this order.
+ Sections are aligned on 8 bytes. Values are written in the native
+ representation of the machine, hence a certificate can only be read on the
+ same architecture, by a TChecker built with the same integer size.
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+namespace binary {
+
+/*!
+ \brief Magic number of binary certificates
+ */
+constexpr char const MAGIC[8] = {'T', 'C', 'K', 'C', 'E', 'R', 'T', '\0'};
+
+/*!
+ \brief Version of the format of binary certificates
+ */
+constexpr std::uint32_t VERSION = 1;
+
+/*!
+ \brief Kind of zones in node records
+ */
+enum zone_kind_t : std::uint32_t {
+  ZONE_DBM = 0,    /*!< DBM over system clocks, dimension 0 is the zero clock */
+  ZONE_REFDBM = 1, /*!< DBM over reference clocks followed by system clocks */
+};
+
+/*!
+ \brief Type of edges
+ */
+enum edge_type_t : std::uint8_t {
+  EDGE_UNTYPED = 0,     /*!< Edge in a graph without edge types */
+  EDGE_ACTUAL = 1,      /*!< Actual edge in a subsumption graph */
+  EDGE_SUBSUMPTION = 2, /*!< Subsumption edge in a subsumption graph */
+};
+
+/*!
+ \brief Flags in node records
+ */
+enum node_flag_t : std::uint32_t {
+  NODE_INITIAL = 1, /*!< Initial node */
+  NODE_FINAL = 2,   /*!< Final node */
+};
+
+/*!
+ \brief Identifiers of sections
+ */
+enum section_id_t {
+  SECTION_STRING_OFFSETS = 0,      /*!< uint64_t[strings+1]: offsets of strings in SECTION_STRINGS */
+  SECTION_STRINGS,                 /*!< characters of all strings (not null-terminated) */
+  SECTION_PROCESSES,               /*!< uint32_t[processes]: process names */
+  SECTION_LOCATIONS,               /*!< location_t[locations] */
+  SECTION_LOCATION_LABELS_OFFSETS, /*!< uint32_t[locations+1]: offsets of labels of locations */
+  SECTION_LOCATION_LABELS,         /*!< uint32_t[]: labels of locations */
+  SECTION_LABELS,                  /*!< uint32_t[labels]: label names */
+  SECTION_EVENTS,                  /*!< uint32_t[events]: event names */
+  SECTION_EDGES,                   /*!< system_edge_t[system_edges] */
+  SECTION_INTVARS,                 /*!< uint32_t[intvars]: names of flattened integer variables */
+  SECTION_CLOCKS,                  /*!< uint32_t[zone_dim]: names of zone dimensions */
+  SECTION_NODES,                   /*!< node records (see header_t) */
+  SECTION_OUTGOING_OFFSETS,        /*!< uint64_t[nodes+1]: outgoing edges of node n are in [offsets[n],offsets[n+1]) */
+  SECTION_EDGE_TARGETS,            /*!< uint32_t[edges]: target node of edges */
+  SECTION_VEDGES,                  /*!< edge_id_t[edges*processes]: tuple of edges (NO_EDGE if process is idle) */
+  SECTION_EDGE_TYPES,              /*!< uint8_t[edges]: edge types (see edge_type_t) */
+  SECTIONS_COUNT,                  /*!< Number of sections */
+};
+
+/*!
+ \brief Section in a binary certificate
+ */
+struct section_t {
+  std::uint64_t offset; /*!< Offset from the beginning of the file, in bytes */
+  std::uint64_t size;   /*!< Size in bytes */
+};
+
+/*!
+ \brief Header of binary certificates
+ \note A node record consists of: uint32_t flags (see node_flag_t), loc_id_t
+ vloc[processes] at offset 4, integer_t intval[intvars] at offset intval_offset,
+ and db_t zone[zone_dim*zone_dim] at offset zone_offset
+ \note Names are identifiers in the string table
+ */
+struct header_t {
+  char magic[8];                              /*!< Magic number */
+  std::uint32_t version;                      /*!< Version of the format */
+  std::uint32_t zone_kind;                    /*!< Kind of zones (see zone_kind_t) */
+  std::uint32_t name;                         /*!< Name of the graph */
+  std::uint32_t processes;                    /*!< Number of processes */
+  std::uint32_t intvars;                      /*!< Number of flattened integer variables */
+  std::uint32_t zone_dim;                     /*!< Dimension of zones */
+  std::uint32_t refcount;                     /*!< Number of reference clocks (ZONE_REFDBM) */
+  std::uint32_t locations;                    /*!< Number of locations */
+  std::uint32_t labels;                       /*!< Number of labels */
+  std::uint32_t events;                       /*!< Number of events */
+  std::uint32_t system_edges;                 /*!< Number of edges in the system */
+  std::uint32_t integer_size;                 /*!< sizeof(tchecker::integer_t) */
+  std::uint32_t db_size;                      /*!< sizeof(tchecker::dbm::db_t) */
+  std::uint32_t node_record_size;             /*!< Size of node records, in bytes */
+  std::uint32_t intval_offset;                /*!< Offset of integer valuation in node records */
+  std::uint32_t zone_offset;                  /*!< Offset of zone in node records */
+  std::uint64_t strings;                      /*!< Number of strings */
+  std::uint64_t nodes;                        /*!< Number of nodes */
+  std::uint64_t edges;                        /*!< Number of edges */
+  struct section_t sections[SECTIONS_COUNT]; /*!< Sections */
+};
+
+/*!
+ \brief Location record
+ */
+struct location_t {
+  std::uint32_t pid;  /*!< Process identifier */
+  std::uint32_t name; /*!< Location name */
+};
+
+/*!
+ \brief System edge record
+ */
+struct system_edge_t {
+  std::uint32_t pid;   /*!< Process identifier */
+  std::uint32_t src;   /*!< Source location */
+  std::uint32_t tgt;   /*!< Target location */
+  std::uint32_t event; /*!< Event */
+};
+
+/*!
+ \class layout_t
+ \brief Layout and writer of binary certificates
+ \note Writes to an output stream sequentially, hence certificates can be
+ written to non-seekable streams. See tchecker::graph::binary::binary_output
+ */
+class layout_t {
+public:
+  /*!
+   \brief Constructor
+   \param name : graph name
+   \param system : a system of timed processes
+   \post this layout has the string table and the system tables of system,
+   and zones are DBMs over the clocks of system
+   \note this keeps a pointer to the layout of packed valuations of system (if
+   any): node records always store unpacked values
+   */
+  layout_t(std::string const & name, tchecker::ta::system_t const & system);
+
+  /*!
+   \brief Set zones to DBMs over system clocks
+   \param zone : a zone
+   */
+  void set_zone(tchecker::zg::zone_t const & zone);
+
+  /*!
+   \brief Set zones to DBMs over reference clocks
+   \param zone : a zone
+   \post zones are DBMs over the reference clocks of zone
+   */
+  void set_zone(tchecker::refzg::zone_t const & zone);
+
+  /*!
+   \brief Write the beginning of a certificate
+   \param os : output stream
+   \param nodes : number of nodes
+   \param edges : number of edges
+   \post the header, the string table and the system tables have been written
+   to os. The layout of the sections has been computed from nodes and edges
+   \throw std::invalid_argument : if nodes or edges cannot be numbered on 32 bits
+   */
+  void begin(std::ostream & os, std::uint64_t nodes, std::uint64_t edges);
+
+  /*!
+   \brief Start a section
+   \param os : output stream
+   \param id : section identifier
+   \pre sections before id have been written
+   \post padding has been written to os up to the beginning of section id
+   */
+  void begin_section(std::ostream & os, enum tchecker::graph::binary::section_id_t id);
+
+  /*!
+   \brief Write a node record
+   \param os : output stream
+   \param initial : initial flag
+   \param final : final flag
+   \param vloc : tuple of locations
+   \param intval : integer valuation
+   \param dbm : zone
+   \pre SECTION_NODES has been started, vloc, intval and dbm have the sizes of
+   this layout (intval is packed if the system has packed valuations)
+   \post the record of the node has been written to os
+   */
+  void write_node(std::ostream & os, bool initial, bool final, tchecker::vloc_t const & vloc,
+                  tchecker::intvars_valuation_t const & intval, tchecker::dbm::db_t const * dbm);
+
+  /*!
+   \brief Write a tuple of edges
+   \param os : output stream
+   \param vedge : tuple of edges
+   \pre SECTION_VEDGES has been started, vedge has size processes
+   \post vedge has been written to os
+   */
+  void write_vedge(std::ostream & os, tchecker::vedge_t const & vedge);
+
+  /*!
+   \brief Write a value
+   \tparam T : type of value
+   \param os : output stream
+   \param t : value
+   \post t has been written to os
+   */
+  template <class T> void write(std::ostream & os, T const & t)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be written");
+    os.write(reinterpret_cast<char const *>(&t), sizeof(T));
+    _position += sizeof(T);
+  }
+
+  /*!
+   \brief Finish a certificate
+   \param os : output stream
+   \pre all sections have been written
+   \post padding has been written to os up to the end of the certificate
+   \throw std::runtime_error : if os is in a failed state
+   */
+  void end(std::ostream & os);
+
+private:
+  /*!
+   \brief Add a string to the string table
+   \param s : a string
+   \return identifier of s in the string table
+   */
+  std::uint32_t add_string(std::string const & s);
+
+  /*!
+   \brief Write padding
+   \param os : output stream
+   \param position : a position
+   \pre position >= current position
+   \post zeros have been written to os up to position
+   */
+  void pad(std::ostream & os, std::uint64_t position);
+
+  tchecker::graph::binary::header_t _header;                         /*!< Header */
+  std::vector<std::uint64_t> _string_offsets;                         /*!< Offsets of strings */
+  std::string _strings;                                               /*!< String table */
+  std::vector<std::uint32_t> _processes;                              /*!< Process names */
+  std::vector<tchecker::graph::binary::location_t> _locations;        /*!< Locations */
+  std::vector<std::uint32_t> _location_labels_offsets;                /*!< Offsets of labels of locations */
+  std::vector<std::uint32_t> _location_labels;                        /*!< Labels of locations */
+  std::vector<std::uint32_t> _labels;                                 /*!< Label names */
+  std::vector<std::uint32_t> _events;                                 /*!< Event names */
+  std::vector<tchecker::graph::binary::system_edge_t> _system_edges; /*!< System edges */
+  std::vector<std::uint32_t> _intvars;                                /*!< Integer variable names */
+  std::vector<std::uint32_t> _clocks;                                 /*!< Names of zone dimensions */
+  std::unordered_map<std::string, std::uint32_t> _string_ids;         /*!< Identifiers of strings */
+  std::vector<char> _record;                                          /*!< Buffer for node records */
+  tchecker::intvars_layout_t const * _intvars_layout;                 /*!< Layout of packed valuations (if any) */
+  std::uint64_t _position;                                            /*!< Number of bytes written */
+};
+
+namespace details {
+
+/*!
+ \brief Detection of graphs with typed edges
+ */
+template <class GRAPH, class = void> struct has_edge_type_t : std::false_type {
+};
+
+template <class GRAPH>
+struct has_edge_type_t<GRAPH, std::void_t<decltype(std::declval<GRAPH const &>().edge_type(
+                                  std::declval<typename GRAPH::edge_sptr_t const &>()))>> : std::true_type {
+};
+
+} // end of namespace details
+
+/*!
+ \brief Output a graph as a binary certificate
+ \tparam GRAPH : type of graph, should provide types GRAPH::node_sptr_t,
+ GRAPH::edge_sptr_t, methods GRAPH::nodes(), GRAPH::outgoing_edges(n) and
+ GRAPH::edge_tgt(e). Nodes should have methods graph_id(), initial(), final()
+ and state() that returns a state of a zone graph (with or without reference
+ clocks), and edges should have a method vedge()
+ \param os : output stream
+ \param g : a graph
+ \param name : graph name
+ \param system : system of timed processes of the states in g
+ \post g has been output to os as a binary certificate. Nodes are numbered in
+ the order of g.nodes(). Edges have type EDGE_ACTUAL or EDGE_SUBSUMPTION if g
+ has a method edge_type(e) (see tchecker::graph::subsumption::graph_t), and
+ EDGE_UNTYPED otherwise
+ \return os after output
+ \throw std::invalid_argument : if g has too many nodes
+ \throw std::runtime_error : if writing to os fails
+ \note g is traversed once to number its nodes, and then once for each section
+ of edges. The memory used is one number per node
+ */
+template <class GRAPH>
+std::ostream & binary_output(std::ostream & os, GRAPH const & g, std::string const & name,
+                             tchecker::ta::system_t const & system)
+{
+  tchecker::graph::binary::layout_t layout{name, system};
+
+  // Number nodes in the order of g.nodes(), indexed by their identifier in g
+  std::vector<std::uint32_t> number;
+  std::uint64_t nodes = 0, edges = 0;
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    if (nodes == 0)
+      layout.set_zone(n->state().zone());
+    if (nodes == std::numeric_limits<std::uint32_t>::max())
+      throw std::invalid_argument("Too many nodes for a binary certificate");
+    if (n->graph_id() >= number.size())
+      number.resize(n->graph_id() + 1);
+    number[n->graph_id()] = static_cast<std::uint32_t>(nodes++);
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      (void)e;
+      ++edges;
+    }
+  }
+
+  layout.begin(os, nodes, edges);
+
+  layout.begin_section(os, tchecker::graph::binary::SECTION_NODES);
+  for (typename GRAPH::node_sptr_t const & n : g.nodes())
+    layout.write_node(os, n->initial(), n->final(), n->state().vloc(), n->state().intval(), n->state().zone().dbm());
+
+  layout.begin_section(os, tchecker::graph::binary::SECTION_OUTGOING_OFFSETS);
+  std::uint64_t offset = 0;
+  layout.write(os, offset);
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      (void)e;
+      ++offset;
+    }
+    layout.write(os, offset);
+  }
+
+  layout.begin_section(os, tchecker::graph::binary::SECTION_EDGE_TARGETS);
+  for (typename GRAPH::node_sptr_t const & n : g.nodes())
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n))
+      layout.write(os, number[g.edge_tgt(e)->graph_id()]);
+
+  layout.begin_section(os, tchecker::graph::binary::SECTION_VEDGES);
+  for (typename GRAPH::node_sptr_t const & n : g.nodes())
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n))
+      layout.write_vedge(os, e->vedge());
+
+  layout.begin_section(os, tchecker::graph::binary::SECTION_EDGE_TYPES);
+  for (typename GRAPH::node_sptr_t const & n : g.nodes())
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      std::uint8_t type = tchecker::graph::binary::EDGE_UNTYPED;
+      if constexpr (tchecker::graph::binary::details::has_edge_type_t<GRAPH>::value)
+        type = (g.edge_type(e) == tchecker::graph::subsumption::EDGE_ACTUAL ? tchecker::graph::binary::EDGE_ACTUAL
+                                                                             : tchecker::graph::binary::EDGE_SUBSUMPTION);
+      layout.write(os, type);
+    }
+
+  layout.end(os);
+  return os;
+}
+
+/*!
+ \class certificate_t
+ \brief Reader of binary certificates
+ \note The certificate file is memory-mapped: opening a certificate only reads
+ its header, and accessors read the records they need. Hence certificates with
+ many millions of nodes can be queried without being loaded into memory
+ */
+class certificate_t {
+public:
+  /*!
+   \brief Constructor
+   \param filename : name of a binary certificate file
+   \post filename has been mapped to memory
+   \throw std::runtime_error : if filename cannot be mapped, or if it is not a
+   valid binary certificate for this architecture
+   */
+  explicit certificate_t(std::string const & filename);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  certificate_t(tchecker::graph::binary::certificate_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  certificate_t(tchecker::graph::binary::certificate_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   \post the certificate file has been unmapped
+   */
+  ~certificate_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::binary::certificate_t & operator=(tchecker::graph::binary::certificate_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::binary::certificate_t & operator=(tchecker::graph::binary::certificate_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return header of this certificate
+   */
+  inline tchecker::graph::binary::header_t const & header() const { return *_header; }
+
+  /*!
+   \brief Accessor
+   \return graph name
+   */
+  inline std::string_view name() const { return string(_header->name); }
+
+  /*!
+   \brief Accessor
+   \return number of nodes
+   */
+  inline std::uint64_t nodes_count() const { return _header->nodes; }
+
+  /*!
+   \brief Accessor
+   \return number of edges
+   */
+  inline std::uint64_t edges_count() const { return _header->edges; }
+
+  /*!
+   \brief Accessor
+   \param id : string identifier
+   \return string with identifier id
+   \throw std::out_of_range : if id is not a string identifier
+   */
+  std::string_view string(std::uint64_t id) const;
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return true if n is an initial node, false otherwise
+   \throw std::out_of_range : if n is not a node
+   */
+  inline bool initial(std::uint64_t n) const { return (flags(n) & tchecker::graph::binary::NODE_INITIAL) != 0; }
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return true if n is a final node, false otherwise
+   \throw std::out_of_range : if n is not a node
+   */
+  inline bool final(std::uint64_t n) const { return (flags(n) & tchecker::graph::binary::NODE_FINAL) != 0; }
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return pointer to the tuple of locations of node n (header().processes
+   locations)
+   \throw std::out_of_range : if n is not a node
+   */
+  tchecker::loc_id_t const * vloc(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return pointer to the integer valuation of node n (header().intvars values)
+   \throw std::out_of_range : if n is not a node
+   */
+  tchecker::integer_t const * intval(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return pointer to the zone of node n (header().zone_dim * header().zone_dim
+   difference bounds)
+   \throw std::out_of_range : if n is not a node
+   */
+  tchecker::dbm::db_t const * zone(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return range [first, last) of the outgoing edges of node n
+   \throw std::out_of_range : if n is not a node
+   */
+  std::pair<std::uint64_t, std::uint64_t> outgoing_edges(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param e : edge number
+   \return target node of edge e
+   \throw std::out_of_range : if e is not an edge
+   */
+  std::uint32_t edge_tgt(std::uint64_t e) const;
+
+  /*!
+   \brief Accessor
+   \param e : edge number
+   \return pointer to the tuple of edges of e (header().processes edge
+   identifiers, tchecker::NO_EDGE for processes not involved in e)
+   \throw std::out_of_range : if e is not an edge
+   */
+  tchecker::edge_id_t const * vedge(std::uint64_t e) const;
+
+  /*!
+   \brief Accessor
+   \param e : edge number
+   \return type of edge e
+   \throw std::out_of_range : if e is not an edge
+   */
+  enum tchecker::graph::binary::edge_type_t edge_type(std::uint64_t e) const;
+
+  /*!
+   \brief Accessor to node attributes
+   \param n : node number
+   \param m : a map (key, value) of attributes
+   \post the attributes of node n have been added to m, with the same keys and
+   values as in certificates output in the graphviz DOT language
+   \throw std::out_of_range : if n is not a node
+   */
+  void attributes(std::uint64_t n, std::map<std::string, std::string> & m) const;
+
+  /*!
+   \brief Accessor to edge attributes
+   \param e : edge number
+   \param m : a map (key, value) of attributes
+   \post the attributes of edge e have been added to m, with the same keys and
+   values as in certificates output in the graphviz DOT language
+   \throw std::out_of_range : if e is not an edge
+   */
+  void edge_attributes(std::uint64_t e, std::map<std::string, std::string> & m) const;
+
+private:
+  /*!
+   \brief Accessor
+   \param id : section identifier
+   \return pointer to the section id in the mapped file
+   */
+  template <class T> inline T const * section(enum tchecker::graph::binary::section_id_t id) const
+  {
+    return reinterpret_cast<T const *>(_data + _header->sections[id].offset);
+  }
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return pointer to the record of node n
+   \throw std::out_of_range : if n is not a node
+   */
+  char const * record(std::uint64_t n) const;
+
+  /*!
+   \brief Accessor
+   \param n : node number
+   \return flags of node n
+   \throw std::out_of_range : if n is not a node
+   */
+  std::uint32_t flags(std::uint64_t n) const;
+
+  /*!
+   \brief Check the header and the sections
+   \throw std::runtime_error : if this is not a valid binary certificate
+   */
+  void check() const;
+
+  char const * _data;                                 /*!< Mapped file */
+  std::size_t _size;                                  /*!< Size of mapped file */
+  tchecker::graph::binary::header_t const * _header; /*!< Header */
+};
+
+} // end of namespace binary
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_GRAPH_BINARY_CERTIFICATE_HH
@@ -10,6 +10,7 @@
 
 #include "tchecker/utils/hashtable.hh"
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/utils/profiling.hh"
 
 /*!
  \file cover_graph.hh
@@ -132,6 +133,7 @@ public:
    */
   bool is_covered(NODE_SPTR const & n, NODE_SPTR & covering_node) const
   {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_COVERING);
     auto && range = _nodes.collision_range(n);
     for (NODE_SPTR const & node : range) {
       if ((n != node) && _node_le(n, node)) {
@@ -154,6 +156,7 @@ public:
    */
   template <class INSERTER> void covered_nodes(NODE_SPTR const & n, INSERTER & ins) const
   {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_COVERING);
     auto && range = _nodes.collision_range(n);
     for (NODE_SPTR const & node : range)
       if ((node != n) && _node_le(node, n))
@@ -0,0 +1,344 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_FROZEN_GRAPH_HH
+#define TCHECKER_FROZEN_GRAPH_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/graph/output.hh"
+
+/*!
+ \file frozen_graph.hh
+ \brief Frozen graphs: immutable compressed sparse row (CSR) view of explored graphs
+ */
+
+namespace tchecker {
+
+namespace graph {
+
+namespace frozen {
+
+/*!
+ \brief Type of node index in a frozen graph
+ */
+using node_index_t = tchecker::node_id_t;
+
+/*!
+ \brief Type of edge index in a frozen graph
+ */
+using edge_index_t = std::size_t;
+
+/*!
+ \class graph_t
+ \brief Frozen graph: immutable copy of the structure of a graph in compressed
+ sparse row (CSR) form
+ \tparam GRAPH : type of graph, should provide types GRAPH::node_sptr_t and
+ GRAPH::edge_sptr_t, a method nodes() that returns the range of nodes, a method
+ outgoing_edges(n) that returns the range of outgoing edges of node n, a method
+ edge_tgt(e) that returns the target node of edge e, and attributes(n, m) and
+ attributes(e, m) on nodes and edges. Nodes should have a method graph_id() that
+ returns their identifier in the graph. See tchecker::graph::reachability::graph_t
+ and tchecker::graph::subsumption::graph_t
+ \note Nodes are indexed from 0 in the order of g.nodes(), and the outgoing
+ edges of each node are stored contiguously, in the order of
+ g.outgoing_edges(n). Traversals only read arrays of indices, without following
+ edge lists or updating reference counters
+ \note The frozen graph keeps pointers to the nodes and edges of the graph it
+ has been built from. It is not updated when this graph is modified
+ */
+template <class GRAPH> class graph_t {
+public:
+  /*!
+   \brief Type of original graph
+   */
+  using graph_type_t = GRAPH;
+
+  /*!
+   \brief Type of pointer to node
+   */
+  using node_sptr_t = typename GRAPH::node_sptr_t;
+
+  /*!
+   \brief Type of pointer to edge
+   */
+  using edge_sptr_t = typename GRAPH::edge_sptr_t;
+
+  /*!
+   \brief Constructor
+   \param g : a graph
+   \post this is a frozen copy of the nodes and edges of g
+   \throw std::invalid_argument : if g has too many nodes
+   */
+  explicit graph_t(GRAPH const & g) : _g(g)
+  {
+    // Number nodes in the order of g.nodes(), indexed by their identifier in g
+    std::vector<node_index_t> index;
+    std::size_t edges_count = 0;
+    for (node_sptr_t const & n : g.nodes()) {
+      if (_nodes.size() == std::numeric_limits<node_index_t>::max())
+        throw std::invalid_argument("Too many nodes to freeze graph");
+      if (n->graph_id() >= index.size())
+        index.resize(n->graph_id() + 1);
+      index[n->graph_id()] = static_cast<node_index_t>(_nodes.size());
+      _nodes.push_back(n);
+      for (edge_sptr_t const & e : g.outgoing_edges(n)) {
+        (void)e;
+        ++edges_count;
+      }
+    }
+
+    _offsets.reserve(_nodes.size() + 1);
+    _edges.reserve(edges_count);
+    _targets.reserve(edges_count);
+    for (node_sptr_t const & n : _nodes) {
+      _offsets.push_back(_edges.size());
+      for (edge_sptr_t const & e : g.outgoing_edges(n)) {
+        _edges.push_back(e);
+        _targets.push_back(index[g.edge_tgt(e)->graph_id()]);
+      }
+    }
+    _offsets.push_back(_edges.size());
+  }
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  graph_t(tchecker::graph::frozen::graph_t<GRAPH> const &) = delete;
+
+  /*!
+   \brief Move constructor
+   */
+  graph_t(tchecker::graph::frozen::graph_t<GRAPH> &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~graph_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::graph::frozen::graph_t<GRAPH> & operator=(tchecker::graph::frozen::graph_t<GRAPH> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::graph::frozen::graph_t<GRAPH> & operator=(tchecker::graph::frozen::graph_t<GRAPH> &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return the graph this has been built from
+   */
+  inline GRAPH const & graph() const { return _g; }
+
+  /*!
+   \brief Accessor
+   \return number of nodes
+   */
+  inline std::size_t nodes_count() const { return _nodes.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of edges
+   */
+  inline std::size_t edges_count() const { return _edges.size(); }
+
+  /*!
+   \brief Accessor
+   \param n : node index
+   \pre n < nodes_count() (checked by assertion)
+   \return node with index n
+   */
+  inline node_sptr_t const & node(node_index_t n) const
+  {
+    assert(n < _nodes.size());
+    return _nodes[n];
+  }
+
+  /*!
+   \brief Accessor
+   \param e : edge index
+   \pre e < edges_count() (checked by assertion)
+   \return edge with index e
+   */
+  inline edge_sptr_t const & edge(edge_index_t e) const
+  {
+    assert(e < _edges.size());
+    return _edges[e];
+  }
+
+  /*!
+   \brief Accessor
+   \param n : node index
+   \pre n < nodes_count() (checked by assertion)
+   \return the pair (first, last) such that the outgoing edges of n are the
+   edges with index in [first, last)
+   */
+  inline std::pair<edge_index_t, edge_index_t> outgoing_edges(node_index_t n) const
+  {
+    assert(n < _nodes.size());
+    return std::make_pair(_offsets[n], _offsets[n + 1]);
+  }
+
+  /*!
+   \brief Accessor
+   \param e : edge index
+   \pre e < edges_count() (checked by assertion)
+   \return index of the source node of e
+   \note logarithmic-time complexity in the number of nodes
+   */
+  node_index_t edge_src(edge_index_t e) const
+  {
+    assert(e < _edges.size());
+    auto it = std::upper_bound(_offsets.begin(), _offsets.end(), e);
+    return static_cast<node_index_t>(it - _offsets.begin() - 1);
+  }
+
+  /*!
+   \brief Accessor
+   \param e : edge index
+   \pre e < edges_count() (checked by assertion)
+   \return index of the target node of e
+   */
+  inline node_index_t edge_tgt(edge_index_t e) const
+  {
+    assert(e < _edges.size());
+    return _targets[e];
+  }
+
+  /*!
+   \brief Accessor to node attributes
+   \param n : node index
+   \param m : a map (key, value) of attributes
+   \post attributes of node n in the original graph have been added to map m
+   */
+  inline void attributes(node_index_t n, std::map<std::string, std::string> & m) const { _g.attributes(node(n), m); }
+
+  /*!
+   \brief Accessor to edge attributes
+   \param e : edge index
+   \param m : a map (key, value) of attributes
+   \post attributes of edge e in the original graph have been added to map m
+   */
+  inline void edge_attributes(edge_index_t e, std::map<std::string, std::string> & m) const { _g.attributes(edge(e), m); }
+
+private:
+  GRAPH const & _g;                   /*!< Original graph */
+  std::vector<node_sptr_t> _nodes;    /*!< Nodes */
+  std::vector<edge_index_t> _offsets; /*!< Outgoing edges of node n are in [_offsets[n], _offsets[n+1]) */
+  std::vector<edge_sptr_t> _edges;    /*!< Edges, sorted by source node */
+  std::vector<node_index_t> _targets; /*!< Target node of each edge */
+};
+
+/*!
+ \brief Freeze a graph
+ \tparam GRAPH : type of graph (see tchecker::graph::frozen::graph_t)
+ \param g : a graph
+ \return a frozen copy of g
+ \pre g is fully explored
+ */
+template <class GRAPH> tchecker::graph::frozen::graph_t<GRAPH> freeze(GRAPH const & g)
+{
+  return tchecker::graph::frozen::graph_t<GRAPH>{g};
+}
+
+/*!
+ \brief Output a frozen graph in graphviz DOT language
+ \tparam GRAPH : type of graph
+ \tparam NODE_LE : total order on type GRAPH::node_sptr_t
+ \tparam EDGE_LE : total order on type GRAPH::edge_sptr_t
+ \param os : output stream
+ \param g : a frozen graph
+ \param name : graph name
+ \post the graph g has been output to os in the graphviz DOT language. The nodes
+ and edges are output following the order given by NODE_LE and EDGE_LE
+ \note The output is the same as tchecker::graph::dot_output on the original
+ graph, but nodes and edges are sorted as arrays of indices instead of ordered
+ trees of pointers
+ */
+template <class GRAPH, class NODE_LE, class EDGE_LE>
+std::ostream & dot_output(std::ostream & os, tchecker::graph::frozen::graph_t<GRAPH> const & g, std::string const & name)
+{
+  NODE_LE node_le;
+  EDGE_LE edge_le;
+
+  // Sort nodes THEN give them an ID. Equivalent nodes w.r.t. NODE_LE share the
+  // same ID, and only the first one is output
+  std::vector<node_index_t> sorted(g.nodes_count());
+  for (node_index_t n = 0; n < sorted.size(); ++n)
+    sorted[n] = n;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [&](node_index_t n1, node_index_t n2) { return node_le(g.node(n1), g.node(n2)); });
+
+  std::vector<node_index_t> id(g.nodes_count());
+  std::vector<node_index_t> representatives;
+  for (std::size_t i = 0; i < sorted.size(); ++i) {
+    if (i == 0 || node_le(g.node(sorted[i - 1]), g.node(sorted[i])))
+      representatives.push_back(sorted[i]);
+    id[sorted[i]] = static_cast<node_index_t>(representatives.size() - 1);
+  }
+
+  // Sort edges as triples (src, tgt, edge)
+  using extended_edge_t = std::tuple<node_index_t, node_index_t, edge_index_t>;
+  std::vector<extended_edge_t> edges;
+  edges.reserve(g.edges_count());
+  for (node_index_t n = 0; n < g.nodes_count(); ++n) {
+    auto && [first, last] = g.outgoing_edges(n);
+    for (edge_index_t e = first; e < last; ++e)
+      edges.emplace_back(id[n], id[g.edge_tgt(e)], e);
+  }
+  std::stable_sort(edges.begin(), edges.end(), [&](extended_edge_t const & e1, extended_edge_t const & e2) {
+    auto && [src1, tgt1, edge1] = e1;
+    auto && [src2, tgt2, edge2] = e2;
+    if (src1 != src2)
+      return src1 < src2;
+    if (tgt1 != tgt2)
+      return tgt1 < tgt2;
+    return edge_le(g.edge(edge1), g.edge(edge2));
+  });
+
+  // output graph
+  std::map<std::string, std::string> attr;
+
+  tchecker::graph::dot_output_header(os, name);
+
+  for (std::size_t i = 0; i < representatives.size(); ++i) {
+    attr.clear();
+    g.attributes(representatives[i], attr);
+    tchecker::graph::dot_output_node(os, std::to_string(i), attr);
+  }
+
+  for (auto && [src, tgt, edge] : edges) {
+    attr.clear();
+    g.edge_attributes(edge, attr);
+    tchecker::graph::dot_output_edge(os, std::to_string(src), std::to_string(tgt), attr);
+  }
+
+  tchecker::graph::dot_output_footer(os);
+
+  return os;
+}
+
+} // end of namespace frozen
+
+} // end of namespace graph
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_FROZEN_GRAPH_HH
@@ -8,6 +8,7 @@
 #ifndef TCHECKER_GRAPH_NODE_HH
 #define TCHECKER_GRAPH_NODE_HH
 
+#include <iostream>
 #include <map>
 #include <string>
 
@@ -88,6 +89,25 @@ int lexical_cmp(tchecker::graph::node_flags_t const & n1, tchecker::graph::node_
 */
 void attributes(tchecker::graph::node_flags_t const & n, std::map<std::string, std::string> & m);
 
+/*!
+ \brief Serialization
+ \param os : output stream
+ \param n : node flags
+ \post the initial/final flags of n have been written to os (binary format)
+ \return os after output
+ */
+std::ostream & serialize(std::ostream & os, tchecker::graph::node_flags_t const & n);
+
+/*!
+ \brief Deserialization
+ \param is : input stream
+ \param n : node flags
+ \post the initial/final flags of n have been read from is (see serialize)
+ \return is after input
+ \throw std::runtime_error : if is does not contain serialized node flags
+ */
+std::istream & deserialize(std::istream & is, tchecker::graph::node_flags_t & n);
+
 /*!
  \struct node_zg_state_t
  \brief Graph node that points to a state of a zone graph
@@ -156,6 +156,47 @@ std::ostream & dot_output(std::ostream & os, GRAPH const & g, std::string const
   return os;
 }
 
+/*!
+ \brief Output a graph in graphviz DOT language, without sorting
+ \tparam GRAPH : type of graph, should provide types GRAPH::node_sptr_t,
+ GRAPH::edge_sptr_t, method GRAPH::nodes() that returns the range of nodes,
+ and a method GRAPH::outgoing_edges(n) that returns the range of outgoing edges
+ of node n. Nodes should have a method graph_id() that returns their identifier
+ \param os : output stream
+ \param g : a graph
+ \param name : graph name
+ \post the graph g has been output to os in the graphviz DOT language. Each node
+ is named by its identifier (i.e. in exploration order), and is followed by its
+ outgoing edges. Nodes are output in the order of g.nodes()
+ \note Nodes and edges are written as they are visited: contrary to
+ tchecker::graph::dot_output, no sorted copy of the graph is built, hence the
+ output uses constant extra memory. The output is not deterministic across
+ runs with different table sizes or search orders
+ */
+template <class GRAPH> std::ostream & dot_output_unsorted(std::ostream & os, GRAPH const & g, std::string const & name)
+{
+  std::map<std::string, std::string> attr;
+
+  tchecker::graph::dot_output_header(os, name);
+
+  for (typename GRAPH::node_sptr_t const & n : g.nodes()) {
+    std::string const src = std::to_string(n->graph_id());
+    attr.clear();
+    g.attributes(n, attr);
+    tchecker::graph::dot_output_node(os, src, attr);
+
+    for (typename GRAPH::edge_sptr_t const & e : g.outgoing_edges(n)) {
+      attr.clear();
+      g.attributes(e, attr);
+      tchecker::graph::dot_output_edge(os, src, std::to_string(g.edge_tgt(e)->graph_id()), attr);
+    }
+  }
+
+  tchecker::graph::dot_output_footer(os);
+
+  return os;
+}
+
 } // end of namespace graph
 
 } // end of namespace tchecker
@@ -17,9 +17,11 @@
 #include <set>
 #include <string>
 
+#include "tchecker/basictypes.hh"
 #include "tchecker/graph/allocators.hh"
 #include "tchecker/graph/directed_graph.hh"
 #include "tchecker/graph/find_graph.hh"
+#include "tchecker/graph/frozen_graph.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/graph/store_graph.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -34,6 +36,8 @@ namespace reachability {
 // Forward declarations
 template <class NODE, class EDGE> class node_t;
 template <class NODE, class EDGE> class edge_t;
+template <class NODE, class EDGE, class NODE_HASH, class NODE_EQUAL> class graph_t;
+template <class NODE, class EDGE> class multigraph_t;
 
 /*!
  \brief Type of shared node
@@ -94,6 +98,19 @@ class node_t : public NODE,
                public tchecker::graph::directed::node_t<tchecker::graph::reachability::edge_sptr_t<NODE, EDGE>> {
 public:
   using NODE::NODE;
+
+  /*!
+   \brief Accessor
+   \return identifier of this node, nodes are numbered in the order they have
+   been added to their graph
+   */
+  inline tchecker::node_id_t graph_id() const { return _graph_id; }
+
+private:
+  template <class N, class E, class NODE_HASH, class NODE_EQUAL> friend class tchecker::graph::reachability::graph_t;
+  template <class N, class E> friend class tchecker::graph::reachability::multigraph_t;
+
+  tchecker::node_id_t _graph_id{0}; /*!< Identifier in graph */
 };
 
 /*!
@@ -216,7 +233,8 @@ public:
   */
   graph_t(std::size_t block_size, std::size_t table_size, NODE_HASH const & node_hash, NODE_EQUAL const & node_equal_to)
       : _node_sptr_hash(node_hash), _node_sptr_equal_to(node_equal_to),
-        _find_graph(table_size, _node_sptr_hash, _node_sptr_equal_to), _node_pool(block_size), _edge_pool(block_size)
+        _find_graph(table_size, _node_sptr_hash, _node_sptr_equal_to), _node_pool(block_size), _edge_pool(block_size),
+        _nodes_added(0)
   {
   }
 
@@ -257,6 +275,29 @@ public:
     _find_graph.clear();
     _node_pool.destruct_all();
     _edge_pool.destruct_all();
+    _nodes_added = 0;
+  }
+
+  /*!
+  \brief Clear the edges
+  \post the graph has no edge, and the memory used by edges has been released
+  \note the nodes of the graph are kept
+  */
+  void clear_edges()
+  {
+    _directed_graph.clear(_find_graph.begin(), _find_graph.end());
+    _edge_pool.destruct_all();
+  }
+
+  /*!
+  \brief Collect unused nodes and edges
+  \post the memory of nodes and edges that are not referenced anymore can be
+  reused by subsequent allocations
+  */
+  void collect()
+  {
+    _node_pool.collect();
+    _edge_pool.collect();
   }
 
   /*!
@@ -274,6 +315,7 @@ public:
     auto && [found, n] = _find_graph.find(node);
     if (found)
       return std::make_tuple(false, n);
+    node->_graph_id = _nodes_added++;
     _find_graph.add_node(node);
     return std::make_tuple(true, node);
   }
@@ -450,6 +492,7 @@ private:
   tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph;                    /*!< Edge store */
   tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;                                /*!< Node pool allocator */
   tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;                                /*!< Edge pool allocator */
+  tchecker::node_id_t _nodes_added;                                                                /*!< Number of added nodes */
 };
 
 /*!
@@ -507,7 +550,7 @@ public:
   \brief Constructor
   \param block_size : number of objects allocated in a block
   */
-  multigraph_t(std::size_t block_size) : _store_graph(), _node_pool(block_size), _edge_pool(block_size) {}
+  multigraph_t(std::size_t block_size) : _store_graph(), _node_pool(block_size), _edge_pool(block_size), _nodes_added(0) {}
 
   /*!
   \brief Copy constructor (deleted)
@@ -547,6 +590,7 @@ public:
     _store_graph.clear();
     _node_pool.destruct_all();
     _edge_pool.destruct_all();
+    _nodes_added = 0;
   }
 
   /*!
@@ -558,6 +602,7 @@ public:
   template <class... ARGS> node_sptr_t add_node(ARGS &&... args)
   {
     node_sptr_t node = _node_pool.construct(args...);
+    node->_graph_id = _nodes_added++;
     _store_graph.add_node(node);
     return node;
   }
@@ -681,6 +726,7 @@ private:
   tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph; /*!< Edge store */
   tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;             /*!< Node pool allocator */
   tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;             /*!< Edge pool allocator */
+  tchecker::node_id_t _nodes_added;                                             /*!< Number of added nodes */
 };
 
 /* output */
@@ -696,11 +742,27 @@ private:
  \param name : graph name
  \post the graph g has been output to os in the graphviz DOT language. The nodes
  and edges are output following the order given by NODE_LE and EDGE_LE
+ \note g is frozen before output (see tchecker::graph::frozen::dot_output)
  */
 template <class GRAPH, class NODE_LE, class EDGE_LE>
 std::ostream & dot_output(std::ostream & os, GRAPH const & g, std::string const & name)
 {
-  return tchecker::graph::dot_output<GRAPH, NODE_LE, EDGE_LE>(os, g, name);
+  return tchecker::graph::frozen::dot_output<GRAPH, NODE_LE, EDGE_LE>(os, tchecker::graph::frozen::freeze(g), name);
+}
+
+/*!
+ \brief Output a graph in graphviz DOT language, without sorting
+ \tparam GRAPH : type of graph, should inherit from
+ tchecker::graph::reachability::graph_t or from tchecker::graph::reachability::multigraph_t
+ \param os : output stream
+ \param g : a graph
+ \param name : graph name
+ \post the graph g has been output to os in the graphviz DOT language, with
+ nodes named by their identifiers (see tchecker::graph::dot_output_unsorted)
+ */
+template <class GRAPH> std::ostream & dot_output_unsorted(std::ostream & os, GRAPH const & g, std::string const & name)
+{
+  return tchecker::graph::dot_output_unsorted<GRAPH>(os, g, name);
 }
 
 } // end of namespace reachability
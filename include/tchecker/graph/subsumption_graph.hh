@@ -17,9 +17,11 @@
 #include <set>
 #include <string>
 
+#include "tchecker/basictypes.hh"
 #include "tchecker/graph/allocators.hh"
 #include "tchecker/graph/cover_graph.hh"
 #include "tchecker/graph/directed_graph.hh"
+#include "tchecker/graph/frozen_graph.hh"
 #include "tchecker/graph/output.hh"
 #include "tchecker/utils/allocation_size.hh"
 #include "tchecker/utils/iterator.hh"
@@ -95,6 +97,18 @@ class node_t : public NODE,
                public tchecker::graph::directed::node_t<tchecker::graph::subsumption::edge_sptr_t<NODE, EDGE>> {
 public:
   using NODE::NODE;
+
+  /*!
+   \brief Accessor
+   \return identifier of this node, nodes are numbered in the order they have
+   been added to their graph
+   */
+  inline tchecker::node_id_t graph_id() const { return _graph_id; }
+
+private:
+  template <class N, class E, class NODE_HASH, class NODE_LE> friend class tchecker::graph::subsumption::graph_t;
+
+  tchecker::node_id_t _graph_id{0}; /*!< Identifier in graph */
 };
 
 /*!
@@ -258,7 +272,7 @@ public:
   */
   graph_t(std::size_t block_size, std::size_t table_size, NODE_HASH const & node_hash, NODE_LE const & node_le)
       : _node_sptr_hash(node_hash), _node_sptr_le(node_le), _cover_graph(table_size, _node_sptr_hash, _node_sptr_le),
-        _node_pool(block_size), _edge_pool(block_size)
+        _node_pool(block_size), _edge_pool(block_size), _nodes_added(0)
   {
   }
 
@@ -299,6 +313,29 @@ public:
     _cover_graph.clear();
     _node_pool.destruct_all();
     _edge_pool.destruct_all();
+    _nodes_added = 0;
+  }
+
+  /*!
+  \brief Clear the edges
+  \post the graph has no edge, and the memory used by edges has been released
+  \note the nodes of the graph are kept
+  */
+  void clear_edges()
+  {
+    _directed_graph.clear(_cover_graph.begin(), _cover_graph.end());
+    _edge_pool.destruct_all();
+  }
+
+  /*!
+  \brief Collect unused nodes and edges
+  \post the memory of nodes and edges that are not referenced anymore can be
+  reused by subsequent allocations
+  */
+  void collect()
+  {
+    _node_pool.collect();
+    _edge_pool.collect();
   }
 
   /*!
@@ -309,6 +346,7 @@ public:
   template <class... ARGS> node_sptr_t add_node(ARGS &&... args)
   {
     node_sptr_t node = _node_pool.construct(args...);
+    node->_graph_id = _nodes_added++;
     _cover_graph.add_node(node);
     return node;
   }
@@ -583,6 +621,7 @@ private:
   tchecker::graph::directed::graph_t<node_sptr_t, edge_sptr_t> _directed_graph;                /*!< Edge store */
   tchecker::graph::node_pool_allocator_t<shared_node_t> _node_pool;                            /*!< Node pool allocator */
   tchecker::graph::edge_pool_allocator_t<shared_edge_t> _edge_pool;                            /*!< Edge pool allocator */
+  tchecker::node_id_t _nodes_added;                                                            /*!< Number of added nodes */
 };
 
 /* output */
@@ -598,11 +637,27 @@ private:
  \param name : graph name
  \post the graph g has been output to os in the graphviz DOT language. The nodes
  and edges are output following the order given by NODE_LE and EDGE_LE
+ \note g is frozen before output (see tchecker::graph::frozen::dot_output)
  */
 template <class GRAPH, class NODE_LE, class EDGE_LE>
 std::ostream & dot_output(std::ostream & os, GRAPH const & g, std::string const & name)
 {
-  return tchecker::graph::dot_output<GRAPH, NODE_LE, EDGE_LE>(os, g, name);
+  return tchecker::graph::frozen::dot_output<GRAPH, NODE_LE, EDGE_LE>(os, tchecker::graph::frozen::freeze(g), name);
+}
+
+/*!
+ \brief Output a graph in graphviz DOT language, without sorting
+ \tparam GRAPH : type of graph, should inherit from
+ tchecker::graph::subsumption::graph_t
+ \param os : output stream
+ \param g : a graph
+ \param name : graph name
+ \post the graph g has been output to os in the graphviz DOT language, with
+ nodes named by their identifiers (see tchecker::graph::dot_output_unsorted)
+ */
+template <class GRAPH> std::ostream & dot_output_unsorted(std::ostream & os, GRAPH const & g, std::string const & name)
+{
+  return tchecker::graph::dot_output_unsorted<GRAPH>(os, g, name);
 }
 
 } // end of namespace subsumption
@@ -0,0 +1,125 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_REFZG_POR_HH
+#define TCHECKER_REFZG_POR_HH
+
+#include <set>
+#include <tuple>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file por.hh
+ \brief Partial-order reduction for zone graphs with reference clocks
+ */
+
+namespace tchecker {
+
+namespace refzg {
+
+/*!
+ \class por_t
+ \brief Static independence of edges and ample locations for partial-order
+ reduction of zone graphs with one reference clock per process (local-time
+ semantics)
+ \note A location l of process p is ample if, from any state where p is in l,
+ the set of outgoing edges of l can be explored alone: (1) l and the targets of
+ its outgoing edges are neither committed nor urgent, (2) the outgoing edges of
+ l are asynchronous and independent from the edges of every other process, (3)
+ they do not change the set of searched labels, (4) l does not belong to a
+ cycle of ample locations of p. Furthermore, some outgoing edge of l shall be
+ uniformly enabled (i.e. its enabledness does not depend on clocks and its
+ target invariant is satisfied by its resets), which is checked on each state
+ by tchecker::refzg::refzg_impl_t. Under local-time semantics, independent edges
+ commute and lead to the same state, hence the reduction preserves
+ reachability of the searched labels
+ */
+class por_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param labels : searched labels
+   \note this does not keep a reference on system
+   */
+  por_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Check independence of edges
+   \param e1 : edge identifier
+   \param e2 : edge identifier
+   \return true if e1 and e2 belong to distinct processes, do not synchronize
+   together, and have no read/write nor write/write conflict on variables, false
+   otherwise
+   */
+  bool independent(tchecker::edge_id_t e1, tchecker::edge_id_t e2) const;
+
+  /*!
+   \brief Accessor
+   \param loc : location identifier
+   \return true if loc is an ample location, false otherwise
+   */
+  inline bool ample(tchecker::loc_id_t loc) const { return _ample[loc]; }
+
+  /*!
+   \brief Accessor
+   \param edge : edge identifier
+   \return true if edge is enabled from every state where its guard on bounded
+   integer variables is satisfied, false otherwise
+   */
+  inline bool uniformly_enabled(tchecker::edge_id_t edge) const { return _uniformly_enabled[edge]; }
+
+  /*!
+   \brief Increment the number of reduced states
+   */
+  inline void reduced() { ++_reduced_states; }
+
+  /*!
+   \brief Accessor
+   \return number of states whose successors have been restricted to an ample set
+   */
+  inline unsigned long reduced_states() const { return _reduced_states; }
+
+private:
+  /*!
+   \brief Check conflicts between variable accesses
+   \param r1 : read variables
+   \param w1 : written variables
+   \param r2 : read variables
+   \param w2 : written variables
+   \return true if w1 intersects r2 or w2, or if r1 intersects w2, false otherwise
+   */
+  static bool conflict(boost::dynamic_bitset<> const & r1, boost::dynamic_bitset<> const & w1,
+                       boost::dynamic_bitset<> const & r2, boost::dynamic_bitset<> const & w2);
+
+  /*!
+   \brief Type of pairs of synchronized (process identifier, event identifier)
+   */
+  using coupling_t = std::tuple<tchecker::process_id_t, tchecker::event_id_t, tchecker::process_id_t, tchecker::event_id_t>;
+
+  std::vector<tchecker::process_id_t> _edge_pid;            /*!< Map : edge id -> process id */
+  std::vector<tchecker::event_id_t> _edge_event;            /*!< Map : edge id -> event id */
+  std::vector<boost::dynamic_bitset<>> _read_clocks;        /*!< Map : edge id -> read clocks */
+  std::vector<boost::dynamic_bitset<>> _written_clocks;     /*!< Map : edge id -> written clocks */
+  std::vector<boost::dynamic_bitset<>> _read_intvars;       /*!< Map : edge id -> read bounded integer variables */
+  std::vector<boost::dynamic_bitset<>> _written_intvars;    /*!< Map : edge id -> written bounded integer variables */
+  std::set<tchecker::refzg::por_t::coupling_t> _couplings;  /*!< Synchronized (pid, event) pairs */
+  boost::dynamic_bitset<> _ample;                           /*!< Ample locations */
+  boost::dynamic_bitset<> _uniformly_enabled;               /*!< Uniformly enabled edges */
+  unsigned long _reduced_states;                            /*!< Number of reduced states */
+};
+
+} // end of namespace refzg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_REFZG_POR_HH
@@ -9,11 +9,13 @@
 #define TCHECKER_REFZG_HH
 
 #include <cstdlib>
+#include <iostream>
 #include <memory>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/refzg/allocators.hh"
+#include "tchecker/refzg/por.hh"
 #include "tchecker/refzg/semantics.hh"
 #include "tchecker/refzg/state.hh"
 #include "tchecker/refzg/transition.hh"
@@ -224,7 +226,29 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::refzg::semantics_t & semantics,
-                              tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & edges);
+                              tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & edges,
+                              bool & intvars_reset);
+
+/*!
+ \brief Compute next state
+ \note same as tchecker::refzg::next above, without reporting the reset of dead
+ variables
+ */
+inline tchecker::state_status_t next(tchecker::ta::system_t const & system,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> const & intval,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::refzg::shared_zone_t> const & zone,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
+                                     tchecker::clock_constraint_container_t & src_invariant,
+                                     tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
+                                     tchecker::clock_constraint_container_t & tgt_invariant,
+                                     tchecker::refzg::semantics_t & semantics, tchecker::integer_t spread,
+                                     tchecker::refzg::outgoing_edges_value_t const & edges)
+{
+  bool intvars_reset = false;
+  return tchecker::refzg::next(system, vloc, intval, zone, vedge, src_invariant, guard, reset, tgt_invariant, semantics, spread,
+                               edges, intvars_reset);
+}
 
 /*!
  \brief Compute next state and transition
@@ -234,6 +258,7 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
  \param semantics : a zone semantics
  \param spread : spread bound over reference clocks
  \param v : outgoing edge value
+ \param intvars_reset : set to true if some dead variable has been reset
  \post s have been updated from v according to semantics and spread, and t is
  the set of edges in v
  \return status of state s after update (see tchecker::refzg::next)
@@ -242,10 +267,34 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 */
 inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::refzg::state_t & s,
                                      tchecker::refzg::transition_t & t, tchecker::refzg::semantics_t & semantics,
-                                     tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & v)
+                                     tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & v,
+                                     bool & intvars_reset)
 {
   return tchecker::refzg::next(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                               t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, spread, v);
+                               t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, spread, v,
+                               intvars_reset);
+}
+
+/*!
+ \brief Compute next state and transition
+ \param system : a system
+ \param s : state
+ \param t : transition
+ \param semantics : a zone semantics
+ \param spread : spread bound over reference clocks
+ \param v : outgoing edge value
+ \post s have been updated from v according to semantics and spread, and t is
+ the set of edges in v
+ \return status of state s after update (see tchecker::refzg::next)
+ \throw std::invalid_argument : if s and v have incompatible size
+ \note set spread to tchecker::refdbm::UNBOUNDED_SPREAD for unbounded spread
+*/
+inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::refzg::state_t & s,
+                                     tchecker::refzg::transition_t & t, tchecker::refzg::semantics_t & semantics,
+                                     tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & v)
+{
+  bool intvars_reset = false;
+  return tchecker::refzg::next(system, s, t, semantics, spread, v, intvars_reset);
 }
 
 /*!
@@ -256,6 +305,16 @@ inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tche
   */
 boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::refzg::state_t const & s);
 
+/*!
+ \brief Checks if a state satisfies a set of labels
+ \param system : a system
+ \param s : a state
+ \param labels : a set of labels
+ \return true if labels is a subset of the labels on state s, false otherwise
+ */
+bool satisfies(tchecker::ta::system_t const & system, tchecker::refzg::state_t const & s,
+               boost::dynamic_bitset<> const & labels);
+
 /*!
  \brief Checks is a state is a valid final state
  \param system : a system
@@ -302,6 +361,7 @@ public:
                                             tchecker::refzg::initial_range_t, tchecker::refzg::outgoing_edges_range_t,
                                             tchecker::refzg::initial_value_t, tchecker::refzg::outgoing_edges_value_t>;
   using sst_t = ts_impl_t::sst_t;
+  using sst_callback_t = ts_impl_t::sst_callback_t;
   using state_t = ts_impl_t::state_t;
   using const_state_t = ts_impl_t::const_state_t;
   using transition_t = ts_impl_t::transition_t;
@@ -319,6 +379,8 @@ public:
    \param spread : spread bound over reference clocks
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash tables
+   \param por : partial-order reduction (nullptr for no reduction)
+   \pre if por is not nullptr, then r has one reference clock per process
    \note all states and transitions are pool allocated and deallocated
    automatically
    \note set spread to tchecker::refdbm::UNBOUNDED_SPREAD for unbounded spread
@@ -326,7 +388,8 @@ public:
   refzg_impl_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
                std::shared_ptr<tchecker::reference_clock_variables_t const> const & r,
                std::shared_ptr<tchecker::refzg::semantics_t> const & semantics, tchecker::integer_t spread,
-               std::size_t block_size, std::size_t table_size = 65536);
+               std::size_t block_size, std::size_t table_size = 65536,
+               std::shared_ptr<tchecker::refzg::por_t> const & por = nullptr);
 
   /*!
    \brief Copy constructor (deleted)
@@ -392,8 +455,36 @@ public:
   virtual void next(tchecker::refzg::const_state_sptr_t const & s, tchecker::refzg::outgoing_edges_value_t const & out_edge,
                     std::vector<sst_t> & v);
 
+  /*!
+   \brief Next states and transitions with selected status
+   \param s : state
+   \param v : container
+   \param mask : mask on next states
+   \post all tuples (status, s', t) such that s -t-> s' is a transition and the
+   status of s' matches mask (i.e. status & mask != 0) have been pushed to v.
+   If partial-order reduction is enabled and the location of some process in s
+   is ample, only the transitions of the first such process with a uniformly
+   enabled edge that yields a state with status tchecker::STATE_OK are pushed
+   to v (see tchecker::refzg::por_t)
+   */
+  virtual void next(tchecker::refzg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask);
+
   using ts_impl_t::next;
 
+  /*!
+   \brief Visit next states and transitions with selected status
+   \param s : state
+   \param mask : mask on next states
+   \param callback : callback on next states and transitions
+   \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+   is a transition and the status of s' matches mask (i.e. status & mask != 0)
+   \note each successor is handed to callback as soon as it has been computed.
+   If partial-order reduction is enabled, successors are computed as in method
+   `next` above, then handed to callback
+   */
+  virtual void for_each_next(tchecker::refzg::const_state_sptr_t const & s, tchecker::state_status_t mask,
+                             sst_callback_t const & callback);
+
   /*!
    \brief Computes the set of labels of a state
    \param s : a state
@@ -401,6 +492,14 @@ public:
    */
   virtual boost::dynamic_bitset<> labels(tchecker::refzg::const_state_sptr_t const & s) const;
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   */
+  virtual bool satisfies(tchecker::refzg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const;
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -441,6 +540,34 @@ public:
   */
   virtual void share(tchecker::refzg::transition_sptr_t & t);
 
+  /*!
+   \brief Collect unused states and transitions
+   \post the memory of states and transitions that are not referenced anymore
+   (and of their components) can be reused by subsequent allocations
+  */
+  virtual void collect();
+
+  /*!
+   \brief Read a state
+   \param is : input stream
+   \return a state read from is (see tchecker::refzg::serialize)
+   \throw std::runtime_error : if is does not contain a serialized state of
+   this zone graph
+   \note the components of the returned state are not shared
+   */
+  tchecker::refzg::state_sptr_t deserialize_state(std::istream & is);
+
+  /*!
+   \brief Read a transition
+   \param is : input stream
+   \return a transition with the tuple of edges read from is (see
+   tchecker::serialize on tchecker::vedge_t), and empty constraints
+   \throw std::runtime_error : if is does not contain a serialized tuple of edges
+   of this zone graph
+   \note the components of the returned transition are not shared
+   */
+  tchecker::refzg::transition_sptr_t deserialize_transition(std::istream & is);
+
   /*!
    \brief Accessor
    \return Shared pointer to underlying system of timed processes
@@ -459,11 +586,39 @@ public:
   */
   tchecker::integer_t spread() const;
 
+  /*!
+   \brief Accessor
+   \return Partial-order reduction (nullptr if no reduction)
+  */
+  std::shared_ptr<tchecker::refzg::por_t const> por() const;
+
+  /*!
+   \brief Accessor
+   \return Number of successors computed so far where some dead bounded
+   integer variable has been reset (see tchecker::ta::next), including
+   successors that have a non-OK status due to clocks
+  */
+  unsigned long intvars_reset_successors() const;
+
 private:
+  /*!
+   \brief Next states and transitions from an ample set
+   \param s : state
+   \param v : container
+   \param mask : mask on next states
+   \post if some ample set has been found in s, the tuples (status, s', t) such
+   that s -t-> s' is a transition in the ample set and the status of s' matches
+   mask have been pushed to v
+   \return true if some ample set has been found in s, false otherwise
+   */
+  bool ample_next(tchecker::refzg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask);
+
   std::shared_ptr<tchecker::ta::system_t const> _system;              /*!< System of timed processes */
   std::shared_ptr<tchecker::reference_clock_variables_t const> _r;    /*!< Reference clock variables */
   std::shared_ptr<tchecker::refzg::semantics_t> _semantics;           /*!< Zone semantics */
   tchecker::integer_t _spread;                                        /*!< Spread bound over reference clocks */
+  std::shared_ptr<tchecker::refzg::por_t> _por;                       /*!< Partial-order reduction */
+  unsigned long _intvars_reset_successors;                            /*!< Number of successors with dead variables reset */
   tchecker::refzg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
   tchecker::refzg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
 };
@@ -500,6 +655,38 @@ public:
    \return Spread
   */
   tchecker::integer_t spread() const;
+
+  /*!
+   \brief Accessor
+   \return Partial-order reduction (nullptr if no reduction)
+  */
+  std::shared_ptr<tchecker::refzg::por_t const> por() const;
+
+  /*!
+   \brief Accessor
+   \return Number of successors computed so far where some dead bounded
+   integer variable has been reset (see tchecker::ta::next), including
+   successors that have a non-OK status due to clocks
+  */
+  unsigned long intvars_reset_successors() const;
+
+  /*!
+   \brief Read a state
+   \param is : input stream
+   \return a state read from is (see tchecker::refzg::serialize)
+   \throw std::runtime_error : if is does not contain a serialized state of
+   this zone graph
+   */
+  tchecker::refzg::state_sptr_t deserialize_state(std::istream & is);
+
+  /*!
+   \brief Read a transition
+   \param is : input stream
+   \return a transition with the tuple of edges read from is
+   \throw std::runtime_error : if is does not contain a serialized tuple of edges
+   of this zone graph
+   */
+  tchecker::refzg::transition_sptr_t deserialize_transition(std::istream & is);
 };
 
 /*!
@@ -534,6 +721,40 @@ public:
    \return Spread
   */
   tchecker::integer_t spread() const;
+
+  /*!
+   \brief Accessor
+   \return Partial-order reduction (nullptr if no reduction)
+  */
+  std::shared_ptr<tchecker::refzg::por_t const> por() const;
+
+  /*!
+   \brief Accessor
+   \return Number of successors computed so far where some dead bounded
+   integer variable has been reset (see tchecker::ta::next), including
+   successors that have a non-OK status due to clocks
+  */
+  unsigned long intvars_reset_successors() const;
+
+  /*!
+   \brief Read a state
+   \param is : input stream
+   \return a state read from is (see tchecker::refzg::serialize)
+   \throw std::runtime_error : if is does not contain a serialized state of
+   this zone graph
+   \note the components of the returned state are shared
+   */
+  tchecker::refzg::state_sptr_t deserialize_state(std::istream & is);
+
+  /*!
+   \brief Read a transition
+   \param is : input stream
+   \return a transition with the tuple of edges read from is
+   \throw std::runtime_error : if is does not contain a serialized tuple of edges
+   of this zone graph
+   \note the components of the returned transition are shared
+   */
+  tchecker::refzg::transition_sptr_t deserialize_transition(std::istream & is);
 };
 
 /*!
@@ -597,15 +818,18 @@ enum reference_clock_variables_type_t {
  \param spread : spread bound over reference clocks
  \param block_size : number of objects allocated in a block
  \param table_size : size of hash tables
+ \param por : partial-order reduction (nullptr for no reduction)
  \return a zone graph over system with zone semantics and spread bound
  defined from semantics_type and spread, reference clocks defined from
  refclocks_type, and allocation of block_size objects at a time
+ \pre if por is not nullptr, then refclocks_type is PROCESS_REFERENCE_CLOCKS
  \note set spread to tchecker::refdbm::UNBOUNDED_SPREAD for unbounded spread
  */
 tchecker::refzg::refzg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                                    enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                                    enum tchecker::refzg::semantics_type_t semantics_type, tchecker::integer_t spread,
-                                   std::size_t block_size, std::size_t table_size);
+                                   std::size_t block_size, std::size_t table_size,
+                                   std::shared_ptr<tchecker::refzg::por_t> const & por = nullptr);
 
 /*!
  \brief Factory of zone graphs with reference clocks and states/transitions sharing
@@ -615,9 +839,11 @@ tchecker::refzg::refzg_t * factory(std::shared_ptr<tchecker::ta::system_t const>
  \param spread : spread bound over reference clocks
  \param block_size : number of objects allocated in a block
  \param table_size : size of hash tables
+ \param por : partial-order reduction (nullptr for no reduction)
  \return a zone graph over system with zone semantics and spread bound
  defined from semantics_type and spread, reference clocks defined from
  refclocks_type, and allocation of block_size objects at a time
+ \pre if por is not nullptr, then refclocks_type is PROCESS_REFERENCE_CLOCKS
  \note set spread to tchecker::refdbm::UNBOUNDED_SPREAD for unbounded spread
  \note the states and transitions computed by the returned zone graph share
  internal components
@@ -625,7 +851,8 @@ tchecker::refzg::refzg_t * factory(std::shared_ptr<tchecker::ta::system_t const>
 tchecker::refzg::sharing_refzg_t * factory_sharing(std::shared_ptr<tchecker::ta::system_t const> const & system,
                                                    enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                                                    enum tchecker::refzg::semantics_type_t semantics_type,
-                                                   tchecker::integer_t spread, std::size_t block_size, std::size_t hash_table);
+                                                   tchecker::integer_t spread, std::size_t block_size, std::size_t hash_table,
+                                                   std::shared_ptr<tchecker::refzg::por_t> const & por = nullptr);
 
 } // end of namespace refzg
 
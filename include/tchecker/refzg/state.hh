@@ -275,6 +275,30 @@ std::size_t shared_hash_value(tchecker::refzg::state_t const & s);
  */
 int lexical_cmp(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t const & s2);
 
+/*!
+ \brief Serialization
+ \param os : output stream
+ \param s : state
+ \post the tuple of locations, the valuation of bounded integer variables and
+ the zone of s have been written to os (binary format)
+ \return os after output
+ */
+std::ostream & serialize(std::ostream & os, tchecker::refzg::state_t const & s);
+
+/*!
+ \brief Deserialization
+ \param is : input stream
+ \param s : state
+ \pre the components of s are not shared, and have the sizes of the components
+ of the serialized state
+ \post the tuple of locations, the valuation of bounded integer variables and
+ the zone of s have been read from is (see tchecker::refzg::serialize)
+ \return is after input
+ \throw std::runtime_error : if is does not contain a serialized state of
+ matching sizes
+ */
+std::istream & deserialize(std::istream & is, tchecker::refzg::state_t & s);
+
 /*!
  \brief Type of shared state
  */
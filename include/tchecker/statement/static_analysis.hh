@@ -48,6 +48,25 @@ void extract_read_variables(tchecker::typed_statement_t const & stmt, std::unord
 void extract_written_variables(tchecker::typed_statement_t const & stmt, std::unordered_set<tchecker::clock_id_t> & clocks,
                                std::unordered_set<tchecker::intvar_id_t> & intvars, std::unordered_set<tchecker::param_id_t> & params);
 
+/*!
+ \brief Extract typed variables IDs that are written by every execution of a statement
+ \param stmt : statement
+ \param clocks : a set of clock IDs
+ \param intvars : a set of integer variable
+ \param params : a set of parameter IDs
+ \post for every assignment to a variable x in stmt that is executed by every
+ terminating execution of stmt, x has been added to clocks if x is a clock, and
+ to intvars if x is an integer variable. Assignments in an If-Then-Else
+ statement are only considered if they occur in both branches, and assignments
+ in the body of While statements are ignored. Assignments to array expressions
+ (i.e. x[e]) are ignored unless x has size 1
+ \note this is an under-approximation of the set of written variables, to be
+ used as kill set in live variables analysis
+ */
+void extract_must_written_variables(tchecker::typed_statement_t const & stmt, std::unordered_set<tchecker::clock_id_t> & clocks,
+                                    std::unordered_set<tchecker::intvar_id_t> & intvars,
+                                    std::unordered_set<tchecker::param_id_t> & params);
+
 /*!
  \brief Check if a statement declares local variables
  \param stmt : statement
@@ -156,12 +156,13 @@ public:
    \pre p has been constructed by this allocator
    \pre p is not nullptr
    \post the tuple of locations in the state pointed by p has been shared with
-   other states
+   other states, and it has memoized attributes (see tchecker::vloc_memo_t)
   */
   void share(tchecker::intrusive_shared_ptr_t<STATE> const & p)
   {
     tchecker::ts::state_pool_allocator_t<STATE>::share(p);
     p->vloc_ptr() = _vloc_cache->find_else_add(p->vloc_ptr());
+    p->vloc_ptr()->attach_memo();
   }
 
   /*!
@@ -277,6 +277,25 @@ inline tchecker::state_status_t next(tchecker::syncprod::system_t const & system
 boost::dynamic_bitset<> committed_processes(tchecker::syncprod::system_t const & system,
                                             tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc);
 
+/*!
+ \brief Accessor to memoized committed processes
+ \param system : a system
+ \param vloc : tuple of locations
+ \return the memo of vloc with committed processes memoized, nullptr if vloc
+ has no memo (see tchecker::vloc_memo_t)
+ */
+tchecker::vloc_memo_t const * committed_processes_memo(tchecker::syncprod::system_t const & system,
+                                                       tchecker::vloc_t const & vloc);
+
+/*!
+ \brief Accessor to memoized labels
+ \param system : a system
+ \param vloc : tuple of locations
+ \return the memo of vloc with labels memoized, nullptr if vloc has no memo
+ (see tchecker::vloc_memo_t)
+ */
+tchecker::vloc_memo_t const * labels_memo(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc);
+
 /*!
  \brief Compute labels in a tuple of locations
  \param system : a system of timed processes
@@ -295,6 +314,28 @@ boost::dynamic_bitset<> labels(tchecker::syncprod::system_t const & system, tche
 */
 boost::dynamic_bitset<> labels(tchecker::syncprod::system_t const & system, tchecker::syncprod::state_t const & s);
 
+/*!
+ \brief Checks if a tuple of locations satisfies a set of labels
+ \param system : a system
+ \param vloc : tuple of locations
+ \param labels : a set of labels
+ \return true if labels is a subset of the labels on locations in vloc, false
+ otherwise
+ \note does not allocate memory when vloc has memoized labels
+ */
+bool satisfies(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc,
+               boost::dynamic_bitset<> const & labels);
+
+/*!
+ \brief Checks if a state satisfies a set of labels
+ \param system : a system
+ \param s : a state
+ \param labels : a set of labels
+ \return true if labels is a subset of the labels on state s, false otherwise
+ */
+bool satisfies(tchecker::syncprod::system_t const & system, tchecker::syncprod::state_t const & s,
+               boost::dynamic_bitset<> const & labels);
+
 /*!
  \brief Compute string representation of the labels of in state
  \param system : a system
@@ -459,6 +500,14 @@ public:
    */
   virtual boost::dynamic_bitset<> labels(tchecker::syncprod::const_state_sptr_t const & s) const;
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   */
+  virtual bool satisfies(tchecker::syncprod::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const;
+
   /*!
   \brief Checks if a state is a valid final state
   \param s : a state
@@ -498,6 +547,13 @@ public:
   */
   virtual void share(tchecker::syncprod::transition_sptr_t & t);
 
+  /*!
+   \brief Collect unused states and transitions
+   \post the memory of states and transitions that are not referenced anymore
+   (and of their components) can be reused by subsequent allocations
+  */
+  virtual void collect();
+
   /*!
    \brief Accessor
    \return Underlying system of timed processes
@@ -252,6 +252,26 @@ std::string to_string(tchecker::vedge_t const & vedge, tchecker::system::system_
  */
 int lexical_cmp(tchecker::vedge_t const & vedge1, tchecker::vedge_t const & vedge2);
 
+/*!
+ \brief Serialization
+ \param os : output stream
+ \param vedge : vector of edges
+ \post vedge has been written to os in binary format
+ \return os after output
+ */
+std::ostream & serialize(std::ostream & os, tchecker::vedge_t const & vedge);
+
+/*!
+ \brief Deserialization
+ \param is : input stream
+ \param vedge : vector of edges
+ \post vedge has been read from is (see tchecker::serialize)
+ \return is after input
+ \throw std::runtime_error : if is does not contain a vector of edges with the
+ same size as vedge
+ */
+std::istream & deserialize(std::istream & is, tchecker::vedge_t & vedge);
+
 /*!
  \brief Type of shared tuple of edges
  */
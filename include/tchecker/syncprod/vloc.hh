@@ -9,6 +9,10 @@
 #define TCHECKER_VLOC_HH
 
 #include <cassert>
+#include <iostream>
+#include <memory>
+
+#include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/system/system.hh"
@@ -24,14 +28,213 @@
 
 namespace tchecker {
 
+/*!
+ \class vloc_memo_t
+ \brief Memoized attributes of a tuple of locations
+ \note Attributes are computed on demand, the first time they are accessed
+ (see tchecker::syncprod::labels, tchecker::ta::delay_allowed, etc). A memo is
+ attached to a tuple of locations when it is shared (i.e. hash-consed), and it
+ is shared by all copies of this tuple of locations until they are modified
+ */
+class vloc_memo_t {
+public:
+  /*!
+   \brief Constructor
+   \post no attribute has been memoized
+   */
+  vloc_memo_t();
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  vloc_memo_t(tchecker::vloc_memo_t const &) = delete;
+
+  /*!
+   \brief Move constructor (deleted)
+   */
+  vloc_memo_t(tchecker::vloc_memo_t &&) = delete;
+
+  /*!
+   \brief Destructor
+   */
+  ~vloc_memo_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::vloc_memo_t & operator=(tchecker::vloc_memo_t const &) = delete;
+
+  /*!
+   \brief Move-assignment operator (deleted)
+   */
+  tchecker::vloc_memo_t & operator=(tchecker::vloc_memo_t &&) = delete;
+
+  /*!
+   \brief Accessor
+   \return true if labels have been memoized, false otherwise
+   */
+  inline bool has_labels() const { return _flags & LABELS; }
+
+  /*!
+   \brief Accessor
+   \pre has_labels() (checked by assertion)
+   \return memoized labels
+   */
+  inline boost::dynamic_bitset<> const & labels() const
+  {
+    assert(has_labels());
+    return _labels;
+  }
+
+  /*!
+   \brief Setter
+   \param labels : set of labels
+   \post labels have been memoized
+   */
+  void set_labels(boost::dynamic_bitset<> const & labels);
+
+  /*!
+   \brief Accessor
+   \return true if committed processes have been memoized, false otherwise
+   */
+  inline bool has_committed_processes() const { return _flags & COMMITTED_PROCESSES; }
+
+  /*!
+   \brief Accessor
+   \pre has_committed_processes() (checked by assertion)
+   \return true if some process is in a committed location, false otherwise
+   */
+  inline bool committed() const
+  {
+    assert(has_committed_processes());
+    return _flags & COMMITTED;
+  }
+
+  /*!
+   \brief Accessor
+   \pre has_committed_processes() (checked by assertion)
+   \return memoized set of committed processes
+   */
+  inline boost::dynamic_bitset<> const & committed_processes() const
+  {
+    assert(has_committed_processes());
+    return _committed_processes;
+  }
+
+  /*!
+   \brief Setter
+   \param committed_processes : set of committed processes
+   \post committed_processes has been memoized
+   */
+  void set_committed_processes(boost::dynamic_bitset<> const & committed_processes);
+
+  /*!
+   \brief Accessor
+   \return true if delay allowed flag has been memoized, false otherwise
+   */
+  inline bool has_delay_allowed() const { return _flags & DELAY_ALLOWED_VALID; }
+
+  /*!
+   \brief Accessor
+   \pre has_delay_allowed() (checked by assertion)
+   \return memoized delay allowed flag
+   */
+  inline bool delay_allowed() const
+  {
+    assert(has_delay_allowed());
+    return _flags & DELAY_ALLOWED;
+  }
+
+  /*!
+   \brief Setter
+   \param delay_allowed : delay allowed flag
+   \post delay_allowed has been memoized
+   */
+  void set_delay_allowed(bool delay_allowed);
+
+  /*!
+   \brief Accessor
+   \return true if the set of reference clocks allowed to delay has been
+   memoized, false otherwise
+   */
+  inline bool has_refclocks_delay_allowed() const { return _flags & REFCLOCKS_DELAY_ALLOWED; }
+
+  /*!
+   \brief Accessor
+   \pre has_refclocks_delay_allowed() (checked by assertion)
+   \return memoized set of reference clocks allowed to delay
+   */
+  inline boost::dynamic_bitset<> const & refclocks_delay_allowed() const
+  {
+    assert(has_refclocks_delay_allowed());
+    return _refclocks_delay_allowed;
+  }
+
+  /*!
+   \brief Setter
+   \param delay_allowed : set of reference clocks allowed to delay
+   \post delay_allowed has been memoized
+   */
+  void set_refclocks_delay_allowed(boost::dynamic_bitset<> const & delay_allowed);
+
+private:
+  /*!
+   \brief Flags of memoized attributes
+   */
+  enum flags_t : unsigned char {
+    LABELS = 1,                  /*!< Labels are memoized */
+    COMMITTED_PROCESSES = 2,     /*!< Committed processes are memoized */
+    COMMITTED = 4,               /*!< Some process is committed */
+    DELAY_ALLOWED_VALID = 8,     /*!< Delay allowed flag is memoized */
+    DELAY_ALLOWED = 16,          /*!< Delay is allowed */
+    REFCLOCKS_DELAY_ALLOWED = 32 /*!< Reference clocks allowed to delay are memoized */
+  };
+
+  unsigned char _flags;                             /*!< Flags of memoized attributes */
+  boost::dynamic_bitset<> _labels;                  /*!< Labels */
+  boost::dynamic_bitset<> _committed_processes;     /*!< Committed processes */
+  boost::dynamic_bitset<> _refclocks_delay_allowed; /*!< Reference clocks allowed to delay */
+};
+
 /*!
  \class vloc_base_t
  \brief Base class for tuple of locations that extends array capacity with
- cache object
+ cache object, and memoized attributes
 */
 class vloc_base_t : public tchecker::array_capacity_t<unsigned int>, public tchecker::cached_object_t {
 public:
   using tchecker::array_capacity_t<unsigned int>::array_capacity_t;
+
+  /*!
+   \brief Accessor
+   \return memoized attributes of this tuple of locations, nullptr if this
+   tuple of locations has no memo (i.e. it has not been shared, or it has been
+   modified since)
+   */
+  inline tchecker::vloc_memo_t * memo() const { return _memo.get(); }
+
+  /*!
+   \brief Attach memo
+   \post a memo with no memoized attribute has been attached to this tuple of
+   locations if it had no memo
+   \note shall only be called on tuples of locations that will not be modified
+   anymore (e.g. shared tuples of locations)
+   */
+  inline void attach_memo() const
+  {
+    if (_memo.get() == nullptr)
+      _memo = std::make_shared<tchecker::vloc_memo_t>();
+  }
+
+protected:
+  /*!
+   \brief Detach memo
+   \post this tuple of locations has no memo
+   */
+  inline void detach_memo() { _memo.reset(); }
+
+private:
+  mutable std::shared_ptr<tchecker::vloc_memo_t> _memo; /*!< Memoized attributes */
 };
 
 /*!
@@ -64,6 +267,81 @@ public:
    */
   inline tchecker::loc_array_t::capacity_t size() const { return tchecker::loc_array_t::capacity(); }
 
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size (checked by assertion)
+   \return reference to the location at index i
+   \post memoized attributes have been detached from this tuple of locations
+   */
+  inline tchecker::loc_id_t & operator[](tchecker::loc_array_t::capacity_t i)
+  {
+    detach_memo();
+    return tchecker::loc_array_t::operator[](i);
+  }
+
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size (checked by assertion)
+   \return const reference to the location at index i
+   */
+  inline tchecker::loc_id_t const & operator[](tchecker::loc_array_t::capacity_t i) const
+  {
+    return tchecker::loc_array_t::operator[](i);
+  }
+
+  /*!
+   \brief Accessor
+   \return iterator to first location
+   \post memoized attributes have been detached from this tuple of locations
+   */
+  inline tchecker::loc_array_t::iterator_t begin()
+  {
+    detach_memo();
+    return tchecker::loc_array_t::begin();
+  }
+
+  /*!
+   \brief Accessor
+   \return const iterator to first location
+   */
+  inline tchecker::loc_array_t::const_iterator_t begin() const { return tchecker::loc_array_t::begin(); }
+
+  /*!
+   \brief Accessor
+   \return past-the-end iterator
+   \post memoized attributes have been detached from this tuple of locations
+   */
+  inline tchecker::loc_array_t::iterator_t end()
+  {
+    detach_memo();
+    return tchecker::loc_array_t::end();
+  }
+
+  /*!
+   \brief Accessor
+   \return past-the-end const iterator
+   */
+  inline tchecker::loc_array_t::const_iterator_t end() const { return tchecker::loc_array_t::end(); }
+
+  /*!
+   \brief Accessor
+   \return pointer to first location
+   \post memoized attributes have been detached from this tuple of locations
+   */
+  inline tchecker::loc_id_t * ptr()
+  {
+    detach_memo();
+    return tchecker::loc_array_t::ptr();
+  }
+
+  /*!
+   \brief Accessor
+   \return pointer to first location
+   */
+  inline tchecker::loc_id_t const * ptr() const { return tchecker::loc_array_t::ptr(); }
+
   /*!
    \brief Construction
    \param args : arguments to a constructor of tchecker::vloc_t
@@ -174,6 +452,26 @@ std::string to_string(tchecker::vloc_t const & vloc, tchecker::system::system_t
  */
 int lexical_cmp(tchecker::vloc_t const & vloc1, tchecker::vloc_t const & vloc2);
 
+/*!
+ \brief Serialization
+ \param os : output stream
+ \param vloc : tuple of locations
+ \post vloc has been written to os in binary format
+ \return os after output
+ */
+std::ostream & serialize(std::ostream & os, tchecker::vloc_t const & vloc);
+
+/*!
+ \brief Deserialization
+ \param is : input stream
+ \param vloc : tuple of locations
+ \post vloc has been read from is (see tchecker::serialize)
+ \return is after input
+ \throw std::runtime_error : if is does not contain a tuple of locations with
+ the same size as vloc
+ */
+std::istream & deserialize(std::istream & is, tchecker::vloc_t & vloc);
+
 /*!
  \brief Type of shared tuple of locations
  */
@@ -12,8 +12,6 @@
 #include <memory>
 #include <vector>
 
-#include <boost/dynamic_bitset/dynamic_bitset.hpp>
-
 #include "tchecker/basictypes.hh"
 #include "tchecker/system/attribute.hh"
 #include "tchecker/utils/iterator.hh"
@@ -161,14 +159,14 @@ public:
 /*!
  \class loc_edges_maps_t
  \brief Maps from location IDs to collection of edges and events
+ \note Edges with a given location and event are found by binary search among
+ the edges of the location sorted by event. Memory is linear in the number of
+ locations and edges, independently of the number of events. Adding an edge
+ takes constant time when the edges of a location are added by non-decreasing
+ events, and time linear in the number of edges of the location otherwise. Use
+ append_edge() and sort_edges() to add many edges in arbitrary order
  */
 class loc_edges_maps_t {
-private:
-  /*!
-   \brief Type of collection of events
-   */
-  using events_collection_t = boost::dynamic_bitset<>;
-
 public:
   /*!
    \brief Clear all maps
@@ -183,6 +181,22 @@ public:
    */
   void add_edge(tchecker::loc_id_t loc, tchecker::system::edge_shared_ptr_t const & edge);
 
+  /*!
+   \brief Append an edge without sorting edges by event
+   \param loc : location identifer
+   \param edge : an edge
+   \post edge has been added to the maps
+   \note sort_edges() must be called before the maps are accessed
+   */
+  void append_edge(tchecker::loc_id_t loc, tchecker::system::edge_shared_ptr_t const & edge);
+
+  /*!
+   \brief Sort edges by event
+   \post the edges of each location are sorted by event, edges with the same
+   event are kept in order of insertion
+   */
+  void sort_edges();
+
   /*!
    \brief Accessor
    \param loc : location identifier
@@ -208,10 +222,10 @@ public:
   bool event(tchecker::loc_id_t loc, tchecker::event_id_t event) const;
 
 private:
-  std::vector<tchecker::system::edges_collection_t> _loc_to_edges;  /*!< Map : loc ID -> edges */
-  std::vector<events_collection_t> _loc_to_events;                  /*!< Map : loc ID -> events */
-  std::vector<std::vector<edges_collection_t>> _loc_event_to_edges; /*!< Map : (loc ID, event ID) -> edges */
-  static tchecker::system::edges_collection_t const _empty_edges;   /*!< Empty collection of edges */
+  std::vector<tchecker::system::edges_collection_t> _loc_to_edges;         /*!< Map : loc ID -> edges */
+  std::vector<std::vector<tchecker::event_id_t>> _loc_to_events;           /*!< Map : loc ID -> sorted events of edges */
+  std::vector<tchecker::system::edges_collection_t> _loc_to_sorted_edges; /*!< Map : loc ID -> edges sorted by event */
+  static tchecker::system::edges_collection_t const _empty_edges;         /*!< Empty collection of edges */
 };
 
 /*!
@@ -387,6 +401,20 @@ private:
    */
   void add_edges(tchecker::system::edges_t const & edges);
 
+  /*!
+   \brief Create an edge
+   \param pid : process identifier
+   \param src : source location
+   \param tgt : target location
+   \param event_id : event identifier
+   \param attr : edge attributes
+   \return edge src -> tgt with event event_id in process pid
+   \post the edge has been added to the collection of edges, but not to the maps
+   \throw std::runtime_error : if edge identifiers have been exhausted
+   */
+  tchecker::system::edge_shared_ptr_t new_edge(tchecker::process_id_t pid, tchecker::loc_id_t src, tchecker::loc_id_t tgt,
+                                               tchecker::event_id_t event_id, tchecker::system::attributes_t const & attr);
+
   /*!< Collection of edges */
   tchecker::system::edges_collection_t _edges;
   /*!< Maps : loc ID to incoming/outgoing edges/events */
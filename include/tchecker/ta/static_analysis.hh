@@ -8,6 +8,9 @@
 #ifndef TCHECKER_TA_STATIC_ANALYSIS_HH
 #define TCHECKER_TA_STATIC_ANALYSIS_HH
 
+#include <vector>
+
+#include "tchecker/basictypes.hh"
 #include "tchecker/ta/system.hh"
 
 /*!
@@ -25,6 +28,17 @@ namespace ta {
  */
 bool has_guarded_weakly_synchronized_event(tchecker::ta::system_t const & system);
 
+/*!
+ \brief Compute dead bounded integer variables
+ \param system : a system of timed processes
+ \return a vector that maps every location ID in system to the flattened bounded
+ integer variables that are only accessed by the process of this location, and
+ that are dead in this location (see tchecker::live_intvars)
+ \note the value of a dead variable in a location is irrelevant, as the
+ variable is written before it is read along every path from this location
+ */
+std::vector<std::vector<tchecker::intvar_id_t>> dead_intvars(tchecker::ta::system_t const & system);
+
 } // end of namespace ta
 
 } // end of namespace tchecker
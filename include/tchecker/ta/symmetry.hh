@@ -0,0 +1,69 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TA_SYMMETRY_HH
+#define TCHECKER_TA_SYMMETRY_HH
+
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/ta/system.hh"
+
+/*!
+ \file symmetry.hh
+ \brief Symmetric processes in systems of timed processes
+ */
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \struct symmetric_process_t
+ \brief Description of a process in a group of symmetric processes. Processes in
+ a group have the same number of locations and of owned variables, and the i-th
+ location (resp. owned variable) of a process corresponds to the i-th location
+ (resp. owned variable) of every other process in the group
+ */
+struct symmetric_process_t {
+  tchecker::process_id_t pid;                 /*!< Process identifier */
+  std::vector<tchecker::loc_id_t> locations;  /*!< Locations of the process, sorted by name */
+  std::vector<tchecker::clock_id_t> clocks;   /*!< Flattened clocks only accessed by the process */
+  std::vector<tchecker::intvar_id_t> intvars; /*!< Flattened bounded integer variables only accessed by the process */
+};
+
+/*!
+ \brief Type of groups of symmetric processes, sorted by increasing process identifier
+ */
+using symmetry_group_t = std::vector<tchecker::ta::symmetric_process_t>;
+
+/*!
+ \brief Compute groups of symmetric processes
+ \param system : a system of timed processes
+ \return the groups of symmetric processes in system with at least two
+ processes. If some process in system has attribute symmetry, the groups are
+ the processes with the same value of attribute symmetry. Otherwise, the
+ groups are detected automatically as the maximal sets of symmetric processes
+ \throw std::invalid_argument : if a group of processes declared with attribute
+ symmetry is not a set of symmetric processes
+ \note Two processes are symmetric if they are identical up to the renaming of
+ the clocks and bounded integer variables that they own (i.e. that no other
+ process accesses): same location names, initial, committed and urgent
+ locations, labels, invariants, and same edges with same events, guards and
+ statements. Owned variables are matched in declaration order, and shall have
+ same sizes, domains and initial values. Furthermore, the synchronizations of
+ system shall be invariant under the permutation of the processes. Exchanging
+ the locations and owned variables of symmetric processes in a state yields a
+ state with the same behaviours and labels.
+ */
+std::vector<tchecker::ta::symmetry_group_t> symmetry_groups(tchecker::ta::system_t const & system);
+
+} // end of namespace ta
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TA_SYMMETRY_HH
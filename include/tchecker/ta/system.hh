@@ -22,6 +22,7 @@
 #include "tchecker/system/attribute.hh"
 #include "tchecker/system/system.hh"
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/variables/intvars.hh"
 #include "tchecker/vm/vm.hh"
 
 /*!
@@ -174,6 +175,57 @@ public:
   using tchecker::syncprod::system_t::intvars_count;
   using tchecker::syncprod::system_t::is_intvar;
 
+  /*!
+   \brief Accessor
+   \param id : location identifier
+   \pre id is a location identifier (checked by assertion)
+   \return flattened bounded integer variables that are dead in location id and
+   only accessed by the process of location id (see tchecker::ta::dead_intvars)
+   */
+  std::vector<tchecker::intvar_id_t> const & dead_intvars(tchecker::loc_id_t id) const;
+
+  /*!
+   \brief Accessor
+   \return true if dead bounded integer variables are reset to their initial
+   value by tchecker::ta::next, false otherwise
+   \note the reset is disabled on construction
+   */
+  inline bool dead_intvars_reset() const { return _dead_intvars_reset; }
+
+  /*!
+   \brief Enable/disable reset of dead bounded integer variables
+   \param reset : reset flag
+   \post dead bounded integer variables are reset to their initial value by
+   tchecker::ta::next if reset is true, and left unchanged otherwise
+   */
+  inline void dead_intvars_reset(bool reset) { _dead_intvars_reset = reset; }
+
+  /*!
+   \brief Accessor
+   \return layout of bit-packed valuations of bounded integer variables, nullptr
+   if valuations are not packed
+   */
+  inline tchecker::intvars_layout_t const * intvars_layout() const { return _intvars_layout.get(); }
+
+  /*!
+   \brief Enable/disable bit-packing of valuations of bounded integer variables
+   \param packed : packing flag
+   \post valuations of bounded integer variables are packed w.r.t.
+   intvars_layout() if packed is true, and store one tchecker::integer_t per
+   flattened variable otherwise. The virtual machine accesses valuations
+   accordingly
+   \note valuations computed before the call should not be used after it
+   */
+  void packed_intvars(bool packed);
+
+  /*!
+   \brief Accessor
+   \return capacity of valuations of bounded integer variables: the number of
+   words of packed valuations if valuations are packed, the number of flattened
+   variables otherwise
+   */
+  std::size_t intvars_valuation_capacity() const;
+
   // Labels
   using tchecker::syncprod::system_t::is_label;
   using tchecker::syncprod::system_t::label_id;
@@ -309,6 +361,9 @@ private:
   std::vector<compiled_expression_t> _guards;     /*!< Map : edge identifier -> guard */
   std::vector<compiled_statement_t> _statements;  /*!< Map : edge identifier -> statement */
   boost::dynamic_bitset<> _urgent;                /*!< Urgent locations */
+  std::vector<std::vector<tchecker::intvar_id_t>> _dead_intvars; /*!< Map : location identifier -> dead variables */
+  bool _dead_intvars_reset;                                      /*!< Reset dead variables */
+  std::shared_ptr<tchecker::intvars_layout_t const> _intvars_layout; /*!< Layout of packed valuations (nullptr if not packed) */
 };
 
 } // end of namespace ta
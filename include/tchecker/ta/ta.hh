@@ -139,6 +139,7 @@ using outgoing_edges_value_t = tchecker::syncprod::outgoing_edges_value_t;
  \param reset : clock resets container for clock resets of vedge
  \param tgt_invariant : clock constaint container for invariant of vloc after it is updated
  \param edges : tuple of edge from vloc (range of synchronized/asynchronous edges)
+ \param intvars_reset : set to true if some dead variable has been reset
  \pre the source location in edges match the locations in vloc.
  No process has more than one edge in edges.
  The pid of every process in edges is less than the size of vloc
@@ -148,7 +149,10 @@ using outgoing_edges_value_t = tchecker::syncprod::outgoing_edges_value_t;
  Clock constraints from the invariants of vloc before it is updated have been pushed to src_invariant.
  Clock constraints from the guards in edges have been pushed into guard.
  Clock resets from the statements in edges have been pushed into reset.
- And clock constraints from the invariants in the updated vloc have been pushed into tgt_invariant
+ And clock constraints from the invariants in the updated vloc have been pushed into tgt_invariant.
+ If system.dead_intvars_reset() holds, the variables that are dead in the target
+ locations of edges have been reset to their initial value. intvars_reset is
+ true if the value of some of them has been changed, false otherwise
  \return STATE_OK if state computation succeeded,
  STATE_INCOMPATIBLE_EDGE if the source locations in edges do not match vloc,
  STATE_SRC_INVARIANT_VIOLATED if the valuation intval does not satisfy the invariant in vloc,
@@ -167,7 +171,25 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant,
-                              tchecker::ta::outgoing_edges_value_t const & edges);
+                              tchecker::ta::outgoing_edges_value_t const & edges, bool & intvars_reset);
+
+/*!
+ \brief Compute next state
+ \note same as tchecker::ta::next above, without reporting the reset of dead
+ variables
+ */
+inline tchecker::state_status_t next(tchecker::ta::system_t const & system,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> const & intval,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
+                                     tchecker::clock_constraint_container_t & src_invariant,
+                                     tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
+                                     tchecker::clock_constraint_container_t & tgt_invariant,
+                                     tchecker::ta::outgoing_edges_value_t const & edges)
+{
+  bool intvars_reset = false;
+  return tchecker::ta::next(system, vloc, intval, vedge, src_invariant, guard, reset, tgt_invariant, edges, intvars_reset);
+}
 
 /*!
 \brief Compute next state and transition
@@ -175,15 +197,34 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 \param s : state
 \param t : transition
 \param v : outgoing edge value
+\param intvars_reset : set to true if some dead variable has been reset
 \post s have been updated from v, and t is the set of edges in v
 \return status of state s after update
 \throw std::invalid_argument : if s and v have incompatible size
 */
 inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::ta::state_t & s,
-                                     tchecker::ta::transition_t & t, tchecker::ta::outgoing_edges_value_t const & v)
+                                     tchecker::ta::transition_t & t, tchecker::ta::outgoing_edges_value_t const & v,
+                                     bool & intvars_reset)
 {
   return tchecker::ta::next(system, s.vloc_ptr(), s.intval_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), v);
+                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), v, intvars_reset);
+}
+
+/*!
+\brief Compute next state and transition
+\param system : a system
+\param s : state
+\param t : transition
+\param v : outgoing edge value
+\post s have been updated from v, and t is the set of edges in v
+\return status of state s after update
+\throw std::invalid_argument : if s and v have incompatible size
+*/
+inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::ta::state_t & s,
+                                     tchecker::ta::transition_t & t, tchecker::ta::outgoing_edges_value_t const & v)
+{
+  bool intvars_reset = false;
+  return tchecker::ta::next(system, s, t, v, intvars_reset);
 }
 
 /*!
@@ -206,6 +247,23 @@ bool delay_allowed(tchecker::ta::system_t const & system, tchecker::vloc_t const
 boost::dynamic_bitset<> delay_allowed(tchecker::ta::system_t const & system, tchecker::reference_clock_variables_t const & r,
                                       tchecker::vloc_t const & vloc);
 
+/*!
+ \brief Compute the set of reference clocks that can let time elapse in a tuple
+ of locations, without allocation when the set is memoized in vloc
+ \param system : a system of timed processes
+ \param r : reference clocks
+ \param vloc : tuple of locations
+ \param scratch : a dynamic bitset
+ \return a dynamic bitset of size r.refcount() that contains all reference clocks
+ that can delay from vloc. The returned bitset is either memoized in vloc, or
+ scratch
+ \note the returned reference is invalidated when vloc is modified or when
+ scratch is modified
+ */
+boost::dynamic_bitset<> const & delay_allowed(tchecker::ta::system_t const & system,
+                                              tchecker::reference_clock_variables_t const & r, tchecker::vloc_t const & vloc,
+                                              boost::dynamic_bitset<> & scratch);
+
 /*!
  \brief Compute the set of reference clocks that should synchronize on a tuple
  of edges
@@ -226,6 +284,15 @@ boost::dynamic_bitset<> sync_refclocks(tchecker::ta::system_t const & system, tc
   */
 boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s);
 
+/*!
+ \brief Checks if a state satisfies a set of labels
+ \param system : a system
+ \param s : a state
+ \param labels : a set of labels
+ \return true if labels is a subset of the labels on state s, false otherwise
+ */
+bool satisfies(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s, boost::dynamic_bitset<> const & labels);
+
 /*!
  \brief Checks is a state is a valid final state
  \param system : a system
@@ -234,6 +301,27 @@ boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::
 */
 bool is_valid_final(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s);
 
+/*!
+ \brief Checks if a state is well formed w.r.t. a system
+ \param system : a system
+ \param s : a state
+ \return true if the i-th location in s is a location of the i-th process of
+ system, and every bounded integer variable in s has a value in its domain,
+ false otherwise
+ \note this is used to check states that have been read from a file
+ */
+bool is_well_formed(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s);
+
+/*!
+ \brief Checks if a transition is well formed w.r.t. a system
+ \param system : a system
+ \param t : a transition
+ \return true if the i-th edge in t is either tchecker::NO_EDGE or an edge of
+ the i-th process of system, false otherwise
+ \note this is used to check transitions that have been read from a file
+ */
+bool is_well_formed(tchecker::ta::system_t const & system, tchecker::ta::transition_t const & t);
+
 /*!
  \brief Accessor to state attributes as strings
  \param system : a system
@@ -270,6 +358,7 @@ public:
                                        tchecker::ta::initial_range_t, tchecker::ta::outgoing_edges_range_t,
                                        tchecker::ta::initial_value_t, tchecker::ta::outgoing_edges_value_t>;
   using sst_t = ts_impl_t::sst_t;
+  using sst_callback_t = ts_impl_t::sst_callback_t;
   using state_t = ts_impl_t::state_t;
   using const_state_t = ts_impl_t::const_state_t;
   using transition_t = ts_impl_t::transition_t;
@@ -354,6 +443,18 @@ public:
 
   using ts_impl_t::next;
 
+  /*!
+   \brief Visit next states and transitions with selected status
+   \param s : state
+   \param mask : mask on next states
+   \param callback : callback on next states and transitions
+   \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+   is a transition and the status of s' matches mask (i.e. status & mask != 0)
+   \note each successor is handed to callback as soon as it has been computed
+   */
+  virtual void for_each_next(tchecker::ta::const_state_sptr_t const & s, tchecker::state_status_t mask,
+                             sst_callback_t const & callback);
+
   /*!
    \brief Computes the set of labels of a state
    \param s : a state
@@ -361,6 +462,14 @@ public:
    */
   virtual boost::dynamic_bitset<> labels(tchecker::ta::const_state_sptr_t const & s) const;
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   */
+  virtual bool satisfies(tchecker::ta::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const;
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -400,6 +509,13 @@ public:
   */
   virtual void share(tchecker::ta::transition_sptr_t & t);
 
+  /*!
+   \brief Collect unused states and transitions
+   \post the memory of states and transitions that are not referenced anymore
+   (and of their components) can be reused by subsequent allocations
+  */
+  virtual void collect();
+
   /*!
    \brief Accessor
    \return Underlying system of timed processes
@@ -8,6 +8,7 @@
 #ifndef TCHECKER_TS_HH
 #define TCHECKER_TS_HH
 
+#include <functional>
 #include <map>
 #include <tuple>
 #include <type_traits>
@@ -94,6 +95,13 @@ public:
   */
   using sst_t = std::tuple<tchecker::state_status_t, state_t, transition_t>;
 
+  /*!
+  \brief Type of callbacks on (status, state, transition)
+  \note state and transition are handed over to the callback, which may modify
+  them (e.g. share their internal components)
+  */
+  using sst_callback_t = std::function<void(tchecker::state_status_t, state_t &, transition_t &)>;
+
   /*!
    \brief Destructor
    */
@@ -178,6 +186,26 @@ public:
     }
   }
 
+  /*!
+   \brief Visit next states and transitions with selected status
+   \param s : state
+   \param mask : mask on next states
+   \param callback : callback on next states and transitions
+   \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+   is a transition and the status of s' matches mask (i.e. status & mask != 0), in
+   the order of the method `next` above
+   \note default implementation calls callback on the tuples computed by `next`.
+   Implementations should override this method to hand each successor to callback
+   as soon as it has been computed, without storing successors in a container
+  */
+  virtual void for_each_next(const_state_t const & s, tchecker::state_status_t mask, sst_callback_t const & callback)
+  {
+    std::vector<sst_t> v;
+    next(s, v, mask);
+    for (auto && [status, nexts, nextt] : v)
+      callback(status, nexts, nextt);
+  }
+
   /*!
    \brief Accessor
    \param sst : a tuple (status, state, transition)
@@ -206,6 +234,18 @@ public:
    */
   virtual boost::dynamic_bitset<> labels(const_state_t const & s) const = 0;
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   \note default implementation computes the set of labels of s
+   */
+  virtual bool satisfies(const_state_t const & s, boost::dynamic_bitset<> const & labels) const
+  {
+    return labels.is_subset_of(this->labels(s));
+  }
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -242,6 +282,13 @@ public:
    \post internal components in t have been shared
   */
   virtual void share(transition_t & t) = 0;
+
+  /*!
+   \brief Collect unused states and transitions
+   \post the memory of states and transitions that are not referenced anymore
+   (and of their components) can be reused by subsequent allocations
+  */
+  virtual void collect() = 0;
 };
 
 /*!
@@ -279,6 +326,11 @@ public:
   */
   using sst_t = std::tuple<tchecker::state_status_t, state_t, transition_t>;
 
+  /*!
+  \brief Type of callbacks on (status, state, transition)
+  */
+  using sst_callback_t = std::function<void(tchecker::state_status_t, state_t const &, transition_t const &)>;
+
   /*!
    \brief Destructor
    */
@@ -324,6 +376,18 @@ public:
   */
   virtual void next(const_state_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask) = 0;
 
+  /*!
+  \brief Visit next states and transitions with selected status
+  \param s : state
+  \param mask : mask on next states
+  \param callback : callback on next states and transitions
+  \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+  is a transition and the status of s' matches mask (i.e. status & mask != 0), in
+  the order of the method `next` above
+  \note unlike `next`, successors are not stored in a container
+  */
+  virtual void for_each_next(const_state_t const & s, tchecker::state_status_t mask, sst_callback_t const & callback) = 0;
+
   /*!
    \brief Computes the set of labels of a state
    \param s : a state
@@ -331,6 +395,18 @@ public:
    */
   virtual boost::dynamic_bitset<> labels(const_state_t const & s) const = 0;
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   \note default implementation computes the set of labels of s
+   */
+  virtual bool satisfies(const_state_t const & s, boost::dynamic_bitset<> const & labels) const
+  {
+    return labels.is_subset_of(this->labels(s));
+  }
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -353,6 +429,13 @@ public:
    \post attributes of transition t have been added to map m
    */
   virtual void attributes(const_transition_t const & t, std::map<std::string, std::string> & m) const = 0;
+
+  /*!
+   \brief Collect unused states and transitions
+   \post the memory of states and transitions that are not referenced anymore
+   (and of their components) can be reused by subsequent allocations
+  */
+  virtual void collect() = 0;
 };
 
 /*!
@@ -370,6 +453,7 @@ public:
   using const_state_t = typename ts_t::const_state_t;
   using const_transition_t = typename ts_t::const_transition_t;
   using sst_t = typename ts_t::sst_t;
+  using sst_callback_t = typename ts_t::sst_callback_t;
   using state_t = typename ts_t::state_t;
   using transition_t = typename ts_t::transition_t;
 
@@ -431,6 +515,22 @@ public:
     _ts_impl.next(s, v, mask);
   }
 
+  /*!
+  \brief Visit next states and transitions with selected status
+  \param s : state
+  \param mask : mask on next states
+  \param callback : callback on next states and transitions
+  \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+  is a transition and the status of s' matches mask (i.e. status & mask != 0)
+  \note simply calls the same method on the underlying transition system implementation
+  */
+  inline virtual void for_each_next(const_state_t const & s, tchecker::state_status_t mask, sst_callback_t const & callback)
+  {
+    _ts_impl.for_each_next(s, mask, [&](tchecker::state_status_t status, state_t & nexts, transition_t & nextt) {
+      callback(status, nexts, nextt);
+    });
+  }
+
   /*!
    \brief Computes the set of labels of a state
    \param s : a state
@@ -438,6 +538,18 @@ public:
    */
   inline virtual boost::dynamic_bitset<> labels(const_state_t const & s) const { return _ts_impl.labels(s); }
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   \note simply calls the same method on the underlying transition system implementation
+   */
+  inline virtual bool satisfies(const_state_t const & s, boost::dynamic_bitset<> const & labels) const
+  {
+    return _ts_impl.satisfies(s, labels);
+  }
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -467,6 +579,12 @@ public:
     _ts_impl.attributes(t, m);
   }
 
+  /*!
+   \brief Collect unused states and transitions
+   \post see tchecker::ts::ts_impl_t::collect
+  */
+  inline virtual void collect() { _ts_impl.collect(); }
+
 protected:
   /*!
    \brief Accessor
@@ -474,6 +592,12 @@ protected:
   */
   TS_IMPL const & ts_impl() const { return _ts_impl; }
 
+  /*!
+   \brief Accessor
+   \return Underlying transition system implementation
+  */
+  TS_IMPL & ts_impl() { return _ts_impl; }
+
 private:
   TS_IMPL _ts_impl; /*!< Transition system implementation */
 };
@@ -494,6 +618,7 @@ public:
   using const_state_t = typename ts_t::const_state_t;
   using const_transition_t = typename ts_t::const_transition_t;
   using sst_t = typename ts_t::sst_t;
+  using sst_callback_t = typename ts_t::sst_callback_t;
   using state_t = typename ts_t::state_t;
   using transition_t = typename ts_t::transition_t;
 
@@ -565,6 +690,27 @@ public:
     vv.clear();
   }
 
+  /*!
+  \brief Visit next states and transitions with selected status
+  \param s : state
+  \param mask : mask on next states
+  \param callback : callback on next states and transitions
+  \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+  is a transition and the status of s' matches mask (i.e. status & mask != 0)
+  \note calls the same method on the underlying transition system, plus shares internal
+  components of the next states and transitions before they are handed to callback
+  */
+  inline virtual void for_each_next(const_state_t const & s, tchecker::state_status_t mask, sst_callback_t const & callback)
+  {
+    _ts_impl.for_each_next(s, mask,
+                           [&](tchecker::state_status_t status, typename TS_IMPL::state_t & nexts,
+                               typename TS_IMPL::transition_t & nextt) {
+                             _ts_impl.share(nexts);
+                             _ts_impl.share(nextt);
+                             callback(status, const_state_t{std::move(nexts)}, const_transition_t{std::move(nextt)});
+                           });
+  }
+
   /*!
    \brief Computes the set of labels of a state
    \param s : a state
@@ -572,6 +718,18 @@ public:
    */
   inline virtual boost::dynamic_bitset<> labels(const_state_t const & s) const { return _ts_impl.labels(s); }
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   \note simply calls the same method on the underlying transition system implementation
+   */
+  inline virtual bool satisfies(const_state_t const & s, boost::dynamic_bitset<> const & labels) const
+  {
+    return _ts_impl.satisfies(s, labels);
+  }
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -601,6 +759,12 @@ public:
     _ts_impl.attributes(t, m);
   }
 
+  /*!
+   \brief Collect unused states and transitions
+   \post see tchecker::ts::ts_impl_t::collect
+  */
+  inline virtual void collect() { _ts_impl.collect(); }
+
 protected:
   /*!
    \brief Accessor
@@ -608,6 +772,12 @@ protected:
   */
   TS_IMPL const & ts_impl() const { return _ts_impl; }
 
+  /*!
+   \brief Accessor
+   \return Underlying transition system implementation
+  */
+  TS_IMPL & ts_impl() { return _ts_impl; }
+
 private:
   /*!
   \brief Share state and transition components
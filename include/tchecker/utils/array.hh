@@ -440,7 +440,7 @@ bool operator!=(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a1,
 template <class T, std::size_t T_ALLOCSIZE, class BASE>
 std::size_t hash_value(tchecker::make_array_t<T, T_ALLOCSIZE, BASE> const & a)
 {
-  std::size_t h = hash_value(static_cast<BASE>(a));
+  std::size_t h = hash_value(static_cast<BASE const &>(a));
   boost::hash_range(h, a.begin(), a.end());
   return h;
 }
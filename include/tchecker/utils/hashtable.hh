@@ -13,14 +13,35 @@
  \brief Hashtable of shared objects
  */
 
+#include <atomic>
 #include <unordered_set>
 #include <vector>
 
 #include "tchecker/utils/iterator.hh"
+#include "tchecker/utils/profiling.hh"
 #include "tchecker/utils/shared_objects.hh"
 
 namespace tchecker {
 
+namespace details {
+
+/*!
+ \brief Memory footprint of all the collision tables, in bytes
+ \note Counts the tables of collision lists and the capacity of collision
+ lists, not the stored objects (which are allocated in pools, see
+ tchecker::pools_memsize)
+ */
+inline std::atomic<std::size_t> hashtables_memsize{0};
+
+} // end of namespace details
+
+/*!
+ \brief Accessor
+ \return Memory footprint of all the collision tables and hashtables, in bytes
+ \note Constant time
+ */
+inline std::size_t hashtables_memsize() { return tchecker::details::hashtables_memsize.load(std::memory_order_relaxed); }
+
 // Forward declaration
 template <class SPTR, class HASH> class collision_table_t;
 template <class SPTR, class HASH, class EQUAL> class hashtable_t;
@@ -169,6 +190,7 @@ public:
   {
     if (table_size == tchecker::COLLISION_TABLE_NOT_STORED)
       throw std::invalid_argument("Collision table size is too big");
+    tchecker::details::hashtables_memsize.fetch_add(_table.capacity() * sizeof(collision_list_t), std::memory_order_relaxed);
   }
 
   /*!
@@ -194,7 +216,17 @@ public:
   /*!
    \brief Move-assignment operator
    */
-  tchecker::collision_table_t<SPTR, HASH> & operator=(tchecker::collision_table_t<SPTR, HASH> &&) = default;
+  tchecker::collision_table_t<SPTR, HASH> & operator=(tchecker::collision_table_t<SPTR, HASH> && t)
+  {
+    if (this != &t) {
+      clear();
+      _table = std::move(t._table);
+      _hash = std::move(t._hash);
+      _size = t._size;
+      t._size = 0;
+    }
+    return *this;
+  }
 
   /*!
    \brief Clear
@@ -204,10 +236,14 @@ public:
    */
   void clear()
   {
-    for (auto & collision_list : _table)
+    std::size_t memsize = _table.capacity() * sizeof(collision_list_t);
+    for (auto & collision_list : _table) {
       clear(collision_list);
-    _table.clear();
+      memsize += collision_list.capacity() * sizeof(SPTR);
+    }
+    std::vector<collision_list_t>().swap(_table);
     _size = 0;
+    tchecker::details::hashtables_memsize.fetch_sub(memsize, std::memory_order_relaxed);
   }
 
   /*!
@@ -479,6 +515,7 @@ protected:
   */
   inline tchecker::collision_table_position_t compute_position_in_table(SPTR const & o) const
   {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_HASH);
     return static_cast<tchecker::collision_table_position_t>(_hash(o) % _table.size());
   }
 
@@ -526,7 +563,10 @@ protected:
   {
     assert(!o->is_stored());
     assert(c.size() < std::numeric_limits<tchecker::collision_table_position_t>::max());
+    std::size_t const capacity = c.capacity();
     c.push_back(o);
+    if (c.capacity() != capacity) // only count reallocations of the collision list
+      tchecker::details::hashtables_memsize.fetch_add((c.capacity() - capacity) * sizeof(SPTR), std::memory_order_relaxed);
     return static_cast<tchecker::collision_table_position_t>(c.size() - 1);
   }
 
@@ -599,6 +639,19 @@ class hashtable_object_t {};
  \note stored objects should derive from tchecker::hashtable_object_t
 */
 template <class SPTR, class HASH, class EQUAL> class hashtable_t {
+#if defined(TCHECKER_PROFILING)
+  /*!
+   \brief Type of container, with profiled hash function and equality predicate
+   */
+  using table_t = std::unordered_set<SPTR, tchecker::profiling::profiled_function_t<tchecker::profiling::PROBE_HASH, HASH>,
+                                     tchecker::profiling::profiled_function_t<tchecker::profiling::PROBE_EQUAL, EQUAL>>;
+#else
+  /*!
+   \brief Type of container
+   */
+  using table_t = std::unordered_set<SPTR, HASH, EQUAL>;
+#endif
+
 public:
   /*!
    \brief Constructor
@@ -697,7 +750,7 @@ public:
   /*!
    \brief Type of iterator
   */
-  using iterator_t = typename std::unordered_set<SPTR, HASH, EQUAL>::iterator;
+  using iterator_t = typename tchecker::hashtable_t<SPTR, HASH, EQUAL>::table_t::iterator;
 
   /*!
    \brief Iterator on first element (if any)
@@ -712,7 +765,7 @@ public:
   /*!
     \brief Type of const iterator
   */
-  using const_iterator_t = typename std::unordered_set<SPTR, HASH, EQUAL>::const_iterator;
+  using const_iterator_t = typename tchecker::hashtable_t<SPTR, HASH, EQUAL>::table_t::const_iterator;
 
   /*!
     \brief Const iterator on first element (if any)
@@ -734,7 +787,7 @@ public:
   iterator_t remove(iterator_t const & it) { return _table.erase(it); }
 
 protected:
-  std::unordered_set<SPTR, HASH, EQUAL> _table; /*!< Container */
+  typename tchecker::hashtable_t<SPTR, HASH, EQUAL>::table_t _table; /*!< Container */
 };
 
 } // end of namespace tchecker
@@ -8,9 +8,11 @@
 #ifndef TCHECKER_POOL_HH
 #define TCHECKER_POOL_HH
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
+#include "tchecker/utils/profiling.hh"
 #include "tchecker/utils/shared_objects.hh"
 
 /*!
@@ -20,6 +22,22 @@
 
 namespace tchecker {
 
+namespace details {
+
+/*!
+ \brief Memory footprint of all the pools, in bytes
+ */
+inline std::atomic<std::size_t> pools_memsize{0};
+
+} // end of namespace details
+
+/*!
+ \brief Accessor
+ \return Memory footprint of all the pools, in bytes
+ \note Constant time
+ */
+inline std::size_t pools_memsize() { return tchecker::details::pools_memsize.load(std::memory_order_relaxed); }
+
 /*!
  \class collectable_t
  \brief Data structure with object collection
@@ -148,6 +166,7 @@ public:
    */
   template <class... ARGS> tchecker::intrusive_shared_ptr_t<T> construct(ARGS &&... args)
   {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_POOL_ALLOCATE);
     void * t = allocate();
     if (t == nullptr)
       return tchecker::intrusive_shared_ptr_t<T>(nullptr);
@@ -183,13 +202,13 @@ public:
       return false;
 
     T * t = p.ptr();
+    p = nullptr; // drop the reference before the chunk is released
+
     T::destruct(t);
 
     typename T::refcount_t * chunk = reinterpret_cast<typename T::refcount_t *>(t) - 1;
     release(chunk);
 
-    p = nullptr;
-
     return true;
   }
 
@@ -202,6 +221,7 @@ public:
    */
   std::size_t collect()
   {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_POOL_COLLECT);
     std::size_t collected = 0;
     void *collected_begin = nullptr, *collected_end = nullptr;
 
@@ -293,6 +313,7 @@ public:
       p = nextblock(p);
       delete[] static_cast<char *>(tmp);
     }
+    tchecker::details::pools_memsize.fetch_sub(memsize(), std::memory_order_relaxed);
     _blocks_count = 0;
     _free_head = nullptr; // _free_head_lock access protection useless
     _block_head = nullptr;
@@ -405,6 +426,7 @@ protected:
     _raw_head = first_chunk_ptr(_raw_head);
     // count one more block
     ++_blocks_count;
+    tchecker::details::pools_memsize.fetch_add(_block_size, std::memory_order_relaxed);
   }
 
   /*!
@@ -0,0 +1,223 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_PROFILING_HH
+#define TCHECKER_PROFILING_HH
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <tchecker/config.hh>
+
+#if defined(TCHECKER_PROFILING)
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+/*!
+ \file profiling.hh
+ \brief Profiling counters and timers on hot paths
+ \note Profiling is enabled by configuring TChecker with -DTCHECKER_PROFILING=ON.
+ Otherwise, probes expand to nothing and tchecker::profiling::attributes does
+ not add any attribute
+ */
+
+namespace tchecker {
+
+namespace profiling {
+
+/*!
+ \brief Profiled functions
+ */
+enum probe_t {
+  PROBE_DBM_TIGHTEN = 0, /*!< tchecker::dbm::tighten */
+  PROBE_EXTRAPOLATION,   /*!< Zone extrapolation */
+  PROBE_VM_RUN,          /*!< tchecker::vm_t::run */
+  PROBE_HASH,            /*!< Hash functions in hash tables */
+  PROBE_EQUAL,           /*!< Equality predicates in hash tables */
+  PROBE_COVERING,        /*!< Covering checks in tchecker::graph::cover::graph_t */
+  PROBE_POOL_ALLOCATE,   /*!< Allocation from tchecker::pool_t */
+  PROBE_POOL_COLLECT,    /*!< Collection in tchecker::pool_t */
+  PROBES_COUNT,          /*!< Number of probes (not a probe) */
+};
+
+/*!
+ \brief Accessor
+ \param probe : a probe
+ \return name of probe
+ */
+char const * name(enum tchecker::profiling::probe_t probe);
+
+#if defined(TCHECKER_PROFILING)
+
+namespace details {
+
+/*!
+ \brief Number of calls for each probe
+ \note counters are updated with relaxed loads and stores rather than atomic
+ increments to keep the overhead low: concurrent updates may be lost
+ */
+inline std::atomic<std::uint64_t> calls[tchecker::profiling::PROBES_COUNT];
+
+/*!
+ \brief Number of ticks spent in each probe
+ */
+inline std::atomic<std::uint64_t> ticks[tchecker::profiling::PROBES_COUNT];
+
+/*!
+ \brief Add to a counter
+ \param counter : a counter
+ \param n : a value
+ \post n has been added to counter
+ */
+inline void add(std::atomic<std::uint64_t> & counter, std::uint64_t n)
+{
+  counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+} // end of namespace details
+
+/*!
+ \brief Read the clock
+ \return time stamp counter on x86, nanoseconds from a steady clock otherwise
+ */
+inline std::uint64_t now()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/*!
+ \class scoped_probe_t
+ \brief Counts a call to a probe and the ticks elapsed until destruction
+ */
+class scoped_probe_t {
+public:
+  /*!
+   \brief Constructor
+   \param probe : a probe
+   */
+  explicit scoped_probe_t(enum tchecker::profiling::probe_t probe) : _probe(probe), _start(tchecker::profiling::now()) {}
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  scoped_probe_t(tchecker::profiling::scoped_probe_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post the call and the elapsed ticks have been added to the counters of the probe
+   */
+  ~scoped_probe_t()
+  {
+    tchecker::profiling::details::add(tchecker::profiling::details::ticks[_probe], tchecker::profiling::now() - _start);
+    tchecker::profiling::details::add(tchecker::profiling::details::calls[_probe], 1);
+  }
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::profiling::scoped_probe_t & operator=(tchecker::profiling::scoped_probe_t const &) = delete;
+
+private:
+  enum tchecker::profiling::probe_t _probe; /*!< Probe */
+  std::uint64_t _start;                     /*!< Ticks at construction */
+};
+
+/*!
+ \brief Profile the enclosing scope
+ \param probe : a probe
+ */
+#define TCHECKER_PROFILE(probe) tchecker::profiling::scoped_probe_t tchecker_profiling_scoped_probe{probe}
+
+/*!
+ \class profiled_function_t
+ \brief Function object that profiles the calls to another function object
+ \tparam PROBE : a probe
+ \tparam F : type of function object
+ */
+template <enum tchecker::profiling::probe_t PROBE, class F> class profiled_function_t {
+public:
+  /*!
+   \brief Constructor
+   \param f : a function object
+   */
+  profiled_function_t(F const & f = F()) : _f(f) {}
+
+  /*!
+   \brief Call operator
+   \param args : arguments to f
+   \return f(args)
+   */
+  template <class... ARGS> auto operator()(ARGS &&... args) const
+  {
+    TCHECKER_PROFILE(PROBE);
+    return _f(std::forward<ARGS>(args)...);
+  }
+
+private:
+  F _f; /*!< Function object */
+};
+
+/*!
+ \brief Accessor
+ \param probe : a probe
+ \return number of calls to probe
+ */
+inline std::uint64_t calls(enum tchecker::profiling::probe_t probe)
+{
+  return tchecker::profiling::details::calls[probe].load(std::memory_order_relaxed);
+}
+
+/*!
+ \brief Accessor
+ \param probe : a probe
+ \return number of ticks spent in probe (see tchecker::profiling::now)
+ */
+inline std::uint64_t ticks(enum tchecker::profiling::probe_t probe)
+{
+  return tchecker::profiling::details::ticks[probe].load(std::memory_order_relaxed);
+}
+
+/*!
+ \brief Reset all the counters
+ */
+void reset();
+
+/*!
+ \brief Accessor
+ \param m : attributes map
+ \post for each probe with at least one call, number of calls, number of ticks,
+ and average ticks per call have been added to m. Ticks are inclusive: time
+ spent in a nested probe is also counted by the enclosing one
+ */
+void attributes(std::map<std::string, std::string> & m);
+
+#else
+
+#define TCHECKER_PROFILE(probe)
+
+inline void reset() {}
+
+inline void attributes(std::map<std::string, std::string> &) {}
+
+#endif // TCHECKER_PROFILING
+
+} // end of namespace profiling
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_PROFILING_HH
@@ -0,0 +1,255 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_RING_BUFFER_HH
+#define TCHECKER_RING_BUFFER_HH
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*!
+ \file ring_buffer.hh
+ \brief Chunked ring buffer
+ */
+
+namespace tchecker {
+
+/*!
+ \class chunked_ring_buffer_t
+ \brief Double-ended container implemented as a ring of fixed-size chunks
+ \tparam T : type of elements, should be default-constructible and
+ move-assignable
+ \tparam CHUNK_SIZE : number of elements in a chunk, should be a power of 2
+ \note Chunks are allocated when the buffer is full and are only released when
+ the buffer is destroyed: a buffer used as a queue or a stack does not allocate
+ once it has reached its maximal size. Growing the buffer moves chunk pointers,
+ and at most CHUNK_SIZE elements. Removed elements are overwritten by T{} so
+ that resources they hold are released
+ */
+template <class T, std::size_t CHUNK_SIZE = 256> class chunked_ring_buffer_t {
+  static_assert(CHUNK_SIZE > 0 && (CHUNK_SIZE & (CHUNK_SIZE - 1)) == 0, "CHUNK_SIZE must be a power of 2");
+
+public:
+  /*!
+   \brief Constructor
+   \post this buffer is empty
+   */
+  chunked_ring_buffer_t() : _mask(0), _head(0), _size(0) {}
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  chunked_ring_buffer_t(tchecker::chunked_ring_buffer_t<T, CHUNK_SIZE> const &) = delete;
+
+  /*!
+   \brief Move constructor
+   */
+  chunked_ring_buffer_t(tchecker::chunked_ring_buffer_t<T, CHUNK_SIZE> &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  ~chunked_ring_buffer_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::chunked_ring_buffer_t<T, CHUNK_SIZE> & operator=(tchecker::chunked_ring_buffer_t<T, CHUNK_SIZE> const &) = delete;
+
+  /*!
+   \brief Move-assignment operator
+   */
+  tchecker::chunked_ring_buffer_t<T, CHUNK_SIZE> & operator=(tchecker::chunked_ring_buffer_t<T, CHUNK_SIZE> &&) = default;
+
+  /*!
+   \brief Accessor
+   \return true if this buffer is empty, false otherwise
+   */
+  inline bool empty() const { return _size == 0; }
+
+  /*!
+   \brief Accessor
+   \return number of elements in this buffer
+   */
+  inline std::size_t size() const { return _size; }
+
+  /*!
+   \brief Accessor
+   \return number of elements this buffer can store without allocating
+   */
+  inline std::size_t capacity() const { return _chunks.size() * CHUNK_SIZE; }
+
+  /*!
+   \brief Accessor
+   \param i : index
+   \pre i < size() (checked by assertion)
+   \return i-th element from the front
+   */
+  inline T & operator[](std::size_t i)
+  {
+    assert(i < _size);
+    return slot(_head + i);
+  }
+
+  /*!
+   \brief Accessor
+   \pre not empty() (checked by assertion)
+   \return first element
+   */
+  inline T & front()
+  {
+    assert(!empty());
+    return slot(_head);
+  }
+
+  /*!
+   \brief Accessor
+   \pre not empty() (checked by assertion)
+   \return last element
+   */
+  inline T & back()
+  {
+    assert(!empty());
+    return slot(_head + _size - 1);
+  }
+
+  /*!
+   \brief Insert at the back
+   \param t : element
+   \post t has been inserted after the last element
+   */
+  inline void push_back(T const & t)
+  {
+    if (_size == capacity())
+      grow();
+    slot(_head + _size) = t;
+    ++_size;
+  }
+
+  /*!
+   \brief Remove first element
+   \pre not empty() (checked by assertion)
+   \post the first element has been removed
+   */
+  inline void pop_front()
+  {
+    assert(!empty());
+    slot(_head) = T{};
+    _head = (_head + 1) & _mask;
+    --_size;
+  }
+
+  /*!
+   \brief Remove last element
+   \pre not empty() (checked by assertion)
+   \post the last element has been removed
+   */
+  inline void pop_back()
+  {
+    assert(!empty());
+    slot(_head + _size - 1) = T{};
+    --_size;
+  }
+
+  /*!
+   \brief Clear
+   \post this buffer is empty. Allocated chunks are kept
+   */
+  void clear()
+  {
+    for (std::size_t i = 0; i < _size; ++i)
+      slot(_head + i) = T{};
+    _head = 0;
+    _size = 0;
+  }
+
+  /*!
+   \brief Remove elements
+   \param pred : predicate on elements
+   \post all elements that satisfy pred have been removed. The order of the
+   other elements is preserved
+   \return number of removed elements
+   \note complexity is linear in the size of the buffer
+   */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < _size; ++i) {
+      T & t = slot(_head + i);
+      if (pred(t))
+        continue;
+      if (i != j)
+        slot(_head + j) = std::move(t);
+      ++j;
+    }
+    std::size_t const removed = _size - j;
+    for (std::size_t i = j; i < _size; ++i)
+      slot(_head + i) = T{};
+    _size = j;
+    return removed;
+  }
+
+private:
+  /*!
+   \brief Accessor
+   \param pos : position in the ring
+   \return element at position pos modulo capacity()
+   */
+  inline T & slot(std::size_t pos)
+  {
+    pos &= _mask;
+    return _chunks[pos / CHUNK_SIZE][pos % CHUNK_SIZE];
+  }
+
+  /*!
+   \brief Double the capacity of this buffer
+   \post the capacity of this buffer has doubled (or is CHUNK_SIZE if the
+   buffer had no capacity), and elements are at the same indices from the front
+   */
+  void grow()
+  {
+    std::size_t const chunks_nb = _chunks.size();
+    std::size_t const new_chunks_nb = (chunks_nb == 0 ? 1 : 2 * chunks_nb);
+    std::vector<std::unique_ptr<T[]>> chunks;
+    chunks.reserve(new_chunks_nb);
+
+    // Rotate chunks so that the chunk of the first element comes first
+    std::size_t const head_chunk = _head / CHUNK_SIZE, head_offset = _head % CHUNK_SIZE;
+    for (std::size_t c = 0; c < chunks_nb; ++c)
+      chunks.push_back(std::move(_chunks[(head_chunk + c) % chunks_nb]));
+
+    // The buffer is full: the last elements before the first one in the chunk
+    // of the first element are moved to a new chunk after the others
+    if (head_offset != 0) {
+      std::unique_ptr<T[]> tail{new T[CHUNK_SIZE]};
+      for (std::size_t i = 0; i < head_offset; ++i) {
+        tail[i] = std::move(chunks[0][i]);
+        chunks[0][i] = T{};
+      }
+      chunks.push_back(std::move(tail));
+    }
+
+    while (chunks.size() < new_chunks_nb)
+      chunks.push_back(std::unique_ptr<T[]>{new T[CHUNK_SIZE]});
+
+    _chunks = std::move(chunks);
+    _mask = _chunks.size() * CHUNK_SIZE - 1;
+    _head = head_offset;
+  }
+
+  std::vector<std::unique_ptr<T[]>> _chunks; /*!< Ring of chunks */
+  std::size_t _mask;                         /*!< Mask to compute positions modulo capacity */
+  std::size_t _head;                         /*!< Position of the first element */
+  std::size_t _size;                         /*!< Number of elements */
+};
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_RING_BUFFER_HH
@@ -0,0 +1,126 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_SERIALIZATION_HH
+#define TCHECKER_SERIALIZATION_HH
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/*!
+ \file serialization.hh
+ \brief Binary serialization of values
+ \note Values are written in the native representation of the machine. Hence,
+ serialized data can only be read back on the same architecture
+ */
+
+namespace tchecker {
+
+namespace serialization {
+
+/*!
+ \brief Write a value
+ \tparam T : type of value, should be trivially copyable
+ \param os : output stream
+ \param t : a value
+ \post t has been written to os
+ */
+template <class T> void write(std::ostream & os, T const & t)
+{
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be serialized");
+  os.write(reinterpret_cast<char const *>(&t), sizeof(T));
+}
+
+/*!
+ \brief Write an array of values
+ \tparam T : type of values, should be trivially copyable
+ \param os : output stream
+ \param t : pointer to the first value
+ \param n : number of values
+ \post the n values from t have been written to os
+ */
+template <class T> void write(std::ostream & os, T const * t, std::size_t n)
+{
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be serialized");
+  os.write(reinterpret_cast<char const *>(t), static_cast<std::streamsize>(n * sizeof(T)));
+}
+
+/*!
+ \brief Write a string
+ \param os : output stream
+ \param s : a string
+ \post the length of s followed by the characters in s have been written to os
+ */
+inline void write(std::ostream & os, std::string const & s)
+{
+  tchecker::serialization::write(os, static_cast<std::uint64_t>(s.size()));
+  tchecker::serialization::write(os, s.data(), s.size());
+}
+
+/*!
+ \brief Read a value
+ \tparam T : type of value, should be trivially copyable
+ \param is : input stream
+ \return the value read from is
+ \throw std::runtime_error : if the value cannot be read from is
+ */
+template <class T> T read(std::istream & is)
+{
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be deserialized");
+  T t;
+  is.read(reinterpret_cast<char *>(&t), sizeof(T));
+  if (!is)
+    throw std::runtime_error("Unexpected end of serialized data");
+  return t;
+}
+
+/*!
+ \brief Read an array of values
+ \tparam T : type of values, should be trivially copyable
+ \param is : input stream
+ \param t : pointer to the first value
+ \param n : number of values
+ \post n values have been read from is into the array starting at t
+ \throw std::runtime_error : if n values cannot be read from is
+ */
+template <class T> void read(std::istream & is, T * t, std::size_t n)
+{
+  static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable values can be deserialized");
+  is.read(reinterpret_cast<char *>(t), static_cast<std::streamsize>(n * sizeof(T)));
+  if (!is)
+    throw std::runtime_error("Unexpected end of serialized data");
+}
+
+/*!
+ \brief Read a string
+ \param is : input stream
+ \return the string read from is (see tchecker::serialization::write)
+ \throw std::runtime_error : if a string cannot be read from is
+ */
+inline std::string read_string(std::istream & is)
+{
+  std::uint64_t const size = tchecker::serialization::read<std::uint64_t>(is);
+  std::string s;
+  while (s.size() < size) { // do not trust size for allocation
+    char buffer[4096];
+    std::size_t const n = std::min<std::uint64_t>(sizeof(buffer), size - s.size());
+    tchecker::serialization::read(is, buffer, n);
+    s.append(buffer, n);
+  }
+  return s;
+}
+
+} // end of namespace serialization
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_SERIALIZATION_HH
@@ -8,10 +8,13 @@
 #ifndef TCHECKER_CLOCKS_HH
 #define TCHECKER_CLOCKS_HH
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include <boost/container/small_vector.hpp>
+
 #include "tchecker/basictypes.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/utils/index.hh"
@@ -288,10 +291,20 @@ std::ostream & output_clock_constraints(std::ostream & os, tchecker::range_t<CLK
  */
 int lexical_cmp(tchecker::clock_constraint_t const & c1, tchecker::clock_constraint_t const & c2);
 
+/*!
+ \brief Number of clock constraints stored in a clock constraint container
+ without heap allocation
+ */
+constexpr std::size_t const CLOCK_CONSTRAINT_CONTAINER_INLINE_CAPACITY = 4;
+
 /*!
  \brief Clock constraint container
+ \note Up to CLOCK_CONSTRAINT_CONTAINER_INLINE_CAPACITY clock constraints are
+ stored inline. Hence, guards and invariants of most transitions are computed
+ without heap allocation
  */
-using clock_constraint_container_t = std::vector<tchecker::clock_constraint_t>;
+using clock_constraint_container_t =
+    boost::container::small_vector<tchecker::clock_constraint_t, tchecker::CLOCK_CONSTRAINT_CONTAINER_INLINE_CAPACITY>;
 
 /*!
  \brief Const iterator over clock constraint container
@@ -307,6 +320,13 @@ using clock_constraint_container_const_iterator_t = tchecker::clock_constraint_c
  */
 int lexical_cmp(tchecker::clock_constraint_container_t const & c1, tchecker::clock_constraint_container_t const & c2);
 
+/*!
+ \brief Hash function
+ \param c : clock constraint container
+ \return hash value for c
+ */
+std::size_t hash_value(tchecker::clock_constraint_container_t const & c);
+
 /*!
  \brief String conversion
  \param c : clock constraint container
@@ -512,10 +532,19 @@ std::ostream & output_clock_resets(std::ostream & os, tchecker::range_t<CLKRESET
  */
 int lexical_cmp(tchecker::clock_reset_t const & r1, tchecker::clock_reset_t const & r2);
 
+/*!
+ \brief Number of clock resets stored in a clock reset container without heap
+ allocation
+ */
+constexpr std::size_t const CLOCK_RESET_CONTAINER_INLINE_CAPACITY = 4;
+
 /*!
  \brief Clock reset container
+ \note Up to CLOCK_RESET_CONTAINER_INLINE_CAPACITY clock resets are stored
+ inline (see tchecker::clock_constraint_container_t)
  */
-using clock_reset_container_t = std::vector<tchecker::clock_reset_t>;
+using clock_reset_container_t =
+    boost::container::small_vector<tchecker::clock_reset_t, tchecker::CLOCK_RESET_CONTAINER_INLINE_CAPACITY>;
 
 /*!
  \brief Const iterator over clock reset container
@@ -531,6 +560,13 @@ using clock_reset_container_const_iterator_t = tchecker::clock_reset_container_t
  */
 int lexical_cmp(tchecker::clock_reset_container_t const & c1, tchecker::clock_reset_container_t const & c2);
 
+/*!
+ \brief Hash function
+ \param c : clock reset container
+ \return hash value for c
+ */
+std::size_t hash_value(tchecker::clock_reset_container_t const & c);
+
 /*!
  \brief String conversion
  \param c : clock reset container
@@ -8,8 +8,11 @@
 #ifndef TCHECKER_INTVARS_HH
 #define TCHECKER_INTVARS_HH
 
+#include <cassert>
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/utils/allocation_size.hh"
@@ -277,24 +280,173 @@ tchecker::intvars_valuation_t * intvars_valuation_allocate_and_construct(unsigne
  */
 void intvars_valuation_destruct_and_deallocate(tchecker::intvars_valuation_t * v);
 
+// Bit-packed integer variables valuations
+
+/*!
+ \class intvars_layout_t
+ \brief Layout of bit-packed integer variables valuations
+ \note Each flattened variable with domain [min,max] is stored as value - min
+ on the number of bits needed to represent max - min, in a field of a word of
+ type tchecker::integer_t. Fields do not cross word boundaries, and variables
+ with a single value take no space.
+ A packed valuation is a tchecker::intvars_valuation_t of size capacity() that
+ contains words instead of values. It should only be accessed through load()
+ and store(). All its bits should be initialized to 0 (which is the case of
+ newly constructed valuations), so that packed valuations with the same values
+ have the same words. Hence, equality and hashing of packed valuations do not
+ depend on the layout
+ */
+class intvars_layout_t {
+public:
+  /*!
+   \brief Type of words in packed valuations
+   */
+  using word_t = std::make_unsigned<tchecker::integer_t>::type;
+
+  /*!
+   \brief Constructor
+   \param intvars : flattened integer variables
+   \post this is a layout of valuations of intvars, with fields allocated in the
+   order of variable identifiers
+   \throw std::invalid_argument : if intvars has too many variables
+   */
+  explicit intvars_layout_t(tchecker::flat_integer_variables_t const & intvars);
+
+  /*!
+   \brief Accessor
+   \return number of variables
+   */
+  inline std::size_t size() const { return _fields.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of words of packed valuations
+   */
+  inline tchecker::intval_base_t::capacity_t capacity() const { return _capacity; }
+
+  /*!
+   \brief Accessor
+   \param id : variable identifier
+   \pre id < size() (checked by assertion)
+   \return number of bits of variable id
+   */
+  inline unsigned int width(tchecker::intvar_id_t id) const
+  {
+    assert(id < _fields.size());
+    return _fields[id].width;
+  }
+
+  /*!
+   \brief Accessor
+   \param id : variable identifier
+   \pre id < size() (checked by assertion)
+   \return offset in bits of variable id in packed valuations
+   */
+  inline std::size_t offset(tchecker::intvar_id_t id) const
+  {
+    assert(id < _fields.size());
+    return _fields[id].word * WORD_BITS + _fields[id].shift;
+  }
+
+  /*!
+   \brief Load the value of a variable
+   \param v : packed valuation
+   \param id : variable identifier
+   \pre v.size() == capacity() and id < size() (checked by assertion)
+   \return value of variable id in v
+   */
+  inline tchecker::integer_t load(tchecker::intvars_valuation_t const & v, tchecker::intvar_id_t id) const
+  {
+    assert(v.size() == _capacity);
+    assert(id < _fields.size());
+    field_t const & f = _fields[id];
+    word_t const bits = static_cast<word_t>(static_cast<word_t>(v[f.word]) >> f.shift) & f.mask;
+    return static_cast<tchecker::integer_t>(static_cast<word_t>(f.min + bits));
+  }
+
+  /*!
+   \brief Store the value of a variable
+   \param v : packed valuation
+   \param id : variable identifier
+   \param value : a value
+   \pre v.size() == capacity() and id < size() (checked by assertion)
+   value is in the domain of variable id (checked by assertion)
+   \post variable id has value in v
+   */
+  inline void store(tchecker::intvars_valuation_t & v, tchecker::intvar_id_t id, tchecker::integer_t value) const
+  {
+    assert(v.size() == _capacity);
+    assert(id < _fields.size());
+    field_t const & f = _fields[id];
+    word_t const bits = static_cast<word_t>(static_cast<word_t>(value) - f.min);
+    assert((bits & f.mask) == bits);
+    word_t const w = static_cast<word_t>(v[f.word]);
+    v[f.word] = static_cast<tchecker::integer_t>(
+        static_cast<word_t>(w & static_cast<word_t>(~static_cast<word_t>(f.mask << f.shift))) |
+        static_cast<word_t>(bits << f.shift));
+  }
+
+  /*!
+   \brief Pack a valuation
+   \param values : valuation with one value per variable
+   \param v : packed valuation
+   \pre values.size() == size() and v.size() == capacity() (checked by assertion)
+   values are in the domains of variables
+   \post v is the packed valuation of values
+   */
+  void pack(tchecker::intvars_valuation_t const & values, tchecker::intvars_valuation_t & v) const;
+
+  /*!
+   \brief Unpack a valuation
+   \param v : packed valuation
+   \param values : valuation with one value per variable
+   \pre v.size() == capacity() and values.size() == size() (checked by assertion)
+   \post values contains the values of variables in v
+   */
+  void unpack(tchecker::intvars_valuation_t const & v, tchecker::intvars_valuation_t & values) const;
+
+private:
+  /*!
+   \brief Number of bits in a word
+   */
+  static constexpr unsigned int WORD_BITS = 8 * sizeof(word_t);
+
+  /*!
+   \brief Field of a variable in packed valuations
+   */
+  struct field_t {
+    tchecker::intval_base_t::capacity_t word; /*!< Index of word */
+    unsigned char shift;                      /*!< Offset in word */
+    unsigned char width;                      /*!< Number of bits */
+    word_t mask;                              /*!< Mask of width bits */
+    word_t min;                               /*!< Minimal value */
+  };
+
+  std::vector<field_t> _fields;                   /*!< Map : variable ID -> field */
+  tchecker::intval_base_t::capacity_t _capacity; /*!< Number of words */
+};
+
 /*!
  \brief Output integer variables valuation
  \param os : output stream
  \param intvars_val : integer variables valuation
  \param index : an index of integer variables
+ \param layout : layout of intvars_val, nullptr if intvars_val is not packed
  \post intvars_val has been output to os with variable names from index
  \return os after output
  */
 std::ostream & output(std::ostream & os, tchecker::intvars_valuation_t const & intvars_val,
-                      tchecker::intvar_index_t const & index);
+                      tchecker::intvar_index_t const & index, tchecker::intvars_layout_t const * layout = nullptr);
 
 /*!
  \brief Write integer variables valuation to string
  \param intvars_val : integer variables valuation
  \param index : an index of integer variables
+ \param layout : layout of intvars_val, nullptr if intvars_val is not packed
  \return An std::string representation of intvars_val using variable names from index
  */
-std::string to_string(tchecker::intvars_valuation_t const & intvars_val, tchecker::intvar_index_t const & index);
+std::string to_string(tchecker::intvars_valuation_t const & intvars_val, tchecker::intvar_index_t const & index,
+                      tchecker::intvars_layout_t const * layout = nullptr);
 
 /*!
  \brief Lexical ordering on integer valuations
@@ -305,6 +457,26 @@ std::string to_string(tchecker::intvars_valuation_t const & intvars_val, tchecke
  */
 int lexical_cmp(tchecker::intvars_valuation_t const & intvars_val1, tchecker::intvars_valuation_t const & intvars_val2);
 
+/*!
+ \brief Serialization
+ \param os : output stream
+ \param intvars_val : integer variables valuation
+ \post intvars_val has been written to os in binary format
+ \return os after output
+ */
+std::ostream & serialize(std::ostream & os, tchecker::intvars_valuation_t const & intvars_val);
+
+/*!
+ \brief Deserialization
+ \param is : input stream
+ \param intvars_val : integer variables valuation
+ \post intvars_val has been read from is (see tchecker::serialize)
+ \return is after input
+ \throw std::runtime_error : if is does not contain a valuation with the same
+ size as intvars_val
+ */
+std::istream & deserialize(std::istream & is, tchecker::intvars_valuation_t & intvars_val);
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_INTVARS_HH
@@ -8,6 +8,10 @@
 #ifndef TCHECKER_VARIABLES_STATIC_ANALYSIS_HH
 #define TCHECKER_VARIABLES_STATIC_ANALYSIS_HH
 
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
+
 #include "tchecker/ta/system.hh"
 #include "tchecker/variables/access.hh"
 
@@ -25,6 +29,35 @@ namespace tchecker {
  */
 tchecker::variable_access_map_t variable_access(tchecker::ta::system_t const & system);
 
+/*!
+ \brief Compute live bounded integer variables from a system
+ \param system : a system
+ \return a vector that maps every location ID in system to the set of flattened
+ bounded integer variables that are live in this location
+ \note a variable accessed by a single process is live in a location of this
+ process if it may be read, along some path of the process from this location,
+ before it is written. Variables accessed by several processes are live in all
+ locations. Reads and writes are over-approximated and under-approximated
+ respectively (see tchecker::extract_read_variables and
+ tchecker::extract_must_written_variables)
+ */
+std::vector<boost::dynamic_bitset<>> live_intvars(tchecker::ta::system_t const & system);
+
+/*!
+ \brief Compute live clocks from a system
+ \param system : a system
+ \return a vector that maps every location ID in system to the set of flattened
+ clocks that are live in this location
+ \note a clock is live in a location if it may be read (in an invariant, a guard
+ or the right-hand side of an assignment) by the process of this location, along
+ some path of the process from this location, before the process resets it.
+ Unlike bounded integer variables, shared clocks need no special treatment: a
+ clock that is dead in every location of a tuple of locations is reset before
+ any process reads it again, hence its value is irrelevant in this tuple of
+ locations
+ */
+std::vector<boost::dynamic_bitset<>> live_clocks(tchecker::ta::system_t const & system);
+
 } // end of namespace tchecker
 
 #endif // TCHECKER_VARIABLES_STATIC_ANALYSIS_HH
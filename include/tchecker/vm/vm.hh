@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "tchecker/basictypes.hh"
+#include "tchecker/utils/profiling.hh"
 #include "tchecker/variables/clocks.hh"
 #include "tchecker/variables/intvars.hh"
 
@@ -165,6 +166,22 @@ public:
    */
   tchecker::vm_t & operator=(tchecker::vm_t &&) = default;
 
+  /*!
+   \brief Accessor
+   \return layout of valuations of bounded integer variables, nullptr if
+   valuations are not packed
+   */
+  inline tchecker::intvars_layout_t const * intvars_layout() const { return _intvars_layout; }
+
+  /*!
+   \brief Set layout of valuations of bounded integer variables
+   \param layout : a layout, nullptr if valuations are not packed
+   \post valuations passed to run() are accessed through layout if it is not
+   nullptr, and directly otherwise
+   \note this does not take ownership of layout, which should outlive this
+   */
+  inline void intvars_layout(tchecker::intvars_layout_t const * layout) { _intvars_layout = layout; }
+
   /*!
    \brief Bytecode interpreter
    \param bytecode : tchecker bytecode
@@ -172,7 +189,8 @@ public:
    \param clkconstr : container of clock constraints
    \param clkreset : container of clock resets
    \pre bytecode is null-terminated (i.e. VM_RET).
-   Variables identifiers in bytecode are less than intval.size() (checked by assertion)
+   Variables identifiers in bytecode are less than intval.size() (checked by assertion).
+   intval is packed w.r.t. intvars_layout() if it is not nullptr
    \return value computed by the last instruction in bytecode
    \post bytecode has been executed:
    intval has been updated,
@@ -190,6 +208,8 @@ public:
   {
     assert(size() == 0); // stack should be empty
 
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_VM_RUN);
+
     tchecker::integer_t eval = 0;
     _return = false;
 
@@ -305,6 +325,10 @@ protected:
       // valuation
     case VM_VALUEAT: {
       auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
+      if (_intvars_layout != nullptr) {
+        push<tchecker::integer_t>(_intvars_layout->load(intval, id));
+        return top<tchecker::integer_t>();
+      }
       assert(id < intval.size());
       push<tchecker::integer_t>(intval[id]);
       return top<tchecker::integer_t>();
@@ -314,6 +338,10 @@ protected:
     case VM_ASSIGN: {
       auto const value = top_and_pop<tchecker::integer_t>();
       auto const id = top_and_pop<tchecker::intval_base_t::capacity_t>();
+      if (_intvars_layout != nullptr) {
+        _intvars_layout->store(intval, id, value);
+        return value;
+      }
       assert(id < intval.size());
       intval[id] = value;
       return value;
@@ -597,6 +625,8 @@ protected:
   // NB: implemented as an std::vector for methods clear() and size()
 
   std::vector<frame_t> _frames;
+
+  tchecker::intvars_layout_t const * _intvars_layout = nullptr; /*!< Layout of packed valuations */
 };
 
 } // end of namespace tchecker
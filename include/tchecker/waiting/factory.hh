@@ -11,6 +11,7 @@
 #include <stdexcept>
 
 #include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/ring.hh"
 #include "tchecker/waiting/stack.hh"
 #include "tchecker/waiting/waiting.hh"
 
@@ -51,6 +52,45 @@ template <class T> tchecker::waiting::waiting_t<T> * factory(enum policy_t polic
   }
 }
 
+/*!
+ \brief Call a function on a statically-typed waiting container
+ \tparam T : type of waiting elements
+ \tparam FUN : type of function, should be callable on a reference to any of
+ tchecker::waiting::ring_queue_t<T>, tchecker::waiting::fast_remove_ring_queue_t<T>,
+ tchecker::waiting::ring_stack_t<T> and tchecker::waiting::fast_remove_ring_stack_t<T>,
+ with the same return type
+ \param policy : waiting policy
+ \param fun : function
+ \return fun(w) where w is an empty waiting container that implements policy
+ \throw std::invalid_argument : if policy is unknown
+ \note this is the static counterpart of tchecker::waiting::factory: fun can
+ instantiate algorithms on the actual type of w, hence calling methods of w
+ without virtual dispatch
+ */
+template <class T, class FUN> auto static_dispatch(enum policy_t policy, FUN && fun)
+{
+  switch (policy) {
+  case tchecker::waiting::QUEUE: {
+    tchecker::waiting::ring_queue_t<T> w;
+    return fun(w);
+  }
+  case tchecker::waiting::FAST_REMOVE_QUEUE: {
+    tchecker::waiting::fast_remove_ring_queue_t<T> w;
+    return fun(w);
+  }
+  case tchecker::waiting::STACK: {
+    tchecker::waiting::ring_stack_t<T> w;
+    return fun(w);
+  }
+  case tchecker::waiting::FAST_REMOVE_STACK: {
+    tchecker::waiting::fast_remove_ring_stack_t<T> w;
+    return fun(w);
+  }
+  default:
+    throw std::invalid_argument("Unknow waiting policy");
+  }
+}
+
 } // end of namespace waiting
 
 } // end of namespace tchecker
@@ -0,0 +1,193 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_WAITING_PRIORITY_HH
+#define TCHECKER_WAITING_PRIORITY_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file priority.hh
+ \brief Waiting priority queue (best-first)
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \class priority_queue_t
+ \brief Waiting container implementing a priority queue: elements with smallest
+ priority come first. Elements with equal priorities are ordered last-in,
+ first-out
+ \tparam T : type of waiting elements
+ \note The priority of an element is computed once, when the element is
+ inserted, from the element and its depth. The depth of an element is 1 plus
+ the depth of the last element removed from the container (0 if no element has
+ been removed yet). This matches the depth in the search tree for algorithms
+ that insert the successors of a node right after removing the node from the
+ container
+ */
+template <class T> class priority_queue_t final : public tchecker::waiting::waiting_t<T> {
+public:
+  /*!
+   \brief Type of priority functions: maps an element and its depth to a
+   priority
+   */
+  using priority_function_t = std::function<std::size_t(T const &, std::size_t)>;
+
+  /*!
+   \brief Constructor
+   \param priority : priority function
+   */
+  priority_queue_t(priority_function_t priority) : _priority(std::move(priority)), _seq(0), _depth(0), _removed(false) {}
+
+  /*!
+   \brief Destructor
+  */
+  virtual ~priority_queue_t() = default;
+
+  /*!
+   \brief Accessor
+   \return true if the container is empty, false otherwise
+   */
+  virtual inline bool empty() { return _heap.empty(); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _heap.size(); }
+
+  /*!
+   \brief Clear the container
+   \post this container is empty
+   */
+  virtual inline void clear()
+  {
+    _heap.clear();
+    _seq = 0;
+    _depth = 0;
+    _removed = false;
+  }
+
+  /*!
+   \brief Insert
+   \param t : element
+   \post t has been inserted with its priority
+   */
+  virtual void insert(T const & t)
+  {
+    std::size_t const depth = (_removed ? _depth + 1 : 0);
+    _heap.push_back(entry_t{_priority(t, depth), depth, _seq++, t});
+    std::push_heap(_heap.begin(), _heap.end(), _less);
+  }
+
+  /*!
+   \brief Remove first element
+   \pre not empty() (checked by assertion)
+   \post element with smallest priority has been removed
+   */
+  virtual void remove_first()
+  {
+    assert(!_heap.empty());
+    _depth = _heap.front().depth;
+    _removed = true;
+    std::pop_heap(_heap.begin(), _heap.end(), _less);
+    _heap.pop_back();
+  }
+
+  /*!
+   \brief Accessor
+   \pre not empty() (checked by assertion)
+   \return element with smallest priority
+   */
+  virtual inline T const & first()
+  {
+    assert(!_heap.empty());
+    return _heap.front().t;
+  }
+
+  /*!
+    \brief Remove an element
+    \param t : element
+    \post all occurrences of t have been removed from the container
+    \note complexity is linear in the size of the container
+  */
+  virtual void remove(T const & t)
+  {
+    auto it = std::remove_if(_heap.begin(), _heap.end(), [&](entry_t const & e) { return e.t == t; });
+    if (it == _heap.end())
+      return;
+    _heap.erase(it, _heap.end());
+    std::make_heap(_heap.begin(), _heap.end(), _less);
+  }
+
+  /*!
+   \brief Remove elements
+   \param pred : predicate on elements
+   \post all elements that satisfy pred have been removed from the container. The
+   order of the other elements is preserved w.r.t. priorities
+   \return number of removed elements
+   \note complexity is linear in the size of the container
+  */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    std::size_t const size = _heap.size();
+    _heap.erase(std::remove_if(_heap.begin(), _heap.end(), [&](entry_t const & e) { return pred(e.t); }), _heap.end());
+    if (_heap.size() != size)
+      std::make_heap(_heap.begin(), _heap.end(), _less);
+    return size - _heap.size();
+  }
+
+private:
+  /*!
+   \brief Entries of the heap
+   */
+  struct entry_t {
+    std::size_t priority; /*!< Priority */
+    std::size_t depth;    /*!< Depth */
+    std::size_t seq;      /*!< Insertion number */
+    T t;                  /*!< Element */
+  };
+
+  /*!
+   \brief Heap ordering: the top of the heap has smallest priority, and largest
+   insertion number among entries with smallest priority
+   */
+  static bool _less(entry_t const & e1, entry_t const & e2)
+  {
+    if (e1.priority != e2.priority)
+      return e1.priority > e2.priority;
+    return e1.seq < e2.seq;
+  }
+
+  priority_function_t _priority; /*!< Priority function */
+  std::vector<entry_t> _heap;    /*!< Heap of entries */
+  std::size_t _seq;              /*!< Next insertion number */
+  std::size_t _depth;            /*!< Depth of the last removed element */
+  bool _removed;                 /*!< Flag: has an element been removed */
+};
+
+/*!
+ \brief Waiting priority queue with fast remove
+ \tparam T : type of elements, should be a pointer to a type deriving from tchecker::waiting::element_t
+*/
+template <class T>
+using fast_remove_priority_queue_t = tchecker::waiting::fast_remove_waiting_t<tchecker::waiting::priority_queue_t<T>>;
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_PRIORITY_HH
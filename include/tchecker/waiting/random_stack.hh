@@ -0,0 +1,196 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_WAITING_RANDOM_STACK_HH
+#define TCHECKER_WAITING_RANDOM_STACK_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file random_stack.hh
+ \brief Waiting stack with random order and random restarts (random-restart
+ depth-first search)
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \class random_stack_t
+ \brief Waiting container implementing a stack where elements inserted between
+ two removals are shuffled, and where a random element is moved on top of the
+ stack every restart_period removals
+ \tparam T : type of waiting elements
+ \note Used for exploration, this container implements a depth-first search
+ that visits successors in random order and periodically restarts from a
+ random waiting element
+ */
+template <class T> class random_stack_t final : public tchecker::waiting::waiting_t<T> {
+public:
+  /*!
+   \brief Constructor
+   \param restart_period : number of removals between two restarts (0 means
+   no restart)
+   \param seed : seed of the random number generator
+   */
+  random_stack_t(std::size_t restart_period = 1000, unsigned int seed = 0)
+      : _restart_period(restart_period), _gen(seed), _fresh(0), _removals(0), _last_restart(0), _restarts(0),
+        _prepared(true)
+  {
+  }
+
+  /*!
+   \brief Destructor
+  */
+  virtual ~random_stack_t() = default;
+
+  /*!
+   \brief Accessor
+   \return true if the container is empty, false otherwise
+   */
+  virtual inline bool empty() { return _v.empty(); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _v.size(); }
+
+  /*!
+   \brief Clear the container
+   \post this container is empty
+   */
+  virtual inline void clear()
+  {
+    _v.clear();
+    _fresh = 0;
+    _prepared = true;
+  }
+
+  /*!
+   \brief Insert
+   \param t : element
+   \post t has been inserted in the stack
+   */
+  virtual inline void insert(T const & t)
+  {
+    _v.push_back(t);
+    _prepared = false;
+  }
+
+  /*!
+   \brief Remove top element
+   \pre not empty() (checked by assertion)
+   \post top element has been removed from the stack
+   */
+  virtual void remove_first()
+  {
+    prepare();
+    assert(!_v.empty());
+    _v.pop_back();
+    _fresh = std::min(_fresh, _v.size());
+    ++_removals;
+    _prepared = false;
+  }
+
+  /*!
+   \brief Accessor
+   \pre not empty() (checked by assertion)
+   \return top element of the stack
+   */
+  virtual T const & first()
+  {
+    prepare();
+    assert(!_v.empty());
+    return _v.back();
+  }
+
+  /*!
+    \brief Remove an element
+    \param t : element
+    \post all occurrences of t have been removed from the stack
+    \note complexity is linear in the size of the container
+  */
+  virtual void remove(T const & t)
+  {
+    prepare();
+    _v.erase(std::remove(_v.begin(), _v.end(), t), _v.end());
+    _fresh = _v.size();
+  }
+
+  /*!
+   \brief Remove elements
+   \param pred : predicate on elements
+   \post all elements that satisfy pred have been removed from the stack. The
+   order of the other elements is preserved
+   \return number of removed elements
+   \note complexity is linear in the size of the container
+  */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    prepare();
+    std::size_t const size = _v.size();
+    _v.erase(std::remove_if(_v.begin(), _v.end(), pred), _v.end());
+    _fresh = _v.size();
+    return size - _v.size();
+  }
+
+  /*!
+   \brief Accessor
+   \return number of restarts
+   */
+  inline std::size_t restarts() const { return _restarts; }
+
+private:
+  /*!
+   \brief Prepare the top of the stack
+   \post elements inserted since the last call have been shuffled, and if a
+   restart is due, a random element has been swapped with the top of the stack
+   */
+  void prepare()
+  {
+    if (_prepared)
+      return;
+    std::shuffle(_v.begin() + _fresh, _v.end(), _gen);
+    _fresh = _v.size();
+    if (_restart_period != 0 && _removals - _last_restart >= _restart_period && _v.size() > 1) {
+      std::uniform_int_distribution<std::size_t> dist(0, _v.size() - 1);
+      std::swap(_v[dist(_gen)], _v.back());
+      _last_restart = _removals;
+      ++_restarts;
+    }
+    _prepared = true;
+  }
+
+  std::size_t _restart_period; /*!< Number of removals between restarts */
+  std::mt19937 _gen;           /*!< Random number generator */
+  std::vector<T> _v;           /*!< Container */
+  std::size_t _fresh;          /*!< Index of the first element inserted since last preparation */
+  std::size_t _removals;       /*!< Number of removals */
+  std::size_t _last_restart;   /*!< Number of removals at last restart */
+  std::size_t _restarts;       /*!< Number of restarts */
+  bool _prepared;              /*!< Flag: top of the stack is prepared */
+};
+
+/*!
+ \brief Random waiting stack with fast remove
+ \tparam T : type of elements, should be a pointer to a type deriving from tchecker::waiting::element_t
+*/
+template <class T> using fast_remove_random_stack_t = tchecker::waiting::fast_remove_waiting_t<tchecker::waiting::random_stack_t<T>>;
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_RANDOM_STACK_HH
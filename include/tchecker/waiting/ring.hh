@@ -0,0 +1,202 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_WAITING_RING_HH
+#define TCHECKER_WAITING_RING_HH
+
+#include <cstddef>
+#include <utility>
+
+#include "tchecker/utils/ring_buffer.hh"
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \file ring.hh
+ \brief Waiting queue (fifo) and stack (lifo) over chunked ring buffers
+ \note These containers are final: algorithms that are instantiated with these
+ types as waiting containers call their methods without virtual dispatch
+ */
+
+namespace tchecker {
+
+namespace waiting {
+
+/*!
+ \class ring_queue_t
+ \brief Waiting container implementing a queue (fifo) over a chunked ring buffer
+ \tparam T : type of waiting elements, should be default-constructible
+ */
+template <class T> class ring_queue_t final : public tchecker::waiting::waiting_t<T> {
+public:
+  /*!
+   \brief Destructor
+  */
+  virtual ~ring_queue_t() = default;
+
+  /*!
+   \brief Accessor
+   \return true if the container is empty, false otherwise
+   */
+  virtual inline bool empty() { return _rb.empty(); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _rb.size(); }
+
+  /*!
+   \brief Clear the container
+   \post this container is empty
+   */
+  virtual inline void clear() { _rb.clear(); }
+
+  /*!
+   \brief Insert
+   \param t : element
+   \post t has been inserted at the end of the queue
+   */
+  virtual inline void insert(T const & t) { _rb.push_back(t); }
+
+  /*!
+   \brief Remove first element
+   \pre not empty()
+   \post first element has been removed from the queue
+   */
+  virtual inline void remove_first() { _rb.pop_front(); }
+
+  /*!
+   \brief Accessor
+   \pre not empty()
+   \return first element in the queue
+   */
+  virtual inline T const & first() { return _rb.front(); }
+
+  /*!
+    \brief Remove an element
+    \param t : element
+    \post all occurrences of t have been removed from the queue
+    \note complexity is linear in the size of the container
+  */
+  virtual void remove(T const & t)
+  {
+    _rb.remove_if([&](T const & u) { return u == t; });
+  }
+
+  /*!
+   \brief Remove elements
+   \param pred : predicate on elements
+   \post all elements that satisfy pred have been removed from the queue. The
+   order of the other elements is preserved
+   \return number of removed elements
+   \note complexity is linear in the size of the container
+  */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    return _rb.remove_if(std::forward<PRED>(pred));
+  }
+
+private:
+  tchecker::chunked_ring_buffer_t<T> _rb; /*!< Container */
+};
+
+/*!
+ \class ring_stack_t
+ \brief Waiting container implementing a stack (lifo) over a chunked ring buffer
+ \tparam T : type of waiting elements, should be default-constructible
+ */
+template <class T> class ring_stack_t final : public tchecker::waiting::waiting_t<T> {
+public:
+  /*!
+   \brief Destructor
+  */
+  virtual ~ring_stack_t() = default;
+
+  /*!
+   \brief Accessor
+   \return true if the container is empty, false otherwise
+   */
+  virtual inline bool empty() { return _rb.empty(); }
+
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _rb.size(); }
+
+  /*!
+   \brief Clear the container
+   \post this container is empty
+   */
+  virtual inline void clear() { _rb.clear(); }
+
+  /*!
+   \brief Insert
+   \param t : element
+   \post t has been inserted on top of the stack
+   */
+  virtual inline void insert(T const & t) { _rb.push_back(t); }
+
+  /*!
+   \brief Remove top element
+   \pre not empty()
+   \post top element has been removed from the stack
+   */
+  virtual inline void remove_first() { _rb.pop_back(); }
+
+  /*!
+   \brief Accessor
+   \pre not empty()
+   \return top element of the stack
+   */
+  virtual inline T const & first() { return _rb.back(); }
+
+  /*!
+    \brief Remove an element
+    \param t : element
+    \post all occurrences of t have been removed from the stack
+    \note complexity is linear in the size of the container
+  */
+  virtual void remove(T const & t)
+  {
+    _rb.remove_if([&](T const & u) { return u == t; });
+  }
+
+  /*!
+   \brief Remove elements
+   \param pred : predicate on elements
+   \post all elements that satisfy pred have been removed from the stack. The
+   order of the other elements is preserved
+   \return number of removed elements
+   \note complexity is linear in the size of the container
+  */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    return _rb.remove_if(std::forward<PRED>(pred));
+  }
+
+private:
+  tchecker::chunked_ring_buffer_t<T> _rb; /*!< Container */
+};
+
+/*!
+ \brief Ring waiting queue with fast remove
+ \tparam T : type of elements, should be a pointer to a type deriving from tchecker::waiting::element_t
+*/
+template <class T> using fast_remove_ring_queue_t = tchecker::waiting::fast_remove_waiting_t<tchecker::waiting::ring_queue_t<T>>;
+
+/*!
+ \brief Ring waiting stack with fast remove
+ \tparam T : type of elements, should be a pointer to a type deriving from tchecker::waiting::element_t
+*/
+template <class T> using fast_remove_ring_stack_t = tchecker::waiting::fast_remove_waiting_t<tchecker::waiting::ring_stack_t<T>>;
+
+} // end of namespace waiting
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_WAITING_RING_HH
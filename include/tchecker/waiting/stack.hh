@@ -8,6 +8,8 @@
 #ifndef TCHECKER_WAITING_STACK_HH
 #define TCHECKER_WAITING_STACK_HH
 
+#include <algorithm>
+#include <cstddef>
 #include <deque>
 
 #include "tchecker/waiting/waiting.hh"
@@ -39,6 +41,12 @@ public:
    */
   virtual inline bool empty() { return _dq.empty(); }
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual inline std::size_t size() { return _dq.size(); }
+
   /*!
    \brief Clear the container
    \post this container is empty
@@ -82,6 +90,21 @@ public:
     }
   }
 
+  /*!
+   \brief Remove elements
+   \param pred : predicate on elements
+   \post all elements that satisfy pred have been removed from the stack. The
+   order of the other elements is preserved
+   \return number of removed elements
+   \note complexity is linear in the size of the container
+  */
+  template <class PRED> std::size_t remove_if(PRED && pred)
+  {
+    std::size_t const size = _dq.size();
+    _dq.erase(std::remove_if(_dq.begin(), _dq.end(), pred), _dq.end());
+    return size - _dq.size();
+  }
+
 private:
   std::deque<T> _dq; /*!< Container */
 };
@@ -9,6 +9,8 @@
 #define TCHECKER_WAITING_HH
 
 #include <cassert>
+#include <cstddef>
+#include <type_traits>
 
 /*!
  \file waiting.hh
@@ -45,6 +47,12 @@ public:
    */
   virtual bool empty() = 0;
 
+  /*!
+   \brief Accessor
+   \return number of elements in the container
+   */
+  virtual std::size_t size() = 0;
+
   /*!
    \brief Clear the container
    \post this container is empty
@@ -115,21 +123,38 @@ protected:
   mutable enum tchecker::waiting::status_t _status; /*!< Waiting status */
 };
 
+/*!
+ \brief Default minimal number of tombstones before compaction of fast remove
+ waiting containers
+ */
+std::size_t const DEFAULT_COMPACTION_THRESHOLD = 1024;
+
 /*!
  \class fast_remove_waiting_t
  \brief Waiting container that simulates fast removing of elements anywhere in the
  container
  \tparam W : type of waiting container, should implement
- tchecker::waiting::waiting_t. The type of elements W::element_t should be a
- pointer to a type deriving from tchecker::waiting::element_t
+ tchecker::waiting::waiting_t, and a method remove_if(pred) that removes all
+ the elements satisfying pred and returns the number of removed elements.
+ The type of elements W::element_t should be a pointer to a type deriving from
+ tchecker::waiting::element_t
+ \note Removed elements are marked as not waiting (tombstones) and stay in the
+ underlying container until they come first. The underlying container is
+ compacted when tombstones exceed both the compaction threshold and half of
+ its elements
  */
-template <class W> class fast_remove_waiting_t : public tchecker::waiting::waiting_t<typename W::element_t> {
+template <class W> class fast_remove_waiting_t final : public tchecker::waiting::waiting_t<typename W::element_t> {
 public:
   /*!
   \brief Constructor
   \param wargs : parameters to a constructor of class W
   */
-  template <class... WARGS> fast_remove_waiting_t(WARGS &&... wargs) : _w(wargs...) {}
+  template <class... WARGS>
+  fast_remove_waiting_t(WARGS &&... wargs)
+      : _w(wargs...), _entries(0), _tombstones(0), _removed(0), _compactions(0),
+        _compaction_threshold(tchecker::waiting::DEFAULT_COMPACTION_THRESHOLD)
+  {
+  }
 
   /*!
   \brief Copy constructor
@@ -166,11 +191,23 @@ public:
     return _w.empty();
   }
 
+  /*!
+   \brief Accessor
+   \return number of waiting elements in the container
+   \note elements that have been removed with remove() are not counted
+   */
+  virtual std::size_t size() { return (_entries > _tombstones ? _entries - _tombstones : 0); }
+
   /*!
    \brief Clear the container
    \post this container is empty
   */
-  virtual void clear() { _w.clear(); }
+  virtual void clear()
+  {
+    _w.clear();
+    _entries = 0;
+    _tombstones = 0;
+  }
 
   /*!
    \brief Insert
@@ -180,6 +217,7 @@ public:
   virtual void insert(typename W::element_t const & t)
   {
     _w.insert(t);
+    ++_entries;
     t->_status = tchecker::waiting::WAITING;
   }
 
@@ -194,6 +232,7 @@ public:
     assert(!empty());
     _w.first()->_status = tchecker::waiting::NOT_WAITING;
     _w.remove_first();
+    --_entries;
   }
 
   /*!
@@ -214,14 +253,39 @@ public:
    \param t : element
    \post t is not waiting anymore
    \note t is marked but it may not be removes from the container. t will then
-   be transparently removed when first in the container.
+   be transparently removed when first in the container, or when the container
+   is compacted
   */
   virtual void remove(typename W::element_t const & t)
   {
-    t->_status = tchecker::waiting::NOT_WAITING;
+    if (t->_status == tchecker::waiting::WAITING) {
+      t->_status = tchecker::waiting::NOT_WAITING;
+      ++_tombstones;
+      ++_removed;
+    }
     remove_non_waiting_first();
+    if (_tombstones > _compaction_threshold && 2 * _tombstones > _entries)
+      compact();
   }
 
+  /*!
+   \brief Accessor
+   \return number of elements that have been removed with remove()
+   */
+  inline unsigned long removed() const { return _removed; }
+
+  /*!
+   \brief Accessor
+   \return number of compactions of the underlying container
+   */
+  inline unsigned long compactions() const { return _compactions; }
+
+  /*!
+   \brief Set compaction threshold
+   \param threshold : minimal number of tombstones before compaction
+   */
+  inline void compaction_threshold(std::size_t threshold) { _compaction_threshold = threshold; }
+
 private:
   /*!
   \brief Removes all first non-waiting elements from the container until a
@@ -238,10 +302,47 @@ private:
       if (t->_status == tchecker::waiting::WAITING)
         break;
       _w.remove_first();
+      --_entries;
+      if (_tombstones > 0)
+        --_tombstones;
     }
   }
 
-  W _w; /*!< Waiting container */
+  /*!
+   \brief Compaction
+   \post all non-waiting elements have been removed from the underlying
+   container. The order between waiting elements has been preserved
+   */
+  void compact()
+  {
+    _entries -= _w.remove_if(
+        [](typename W::element_t const & t) { return t->_status != tchecker::waiting::WAITING; });
+    _tombstones = 0;
+    ++_compactions;
+  }
+
+  W _w;                              /*!< Waiting container */
+  std::size_t _entries;              /*!< Number of elements in _w */
+  std::size_t _tombstones;           /*!< Number of non-waiting elements in _w */
+  unsigned long _removed;            /*!< Number of elements removed with remove() */
+  unsigned long _compactions;        /*!< Number of compactions of _w */
+  std::size_t _compaction_threshold; /*!< Minimal number of tombstones before compaction */
+};
+
+/*!
+ \class is_fast_remove_waiting
+ \brief Type trait: value is true if W is a fast remove waiting container
+ \tparam W : type of waiting container
+ */
+template <class W> struct is_fast_remove_waiting : std::false_type {
+};
+
+/*!
+ \class is_fast_remove_waiting
+ \brief Type trait: value is true for fast remove waiting containers
+ \tparam W : type of underlying waiting container
+ */
+template <class W> struct is_fast_remove_waiting<tchecker::waiting::fast_remove_waiting_t<W>> : std::true_type {
 };
 
 } // end of namespace waiting
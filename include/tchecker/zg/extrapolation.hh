@@ -9,8 +9,12 @@
 #define TCHECKER_ZG_EXTRAPOLATION_HH
 
 #include <memory>
+#include <vector>
+
+#include <boost/dynamic_bitset.hpp>
 
 #include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/dbm/db.hh"
 #include "tchecker/dbm/dbm.hh"
@@ -178,33 +182,40 @@ public:
 
   /*!
   \brief Copy constructor
+  \note this shares the cache of clock bounds with e
   */
-  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e);
+  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e) = default;
 
   /*!
   \brief Move constructor
   */
-  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e);
+  local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e) = default;
 
   /*!
    \brief Destructor
   */
-  virtual ~local_lu_extrapolation_t();
+  virtual ~local_lu_extrapolation_t() = default;
 
   /*!
   \brief Assignment operator
+  \note this shares the cache of clock bounds with e
   */
-  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t const & e);
+  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t const & e) = default;
 
   /*!
   \brief Move-assignment operator
   */
-  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t && e);
+  tchecker::zg::details::local_lu_extrapolation_t & operator=(tchecker::zg::details::local_lu_extrapolation_t && e) = default;
+
+  /*!
+   \brief Accessor
+   \return cache of local LU clock bounds
+   */
+  inline std::shared_ptr<tchecker::clockbounds::local_lu_cache_t> const & cache() const { return _cache; }
 
 protected:
-  tchecker::clockbounds::map_t * _l;                                          /*!< clock bounds L map */
-  tchecker::clockbounds::map_t * _u;                                          /*!< clock bounds U map */
   std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> _clock_bounds; /*!< local LU clock bounds map */
+  std::shared_ptr<tchecker::clockbounds::local_lu_cache_t> _cache;           /*!< cache of local LU clock bounds */
 };
 
 } // end of namespace details
@@ -367,32 +378,40 @@ public:
 
   /*!
   \brief Copy constructor
+  \note this shares the cache of clock bounds with e
   */
-  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e);
+  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e) = default;
 
   /*!
   \brief Move constructor
   */
-  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e);
+  local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e) = default;
 
   /*!
    \brief Destructor
   */
-  virtual ~local_m_extrapolation_t();
+  virtual ~local_m_extrapolation_t() = default;
 
   /*!
   \brief Assignment operator
+  \note this shares the cache of clock bounds with e
   */
-  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t const & e);
+  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t const & e) = default;
 
   /*!
   \brief Move-assignment operator
   */
-  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t && e);
+  tchecker::zg::details::local_m_extrapolation_t & operator=(tchecker::zg::details::local_m_extrapolation_t && e) = default;
+
+  /*!
+   \brief Accessor
+   \return cache of local M clock bounds
+   */
+  inline std::shared_ptr<tchecker::clockbounds::local_m_cache_t> const & cache() const { return _cache; }
 
 protected:
-  tchecker::clockbounds::map_t * _m;                                         /*!< clock bounds M map */
   std::shared_ptr<tchecker::clockbounds::local_m_map_t const> _clock_bounds; /*!< local M clock bounds map */
+  std::shared_ptr<tchecker::clockbounds::local_m_cache_t> _cache;           /*!< cache of local M clock bounds */
 };
 
 } // end of namespace details
@@ -445,6 +464,63 @@ public:
   virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
 };
 
+/*!
+ \class active_clocks_extrapolation_t
+ \brief Zone extrapolation that frees inactive clocks
+ \note A clock is inactive in a tuple of locations if it is dead in every
+ location of the tuple (see tchecker::live_clocks), i.e. every process resets
+ the clock before it reads it. The value of an inactive clock is irrelevant,
+ hence it is freed in the zone after extrapolation. Zones with equal constraints
+ on active clocks then coincide.
+ \note Local LU and M extrapolations already abstract clocks without local
+ bounds, which are the inactive clocks. This extrapolation reduces zone graphs
+ with global or no extrapolation.
+ */
+class active_clocks_extrapolation_t final : public tchecker::zg::extrapolation_t {
+public:
+  /*!
+   \brief Constructor
+   \param extrapolation : a zone extrapolation
+   \param live_clocks : map from location IDs to live clocks
+   \param clock_nb : number of clocks
+   \pre extrapolation is not nullptr (checked by assertion)
+   live_clocks is not nullptr (checked by assertion)
+   every set in live_clocks has size clock_nb (checked by assertion)
+   \note this keeps shared pointers on extrapolation and live_clocks
+   */
+  active_clocks_extrapolation_t(std::shared_ptr<tchecker::zg::extrapolation_t> const & extrapolation,
+                                std::shared_ptr<std::vector<boost::dynamic_bitset<>> const> const & live_clocks,
+                                tchecker::clock_id_t clock_nb);
+
+  /*!
+  \brief Destructor
+  */
+  virtual ~active_clocks_extrapolation_t() = default;
+
+  /*!
+  \brief Zone extrapolation
+  \param dbm : a dbm
+  \param dim : dimension of dbm
+  \param vloc : a tuple of locations
+  \pre dim is 1 plus the number of clocks (checked by assertion)
+  \post the underlying extrapolation has been applied to dbm, then all clocks
+  that are inactive in vloc have been freed in dbm
+ */
+  virtual void extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc);
+
+  /*!
+   \brief Accessor
+   \return number of clocks that have been freed
+   */
+  inline unsigned long freed_clocks() const { return _freed_clocks; }
+
+private:
+  std::shared_ptr<tchecker::zg::extrapolation_t> _extrapolation;                    /*!< Underlying extrapolation */
+  std::shared_ptr<std::vector<boost::dynamic_bitset<>> const> _live_clocks;        /*!< Live clocks in locations */
+  boost::dynamic_bitset<> _active;                                                 /*!< Active clocks (scratch) */
+  unsigned long _freed_clocks;                                                     /*!< Number of freed clocks */
+};
+
 /*!
  \brief Type of extrapolation
 */
@@ -485,6 +561,21 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
 tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t extrapolation_type,
                                                       tchecker::clockbounds::clockbounds_t const & clock_bounds);
 
+/*!
+ \brief Zone extrapolation factory with inactive clocks freeing
+ \param extrapolation_type : type of extrapolation
+ \param system : system of timed processes
+ \param clock_bounds : clock bounds of system
+ \return a zone extrapolation of type extrapolation_type using clock bounds from
+ clock_bounds, wrapped in a tchecker::zg::active_clocks_extrapolation_t that
+ frees the clocks that are inactive w.r.t. tchecker::live_clocks(system)
+ \note the returned extrapolation must be deallocated by the caller
+ \throw std::invalid_argument : if extrapolation_type is unknown
+ */
+tchecker::zg::extrapolation_t * active_clocks_extrapolation_factory(enum extrapolation_type_t extrapolation_type,
+                                                                    tchecker::ta::system_t const & system,
+                                                                    tchecker::clockbounds::clockbounds_t const & clock_bounds);
+
 } // end of namespace zg
 
 } // end of namespace tchecker
@@ -0,0 +1,111 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_ZG_SYMMETRY_HH
+#define TCHECKER_ZG_SYMMETRY_HH
+
+#include <cstddef>
+#include <vector>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/dbm/db.hh"
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/state.hh"
+
+/*!
+ \file symmetry.hh
+ \brief Symmetry reduction for zone graphs
+ */
+
+namespace tchecker {
+
+namespace zg {
+
+/*!
+ \class symmetry_t
+ \brief Canonicalization of zone graph states w.r.t. groups of symmetric processes
+ \note States are canonicalized by sorting the processes in each group w.r.t.
+ their location, the values of their owned bounded integer variables, and the
+ bounds on their owned clocks in the zone. The locations, owned bounded integer
+ variables and owned clocks (i.e. the rows and columns of the DBM) of the
+ processes are permuted accordingly. Symmetric states that are only
+ distinguished by constraints between clocks of distinct processes may have
+ distinct canonical forms: the reduction is sound, but not always maximal
+ */
+class symmetry_t {
+public:
+  /*!
+   \brief Constructor
+   \param system : a system of timed processes
+   \param groups : groups of symmetric processes in system
+   \pre groups have been computed from system (see tchecker::ta::symmetry_groups)
+   \note this does not keep a reference on system, but it keeps a pointer to the
+   layout of packed valuations of system (if any)
+   */
+  symmetry_t(tchecker::ta::system_t const & system, std::vector<tchecker::ta::symmetry_group_t> const & groups);
+
+  /*!
+   \brief Accessor
+   \return groups of symmetric processes
+   */
+  inline std::vector<tchecker::ta::symmetry_group_t> const & groups() const { return _groups; }
+
+  /*!
+   \brief Canonicalize a state
+   \param s : a state
+   \pre the tuple of locations, the valuation of bounded integer variables and
+   the zone in s are not shared
+   \post s has been replaced by its canonical form
+   \return true if s has been modified, false otherwise
+   */
+  bool canonicalize(tchecker::zg::state_t & s);
+
+  /*!
+   \brief Accessor
+   \return number of states that have been modified by canonicalize()
+   */
+  inline unsigned long permuted_states() const { return _permuted_states; }
+
+private:
+  /*!
+   \brief Compare processes in a state
+   \param s : a state
+   \param p1 : a process
+   \param p2 : a process in the same group as p1
+   \return true if p1 comes before p2 in the canonical order of processes
+   */
+  bool less(tchecker::zg::state_t const & s, tchecker::ta::symmetric_process_t const & p1,
+            tchecker::ta::symmetric_process_t const & p2) const;
+
+  /*!
+   \brief Accessor
+   \param intval : a valuation of bounded integer variables
+   \param id : variable identifier
+   \return value of variable id in intval
+   */
+  inline tchecker::integer_t value(tchecker::intvars_valuation_t const & intval, tchecker::intvar_id_t id) const
+  {
+    return (_intvars_layout == nullptr ? intval[id] : _intvars_layout->load(intval, id));
+  }
+
+  std::vector<tchecker::ta::symmetry_group_t> _groups; /*!< Groups of symmetric processes */
+  std::vector<std::size_t> _local_location;            /*!< Map : loc id -> index in locations of its process */
+  std::vector<std::size_t> _order;                     /*!< Permutation of a group (scratch) */
+  std::vector<tchecker::clock_id_t> _dbm_permutation;  /*!< Permutation of DBM indices (scratch) */
+  std::vector<tchecker::dbm::db_t> _dbm;               /*!< Copy of a DBM (scratch) */
+  std::vector<tchecker::loc_id_t> _vloc;               /*!< Copy of a tuple of locations (scratch) */
+  std::vector<tchecker::integer_t> _intval;            /*!< Copy of the values of a valuation (scratch) */
+  tchecker::intvars_layout_t const * _intvars_layout;  /*!< Layout of packed valuations (nullptr if not packed) */
+  unsigned long _permuted_states;                      /*!< Number of states modified by canonicalize() */
+};
+
+} // end of namespace zg
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_ZG_SYMMETRY_HH
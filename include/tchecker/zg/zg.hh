@@ -9,6 +9,7 @@
 #define TCHECKER_ZG_HH
 
 #include <cstdlib>
+#include <iostream>
 
 #include "tchecker/basictypes.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
@@ -23,6 +24,7 @@
 #include "tchecker/zg/extrapolation.hh"
 #include "tchecker/zg/semantics.hh"
 #include "tchecker/zg/state.hh"
+#include "tchecker/zg/symmetry.hh"
 #include "tchecker/zg/transition.hh"
 #include "tchecker/zg/zone.hh"
 
@@ -160,6 +162,8 @@ using outgoing_edges_value_t = tchecker::ta::outgoing_edges_value_t;
  \param semantics : a zone semantics
  \param extrapolation : an extrapolation
  \param edges : tuple of edge from vloc (range of synchronized/asynchronous edges)
+ \param intvars_reset : set to true if some dead variable has been reset (see
+ tchecker::ta::next)
  \pre the source location in edges match the locations in vloc.
  No process has more than one edge in edges.
  The pid of every process in edges is less than the size of vloc
@@ -210,7 +214,28 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
                               tchecker::zg::extrapolation_t & extrapolation,
-                              tchecker::zg::outgoing_edges_value_t const & edges);
+                              tchecker::zg::outgoing_edges_value_t const & edges, bool & intvars_reset);
+
+/*!
+ \brief Compute next state
+ \note same as tchecker::zg::next above, without reporting the reset of dead
+ variables
+ */
+inline tchecker::state_status_t next(tchecker::ta::system_t const & system,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t> const & vloc,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_intval_t> const & intval,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::zg::shared_zone_t> const & zone,
+                                     tchecker::intrusive_shared_ptr_t<tchecker::shared_vedge_t> const & vedge,
+                                     tchecker::clock_constraint_container_t & src_invariant,
+                                     tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
+                                     tchecker::clock_constraint_container_t & tgt_invariant,
+                                     tchecker::zg::semantics_t & semantics, tchecker::zg::extrapolation_t & extrapolation,
+                                     tchecker::zg::outgoing_edges_value_t const & edges)
+{
+  bool intvars_reset = false;
+  return tchecker::zg::next(system, vloc, intval, zone, vedge, src_invariant, guard, reset, tgt_invariant, semantics,
+                            extrapolation, edges, intvars_reset);
+}
 
 /*!
  \brief Compute next state and transition
@@ -220,6 +245,7 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
  \param semantics : a zone semantics
  \param extrapolation : an extrapolation
  \param v : outgoing edge value
+ \param intvars_reset : set to true if some dead variable has been reset
  \post s have been updated from v according to semantics and extrapolation, and
  t is the set of edges in v
  \return status of state s after update (see tchecker::zg::next)
@@ -228,10 +254,33 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
                                      tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
                                      tchecker::zg::extrapolation_t & extrapolation,
-                                     tchecker::zg::outgoing_edges_value_t const & v)
+                                     tchecker::zg::outgoing_edges_value_t const & v, bool & intvars_reset)
 {
   return tchecker::zg::next(system, s.vloc_ptr(), s.intval_ptr(), s.zone_ptr(), t.vedge_ptr(), t.src_invariant_container(),
-                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, extrapolation, v);
+                            t.guard_container(), t.reset_container(), t.tgt_invariant_container(), semantics, extrapolation, v,
+                            intvars_reset);
+}
+
+/*!
+ \brief Compute next state and transition
+ \param system : a system
+ \param s : state
+ \param t : transition
+ \param semantics : a zone semantics
+ \param extrapolation : an extrapolation
+ \param v : outgoing edge value
+ \post s have been updated from v according to semantics and extrapolation, and
+ t is the set of edges in v
+ \return status of state s after update (see tchecker::zg::next)
+ \throw std::invalid_argument : if s and v have incompatible size
+*/
+inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tchecker::zg::state_t & s,
+                                     tchecker::zg::transition_t & t, tchecker::zg::semantics_t & semantics,
+                                     tchecker::zg::extrapolation_t & extrapolation,
+                                     tchecker::zg::outgoing_edges_value_t const & v)
+{
+  bool intvars_reset = false;
+  return tchecker::zg::next(system, s, t, semantics, extrapolation, v, intvars_reset);
 }
 
 /*!
@@ -242,6 +291,16 @@ inline tchecker::state_status_t next(tchecker::ta::system_t const & system, tche
 */
 boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::zg::state_t const & s);
 
+/*!
+ \brief Checks if a state satisfies a set of labels
+ \param system : a system
+ \param s : a state
+ \param labels : a set of labels
+ \return true if labels is a subset of the labels on state s, false otherwise
+ */
+bool satisfies(tchecker::ta::system_t const & system, tchecker::zg::state_t const & s,
+               boost::dynamic_bitset<> const & labels);
+
 /*!
  \brief Checks is a state is a valid final state
  \param system : a system
@@ -285,6 +344,7 @@ public:
                                             tchecker::zg::initial_range_t, tchecker::zg::outgoing_edges_range_t,
                                             tchecker::zg::initial_value_t, tchecker::zg::outgoing_edges_value_t>;
   using sst_t = ts_impl_t::sst_t;
+  using sst_callback_t = ts_impl_t::sst_callback_t;
   using state_t = ts_impl_t::state_t;
   using const_state_t = ts_impl_t::const_state_t;
   using transition_t = ts_impl_t::transition_t;
@@ -301,12 +361,16 @@ public:
    \param extrapolation : a zone extrapolation
    \param block_size : number of objects allocated in a block
    \param table_size : size of hash tables
+   \param symmetry : symmetry reduction (none if nullptr)
    \note all states and transitions are pool allocated and deallocated automatically
+   \note if symmetry is not nullptr, initial and next states are canonicalized
+   w.r.t. symmetry: transitions may then lead to a permutation of the successor
+   of their source state along their tuple of edges
    */
   zg_impl_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
             std::shared_ptr<tchecker::zg::semantics_t> const & semantics,
             std::shared_ptr<tchecker::zg::extrapolation_t> const & extrapolation, std::size_t block_size,
-            std::size_t table_size);
+            std::size_t table_size, std::shared_ptr<tchecker::zg::symmetry_t> const & symmetry = nullptr);
 
   /*!
    \brief Copy constructor (deleted)
@@ -375,14 +439,32 @@ public:
   using ts_impl_t::next;
 
   /*!
-    \brief Checks if a state satisfies a set of labels
-    \param s : a state
-    \param labels : a set of labels
-    \return true if labels is not empty and labels is included in the set of
-    labels of state s, false otherwise
-    */
+   \brief Visit next states and transitions with selected status
+   \param s : state
+   \param mask : mask on next states
+   \param callback : callback on next states and transitions
+   \post callback has been called on all tuples (status, s', t) such that s -t-> s'
+   is a transition and the status of s' matches mask (i.e. status & mask != 0)
+   \note each successor is handed to callback as soon as it has been computed
+   */
+  virtual void for_each_next(tchecker::zg::const_state_sptr_t const & s, tchecker::state_status_t mask,
+                             sst_callback_t const & callback);
+
+  /*!
+   \brief Computes the set of labels of a state
+   \param s : a state
+   \return the set of labels on state s
+   */
   virtual boost::dynamic_bitset<> labels(tchecker::zg::const_state_sptr_t const & s) const;
 
+  /*!
+   \brief Checks if a state satisfies a set of labels
+   \param s : a state
+   \param labels : a set of labels
+   \return true if labels is a subset of the labels on state s, false otherwise
+   */
+  virtual bool satisfies(tchecker::zg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const;
+
   /*!
    \brief Checks if a state is a valid final state
    \param s : a state
@@ -422,6 +504,34 @@ public:
   */
   virtual void share(tchecker::zg::transition_sptr_t & t);
 
+  /*!
+   \brief Collect unused states and transitions
+   \post the memory of states and transitions that are not referenced anymore
+   (and of their components) can be reused by subsequent allocations
+  */
+  virtual void collect();
+
+  /*!
+   \brief Read a state
+   \param is : input stream
+   \return a state read from is (see tchecker::zg::serialize)
+   \throw std::runtime_error : if is does not contain a serialized state of
+   this zone graph
+   \note the components of the returned state are not shared
+   */
+  tchecker::zg::state_sptr_t deserialize_state(std::istream & is);
+
+  /*!
+   \brief Read a transition
+   \param is : input stream
+   \return a transition with the tuple of edges read from is (see
+   tchecker::serialize on tchecker::vedge_t), and empty constraints
+   \throw std::runtime_error : if is does not contain a serialized tuple of edges
+   of this zone graph
+   \note the components of the returned transition are not shared
+   */
+  tchecker::zg::transition_sptr_t deserialize_transition(std::istream & is);
+
   /*!
    \brief Accessor
    \return Pointer to underlying system of timed processes
@@ -434,10 +544,32 @@ public:
    */
   tchecker::ta::system_t const & system() const;
 
+  /*!
+   \brief Accessor
+   \return Pointer to symmetry reduction (nullptr if none)
+   */
+  std::shared_ptr<tchecker::zg::symmetry_t const> symmetry() const;
+
+  /*!
+   \brief Accessor
+   \return Pointer to zone extrapolation
+   */
+  std::shared_ptr<tchecker::zg::extrapolation_t const> extrapolation() const;
+
+  /*!
+   \brief Accessor
+   \return Number of successors computed so far where some dead bounded
+   integer variable has been reset (see tchecker::ta::next), including
+   successors that have a non-OK status due to clocks
+   */
+  unsigned long intvars_reset_successors() const;
+
 private:
   std::shared_ptr<tchecker::ta::system_t const> _system;           /*!< System of timed processes */
   std::shared_ptr<tchecker::zg::semantics_t> _semantics;           /*!< Zone semantics */
   std::shared_ptr<tchecker::zg::extrapolation_t> _extrapolation;   /*!< Zone extrapolation */
+  std::shared_ptr<tchecker::zg::symmetry_t> _symmetry;             /*!< Symmetry reduction */
+  unsigned long _intvars_reset_successors;                         /*!< Number of successors with dead variables reset */
   tchecker::zg::state_pool_allocator_t _state_allocator;           /*!< Pool allocator of states */
   tchecker::zg::transition_pool_allocator_t _transition_allocator; /*! Pool allocator of transitions */
 };
@@ -467,6 +599,44 @@ public:
    \return Underlying system of timed processes
    */
   tchecker::ta::system_t const & system() const;
+
+  /*!
+   \brief Accessor
+   \return Pointer to symmetry reduction (nullptr if none)
+   */
+  std::shared_ptr<tchecker::zg::symmetry_t const> symmetry() const;
+
+  /*!
+   \brief Accessor
+   \return Pointer to zone extrapolation
+   */
+  std::shared_ptr<tchecker::zg::extrapolation_t const> extrapolation() const;
+
+  /*!
+   \brief Accessor
+   \return Number of successors computed so far where some dead bounded
+   integer variable has been reset (see tchecker::ta::next), including
+   successors that have a non-OK status due to clocks
+   */
+  unsigned long intvars_reset_successors() const;
+
+  /*!
+   \brief Read a state
+   \param is : input stream
+   \return a state read from is (see tchecker::zg::serialize)
+   \throw std::runtime_error : if is does not contain a serialized state of
+   this zone graph
+   */
+  tchecker::zg::state_sptr_t deserialize_state(std::istream & is);
+
+  /*!
+   \brief Read a transition
+   \param is : input stream
+   \return a transition with the tuple of edges read from is
+   \throw std::runtime_error : if is does not contain a serialized tuple of edges
+   of this zone graph
+   */
+  tchecker::zg::transition_sptr_t deserialize_transition(std::istream & is);
 };
 
 /*!
@@ -495,6 +665,46 @@ public:
    \return Underlying system of timed processes
    */
   tchecker::ta::system_t const & system() const;
+
+  /*!
+   \brief Accessor
+   \return Pointer to symmetry reduction (nullptr if none)
+   */
+  std::shared_ptr<tchecker::zg::symmetry_t const> symmetry() const;
+
+  /*!
+   \brief Accessor
+   \return Pointer to zone extrapolation
+   */
+  std::shared_ptr<tchecker::zg::extrapolation_t const> extrapolation() const;
+
+  /*!
+   \brief Accessor
+   \return Number of successors computed so far where some dead bounded
+   integer variable has been reset (see tchecker::ta::next), including
+   successors that have a non-OK status due to clocks
+   */
+  unsigned long intvars_reset_successors() const;
+
+  /*!
+   \brief Read a state
+   \param is : input stream
+   \return a state read from is (see tchecker::zg::serialize)
+   \throw std::runtime_error : if is does not contain a serialized state of
+   this zone graph
+   \note the components of the returned state are shared
+   */
+  tchecker::zg::state_sptr_t deserialize_state(std::istream & is);
+
+  /*!
+   \brief Read a transition
+   \param is : input stream
+   \return a transition with the tuple of edges read from is
+   \throw std::runtime_error : if is does not contain a serialized tuple of edges
+   of this zone graph
+   \note the components of the returned transition are shared
+   */
+  tchecker::zg::transition_sptr_t deserialize_transition(std::istream & is);
 };
 
 /*!
@@ -302,6 +302,26 @@ template <class... ARGS> tchecker::zg::zone_t * zone_allocate_and_construct(tche
  */
 void zone_destruct_and_deallocate(tchecker::zg::zone_t * zone);
 
+/*!
+ \brief Serialization
+ \param os : output stream
+ \param zone : a zone
+ \post zone has been written to os in binary format
+ \return os after output
+ */
+std::ostream & serialize(std::ostream & os, tchecker::zg::zone_t const & zone);
+
+/*!
+ \brief Deserialization
+ \param is : input stream
+ \param zone : a zone
+ \post zone has been read from is (see tchecker::zg::serialize)
+ \return is after input
+ \throw std::runtime_error : if is does not contain a zone with the same
+ dimension as zone, or if the DBM read from is is not consistent and tight
+ */
+std::istream & deserialize(std::istream & is, tchecker::zg::zone_t & zone);
+
 } // end of namespace zg
 
 /*!
@@ -0,0 +1,122 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "tchecker/algorithms/checkpoint.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+/*!
+ \brief Magic string at the beginning of checkpoint files
+ */
+static char const CHECKPOINT_MAGIC[] = "TCKCKPT1";
+
+/*!
+ \brief Version of the checkpoint file format
+ */
+static std::uint32_t const CHECKPOINT_VERSION = 1;
+
+/*!
+ \brief Fingerprint of a string
+ \param s : a string
+ \return 64-bits FNV-1a hash of s
+ */
+static std::uint64_t fingerprint(std::string const & s)
+{
+  std::uint64_t h = 14695981039346656037ULL;
+  for (unsigned char c : s) {
+    h ^= c;
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/* checkpoint_t */
+
+checkpoint_t::checkpoint_t(std::string const & filename, double period, std::string const & resume_filename,
+                           std::string const & configuration)
+    : _filename(filename),
+      _period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(period))),
+      _resume_filename(resume_filename), _fingerprint(tchecker::algorithms::fingerprint(configuration)), _resumed(false),
+      _next_checkpoint(std::chrono::steady_clock::now() + _period), _ticks(0)
+{
+}
+
+void checkpoint_t::save(std::string const & algorithm, std::function<void(std::ostream &)> const & save)
+{
+  std::string const tmp_filename = _filename + ".tmp";
+  {
+    std::ofstream ofs(tmp_filename, std::ios::binary | std::ios::trunc);
+    if (!ofs)
+      throw std::runtime_error("Unable to write checkpoint file " + tmp_filename);
+    ofs.write(CHECKPOINT_MAGIC, std::strlen(CHECKPOINT_MAGIC));
+    tchecker::serialization::write(ofs, CHECKPOINT_VERSION);
+    tchecker::serialization::write(ofs, algorithm);
+    tchecker::serialization::write(ofs, _fingerprint);
+    save(ofs);
+    ofs.flush();
+    if (!ofs)
+      throw std::runtime_error("Unable to write checkpoint file " + tmp_filename);
+  }
+  if (std::rename(tmp_filename.c_str(), _filename.c_str()) != 0)
+    throw std::runtime_error("Unable to write checkpoint file " + _filename);
+  _next_checkpoint = std::chrono::steady_clock::now() + _period;
+}
+
+void checkpoint_t::load(std::string const & algorithm, std::function<void(std::istream &)> const & load)
+{
+  assert(resuming());
+  _resumed = true;
+
+  std::ifstream ifs(_resume_filename, std::ios::binary);
+  if (!ifs)
+    throw std::runtime_error("Unable to read checkpoint file " + _resume_filename);
+
+  char magic[sizeof(CHECKPOINT_MAGIC) - 1];
+  ifs.read(magic, sizeof(magic));
+  if (!ifs || std::memcmp(magic, CHECKPOINT_MAGIC, sizeof(magic)) != 0)
+    throw std::runtime_error(_resume_filename + " is not a checkpoint file");
+  if (tchecker::serialization::read<std::uint32_t>(ifs) != CHECKPOINT_VERSION)
+    throw std::runtime_error("Unsupported version of checkpoint file " + _resume_filename);
+  std::string const checkpoint_algorithm = tchecker::serialization::read_string(ifs);
+  if (checkpoint_algorithm != algorithm)
+    throw std::runtime_error("Checkpoint file " + _resume_filename + " has been produced by algorithm " +
+                             checkpoint_algorithm + ", not " + algorithm);
+  if (tchecker::serialization::read<std::uint64_t>(ifs) != _fingerprint)
+    throw std::runtime_error("Checkpoint file " + _resume_filename + " has been produced with another model or other options");
+
+  load(ifs);
+
+  if (ifs.peek() != std::char_traits<char>::eof())
+    throw std::runtime_error("Unexpected data at the end of checkpoint file " + _resume_filename);
+}
+
+/* global checkpoints */
+
+static std::shared_ptr<tchecker::algorithms::checkpoint_t> checkpoint_sptr{nullptr};
+
+namespace details {
+
+tchecker::algorithms::checkpoint_t * checkpoint = nullptr;
+
+} // end of namespace details
+
+void set_checkpoint(std::shared_ptr<tchecker::algorithms::checkpoint_t> const & checkpoint)
+{
+  tchecker::algorithms::checkpoint_sptr = checkpoint;
+  tchecker::algorithms::details::checkpoint = checkpoint.get();
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
@@ -14,7 +14,11 @@ namespace tchecker {
 namespace algorithms {
 namespace covreach {
 
-stats_t::stats_t() : _visited_states(0), _visited_transitions(0), _covered_states(0), _reachable(false) {}
+stats_t::stats_t()
+    : _visited_states(0), _visited_transitions(0), _covered_states(0), _stored_states(0), _waiting_removed(0),
+      _waiting_compactions(0), _reachable(false)
+{
+}
 
 unsigned long & stats_t::visited_states() { return _visited_states; }
 
@@ -32,6 +36,14 @@ unsigned long & stats_t::stored_states() { return _stored_states; }
 
 unsigned long stats_t::stored_states() const { return _stored_states; }
 
+unsigned long & stats_t::waiting_removed() { return _waiting_removed; }
+
+unsigned long stats_t::waiting_removed() const { return _waiting_removed; }
+
+unsigned long & stats_t::waiting_compactions() { return _waiting_compactions; }
+
+unsigned long stats_t::waiting_compactions() const { return _waiting_compactions; }
+
 bool & stats_t::reachable() { return _reachable; }
 
 bool stats_t::reachable() const { return _reachable; }
@@ -57,6 +69,14 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream << _stored_states;
   m["STORED_STATES"] = sstream.str();
 
+  sstream.str("");
+  sstream << _waiting_removed;
+  m["WAITING_REMOVED"] = sstream.str();
+
+  sstream.str("");
+  sstream << _waiting_compactions;
+  m["WAITING_COMPACTIONS"] = sstream.str();
+
   sstream.str("");
   sstream << std::boolalpha << _reachable;
   m["REACHABLE"] = sstream.str();
@@ -0,0 +1,83 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <deque>
+
+#include "tchecker/algorithms/heuristics.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+/* labels_heuristics_t */
+
+labels_heuristics_t::labels_heuristics_t(tchecker::syncprod::system_t const & system, boost::dynamic_bitset<> const & labels)
+    : _target(system.locations_count(), false), _has_target(system.processes_count(), false),
+      _infinity(system.locations_count() + 1), _processes_bound(system.processes_count() + 1)
+{
+  std::size_t const locations_count = system.locations_count();
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    if ((system.labels(loc->id()) & labels).any()) {
+      _target[loc->id()] = true;
+      _has_target[loc->pid()] = true;
+    }
+
+  // Backward breadth-first search from the locations with label l
+  std::deque<tchecker::loc_id_t> bfs;
+  for (std::size_t l = labels.find_first(); l != boost::dynamic_bitset<>::npos; l = labels.find_next(l)) {
+    std::vector<std::size_t> distance(locations_count, _infinity);
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+      if (system.labels(loc->id())[l]) {
+        distance[loc->id()] = 0;
+        bfs.push_back(loc->id());
+      }
+    while (!bfs.empty()) {
+      tchecker::loc_id_t tgt = bfs.front();
+      bfs.pop_front();
+      for (tchecker::system::edge_const_shared_ptr_t const & edge : system.incoming_edges(tgt))
+        if (distance[edge->src()] == _infinity) {
+          distance[edge->src()] = distance[tgt] + 1;
+          bfs.push_back(edge->src());
+        }
+    }
+    _distance.push_back(std::move(distance));
+  }
+}
+
+std::size_t labels_heuristics_t::distance(tchecker::vloc_t const & vloc) const
+{
+  std::size_t d = 0;
+  for (std::vector<std::size_t> const & distance : _distance) {
+    std::size_t dl = _infinity;
+    for (tchecker::loc_id_t loc : vloc)
+      dl = std::min(dl, distance[loc]);
+    d = std::max(d, dl);
+  }
+  return d;
+}
+
+std::size_t labels_heuristics_t::processes_not_in_target(tchecker::vloc_t const & vloc) const
+{
+  std::size_t count = 0;
+  for (tchecker::process_id_t pid = 0; pid < vloc.size(); ++pid)
+    if (_has_target[pid] && !_target[vloc[pid]])
+      ++count;
+  return count;
+}
+
+/* guided search orders */
+
+bool guided_search_order(std::string const & search_order)
+{
+  return (search_order == "best") || (search_order == "astar") || (search_order == "random");
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
@@ -0,0 +1,101 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cctype>
+#include <limits>
+#include <stdexcept>
+
+#include "tchecker/algorithms/memory_limit.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+std::ostream & operator<<(std::ostream & os, enum tchecker::algorithms::memory_degradation_t degradation)
+{
+  switch (degradation) {
+  case tchecker::algorithms::MEMORY_NO_DEGRADATION:
+    return os << "none";
+  case tchecker::algorithms::MEMORY_DROP_EDGES:
+    return os << "drop-edges";
+  case tchecker::algorithms::MEMORY_COLLECT:
+    return os << "collect";
+  case tchecker::algorithms::MEMORY_EXHAUSTED:
+    return os << "exhausted";
+  default:
+    throw std::invalid_argument("Unknown memory degradation");
+  }
+}
+
+/* memory_limit_t */
+
+memory_limit_t::memory_limit_t(std::size_t limit) : _limit(limit), _threshold(limit - limit / 10)
+{
+  if (_limit == 0)
+    throw std::invalid_argument("Memory limit should be positive");
+}
+
+/* parse_memory_size */
+
+std::size_t parse_memory_size(std::string const & s)
+{
+  std::size_t i = 0, size = 0;
+  while (i < s.size() && std::isdigit(static_cast<unsigned char>(s[i]))) {
+    std::size_t const digit = s[i] - '0';
+    if (size > (std::numeric_limits<std::size_t>::max() - digit) / 10)
+      throw std::invalid_argument("Memory size is too big: " + s);
+    size = 10 * size + digit;
+    ++i;
+  }
+  if (i == 0)
+    throw std::invalid_argument("Invalid memory size: " + s);
+
+  std::size_t unit = 1;
+  if (i + 1 == s.size()) {
+    switch (std::toupper(static_cast<unsigned char>(s[i]))) {
+    case 'K':
+      unit = 1UL << 10;
+      break;
+    case 'M':
+      unit = 1UL << 20;
+      break;
+    case 'G':
+      unit = 1UL << 30;
+      break;
+    default:
+      throw std::invalid_argument("Invalid memory size: " + s);
+    }
+  }
+  else if (i != s.size())
+    throw std::invalid_argument("Invalid memory size: " + s);
+
+  if (size > std::numeric_limits<std::size_t>::max() / unit)
+    throw std::invalid_argument("Memory size is too big: " + s);
+  if (size == 0)
+    throw std::invalid_argument("Memory size should be positive: " + s);
+  return size * unit;
+}
+
+/* global memory limit */
+
+static std::shared_ptr<tchecker::algorithms::memory_limit_t> memory_limit_sptr{nullptr};
+
+namespace details {
+
+tchecker::algorithms::memory_limit_t * memory_limit = nullptr;
+
+} // end of namespace details
+
+void set_memory_limit(std::shared_ptr<tchecker::algorithms::memory_limit_t> const & memory_limit)
+{
+  tchecker::algorithms::memory_limit_sptr = memory_limit;
+  tchecker::algorithms::details::memory_limit = memory_limit.get();
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
@@ -0,0 +1,88 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <fstream>
+#include <iomanip>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "tchecker/algorithms/progress.hh"
+#include "tchecker/utils/pool.hh"
+
+namespace tchecker {
+
+namespace algorithms {
+
+/* progress_t */
+
+progress_t::progress_t(std::ostream & os, enum tchecker::algorithms::progress_format_t format, double period)
+    : _os(os), _format(format),
+      _period(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(period))),
+      _start(std::chrono::steady_clock::now()), _last_report(_start), _next_report(_start + _period), _last_visited_states(0),
+      _ticks(0)
+{
+}
+
+void progress_t::report(char const * algorithm, unsigned long visited_states, unsigned long visited_transitions,
+                        std::size_t waiting, std::size_t stored_nodes, bool terminated)
+{
+  std::chrono::time_point<std::chrono::steady_clock> const now = std::chrono::steady_clock::now();
+  std::chrono::duration<double> const time = now - _start;
+  std::chrono::duration<double> const elapsed = now - _last_report;
+  unsigned long const new_states = (visited_states >= _last_visited_states ? visited_states - _last_visited_states : visited_states);
+  double const states_per_second = (elapsed.count() > 0 ? new_states / elapsed.count() : 0.0);
+
+  if (_format == tchecker::algorithms::PROGRESS_JSON)
+    _os << "{\"algorithm\":\"" << algorithm << "\",\"time\":" << time.count() << ",\"visited_states\":" << visited_states
+        << ",\"visited_transitions\":" << visited_transitions << ",\"states_per_second\":" << states_per_second
+        << ",\"waiting\":" << waiting << ",\"stored_nodes\":" << stored_nodes
+        << ",\"pool_memory\":" << tchecker::pools_memsize() << ",\"rss_kb\":" << tchecker::algorithms::current_rss()
+        << ",\"terminated\":" << (terminated ? "true" : "false") << "}" << std::endl;
+  else
+    _os << "[progress] " << algorithm << " " << std::fixed << std::setprecision(1) << time.count() << "s"
+        << (terminated ? " (terminated)" : "") << ": " << visited_states << " states (" << states_per_second
+        << " states/s), " << visited_transitions << " transitions, " << waiting << " waiting, " << stored_nodes
+        << " stored nodes, " << tchecker::pools_memsize() << " bytes in pools, RSS " << tchecker::algorithms::current_rss()
+        << " kB" << std::defaultfloat << std::endl;
+
+  _last_report = now;
+  _next_report = now + _period;
+  _last_visited_states = visited_states;
+}
+
+/* global progress reporter */
+
+static std::shared_ptr<tchecker::algorithms::progress_t> progress_sptr{nullptr};
+
+namespace details {
+
+tchecker::algorithms::progress_t * progress = nullptr;
+
+} // end of namespace details
+
+void set_progress(std::shared_ptr<tchecker::algorithms::progress_t> const & progress)
+{
+  tchecker::algorithms::progress_sptr = progress;
+  tchecker::algorithms::details::progress = progress.get();
+}
+
+long current_rss()
+{
+  std::ifstream statm("/proc/self/statm");
+  long size = 0, resident = 0;
+  if (statm >> size >> resident)
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == -1)
+    return -1;
+  return usage.ru_maxrss;
+}
+
+} // end of namespace algorithms
+
+} // end of namespace tchecker
@@ -9,11 +9,14 @@
 #include <sys/resource.h>
 
 #include "tchecker/algorithms/stats.hh"
+#include "tchecker/utils/profiling.hh"
 
 namespace tchecker {
 
 namespace algorithms {
 
+stats_t::stats_t() : _stopped(false), _memory_degradation(tchecker::algorithms::MEMORY_NO_DEGRADATION) {}
+
 void stats_t::set_start_time() { _start_time = std::chrono::steady_clock::now(); }
 
 std::chrono::time_point<std::chrono::steady_clock> stats_t::start_time() const { return _start_time; }
@@ -37,6 +40,14 @@ long stats_t::max_rss() const
   return usage.ru_maxrss;
 }
 
+bool & stats_t::stopped() { return _stopped; }
+
+bool stats_t::stopped() const { return _stopped; }
+
+enum tchecker::algorithms::memory_degradation_t & stats_t::memory_degradation() { return _memory_degradation; }
+
+enum tchecker::algorithms::memory_degradation_t stats_t::memory_degradation() const { return _memory_degradation; }
+
 void stats_t::attributes(std::map<std::string, std::string> & m) const
 {
   std::stringstream sstream;
@@ -47,6 +58,17 @@ void stats_t::attributes(std::map<std::string, std::string> & m) const
   sstream.str("");
   sstream << max_rss();
   m["MEMORY_MAX_RSS"] = sstream.str();
+
+  if (_stopped)
+    m["STOPPED"] = "true";
+
+  if (_memory_degradation != tchecker::algorithms::MEMORY_NO_DEGRADATION) {
+    sstream.str("");
+    sstream << _memory_degradation;
+    m["MEMORY_DEGRADATION"] = sstream.str();
+  }
+
+  tchecker::profiling::attributes(m);
 }
 
 } // end of namespace algorithms
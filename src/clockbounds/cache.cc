@@ -0,0 +1,109 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cassert>
+
+#include <boost/functional/hash.hpp>
+
+#include "tchecker/clockbounds/cache.hh"
+
+namespace tchecker {
+
+namespace clockbounds {
+
+namespace details {
+
+/* vloc_bounds_cache_t */
+
+vloc_bounds_cache_t::vloc_bounds_cache_t(tchecker::clock_id_t clock_nb, std::size_t maps_nb, std::size_t size)
+    : _clock_nb(clock_nb), _maps_nb(maps_nb), _mask(size - 1), _keys(size), _valid(size, false),
+      _maps(size * maps_nb, nullptr), _hits(0), _misses(0)
+{
+  assert(size > 0);
+  assert((size & (size - 1)) == 0);
+}
+
+vloc_bounds_cache_t::~vloc_bounds_cache_t()
+{
+  for (tchecker::clockbounds::map_t * m : _maps)
+    if (m != nullptr)
+      tchecker::clockbounds::deallocate_map(m);
+}
+
+void vloc_bounds_cache_t::clear() { std::fill(_valid.begin(), _valid.end(), false); }
+
+std::size_t vloc_bounds_cache_t::lookup(tchecker::vloc_t const & vloc, bool & found)
+{
+  std::size_t const entry = boost::hash_range(vloc.begin(), vloc.end()) & _mask;
+  std::vector<tchecker::loc_id_t> & key = _keys[entry];
+  found = _valid[entry] && key.size() == vloc.size() && std::equal(key.begin(), key.end(), vloc.begin());
+  if (found)
+    ++_hits;
+  else {
+    ++_misses;
+    key.assign(vloc.begin(), vloc.end());
+    _valid[entry] = true;
+    // Clock bound maps are allocated the first time the entry is used
+    for (std::size_t i = entry * _maps_nb; i < (entry + 1) * _maps_nb; ++i)
+      if (_maps[i] == nullptr)
+        _maps[i] = tchecker::clockbounds::allocate_map(_clock_nb);
+  }
+  return entry;
+}
+
+tchecker::clockbounds::map_t * vloc_bounds_cache_t::map(std::size_t entry, std::size_t i) const
+{
+  assert(entry <= _mask);
+  assert(i < _maps_nb);
+  return _maps[entry * _maps_nb + i];
+}
+
+} // end of namespace details
+
+/* local_lu_cache_t */
+
+local_lu_cache_t::local_lu_cache_t(std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds,
+                                   std::size_t size)
+    : tchecker::clockbounds::details::vloc_bounds_cache_t(clock_bounds->clock_number(), 2, size), _clock_bounds(clock_bounds)
+{
+}
+
+void local_lu_cache_t::bounds(tchecker::vloc_t const & vloc, tchecker::clockbounds::map_t const *& L,
+                              tchecker::clockbounds::map_t const *& U)
+{
+  bool found;
+  std::size_t const entry = lookup(vloc, found);
+  tchecker::clockbounds::map_t * l = map(entry, 0);
+  tchecker::clockbounds::map_t * u = map(entry, 1);
+  if (!found)
+    _clock_bounds->bounds(vloc, *l, *u);
+  L = l;
+  U = u;
+}
+
+/* local_m_cache_t */
+
+local_m_cache_t::local_m_cache_t(std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & clock_bounds,
+                                 std::size_t size)
+    : tchecker::clockbounds::details::vloc_bounds_cache_t(clock_bounds->clock_number(), 1, size), _clock_bounds(clock_bounds)
+{
+}
+
+tchecker::clockbounds::map_t const * local_m_cache_t::bounds(tchecker::vloc_t const & vloc)
+{
+  bool found;
+  std::size_t const entry = lookup(vloc, found);
+  tchecker::clockbounds::map_t * m = map(entry, 0);
+  if (!found)
+    _clock_bounds->bounds(vloc, *m);
+  return m;
+}
+
+} // end of namespace clockbounds
+
+} // end of namespace tchecker
@@ -15,6 +15,7 @@
 
 #include "tchecker/dbm/dbm.hh"
 #include "tchecker/utils/ordering.hh"
+#include "tchecker/utils/profiling.hh"
 
 namespace tchecker {
 
@@ -150,6 +151,8 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
   assert(dbm != nullptr);
   assert(dim >= 1);
 
+  TCHECKER_PROFILE(tchecker::profiling::PROBE_DBM_TIGHTEN);
+
   for (tchecker::clock_id_t k = 0; k < dim; ++k) {
     for (tchecker::clock_id_t i = 0; i < dim; ++i) {
       if ((i == k) || (DBM(i, k) == tchecker::dbm::LT_INFINITY)) // optimization
@@ -173,6 +176,8 @@ enum tchecker::dbm::status_t tighten(tchecker::dbm::db_t * dbm, tchecker::clock_
   assert(dbm != nullptr);
   assert(dim >= 1);
 
+  TCHECKER_PROFILE(tchecker::profiling::PROBE_DBM_TIGHTEN);
+
   if (DBM(x, y) == tchecker::dbm::LT_INFINITY)
     return tchecker::dbm::MAY_BE_EMPTY;
 
@@ -384,6 +389,28 @@ void open_up(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim)
   assert(tchecker::dbm::is_tight(dbm, dim));
 }
 
+void free_clock(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::clock_id_t x)
+{
+  assert(dbm != nullptr);
+  assert(dim >= 1);
+  assert(0 < x);
+  assert(x < dim);
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+  assert(tchecker::dbm::is_positive(dbm, dim));
+
+  // y - x <= y - 0 since x >= 0
+  for (tchecker::clock_id_t y = 0; y < dim; ++y) {
+    if (y == x)
+      continue;
+    DBM(x, y) = tchecker::dbm::LT_INFINITY;
+    DBM(y, x) = DBM(y, 0);
+  }
+
+  assert(tchecker::dbm::is_consistent(dbm, dim));
+  assert(tchecker::dbm::is_tight(dbm, dim));
+}
+
 enum tchecker::dbm::status_t intersection(tchecker::dbm::db_t * dbm, tchecker::dbm::db_t const * dbm1,
                                           tchecker::dbm::db_t const * dbm2, tchecker::clock_id_t dim)
 {
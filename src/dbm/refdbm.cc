@@ -706,7 +706,13 @@ std::ostream & output_matrix(std::ostream & os, tchecker::dbm::db_t const * rdbm
 
 std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * rdbm, tchecker::reference_clock_variables_t const & r)
 {
-  tchecker::clock_id_t const rdim = r.size();
+  return tchecker::refdbm::output(os, rdbm, r.size(), [&](tchecker::clock_id_t id) { return r.name(id); });
+}
+
+std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * rdbm, tchecker::clock_id_t rdim,
+                      std::function<std::string(tchecker::clock_id_t)> clock_name)
+{
+  assert(rdbm != nullptr);
   bool first = true;
 
   os << "(";
@@ -720,7 +726,7 @@ std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * rdbm, tchec
           os << " & ";
         first = false;
 
-        os << r.name(i) << "=" << r.name(j);
+        os << clock_name(i) << "=" << clock_name(j);
         tchecker::integer_t vij = tchecker::dbm::value(cij);
         if (vij > 0)
           os << "+" << tchecker::dbm::value(cij);
@@ -736,7 +742,7 @@ std::ostream & output(std::ostream & os, tchecker::dbm::db_t const * rdbm, tchec
         if (cji != tchecker::dbm::LT_INFINITY)
           os << -tchecker::dbm::value(cji) << tchecker::dbm::comparator_str(cji);
 
-        os << r.name(i) << "-" << r.name(j);
+        os << clock_name(i) << "-" << clock_name(j);
 
         if (cij != tchecker::dbm::LT_INFINITY)
           os << tchecker::dbm::comparator_str(cij) << tchecker::dbm::value(cij);
@@ -675,6 +675,8 @@ private:
       _clocks.insert(id);
     else if ((type == tchecker::EXPR_TYPE_PARAM) || (type == tchecker::EXPR_TYPE_PARAMARRAY))
       _params.insert(id);
+    else if ((type == tchecker::EXPR_TYPE_LOCALINTVAR) || (type == tchecker::EXPR_TYPE_LOCALINTARRAY))
+      return; // local variables are not part of the system variables
     else
       throw std::invalid_argument("typed expression is not well-typed");
   }
@@ -0,0 +1,545 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/dbm/refdbm.hh"
+#include "tchecker/graph/binary_certificate.hh"
+
+namespace tchecker {
+
+namespace graph {
+
+namespace binary {
+
+/*!
+ \brief Round up to a multiple
+ \param n : a number
+ \param alignment : an alignment
+ \return the smallest multiple of alignment that is greater than or equal to n
+ */
+static inline std::uint64_t align(std::uint64_t n, std::uint64_t alignment)
+{
+  return (n + alignment - 1) / alignment * alignment;
+}
+
+/*!
+ \brief Layout of node records
+ \param h : a header
+ \post the offsets and the size of node records in h have been computed from
+ the numbers of processes and integer variables, and the dimension of zones
+ */
+static void node_record_layout(tchecker::graph::binary::header_t & h)
+{
+  std::uint64_t const vloc_end = sizeof(std::uint32_t) + h.processes * sizeof(tchecker::loc_id_t);
+  std::uint64_t const intval_offset = align(vloc_end, alignof(tchecker::integer_t));
+  std::uint64_t const zone_offset = align(intval_offset + h.intvars * sizeof(tchecker::integer_t), alignof(tchecker::dbm::db_t));
+  std::uint64_t const size =
+      align(zone_offset + static_cast<std::uint64_t>(h.zone_dim) * h.zone_dim * sizeof(tchecker::dbm::db_t), 8);
+  if (size > std::numeric_limits<std::uint32_t>::max())
+    throw std::invalid_argument("Node records too big for a binary certificate");
+  h.intval_offset = static_cast<std::uint32_t>(intval_offset);
+  h.zone_offset = static_cast<std::uint32_t>(zone_offset);
+  h.node_record_size = static_cast<std::uint32_t>(size);
+}
+
+/*!
+ \brief Size of a section
+ \param h : a header
+ \param id : section identifier
+ \return the size of section id determined by h, or 0 if the size of section id
+ is not determined by h
+ */
+static std::uint64_t section_size(tchecker::graph::binary::header_t const & h, enum tchecker::graph::binary::section_id_t id)
+{
+  switch (id) {
+  case tchecker::graph::binary::SECTION_STRING_OFFSETS:
+    return (h.strings + 1) * sizeof(std::uint64_t);
+  case tchecker::graph::binary::SECTION_PROCESSES:
+    return h.processes * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_LOCATIONS:
+    return h.locations * sizeof(tchecker::graph::binary::location_t);
+  case tchecker::graph::binary::SECTION_LOCATION_LABELS_OFFSETS:
+    return (h.locations + 1) * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_LABELS:
+    return h.labels * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_EVENTS:
+    return h.events * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_EDGES:
+    return h.system_edges * sizeof(tchecker::graph::binary::system_edge_t);
+  case tchecker::graph::binary::SECTION_INTVARS:
+    return h.intvars * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_CLOCKS:
+    return h.zone_dim * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_NODES:
+    return h.nodes * h.node_record_size;
+  case tchecker::graph::binary::SECTION_OUTGOING_OFFSETS:
+    return (h.nodes + 1) * sizeof(std::uint64_t);
+  case tchecker::graph::binary::SECTION_EDGE_TARGETS:
+    return h.edges * sizeof(std::uint32_t);
+  case tchecker::graph::binary::SECTION_VEDGES:
+    return h.edges * h.processes * sizeof(tchecker::edge_id_t);
+  case tchecker::graph::binary::SECTION_EDGE_TYPES:
+    return h.edges * sizeof(std::uint8_t);
+  default:
+    return 0;
+  }
+}
+
+/* layout_t */
+
+layout_t::layout_t(std::string const & name, tchecker::ta::system_t const & system)
+    : _intvars_layout(system.intvars_layout()), _position(0)
+{
+  std::memset(&_header, 0, sizeof(_header));
+  std::memcpy(_header.magic, tchecker::graph::binary::MAGIC, sizeof(_header.magic));
+  _header.version = tchecker::graph::binary::VERSION;
+  _header.integer_size = sizeof(tchecker::integer_t);
+  _header.db_size = sizeof(tchecker::dbm::db_t);
+
+  _string_offsets.push_back(0);
+  _header.name = add_string(name);
+
+  _header.processes = static_cast<std::uint32_t>(system.processes_count());
+  for (tchecker::process_id_t pid = 0; pid < _header.processes; ++pid)
+    _processes.push_back(add_string(system.process_name(pid)));
+
+  _header.locations = static_cast<std::uint32_t>(system.locations_count());
+  _location_labels_offsets.push_back(0);
+  for (tchecker::loc_id_t id = 0; id < _header.locations; ++id) {
+    auto const & loc = system.location(id);
+    _locations.push_back({loc->pid(), add_string(loc->name())});
+    boost::dynamic_bitset<> const & labels = system.labels(id);
+    for (std::size_t l = labels.find_first(); l != boost::dynamic_bitset<>::npos; l = labels.find_next(l))
+      _location_labels.push_back(static_cast<std::uint32_t>(l));
+    _location_labels_offsets.push_back(static_cast<std::uint32_t>(_location_labels.size()));
+  }
+
+  _header.labels = static_cast<std::uint32_t>(system.labels_count());
+  for (tchecker::label_id_t id = 0; id < _header.labels; ++id)
+    _labels.push_back(add_string(system.label_name(id)));
+
+  _header.events = static_cast<std::uint32_t>(system.events_count());
+  for (tchecker::event_id_t id = 0; id < _header.events; ++id)
+    _events.push_back(add_string(system.event_name(id)));
+
+  _header.system_edges = static_cast<std::uint32_t>(system.edges_count());
+  for (tchecker::edge_id_t id = 0; id < _header.system_edges; ++id) {
+    auto const & edge = system.edge(id);
+    _system_edges.push_back({edge->pid(), edge->src(), edge->tgt(), edge->event_id()});
+  }
+
+  auto const & intvars_index = system.integer_variables().flattened().index();
+  _header.intvars = static_cast<std::uint32_t>(system.intvars_count(tchecker::VK_FLATTENED));
+  for (tchecker::intvar_id_t id = 0; id < _header.intvars; ++id)
+    _intvars.push_back(add_string(intvars_index.value(id)));
+
+  auto const & clocks_index = system.clock_variables().flattened().index();
+  _header.zone_kind = tchecker::graph::binary::ZONE_DBM;
+  _header.zone_dim = static_cast<std::uint32_t>(system.clocks_count(tchecker::VK_FLATTENED) + 1);
+  _header.refcount = 0;
+  _clocks.push_back(add_string("0"));
+  for (tchecker::clock_id_t id = 0; id < _header.zone_dim - 1; ++id)
+    _clocks.push_back(add_string(clocks_index.value(id)));
+}
+
+void layout_t::set_zone(tchecker::zg::zone_t const & zone)
+{
+  if (zone.dim() != _header.zone_dim || _header.zone_kind != tchecker::graph::binary::ZONE_DBM)
+    throw std::invalid_argument("Zone does not match the clocks of the system");
+}
+
+void layout_t::set_zone(tchecker::refzg::zone_t const & zone)
+{
+  tchecker::reference_clock_variables_t const & r = *zone.reference_clock_variables();
+  _header.zone_kind = tchecker::graph::binary::ZONE_REFDBM;
+  _header.zone_dim = static_cast<std::uint32_t>(r.size());
+  _header.refcount = static_cast<std::uint32_t>(r.refcount());
+  _clocks.clear();
+  for (tchecker::clock_id_t id = 0; id < _header.zone_dim; ++id)
+    _clocks.push_back(add_string(r.name(id)));
+}
+
+void layout_t::begin(std::ostream & os, std::uint64_t nodes, std::uint64_t edges)
+{
+  if (nodes > std::numeric_limits<std::uint32_t>::max())
+    throw std::invalid_argument("Too many nodes for a binary certificate");
+
+  _header.strings = _string_offsets.size() - 1;
+  _header.nodes = nodes;
+  _header.edges = edges;
+  tchecker::graph::binary::node_record_layout(_header);
+
+  std::uint64_t offset = align(sizeof(_header), 8);
+  for (int i = 0; i < tchecker::graph::binary::SECTIONS_COUNT; ++i) {
+    auto const id = static_cast<enum tchecker::graph::binary::section_id_t>(i);
+    std::uint64_t size = tchecker::graph::binary::section_size(_header, id);
+    if (id == tchecker::graph::binary::SECTION_STRINGS)
+      size = _strings.size();
+    else if (id == tchecker::graph::binary::SECTION_LOCATION_LABELS)
+      size = _location_labels.size() * sizeof(std::uint32_t);
+    _header.sections[id] = {offset, size};
+    offset = align(offset + size, 8);
+  }
+
+  _position = 0;
+  write(os, _header);
+
+  auto write_section = [&](enum tchecker::graph::binary::section_id_t id, void const * data) {
+    begin_section(os, id);
+    os.write(reinterpret_cast<char const *>(data), static_cast<std::streamsize>(_header.sections[id].size));
+    _position += _header.sections[id].size;
+  };
+
+  write_section(tchecker::graph::binary::SECTION_STRING_OFFSETS, _string_offsets.data());
+  write_section(tchecker::graph::binary::SECTION_STRINGS, _strings.data());
+  write_section(tchecker::graph::binary::SECTION_PROCESSES, _processes.data());
+  write_section(tchecker::graph::binary::SECTION_LOCATIONS, _locations.data());
+  write_section(tchecker::graph::binary::SECTION_LOCATION_LABELS_OFFSETS, _location_labels_offsets.data());
+  write_section(tchecker::graph::binary::SECTION_LOCATION_LABELS, _location_labels.data());
+  write_section(tchecker::graph::binary::SECTION_LABELS, _labels.data());
+  write_section(tchecker::graph::binary::SECTION_EVENTS, _events.data());
+  write_section(tchecker::graph::binary::SECTION_EDGES, _system_edges.data());
+  write_section(tchecker::graph::binary::SECTION_INTVARS, _intvars.data());
+  write_section(tchecker::graph::binary::SECTION_CLOCKS, _clocks.data());
+
+  _record.assign(_header.node_record_size, 0);
+}
+
+void layout_t::begin_section(std::ostream & os, enum tchecker::graph::binary::section_id_t id)
+{
+  pad(os, _header.sections[id].offset);
+}
+
+void layout_t::write_node(std::ostream & os, bool initial, bool final, tchecker::vloc_t const & vloc,
+                          tchecker::intvars_valuation_t const & intval, tchecker::dbm::db_t const * dbm)
+{
+  assert(vloc.size() == _header.processes);
+  assert(intval.size() == (_intvars_layout == nullptr ? _header.intvars : _intvars_layout->capacity()));
+
+  char * record = _record.data();
+  std::uint32_t const flags =
+      (initial ? tchecker::graph::binary::NODE_INITIAL : 0) | (final ? tchecker::graph::binary::NODE_FINAL : 0);
+  std::memcpy(record, &flags, sizeof(flags));
+
+  tchecker::loc_id_t * vloc_record = reinterpret_cast<tchecker::loc_id_t *>(record + sizeof(flags));
+  for (tchecker::loc_id_t id : vloc)
+    *vloc_record++ = id;
+
+  tchecker::integer_t * intval_record = reinterpret_cast<tchecker::integer_t *>(record + _header.intval_offset);
+  for (std::size_t i = 0; i < _header.intvars; ++i)
+    intval_record[i] = (_intvars_layout == nullptr ? intval[i] : _intvars_layout->load(intval, i));
+
+  std::memcpy(record + _header.zone_offset, dbm, _header.zone_dim * _header.zone_dim * sizeof(tchecker::dbm::db_t));
+
+  os.write(record, static_cast<std::streamsize>(_record.size()));
+  _position += _record.size();
+}
+
+void layout_t::write_vedge(std::ostream & os, tchecker::vedge_t const & vedge)
+{
+  assert(vedge.size() == _header.processes);
+  for (auto it = vedge.begin_array(); it != vedge.end_array(); ++it)
+    write(os, *it);
+}
+
+void layout_t::end(std::ostream & os)
+{
+  tchecker::graph::binary::section_t const & last = _header.sections[tchecker::graph::binary::SECTIONS_COUNT - 1];
+  pad(os, align(last.offset + last.size, 8));
+  os.flush();
+  if (!os)
+    throw std::runtime_error("Failed to write binary certificate");
+}
+
+std::uint32_t layout_t::add_string(std::string const & s)
+{
+  auto it = _string_ids.find(s);
+  if (it != _string_ids.end())
+    return it->second;
+  std::uint32_t const id = static_cast<std::uint32_t>(_string_offsets.size() - 1);
+  _strings.append(s);
+  _string_offsets.push_back(_strings.size());
+  _string_ids.emplace(s, id);
+  return id;
+}
+
+void layout_t::pad(std::ostream & os, std::uint64_t position)
+{
+  assert(position >= _position);
+  for (; _position < position; ++_position)
+    os.put('\0');
+}
+
+/* certificate_t */
+
+certificate_t::certificate_t(std::string const & filename) : _data(nullptr), _size(0), _header(nullptr)
+{
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Unable to open " + filename + ": " + std::strerror(errno));
+
+  struct stat st;
+  if (::fstat(fd, &st) != 0) {
+    std::string const error = std::strerror(errno);
+    ::close(fd);
+    throw std::runtime_error("Unable to read " + filename + ": " + error);
+  }
+  if (static_cast<std::size_t>(st.st_size) < sizeof(tchecker::graph::binary::header_t)) {
+    ::close(fd);
+    throw std::runtime_error(filename + " is not a binary certificate");
+  }
+
+  _size = static_cast<std::size_t>(st.st_size);
+  void * data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED)
+    throw std::runtime_error("Unable to map " + filename + ": " + std::strerror(errno));
+
+  _data = static_cast<char const *>(data);
+  _header = reinterpret_cast<tchecker::graph::binary::header_t const *>(_data);
+
+  try {
+    check();
+  }
+  catch (std::runtime_error const & e) {
+    ::munmap(const_cast<char *>(_data), _size);
+    throw std::runtime_error(filename + ": " + e.what());
+  }
+}
+
+certificate_t::~certificate_t() { ::munmap(const_cast<char *>(_data), _size); }
+
+std::string_view certificate_t::string(std::uint64_t id) const
+{
+  if (id >= _header->strings)
+    throw std::out_of_range("Invalid string identifier");
+  std::uint64_t const * offsets = section<std::uint64_t>(tchecker::graph::binary::SECTION_STRING_OFFSETS);
+  std::uint64_t const begin = offsets[id], end = offsets[id + 1];
+  if (begin > end || end > _header->sections[tchecker::graph::binary::SECTION_STRINGS].size)
+    throw std::out_of_range("Corrupted string table");
+  return std::string_view(section<char>(tchecker::graph::binary::SECTION_STRINGS) + begin, end - begin);
+}
+
+tchecker::loc_id_t const * certificate_t::vloc(std::uint64_t n) const
+{
+  return reinterpret_cast<tchecker::loc_id_t const *>(record(n) + sizeof(std::uint32_t));
+}
+
+tchecker::integer_t const * certificate_t::intval(std::uint64_t n) const
+{
+  return reinterpret_cast<tchecker::integer_t const *>(record(n) + _header->intval_offset);
+}
+
+tchecker::dbm::db_t const * certificate_t::zone(std::uint64_t n) const
+{
+  return reinterpret_cast<tchecker::dbm::db_t const *>(record(n) + _header->zone_offset);
+}
+
+std::pair<std::uint64_t, std::uint64_t> certificate_t::outgoing_edges(std::uint64_t n) const
+{
+  if (n >= _header->nodes)
+    throw std::out_of_range("Invalid node number");
+  std::uint64_t const * offsets = section<std::uint64_t>(tchecker::graph::binary::SECTION_OUTGOING_OFFSETS);
+  if (offsets[n] > offsets[n + 1] || offsets[n + 1] > _header->edges)
+    throw std::out_of_range("Corrupted outgoing edges");
+  return std::make_pair(offsets[n], offsets[n + 1]);
+}
+
+std::uint32_t certificate_t::edge_tgt(std::uint64_t e) const
+{
+  if (e >= _header->edges)
+    throw std::out_of_range("Invalid edge number");
+  return section<std::uint32_t>(tchecker::graph::binary::SECTION_EDGE_TARGETS)[e];
+}
+
+tchecker::edge_id_t const * certificate_t::vedge(std::uint64_t e) const
+{
+  if (e >= _header->edges)
+    throw std::out_of_range("Invalid edge number");
+  return section<tchecker::edge_id_t>(tchecker::graph::binary::SECTION_VEDGES) + e * _header->processes;
+}
+
+enum tchecker::graph::binary::edge_type_t certificate_t::edge_type(std::uint64_t e) const
+{
+  if (e >= _header->edges)
+    throw std::out_of_range("Invalid edge number");
+  return static_cast<enum tchecker::graph::binary::edge_type_t>(
+      section<std::uint8_t>(tchecker::graph::binary::SECTION_EDGE_TYPES)[e]);
+}
+
+void certificate_t::attributes(std::uint64_t n, std::map<std::string, std::string> & m) const
+{
+  if (initial(n))
+    m["initial"] = "true";
+  if (final(n))
+    m["final"] = "true";
+
+  tchecker::graph::binary::location_t const * locations =
+      section<tchecker::graph::binary::location_t>(tchecker::graph::binary::SECTION_LOCATIONS);
+  std::uint32_t const * labels_offsets = section<std::uint32_t>(tchecker::graph::binary::SECTION_LOCATION_LABELS_OFFSETS);
+  std::uint32_t const * location_labels = section<std::uint32_t>(tchecker::graph::binary::SECTION_LOCATION_LABELS);
+  std::uint64_t const location_labels_count =
+      _header->sections[tchecker::graph::binary::SECTION_LOCATION_LABELS].size / sizeof(std::uint32_t);
+
+  // vloc and labels
+  std::stringstream vloc_str;
+  boost::dynamic_bitset<> labels(_header->labels);
+  tchecker::loc_id_t const * v = vloc(n);
+  vloc_str << "<";
+  for (std::uint32_t pid = 0; pid < _header->processes; ++pid) {
+    if (v[pid] >= _header->locations)
+      throw std::out_of_range("Invalid location identifier");
+    if (pid > 0)
+      vloc_str << ",";
+    vloc_str << string(locations[v[pid]].name);
+    for (std::uint32_t i = labels_offsets[v[pid]]; i < labels_offsets[v[pid] + 1] && i < location_labels_count; ++i)
+      if (location_labels[i] < _header->labels)
+        labels.set(location_labels[i]);
+  }
+  vloc_str << ">";
+  m["vloc"] = vloc_str.str();
+
+  std::uint32_t const * label_names = section<std::uint32_t>(tchecker::graph::binary::SECTION_LABELS);
+  std::stringstream labels_str;
+  std::size_t const first = labels.find_first();
+  for (std::size_t i = first; i != boost::dynamic_bitset<>::npos; i = labels.find_next(i)) {
+    if (i != first)
+      labels_str << ",";
+    labels_str << string(label_names[i]);
+  }
+  m["labels"] = labels_str.str();
+
+  // intval
+  std::uint32_t const * intvar_names = section<std::uint32_t>(tchecker::graph::binary::SECTION_INTVARS);
+  tchecker::integer_t const * val = intval(n);
+  std::stringstream intval_str;
+  for (std::uint32_t id = 0; id < _header->intvars; ++id) {
+    if (id > 0)
+      intval_str << ",";
+    intval_str << string(intvar_names[id]) << "=" << val[id];
+  }
+  m["intval"] = intval_str.str();
+
+  // zone
+  std::uint32_t const * clock_names = section<std::uint32_t>(tchecker::graph::binary::SECTION_CLOCKS);
+  auto clock_name = [&](tchecker::clock_id_t id) { return std::string(string(clock_names[id])); };
+  std::stringstream zone_str;
+  if (_header->zone_kind == tchecker::graph::binary::ZONE_REFDBM)
+    tchecker::refdbm::output(zone_str, zone(n), _header->zone_dim, clock_name);
+  else
+    tchecker::dbm::output(zone_str, zone(n), _header->zone_dim, clock_name);
+  m["zone"] = zone_str.str();
+}
+
+void certificate_t::edge_attributes(std::uint64_t e, std::map<std::string, std::string> & m) const
+{
+  enum tchecker::graph::binary::edge_type_t const type = edge_type(e);
+  if (type != tchecker::graph::binary::EDGE_UNTYPED)
+    m["edge_type"] = (type == tchecker::graph::binary::EDGE_ACTUAL ? "actual" : "subsumption");
+
+  tchecker::graph::binary::system_edge_t const * edges =
+      section<tchecker::graph::binary::system_edge_t>(tchecker::graph::binary::SECTION_EDGES);
+  std::uint32_t const * process_names = section<std::uint32_t>(tchecker::graph::binary::SECTION_PROCESSES);
+  std::uint32_t const * event_names = section<std::uint32_t>(tchecker::graph::binary::SECTION_EVENTS);
+
+  std::stringstream vedge_str;
+  tchecker::edge_id_t const * v = vedge(e);
+  bool first = true;
+  vedge_str << "<";
+  for (std::uint32_t pid = 0; pid < _header->processes; ++pid) {
+    if (v[pid] == tchecker::NO_EDGE)
+      continue;
+    if (v[pid] >= _header->system_edges)
+      throw std::out_of_range("Invalid edge identifier");
+    tchecker::graph::binary::system_edge_t const & edge = edges[v[pid]];
+    if (edge.pid >= _header->processes || edge.event >= _header->events)
+      throw std::out_of_range("Corrupted edge table");
+    if (!first)
+      vedge_str << ",";
+    first = false;
+    vedge_str << string(process_names[edge.pid]) << "@" << string(event_names[edge.event]);
+  }
+  vedge_str << ">";
+  m["vedge"] = vedge_str.str();
+}
+
+char const * certificate_t::record(std::uint64_t n) const
+{
+  if (n >= _header->nodes)
+    throw std::out_of_range("Invalid node number");
+  return section<char>(tchecker::graph::binary::SECTION_NODES) + n * _header->node_record_size;
+}
+
+std::uint32_t certificate_t::flags(std::uint64_t n) const
+{
+  std::uint32_t flags;
+  std::memcpy(&flags, record(n), sizeof(flags));
+  return flags;
+}
+
+void certificate_t::check() const
+{
+  if (std::memcmp(_header->magic, tchecker::graph::binary::MAGIC, sizeof(_header->magic)) != 0)
+    throw std::runtime_error("not a binary certificate");
+  if (_header->version != tchecker::graph::binary::VERSION)
+    throw std::runtime_error("unsupported version of binary certificate");
+  if (_header->integer_size != sizeof(tchecker::integer_t) || _header->db_size != sizeof(tchecker::dbm::db_t))
+    throw std::runtime_error("binary certificate written with another integer size");
+  if (_header->zone_kind != tchecker::graph::binary::ZONE_DBM && _header->zone_kind != tchecker::graph::binary::ZONE_REFDBM)
+    throw std::runtime_error("unknown kind of zones");
+
+  if (_header->nodes > std::numeric_limits<std::uint32_t>::max() || _header->edges > _size || _header->strings > _size)
+    throw std::runtime_error("truncated binary certificate");
+
+  tchecker::graph::binary::header_t h = *_header;
+  tchecker::graph::binary::node_record_layout(h);
+  if (h.node_record_size != _header->node_record_size || h.intval_offset != _header->intval_offset ||
+      h.zone_offset != _header->zone_offset)
+    throw std::runtime_error("invalid layout of node records");
+
+  for (int i = 0; i < tchecker::graph::binary::SECTIONS_COUNT; ++i) {
+    auto const id = static_cast<enum tchecker::graph::binary::section_id_t>(i);
+    tchecker::graph::binary::section_t const & s = _header->sections[id];
+    if (s.offset % 8 != 0 || s.offset < sizeof(tchecker::graph::binary::header_t) || s.offset > _size ||
+        s.size > _size - s.offset)
+      throw std::runtime_error("truncated binary certificate");
+    if (id != tchecker::graph::binary::SECTION_STRINGS && id != tchecker::graph::binary::SECTION_LOCATION_LABELS &&
+        s.size != tchecker::graph::binary::section_size(*_header, id))
+      throw std::runtime_error("invalid section size");
+  }
+
+  std::uint64_t const * string_offsets = section<std::uint64_t>(tchecker::graph::binary::SECTION_STRING_OFFSETS);
+  if (string_offsets[_header->strings] != _header->sections[tchecker::graph::binary::SECTION_STRINGS].size)
+    throw std::runtime_error("invalid string table");
+
+  std::uint32_t const * labels_offsets = section<std::uint32_t>(tchecker::graph::binary::SECTION_LOCATION_LABELS_OFFSETS);
+  if (labels_offsets[_header->locations] * sizeof(std::uint32_t) !=
+      _header->sections[tchecker::graph::binary::SECTION_LOCATION_LABELS].size)
+    throw std::runtime_error("invalid labels of locations");
+
+  std::uint64_t const * outgoing_offsets = section<std::uint64_t>(tchecker::graph::binary::SECTION_OUTGOING_OFFSETS);
+  if (outgoing_offsets[_header->nodes] != _header->edges)
+    throw std::runtime_error("invalid edges");
+}
+
+} // end of namespace binary
+
+} // end of namespace graph
+
+} // end of namespace tchecker
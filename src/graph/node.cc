@@ -11,7 +11,11 @@
 #include <boost/container_hash/hash.hpp>
 #endif
 
+#include <cstdint>
+#include <stdexcept>
+
 #include "tchecker/graph/node.hh"
+#include "tchecker/utils/serialization.hh"
 
 namespace tchecker {
 
@@ -72,6 +76,23 @@ void attributes(tchecker::graph::node_flags_t const & n, std::map<std::string, s
     m["final"] = "true";
 }
 
+std::ostream & serialize(std::ostream & os, tchecker::graph::node_flags_t const & n)
+{
+  std::uint8_t const flags = (n.initial() ? 1 : 0) | (n.final() ? 2 : 0);
+  tchecker::serialization::write(os, flags);
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::graph::node_flags_t & n)
+{
+  std::uint8_t const flags = tchecker::serialization::read<std::uint8_t>(is);
+  if (flags > 3)
+    throw std::runtime_error("Invalid serialized node flags");
+  n.initial((flags & 1) != 0);
+  n.final((flags & 2) != 0);
+  return is;
+}
+
 /* node_zg_state_t */
 
 node_zg_state_t::node_zg_state_t(tchecker::zg::state_sptr_t const & s) : _state(s) {}
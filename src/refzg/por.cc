@@ -0,0 +1,196 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <unordered_set>
+
+#include "tchecker/expression/static_analysis.hh"
+#include "tchecker/refzg/por.hh"
+#include "tchecker/statement/static_analysis.hh"
+
+namespace tchecker {
+
+namespace refzg {
+
+/*!
+ \brief Add variables to bitsets
+ \param clocks : a set of clock identifiers
+ \param intvars : a set of bounded integer variable identifiers
+ \param clocks_bitset : a bitset of clocks
+ \param intvars_bitset : a bitset of bounded integer variables
+ \post clocks have been added to clocks_bitset, and intvars have been added to
+ intvars_bitset
+ */
+static void add_variables(std::unordered_set<tchecker::clock_id_t> const & clocks,
+                          std::unordered_set<tchecker::intvar_id_t> const & intvars, boost::dynamic_bitset<> & clocks_bitset,
+                          boost::dynamic_bitset<> & intvars_bitset)
+{
+  for (tchecker::clock_id_t id : clocks)
+    clocks_bitset[id] = 1;
+  for (tchecker::intvar_id_t id : intvars)
+    intvars_bitset[id] = 1;
+}
+
+por_t::por_t(tchecker::ta::system_t const & system, boost::dynamic_bitset<> const & labels)
+    : _edge_pid(system.edges_count()), _edge_event(system.edges_count()),
+      _read_clocks(system.edges_count(), boost::dynamic_bitset<>(system.clocks_count(tchecker::VK_FLATTENED))),
+      _written_clocks(system.edges_count(), boost::dynamic_bitset<>(system.clocks_count(tchecker::VK_FLATTENED))),
+      _read_intvars(system.edges_count(), boost::dynamic_bitset<>(system.intvars_count(tchecker::VK_FLATTENED))),
+      _written_intvars(system.edges_count(), boost::dynamic_bitset<>(system.intvars_count(tchecker::VK_FLATTENED))),
+      _ample(system.locations_count()), _uniformly_enabled(system.edges_count()), _reduced_states(0)
+{
+  std::size_t const processes_count = system.processes_count();
+  std::size_t const clocks_count = system.clocks_count(tchecker::VK_FLATTENED);
+  std::size_t const intvars_count = system.intvars_count(tchecker::VK_FLATTENED);
+
+  // Variables accessed by each edge and by each process
+  std::vector<boost::dynamic_bitset<>> process_read_clocks(processes_count, boost::dynamic_bitset<>(clocks_count));
+  std::vector<boost::dynamic_bitset<>> process_written_clocks(processes_count, boost::dynamic_bitset<>(clocks_count));
+  std::vector<boost::dynamic_bitset<>> process_read_intvars(processes_count, boost::dynamic_bitset<>(intvars_count));
+  std::vector<boost::dynamic_bitset<>> process_written_intvars(processes_count, boost::dynamic_bitset<>(intvars_count));
+
+  std::unordered_set<tchecker::clock_id_t> clocks;
+  std::unordered_set<tchecker::intvar_id_t> intvars;
+  std::unordered_set<tchecker::param_id_t> params;
+
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+    clocks.clear();
+    intvars.clear();
+    tchecker::extract_variables(system.invariant(loc->id()), clocks, intvars, params);
+    tchecker::refzg::add_variables(clocks, intvars, process_read_clocks[loc->pid()], process_read_intvars[loc->pid()]);
+  }
+
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    tchecker::edge_id_t const id = edge->id();
+    _edge_pid[id] = edge->pid();
+    _edge_event[id] = edge->event_id();
+
+    clocks.clear();
+    intvars.clear();
+    tchecker::extract_variables(system.guard(id), clocks, intvars, params);
+    tchecker::extract_variables(system.invariant(edge->src()), clocks, intvars, params);
+    tchecker::extract_variables(system.invariant(edge->tgt()), clocks, intvars, params);
+    tchecker::extract_read_variables(system.statement(id), clocks, intvars, params);
+    tchecker::refzg::add_variables(clocks, intvars, _read_clocks[id], _read_intvars[id]);
+
+    clocks.clear();
+    intvars.clear();
+    tchecker::extract_written_variables(system.statement(id), clocks, intvars, params);
+    tchecker::refzg::add_variables(clocks, intvars, _written_clocks[id], _written_intvars[id]);
+
+    process_read_clocks[edge->pid()] |= _read_clocks[id];
+    process_written_clocks[edge->pid()] |= _written_clocks[id];
+    process_read_intvars[edge->pid()] |= _read_intvars[id];
+    process_written_intvars[edge->pid()] |= _written_intvars[id];
+
+    // Uniformly enabled: clocks are neither checked by the guard nor read by
+    // the statement, and the clocks in the target invariant are always reset
+    clocks.clear();
+    intvars.clear();
+    tchecker::extract_variables(system.guard(id), clocks, intvars, params);
+    tchecker::extract_read_variables(system.statement(id), clocks, intvars, params);
+    if (!clocks.empty())
+      continue;
+    std::unordered_set<tchecker::clock_id_t> invariant_clocks, reset_clocks;
+    tchecker::extract_variables(system.invariant(edge->tgt()), invariant_clocks, intvars, params);
+    tchecker::extract_must_written_variables(system.statement(id), reset_clocks, intvars, params);
+    bool reset = true;
+    for (tchecker::clock_id_t x : invariant_clocks)
+      reset = reset && (reset_clocks.find(x) != reset_clocks.end());
+    _uniformly_enabled[id] = reset;
+  }
+
+  // Synchronized (pid, event) pairs
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    for (tchecker::system::sync_constraint_t const & c1 : sync.synchronization_constraints())
+      for (tchecker::system::sync_constraint_t const & c2 : sync.synchronization_constraints())
+        if (c1.pid() != c2.pid())
+          _couplings.insert(std::make_tuple(c1.pid(), c1.event_id(), c2.pid(), c2.event_id()));
+
+  // Candidate ample locations: conditions (1), (2) and (3), and some uniformly
+  // enabled outgoing edge
+  boost::dynamic_bitset<> searched_labels{labels};
+  searched_labels.resize(system.labels_count());
+
+  boost::dynamic_bitset<> candidates(system.locations_count());
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+    tchecker::process_id_t const pid = loc->pid();
+    if (system.is_committed(loc->id()) || system.is_urgent(loc->id()))
+      continue;
+
+    boost::dynamic_bitset<> others_read_clocks(clocks_count), others_written_clocks(clocks_count);
+    boost::dynamic_bitset<> others_read_intvars(intvars_count), others_written_intvars(intvars_count);
+    for (tchecker::process_id_t other = 0; other < processes_count; ++other) {
+      if (other == pid)
+        continue;
+      others_read_clocks |= process_read_clocks[other];
+      others_written_clocks |= process_written_clocks[other];
+      others_read_intvars |= process_read_intvars[other];
+      others_written_intvars |= process_written_intvars[other];
+    }
+
+    boost::dynamic_bitset<> const loc_labels = system.labels(loc->id()) & searched_labels;
+    bool candidate = false;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.outgoing_edges(loc->id())) {
+      tchecker::edge_id_t const id = edge->id();
+      if (!system.is_asynchronous(*edge) || system.is_committed(edge->tgt()) || system.is_urgent(edge->tgt()) ||
+          (system.labels(edge->tgt()) & searched_labels) != loc_labels ||
+          tchecker::refzg::por_t::conflict(_read_clocks[id], _written_clocks[id], others_read_clocks, others_written_clocks) ||
+          tchecker::refzg::por_t::conflict(_read_intvars[id], _written_intvars[id], others_read_intvars,
+                                           others_written_intvars)) {
+        candidate = false;
+        break;
+      }
+      candidate = candidate || _uniformly_enabled[id];
+    }
+    candidates[loc->id()] = candidate;
+  }
+
+  // Condition (4): ample locations are the candidates that do not belong to a
+  // cycle of candidates
+  std::vector<tchecker::loc_id_t> waiting;
+  boost::dynamic_bitset<> visited(system.locations_count());
+  for (std::size_t l = candidates.find_first(); l != boost::dynamic_bitset<>::npos; l = candidates.find_next(l)) {
+    visited.reset();
+    waiting.assign(1, l);
+    bool cycle = false;
+    while (!waiting.empty() && !cycle) {
+      tchecker::loc_id_t const current = waiting.back();
+      waiting.pop_back();
+      for (tchecker::system::edge_const_shared_ptr_t const & edge : system.outgoing_edges(current)) {
+        if (edge->tgt() == l) {
+          cycle = true;
+          break;
+        }
+        if (candidates[edge->tgt()] && !visited[edge->tgt()]) {
+          visited[edge->tgt()] = 1;
+          waiting.push_back(edge->tgt());
+        }
+      }
+    }
+    _ample[l] = !cycle;
+  }
+}
+
+bool por_t::independent(tchecker::edge_id_t e1, tchecker::edge_id_t e2) const
+{
+  if (_edge_pid[e1] == _edge_pid[e2])
+    return false;
+  if (_couplings.find(std::make_tuple(_edge_pid[e1], _edge_event[e1], _edge_pid[e2], _edge_event[e2])) != _couplings.end())
+    return false;
+  return !tchecker::refzg::por_t::conflict(_read_clocks[e1], _written_clocks[e1], _read_clocks[e2], _written_clocks[e2]) &&
+         !tchecker::refzg::por_t::conflict(_read_intvars[e1], _written_intvars[e1], _read_intvars[e2], _written_intvars[e2]);
+}
+
+bool por_t::conflict(boost::dynamic_bitset<> const & r1, boost::dynamic_bitset<> const & w1, boost::dynamic_bitset<> const & r2,
+                     boost::dynamic_bitset<> const & w2)
+{
+  return w1.intersects(r2) || w1.intersects(w2) || r1.intersects(w2);
+}
+
+} // end of namespace refzg
+
+} // end of namespace tchecker
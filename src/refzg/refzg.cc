@@ -6,6 +6,7 @@
  */
 
 #include <memory>
+#include <stdexcept>
 
 #include <boost/dynamic_bitset.hpp>
 
@@ -34,7 +35,8 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
 
   std::shared_ptr<tchecker::reference_clock_variables_t const> r = zone->reference_clock_variables();
 
-  boost::dynamic_bitset<> delay_allowed = tchecker::ta::delay_allowed(system, *r, *vloc);
+  boost::dynamic_bitset<> scratch;
+  boost::dynamic_bitset<> const & delay_allowed = tchecker::ta::delay_allowed(system, *r, *vloc, scratch);
 
   tchecker::dbm::db_t * rdbm = zone->dbm();
 
@@ -49,18 +51,22 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::refzg::semantics_t & semantics,
-                              tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & edges)
+                              tchecker::integer_t spread, tchecker::refzg::outgoing_edges_value_t const & edges,
+                              bool & intvars_reset)
 {
   std::shared_ptr<tchecker::reference_clock_variables_t const> r = zone->reference_clock_variables();
 
+  // vloc is updated in place by tchecker::ta::next below: src_delay_allowed
+  // must not refer to vloc's memoized attributes
   boost::dynamic_bitset<> const src_delay_allowed = tchecker::ta::delay_allowed(system, *r, *vloc);
 
   tchecker::state_status_t status =
-      tchecker::ta::next(system, vloc, intval, vedge, src_invariant, guard, reset, tgt_invariant, edges);
+      tchecker::ta::next(system, vloc, intval, vedge, src_invariant, guard, reset, tgt_invariant, edges, intvars_reset);
   if (status != tchecker::STATE_OK)
     return status;
 
-  boost::dynamic_bitset<> const tgt_delay_allowed = tchecker::ta::delay_allowed(system, *r, *vloc);
+  boost::dynamic_bitset<> scratch;
+  boost::dynamic_bitset<> const & tgt_delay_allowed = tchecker::ta::delay_allowed(system, *r, *vloc, scratch);
   boost::dynamic_bitset<> const sync_refclocks = tchecker::ta::sync_refclocks(system, *r, *vedge);
 
   tchecker::dbm::db_t * rdbm = zone->dbm();
@@ -75,6 +81,12 @@ boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::
   return tchecker::ta::labels(system, s);
 }
 
+bool satisfies(tchecker::ta::system_t const & system, tchecker::refzg::state_t const & s,
+               boost::dynamic_bitset<> const & labels)
+{
+  return tchecker::ta::satisfies(system, s, labels);
+}
+
 /* is_valid_final */
 
 bool is_valid_final(tchecker::ta::system_t const & system, tchecker::refzg::state_t const & s)
@@ -102,10 +114,11 @@ void attributes(tchecker::ta::system_t const & system, tchecker::refzg::transiti
 refzg_impl_t::refzg_impl_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
                            std::shared_ptr<tchecker::reference_clock_variables_t const> const & r,
                            std::shared_ptr<tchecker::refzg::semantics_t> const & semantics, tchecker::integer_t spread,
-                           std::size_t block_size, std::size_t table_size)
-    : _system(system), _r(r), _semantics(semantics), _spread(spread),
+                           std::size_t block_size, std::size_t table_size,
+                           std::shared_ptr<tchecker::refzg::por_t> const & por)
+    : _system(system), _r(r), _semantics(semantics), _spread(spread), _por(por), _intvars_reset_successors(0),
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
-                       _system->intvars_count(tchecker::VK_FLATTENED), block_size, _r, table_size),
+                       _system->intvars_valuation_capacity(), block_size, _r, table_size),
       _transition_allocator(block_size, block_size, _system->processes_count(), table_size)
 {
   tchecker::variable_access_map_t va_map = tchecker::variable_access(*system);
@@ -133,15 +146,89 @@ void refzg_impl_t::next(tchecker::refzg::const_state_sptr_t const & s, tchecker:
 {
   tchecker::refzg::state_sptr_t nexts = _state_allocator.clone(*s);
   tchecker::refzg::transition_sptr_t nextt = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::refzg::next(*_system, *nexts, *nextt, *_semantics, _spread, out_edge);
+  bool intvars_reset = false;
+  tchecker::state_status_t status =
+      tchecker::refzg::next(*_system, *nexts, *nextt, *_semantics, _spread, out_edge, intvars_reset);
+  if (intvars_reset)
+    ++_intvars_reset_successors;
   v.push_back(std::make_tuple(status, nexts, nextt));
 }
 
+void refzg_impl_t::next(tchecker::refzg::const_state_sptr_t const & s, std::vector<sst_t> & v, tchecker::state_status_t mask)
+{
+  if (_por.get() != nullptr && ample_next(s, v, mask))
+    return;
+  ts_impl_t::next(s, v, mask);
+}
+
+void refzg_impl_t::for_each_next(tchecker::refzg::const_state_sptr_t const & s, tchecker::state_status_t mask,
+                                 sst_callback_t const & callback)
+{
+  if (_por.get() != nullptr) {
+    ts_impl_t::for_each_next(s, mask, callback);
+    return;
+  }
+
+  tchecker::refzg::outgoing_edges_range_t out_edges = outgoing_edges(s);
+  for (tchecker::refzg::outgoing_edges_value_t && out_edge : out_edges) {
+    tchecker::refzg::state_sptr_t nexts = _state_allocator.clone(*s);
+    tchecker::refzg::transition_sptr_t nextt = _transition_allocator.construct();
+    bool intvars_reset = false;
+    tchecker::state_status_t status =
+        tchecker::refzg::next(*_system, *nexts, *nextt, *_semantics, _spread, out_edge, intvars_reset);
+    if (intvars_reset)
+      ++_intvars_reset_successors;
+    if (status & mask)
+      callback(status, nexts, nextt);
+  }
+}
+
+bool refzg_impl_t::ample_next(tchecker::refzg::const_state_sptr_t const & s, std::vector<sst_t> & v,
+                              tchecker::state_status_t mask)
+{
+  tchecker::vloc_t const & vloc = s->vloc();
+  for (tchecker::loc_id_t loc : vloc)
+    if (_system->is_committed(loc) || _system->is_urgent(loc))
+      return false;
+
+  std::vector<sst_t> vv;
+  for (tchecker::loc_id_t loc : vloc) {
+    if (!_por->ample(loc))
+      continue;
+
+    bool enabled = false;
+    vv.clear();
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : _system->outgoing_edges(loc)) {
+      std::size_t const first = vv.size();
+      next(s,
+           tchecker::make_range(tchecker::syncprod::edges_iterator_t{edge, false},
+                                tchecker::syncprod::edges_iterator_t{edge, true}),
+           vv);
+      for (std::size_t i = first; i < vv.size(); ++i)
+        enabled = enabled || (std::get<0>(vv[i]) == tchecker::STATE_OK && _por->uniformly_enabled(edge->id()));
+    }
+    if (!enabled)
+      continue;
+
+    for (auto && [status, nexts, nextt] : vv)
+      if (status & mask)
+        v.push_back(std::make_tuple(status, nexts, nextt));
+    _por->reduced();
+    return true;
+  }
+  return false;
+}
+
 boost::dynamic_bitset<> refzg_impl_t::labels(tchecker::refzg::const_state_sptr_t const & s) const
 {
   return tchecker::refzg::labels(*_system, *s);
 }
 
+bool refzg_impl_t::satisfies(tchecker::refzg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const
+{
+  return tchecker::refzg::satisfies(*_system, *s, labels);
+}
+
 bool refzg_impl_t::is_valid_final(tchecker::refzg::const_state_sptr_t const & s) const
 {
   return tchecker::refzg::is_valid_final(*_system, *s);
@@ -161,12 +248,40 @@ void refzg_impl_t::share(tchecker::refzg::state_sptr_t & s) { _state_allocator.s
 
 void refzg_impl_t::share(tchecker::refzg::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+void refzg_impl_t::collect()
+{
+  _transition_allocator.collect();
+  _state_allocator.collect();
+}
+
+tchecker::refzg::state_sptr_t refzg_impl_t::deserialize_state(std::istream & is)
+{
+  tchecker::refzg::state_sptr_t s = _state_allocator.construct();
+  tchecker::refzg::deserialize(is, *s);
+  if (!tchecker::ta::is_well_formed(*_system, *s))
+    throw std::runtime_error("Serialized state does not belong to the system");
+  return s;
+}
+
+tchecker::refzg::transition_sptr_t refzg_impl_t::deserialize_transition(std::istream & is)
+{
+  tchecker::refzg::transition_sptr_t t = _transition_allocator.construct();
+  tchecker::deserialize(is, *t->vedge_ptr());
+  if (!tchecker::ta::is_well_formed(*_system, *t))
+    throw std::runtime_error("Serialized transition does not belong to the system");
+  return t;
+}
+
 std::shared_ptr<tchecker::ta::system_t const> const & refzg_impl_t::system_ptr() const { return _system; }
 
 tchecker::ta::system_t const & refzg_impl_t::system() const { return *_system; }
 
 tchecker::integer_t refzg_impl_t::spread() const { return _spread; }
 
+std::shared_ptr<tchecker::refzg::por_t const> refzg_impl_t::por() const { return _por; }
+
+unsigned long refzg_impl_t::intvars_reset_successors() const { return _intvars_reset_successors; }
+
 /* refzg_t */
 
 std::shared_ptr<tchecker::ta::system_t const> const & refzg_t::system_ptr() const { return ts_impl().system_ptr(); }
@@ -175,6 +290,22 @@ tchecker::ta::system_t const & refzg_t::system() const { return ts_impl().system
 
 tchecker::integer_t refzg_t::spread() const { return ts_impl().spread(); }
 
+std::shared_ptr<tchecker::refzg::por_t const> refzg_t::por() const { return ts_impl().por(); }
+
+unsigned long refzg_t::intvars_reset_successors() const { return ts_impl().intvars_reset_successors(); }
+
+tchecker::refzg::state_sptr_t refzg_t::deserialize_state(std::istream & is)
+{
+  tchecker::refzg::state_sptr_t s = ts_impl().deserialize_state(is);
+  return s;
+}
+
+tchecker::refzg::transition_sptr_t refzg_t::deserialize_transition(std::istream & is)
+{
+  tchecker::refzg::transition_sptr_t t = ts_impl().deserialize_transition(is);
+  return t;
+}
+
 /* sharing_refzg_t */
 
 std::shared_ptr<tchecker::ta::system_t const> const & sharing_refzg_t::system_ptr() const { return ts_impl().system_ptr(); }
@@ -183,6 +314,24 @@ tchecker::ta::system_t const & sharing_refzg_t::system() const { return ts_impl(
 
 tchecker::integer_t sharing_refzg_t::spread() const { return ts_impl().spread(); }
 
+std::shared_ptr<tchecker::refzg::por_t const> sharing_refzg_t::por() const { return ts_impl().por(); }
+
+unsigned long sharing_refzg_t::intvars_reset_successors() const { return ts_impl().intvars_reset_successors(); }
+
+tchecker::refzg::state_sptr_t sharing_refzg_t::deserialize_state(std::istream & is)
+{
+  tchecker::refzg::state_sptr_t s = ts_impl().deserialize_state(is);
+  ts_impl().share(s);
+  return s;
+}
+
+tchecker::refzg::transition_sptr_t sharing_refzg_t::deserialize_transition(std::istream & is)
+{
+  tchecker::refzg::transition_sptr_t t = ts_impl().deserialize_transition(is);
+  ts_impl().share(t);
+  return t;
+}
+
 /* factory */
 
 // Factory of reference clock variables
@@ -211,30 +360,35 @@ template <class REFZG>
 REFZG * factory_generic(std::shared_ptr<tchecker::ta::system_t const> const & system,
                         enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                         enum tchecker::refzg::semantics_type_t semantics_type, tchecker::integer_t spread,
-                        std::size_t block_size, std::size_t table_size)
+                        std::size_t block_size, std::size_t table_size,
+                        std::shared_ptr<tchecker::refzg::por_t> const & por)
 {
+  if (por.get() != nullptr && refclocks_type != tchecker::refzg::PROCESS_REFERENCE_CLOCKS)
+    throw std::invalid_argument("Partial-order reduction requires one reference clock per process");
   std::shared_ptr<tchecker::reference_clock_variables_t const> r(
       tchecker::refzg::reference_clocks_factory(refclocks_type, *system));
   std::shared_ptr<tchecker::refzg::semantics_t> semantics{tchecker::refzg::semantics_factory(semantics_type)};
-  return new REFZG(system, r, semantics, spread, block_size, table_size);
+  return new REFZG(system, r, semantics, spread, block_size, table_size, por);
 }
 
 tchecker::refzg::refzg_t * factory(std::shared_ptr<tchecker::ta::system_t const> const & system,
                                    enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                                    enum tchecker::refzg::semantics_type_t semantics_type, tchecker::integer_t spread,
-                                   std::size_t block_size, std::size_t table_size)
+                                   std::size_t block_size, std::size_t table_size,
+                                   std::shared_ptr<tchecker::refzg::por_t> const & por)
 {
   return tchecker::refzg::factory_generic<tchecker::refzg::refzg_t>(system, refclocks_type, semantics_type, spread, block_size,
-                                                                    table_size);
+                                                                    table_size, por);
 }
 
 tchecker::refzg::sharing_refzg_t * factory_sharing(std::shared_ptr<tchecker::ta::system_t const> const & system,
                                                    enum tchecker::refzg::reference_clock_variables_type_t refclocks_type,
                                                    enum tchecker::refzg::semantics_type_t semantics_type,
-                                                   tchecker::integer_t spread, std::size_t block_size, std::size_t table_size)
+                                                   tchecker::integer_t spread, std::size_t block_size, std::size_t table_size,
+                                                   std::shared_ptr<tchecker::refzg::por_t> const & por)
 {
   return tchecker::refzg::factory_generic<tchecker::refzg::sharing_refzg_t>(system, refclocks_type, semantics_type, spread,
-                                                                            block_size, table_size);
+                                                                            block_size, table_size, por);
 }
 
 } // end of namespace refzg
@@ -100,6 +100,22 @@ int lexical_cmp(tchecker::refzg::state_t const & s1, tchecker::refzg::state_t co
   return s1.zone().lexical_cmp(s2.zone());
 }
 
+std::ostream & serialize(std::ostream & os, tchecker::refzg::state_t const & s)
+{
+  tchecker::serialize(os, s.vloc());
+  tchecker::serialize(os, s.intval());
+  tchecker::refzg::serialize(os, s.zone());
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::refzg::state_t & s)
+{
+  tchecker::deserialize(is, *s.vloc_ptr());
+  tchecker::deserialize(is, *s.intval_ptr());
+  tchecker::refzg::deserialize(is, *s.zone_ptr());
+  return is;
+}
+
 std::size_t hash_value(tchecker::refzg::state_t const & s)
 {
   std::size_t h = tchecker::ta::hash_value(s);
@@ -5,10 +5,13 @@
  *
  */
 
+#include <cstdint>
 #include <sstream>
+#include <stdexcept>
 
 #include "tchecker/dbm/refdbm.hh"
 #include "tchecker/refzg/zone.hh"
+#include "tchecker/utils/serialization.hh"
 
 namespace tchecker {
 
@@ -111,6 +114,26 @@ zone_t::zone_t(tchecker::refzg::zone_t const & zone) : _ref_clocks(zone._ref_clo
 
 zone_t::~zone_t() = default;
 
+// Serialization
+
+std::ostream & serialize(std::ostream & os, tchecker::refzg::zone_t const & zone)
+{
+  tchecker::serialization::write(os, static_cast<std::uint32_t>(zone.dim()));
+  tchecker::serialization::write(os, zone.dbm(), zone.dim() * zone.dim());
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::refzg::zone_t & zone)
+{
+  if (tchecker::serialization::read<std::uint32_t>(is) != zone.dim())
+    throw std::runtime_error("Serialized zone has wrong dimension");
+  tchecker::serialization::read(is, zone.dbm(), zone.dim() * zone.dim());
+  tchecker::reference_clock_variables_t const & r = *zone.reference_clock_variables();
+  if (!tchecker::refdbm::is_consistent(zone.dbm(), r) || !tchecker::refdbm::is_tight(zone.dbm(), r))
+    throw std::runtime_error("Serialized zone is not a consistent tight DBM");
+  return is;
+}
+
 } // end of namespace refzg
 
 std::string to_string(tchecker::refzg::zone_t const & zone, tchecker::clock_index_t const & index)
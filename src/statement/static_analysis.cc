@@ -284,6 +284,165 @@ void extract_written_variables(tchecker::typed_statement_t const & stmt, std::un
   stmt.visit(v);
 }
 
+/* extract_must_written_variables */
+
+namespace details {
+
+/*!
+ \class extract_must_written_variables_visitor_t
+ \brief Visitor of statements that extract variables written by every execution
+ */
+class extract_must_written_variables_visitor_t : public tchecker::typed_statement_visitor_t {
+public:
+  /*!
+   \brief Constructor
+   */
+  extract_must_written_variables_visitor_t(std::unordered_set<tchecker::clock_id_t> & clocks,
+                                           std::unordered_set<tchecker::intvar_id_t> & intvars,
+                                           std::unordered_set<tchecker::param_id_t> & params)
+      : _clocks(clocks), _intvars(intvars), _params(params)
+  {
+  }
+
+  /*!
+   \brief Copy constructor
+   */
+  extract_must_written_variables_visitor_t(tchecker::details::extract_must_written_variables_visitor_t const &) = default;
+
+  /*!
+   \brief Move constructor
+   */
+  extract_must_written_variables_visitor_t(tchecker::details::extract_must_written_variables_visitor_t &&) = default;
+
+  /*!
+   \brief Destructor
+   */
+  virtual ~extract_must_written_variables_visitor_t() = default;
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::details::extract_must_written_variables_visitor_t &
+  operator=(tchecker::details::extract_must_written_variables_visitor_t const &) = delete;
+
+  /*!
+   \brief Move assignment operator (deleted)
+   */
+  tchecker::details::extract_must_written_variables_visitor_t &
+  operator=(tchecker::details::extract_must_written_variables_visitor_t &&) = delete;
+
+  /*!
+   \brief Add variable ID from the left-hand side expression of stmt to the sets
+   */
+  virtual void visit(tchecker::typed_assign_statement_t const & stmt) { add_lvalue(stmt.lvalue()); }
+
+  /*!
+   \brief Add variable ID from the left-hand side clock of stmt to the sets
+   */
+  virtual void visit(tchecker::typed_int_to_clock_assign_statement_t const & stmt) { add_lvalue(stmt.clock()); }
+
+  /*!
+   \brief Add variable ID from the left-hand side clock of stmt to the sets
+   */
+  virtual void visit(tchecker::typed_clock_to_clock_assign_statement_t const & stmt) { add_lvalue(stmt.lclock()); }
+
+  /*!
+   \brief Add variable ID from the left-hand side clock of stmt to the sets
+   */
+  virtual void visit(tchecker::typed_sum_to_clock_assign_statement_t const & stmt) { add_lvalue(stmt.lclock()); }
+
+  /*!
+   \brief Add variable ID from the left-hand side clock of stmt to the sets
+   */
+  virtual void visit(tchecker::typed_param_to_clock_assign_statement_t const & stmt) { add_lvalue(stmt.clock()); }
+
+  /* other visitors */
+
+  virtual void visit(tchecker::typed_nop_statement_t const &) {}
+
+  virtual void visit(tchecker::typed_sequence_statement_t const & stmt)
+  {
+    stmt.first().visit(*this);
+    stmt.second().visit(*this);
+  }
+
+  /*!
+   \brief Add variable IDs that are written in both branches of stmt to the sets
+   */
+  virtual void visit(tchecker::typed_if_statement_t const & stmt)
+  {
+    std::unordered_set<tchecker::clock_id_t> then_clocks, else_clocks;
+    std::unordered_set<tchecker::intvar_id_t> then_intvars, else_intvars;
+    std::unordered_set<tchecker::param_id_t> then_params, else_params;
+
+    tchecker::details::extract_must_written_variables_visitor_t then_visitor(then_clocks, then_intvars, then_params);
+    stmt.then_stmt().visit(then_visitor);
+    tchecker::details::extract_must_written_variables_visitor_t else_visitor(else_clocks, else_intvars, else_params);
+    stmt.else_stmt().visit(else_visitor);
+
+    intersect(then_clocks, else_clocks, _clocks);
+    intersect(then_intvars, else_intvars, _intvars);
+    intersect(then_params, else_params, _params);
+  }
+
+  virtual void visit(tchecker::typed_while_statement_t const & stmt) {}
+
+  virtual void visit(tchecker::typed_local_var_statement_t const & stmt) {}
+
+  virtual void visit(tchecker::typed_local_array_statement_t const & stmt) {}
+
+private:
+  /*!
+   \brief Add the base variable of an lvalue expression to the sets
+   \param lvalue : lvalue expression
+   \post the base variable of lvalue has been added to the sets if lvalue
+   denotes exactly one variable
+   */
+  void add_lvalue(tchecker::typed_lvalue_expression_t const & lvalue)
+  {
+    std::unordered_set<tchecker::clock_id_t> clocks;
+    std::unordered_set<tchecker::intvar_id_t> intvars;
+    std::unordered_set<tchecker::param_id_t> params;
+
+    tchecker::extract_lvalue_base_variable_ids(lvalue, clocks, intvars, params);
+
+    if (clocks.size() + intvars.size() + params.size() != 1)
+      return;
+    _clocks.insert(clocks.begin(), clocks.end());
+    _intvars.insert(intvars.begin(), intvars.end());
+    _params.insert(params.begin(), params.end());
+  }
+
+  /*!
+   \brief Intersection
+   \param s1 : a set of IDs
+   \param s2 : a set of IDs
+   \param s : a set of IDs
+   \post all IDs that belong to both s1 and s2 have been added to s
+   */
+  template <class ID>
+  static void intersect(std::unordered_set<ID> const & s1, std::unordered_set<ID> const & s2, std::unordered_set<ID> & s)
+  {
+    for (ID id : s1)
+      if (s2.find(id) != s2.end())
+        s.insert(id);
+  }
+
+  std::unordered_set<tchecker::clock_id_t> & _clocks;   /*!< Set of clock IDs */
+  std::unordered_set<tchecker::intvar_id_t> & _intvars; /*!< Set of integer variable IDs */
+  std::unordered_set<tchecker::param_id_t> & _params;   /*!< Set of parameter IDs */
+};
+
+} // end of namespace details
+
+void extract_must_written_variables(tchecker::typed_statement_t const & stmt, std::unordered_set<tchecker::clock_id_t> & clocks,
+                                    std::unordered_set<tchecker::intvar_id_t> & intvars,
+                                    std::unordered_set<tchecker::param_id_t> & params)
+{
+  tchecker::details::extract_must_written_variables_visitor_t v(clocks, intvars, params);
+  stmt.visit(v);
+}
+
 /* local_declaration */
 
 namespace details {
@@ -121,8 +121,12 @@ outgoing_edges(tchecker::syncprod::system_t const & system,
   tchecker::range_t<tchecker::syncprod::vloc_asynchronous_edges_iterator_t, tchecker::end_iterator_t> async_edges(
       tchecker::syncprod::outgoing_asynchronous_edges(system, vloc));
 
-  tchecker::syncprod::outgoing_edges_iterator_t begin(sync_edges.begin(), async_edges.begin(),
-                                                      committed_processes(system, vloc));
+  // An empty set of committed processes avoids copying the memoized set when
+  // no process is committed in vloc
+  tchecker::vloc_memo_t const * memo = tchecker::syncprod::committed_processes_memo(system, *vloc);
+  tchecker::syncprod::outgoing_edges_iterator_t begin(
+      sync_edges.begin(), async_edges.begin(),
+      (memo != nullptr && !memo->committed()) ? boost::dynamic_bitset<>{} : committed_processes(system, vloc));
 
   return tchecker::make_range(begin, tchecker::past_the_end_iterator);
 }
@@ -150,20 +154,51 @@ tchecker::state_status_t next(tchecker::syncprod::system_t const & system,
   return tchecker::STATE_OK;
 }
 
-boost::dynamic_bitset<> committed_processes(tchecker::syncprod::system_t const & system,
-                                            tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
+/*!
+ \brief Compute set of committed processes in a vloc
+ \param system : a system
+ \param vloc : tuple of locations
+ \return the set of processes from system that are committed in vloc
+ */
+static boost::dynamic_bitset<> compute_committed_processes(tchecker::syncprod::system_t const & system,
+                                                           tchecker::vloc_t const & vloc)
 {
   boost::dynamic_bitset<> committed(system.processes_count());
   committed.reset();
-  for (tchecker::loc_id_t id : *vloc)
+  for (tchecker::loc_id_t id : vloc)
     if (system.is_committed(id))
       committed[system.location(id)->pid()] = 1;
   return committed;
 }
 
+tchecker::vloc_memo_t const * committed_processes_memo(tchecker::syncprod::system_t const & system,
+                                                       tchecker::vloc_t const & vloc)
+{
+  tchecker::vloc_memo_t * memo = vloc.memo();
+  if (memo != nullptr && !memo->has_committed_processes())
+    memo->set_committed_processes(tchecker::syncprod::compute_committed_processes(system, vloc));
+  return memo;
+}
+
+boost::dynamic_bitset<> committed_processes(tchecker::syncprod::system_t const & system,
+                                            tchecker::intrusive_shared_ptr_t<tchecker::shared_vloc_t const> const & vloc)
+{
+  tchecker::vloc_memo_t const * memo = tchecker::syncprod::committed_processes_memo(system, *vloc);
+  if (memo != nullptr)
+    return memo->committed_processes();
+  return tchecker::syncprod::compute_committed_processes(system, *vloc);
+}
+
 /* labels */
 
-boost::dynamic_bitset<> labels(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc)
+/*!
+ \brief Compute labels in a tuple of locations
+ \param system : a system of timed processes
+ \param vloc : tuple of locations
+ \return a dynamic bitset of size system.labels_count() that contains all labels
+ on locations in vloc
+ */
+static boost::dynamic_bitset<> compute_labels(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc)
 {
   boost::dynamic_bitset<> l(system.labels_count());
   for (tchecker::loc_id_t loc_id : vloc)
@@ -171,6 +206,48 @@ boost::dynamic_bitset<> labels(tchecker::syncprod::system_t const & system, tche
   return l;
 }
 
+tchecker::vloc_memo_t const * labels_memo(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc)
+{
+  tchecker::vloc_memo_t * memo = vloc.memo();
+  if (memo != nullptr && !memo->has_labels())
+    memo->set_labels(tchecker::syncprod::compute_labels(system, vloc));
+  return memo;
+}
+
+boost::dynamic_bitset<> labels(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc)
+{
+  tchecker::vloc_memo_t const * memo = tchecker::syncprod::labels_memo(system, vloc);
+  if (memo != nullptr)
+    return memo->labels();
+  return tchecker::syncprod::compute_labels(system, vloc);
+}
+
+bool satisfies(tchecker::syncprod::system_t const & system, tchecker::vloc_t const & vloc,
+               boost::dynamic_bitset<> const & labels)
+{
+  tchecker::vloc_memo_t const * memo = tchecker::syncprod::labels_memo(system, vloc);
+  if (memo != nullptr)
+    return labels.is_subset_of(memo->labels());
+
+  for (std::size_t i = labels.find_first(); i != boost::dynamic_bitset<>::npos; i = labels.find_next(i)) {
+    bool found = false;
+    for (tchecker::loc_id_t loc_id : vloc)
+      if (system.labels(loc_id)[i]) {
+        found = true;
+        break;
+      }
+    if (!found)
+      return false;
+  }
+  return true;
+}
+
+bool satisfies(tchecker::syncprod::system_t const & system, tchecker::syncprod::state_t const & s,
+               boost::dynamic_bitset<> const & labels)
+{
+  return tchecker::syncprod::satisfies(system, s.vloc(), labels);
+}
+
 boost::dynamic_bitset<> labels(tchecker::syncprod::system_t const & system, tchecker::syncprod::state_t const & s)
 {
   return tchecker::syncprod::labels(system, s.vloc());
@@ -261,6 +338,11 @@ boost::dynamic_bitset<> syncprod_impl_t::labels(tchecker::syncprod::const_state_
   return tchecker::syncprod::labels(*_system, *s);
 }
 
+bool syncprod_impl_t::satisfies(tchecker::syncprod::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const
+{
+  return tchecker::syncprod::satisfies(*_system, *s, labels);
+}
+
 bool syncprod_impl_t::is_valid_final(tchecker::syncprod::const_state_sptr_t const & s) const
 {
   return tchecker::syncprod::is_valid_final(*_system, *s);
@@ -281,6 +363,12 @@ void syncprod_impl_t::share(tchecker::syncprod::state_sptr_t & s) { _state_alloc
 
 void syncprod_impl_t::share(tchecker::syncprod::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+void syncprod_impl_t::collect()
+{
+  _transition_allocator.collect();
+  _state_allocator.collect();
+}
+
 tchecker::syncprod::system_t const & syncprod_impl_t::system() const { return *_system; }
 
 /* syncprod_t */
@@ -5,10 +5,13 @@
  *
  */
 
+#include <cstdint>
 #include <sstream>
+#include <stdexcept>
 
 #include "tchecker/syncprod/vedge.hh"
 #include "tchecker/utils/ordering.hh"
+#include "tchecker/utils/serialization.hh"
 
 namespace tchecker {
 
@@ -80,4 +83,21 @@ int lexical_cmp(tchecker::vedge_t const & vedge1, tchecker::vedge_t const & vedg
       [](tchecker::edge_id_t id1, tchecker::edge_id_t id2) -> int { return (id1 < id2 ? -1 : (id1 == id2 ? 0 : 1)); });
 }
 
+std::ostream & serialize(std::ostream & os, tchecker::vedge_t const & vedge)
+{
+  tchecker::serialization::write(os, static_cast<std::uint32_t>(vedge.size()));
+  for (auto it = vedge.begin_array(); it != vedge.end_array(); ++it)
+    tchecker::serialization::write(os, *it);
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::vedge_t & vedge)
+{
+  if (tchecker::serialization::read<std::uint32_t>(is) != vedge.size())
+    throw std::runtime_error("Serialized vector of edges has wrong size");
+  for (auto it = vedge.begin_array(); it != vedge.end_array(); ++it)
+    *it = tchecker::serialization::read<tchecker::edge_id_t>(is);
+  return is;
+}
+
 } // end of namespace tchecker
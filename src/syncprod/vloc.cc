@@ -5,13 +5,49 @@
  *
  */
 
+#include <cstdint>
 #include <sstream>
+#include <stdexcept>
 
 #include "tchecker/syncprod/vloc.hh"
 #include "tchecker/utils/ordering.hh"
+#include "tchecker/utils/serialization.hh"
 
 namespace tchecker {
 
+/* vloc_memo_t */
+
+vloc_memo_t::vloc_memo_t() : _flags(0) {}
+
+void vloc_memo_t::set_labels(boost::dynamic_bitset<> const & labels)
+{
+  _labels = labels;
+  _flags |= LABELS;
+}
+
+void vloc_memo_t::set_committed_processes(boost::dynamic_bitset<> const & committed_processes)
+{
+  _committed_processes = committed_processes;
+  _flags |= COMMITTED_PROCESSES;
+  if (_committed_processes.any())
+    _flags |= COMMITTED;
+}
+
+void vloc_memo_t::set_delay_allowed(bool delay_allowed)
+{
+  _flags |= DELAY_ALLOWED_VALID;
+  if (delay_allowed)
+    _flags |= DELAY_ALLOWED;
+}
+
+void vloc_memo_t::set_refclocks_delay_allowed(boost::dynamic_bitset<> const & delay_allowed)
+{
+  _refclocks_delay_allowed = delay_allowed;
+  _flags |= REFCLOCKS_DELAY_ALLOWED;
+}
+
+/* vloc_t */
+
 vloc_t::vloc_t(unsigned int size) : tchecker::loc_array_t(std::make_tuple(size), std::make_tuple(tchecker::NO_LOC)) {}
 
 void vloc_destruct_and_deallocate(tchecker::vloc_t * vloc)
@@ -47,4 +83,21 @@ int lexical_cmp(tchecker::vloc_t const & vloc1, tchecker::vloc_t const & vloc2)
       [](tchecker::loc_id_t id1, tchecker::loc_id_t id2) -> int { return (id1 < id2 ? -1 : (id1 == id2 ? 0 : 1)); });
 }
 
+std::ostream & serialize(std::ostream & os, tchecker::vloc_t const & vloc)
+{
+  tchecker::serialization::write(os, static_cast<std::uint32_t>(vloc.size()));
+  for (tchecker::loc_id_t id : vloc)
+    tchecker::serialization::write(os, id);
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::vloc_t & vloc)
+{
+  if (tchecker::serialization::read<std::uint32_t>(is) != vloc.size())
+    throw std::runtime_error("Serialized tuple of locations has wrong size");
+  for (tchecker::loc_id_t & id : vloc)
+    id = tchecker::serialization::read<tchecker::loc_id_t>(is);
+  return is;
+}
+
 } // end of namespace tchecker
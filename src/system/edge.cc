@@ -5,6 +5,7 @@
  *
  */
 
+#include <algorithm>
 #include <cassert>
 #include <stdexcept>
 
@@ -38,28 +39,55 @@ void loc_edges_maps_t::clear()
 {
   _loc_to_events.clear();
   _loc_to_edges.clear();
-  _loc_event_to_edges.clear();
+  _loc_to_sorted_edges.clear();
 }
 
 void loc_edges_maps_t::add_edge(tchecker::loc_id_t loc, tchecker::system::edge_shared_ptr_t const & edge)
 {
   tchecker::event_id_t event = edge->event_id();
 
-  if (loc >= _loc_to_edges.size())
-    _loc_to_edges.resize(loc + 1);
+  if (loc >= _loc_to_events.size() || _loc_to_events[loc].empty() || _loc_to_events[loc].back() <= event) {
+    append_edge(loc, edge);
+    return;
+  }
+
   _loc_to_edges[loc].push_back(edge);
 
-  if (loc >= _loc_to_events.size())
+  // Insert after the edges with the same event to preserve their order
+  std::vector<tchecker::event_id_t> & events = _loc_to_events[loc];
+  auto it = std::upper_bound(events.begin(), events.end(), event);
+  auto const pos = it - events.begin();
+  events.insert(it, event);
+  _loc_to_sorted_edges[loc].insert(_loc_to_sorted_edges[loc].begin() + pos, edge);
+}
+
+void loc_edges_maps_t::append_edge(tchecker::loc_id_t loc, tchecker::system::edge_shared_ptr_t const & edge)
+{
+  if (loc >= _loc_to_edges.size()) {
+    _loc_to_edges.resize(loc + 1);
     _loc_to_events.resize(loc + 1);
-  if (event >= _loc_to_events[loc].size())
-    _loc_to_events[loc].resize(event + 1);
-  _loc_to_events[loc][event] = 1;
+    _loc_to_sorted_edges.resize(loc + 1);
+  }
+  _loc_to_edges[loc].push_back(edge);
+  _loc_to_events[loc].push_back(edge->event_id());
+  _loc_to_sorted_edges[loc].push_back(edge);
+}
+
+void loc_edges_maps_t::sort_edges()
+{
+  for (std::size_t loc = 0; loc < _loc_to_sorted_edges.size(); ++loc) {
+    std::vector<tchecker::event_id_t> & events = _loc_to_events[loc];
+    if (std::is_sorted(events.begin(), events.end()))
+      continue;
 
-  if (loc >= _loc_event_to_edges.size())
-    _loc_event_to_edges.resize(loc + 1);
-  if (event >= _loc_event_to_edges[loc].size())
-    _loc_event_to_edges[loc].resize(event + 1);
-  _loc_event_to_edges[loc][event].push_back(edge);
+    tchecker::system::edges_collection_t & sorted_edges = _loc_to_sorted_edges[loc];
+    std::stable_sort(sorted_edges.begin(), sorted_edges.end(),
+                     [](tchecker::system::edge_shared_ptr_t const & e1, tchecker::system::edge_shared_ptr_t const & e2) {
+                       return e1->event_id() < e2->event_id();
+                     });
+    for (std::size_t i = 0; i < sorted_edges.size(); ++i)
+      events[i] = sorted_edges[i]->event_id();
+  }
 }
 
 tchecker::range_t<tchecker::system::edges_collection_const_iterator_t> loc_edges_maps_t::edges(tchecker::loc_id_t loc) const
@@ -73,15 +101,18 @@ tchecker::range_t<tchecker::system::edges_collection_const_iterator_t> loc_edges
 tchecker::range_t<tchecker::system::edges_collection_const_iterator_t> loc_edges_maps_t::edges(tchecker::loc_id_t loc,
                                                                                                tchecker::event_id_t event) const
 {
-  if (loc >= _loc_event_to_edges.size() || event >= _loc_event_to_edges[loc].size())
+  if (loc >= _loc_to_events.size())
     return tchecker::make_range<tchecker::system::edges_collection_const_iterator_t>(_empty_edges.begin(), _empty_edges.end());
-  return tchecker::make_range<tchecker::system::edges_collection_const_iterator_t>(_loc_event_to_edges[loc][event].begin(),
-                                                                                   _loc_event_to_edges[loc][event].end());
+  std::vector<tchecker::event_id_t> const & events = _loc_to_events[loc];
+  auto && [first, last] = std::equal_range(events.begin(), events.end(), event);
+  auto const edges_begin = _loc_to_sorted_edges[loc].begin();
+  return tchecker::make_range<tchecker::system::edges_collection_const_iterator_t>(edges_begin + (first - events.begin()),
+                                                                                   edges_begin + (last - events.begin()));
 }
 
 bool loc_edges_maps_t::event(tchecker::loc_id_t loc, tchecker::event_id_t event) const
 {
-  return (loc < _loc_to_events.size() && event < _loc_to_events[loc].size() && _loc_to_events[loc][event]);
+  return (loc < _loc_to_events.size() && std::binary_search(_loc_to_events[loc].begin(), _loc_to_events[loc].end(), event));
 }
 
 /* edges_t */
@@ -134,14 +165,7 @@ void edges_t::clear()
 void edges_t::add_edge(tchecker::process_id_t pid, tchecker::loc_id_t src, tchecker::loc_id_t tgt,
                        tchecker::event_id_t event_id, tchecker::system::attributes_t const & attr)
 {
-  tchecker::edge_id_t id = _edges.size();
-
-  if (!tchecker::valid_edge_id(id))
-    throw std::runtime_error("add_edge: invalid location identifier");
-
-  tchecker::system::edge_shared_ptr_t edge(new tchecker::system::edge_t(pid, id, src, tgt, event_id, attr));
-  _edges.push_back(edge);
-  assert(_edges.back()->id() == _edges.size() - 1);
+  tchecker::system::edge_shared_ptr_t edge = new_edge(pid, src, tgt, event_id, attr);
   _loc_edges_maps[tchecker::system::INCOMING_EDGE]->add_edge(tgt, edge);
   _loc_edges_maps[tchecker::system::OUTGOING_EDGE]->add_edge(src, edge);
 }
@@ -195,8 +219,28 @@ std::shared_ptr<tchecker::system::loc_edges_maps_t const> edges_t::incoming_edge
 
 void edges_t::add_edges(tchecker::system::edges_t const & edges)
 {
-  for (tchecker::system::edge_const_shared_ptr_t edge : edges._edges)
-    add_edge(edge->pid(), edge->src(), edge->tgt(), edge->event_id(), edge->attributes());
+  for (tchecker::system::edge_const_shared_ptr_t e : edges._edges) {
+    tchecker::system::edge_shared_ptr_t edge = new_edge(e->pid(), e->src(), e->tgt(), e->event_id(), e->attributes());
+    _loc_edges_maps[tchecker::system::INCOMING_EDGE]->append_edge(edge->tgt(), edge);
+    _loc_edges_maps[tchecker::system::OUTGOING_EDGE]->append_edge(edge->src(), edge);
+  }
+  _loc_edges_maps[tchecker::system::INCOMING_EDGE]->sort_edges();
+  _loc_edges_maps[tchecker::system::OUTGOING_EDGE]->sort_edges();
+}
+
+tchecker::system::edge_shared_ptr_t edges_t::new_edge(tchecker::process_id_t pid, tchecker::loc_id_t src,
+                                                      tchecker::loc_id_t tgt, tchecker::event_id_t event_id,
+                                                      tchecker::system::attributes_t const & attr)
+{
+  tchecker::edge_id_t id = _edges.size();
+
+  if (!tchecker::valid_edge_id(id))
+    throw std::runtime_error("add_edge: invalid location identifier");
+
+  tchecker::system::edge_shared_ptr_t edge(new tchecker::system::edge_t(pid, id, src, tgt, event_id, attr));
+  _edges.push_back(edge);
+  assert(_edges.back()->id() == _edges.size() - 1);
+  return edge;
 }
 
 bool edges_t::is_edge(tchecker::edge_id_t id) const { return id < _edges.size(); }
@@ -9,6 +9,8 @@
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/static_analysis.hh"
 #include "tchecker/ta/system.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
 
 namespace tchecker {
 
@@ -32,6 +34,25 @@ bool has_guarded_weakly_synchronized_event(tchecker::ta::system_t const & system
   return false;
 }
 
+std::vector<std::vector<tchecker::intvar_id_t>> dead_intvars(tchecker::ta::system_t const & system)
+{
+  std::size_t const intvars_count = system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::variable_access_map_t const access_map = tchecker::variable_access(system);
+  std::vector<boost::dynamic_bitset<>> const live = tchecker::live_intvars(system);
+
+  std::vector<std::vector<tchecker::intvar_id_t>> dead(system.locations_count());
+  for (tchecker::intvar_id_t id = 0; id < intvars_count; ++id) {
+    auto range = access_map.accessing_processes(id, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY);
+    if (std::distance(range.begin(), range.end()) != 1)
+      continue;
+    tchecker::process_id_t const pid = *range.begin();
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+      if (loc->pid() == pid && !live[loc->id()][id])
+        dead[loc->id()].push_back(id);
+  }
+  return dead;
+}
+
 } // end of namespace ta
 
 } // end of namespace tchecker
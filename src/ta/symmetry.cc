@@ -0,0 +1,260 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <map>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+
+#include "tchecker/system/synchronization.hh"
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/variables/access.hh"
+#include "tchecker/variables/static_analysis.hh"
+
+namespace tchecker {
+
+namespace ta {
+
+/*!
+ \brief Check if a variable is only accessed by a given process
+ \param access_map : variable access map
+ \param id : first flattened identifier of the variable
+ \param size : size of the variable
+ \param vtype : type of the variable
+ \param pid : process identifier
+ \return true if some flattened variable in id..id+size-1 is accessed, and all
+ of them are only accessed by process pid, false otherwise
+ */
+static bool owned_variable(tchecker::variable_access_map_t const & access_map, tchecker::variable_id_t id, std::size_t size,
+                           enum tchecker::variable_type_t vtype, tchecker::process_id_t pid)
+{
+  bool accessed = false;
+  for (tchecker::variable_id_t flat_id = id; flat_id < id + size; ++flat_id)
+    for (tchecker::process_id_t accessing_pid : access_map.accessing_processes(flat_id, vtype, tchecker::VACCESS_ANY)) {
+      if (accessing_pid != pid)
+        return false;
+      accessed = true;
+    }
+  return accessed;
+}
+
+/*!
+ \brief Rename identifiers
+ \param s : a string
+ \param renaming : map from identifiers to identifiers
+ \return s where every identifier in the domain of renaming has been replaced by
+ its image
+ */
+static std::string rename(std::string const & s, std::unordered_map<std::string, std::string> const & renaming)
+{
+  auto is_identifier_char = [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '.'; };
+
+  std::string result;
+  std::size_t i = 0;
+  while (i < s.size()) {
+    if (!is_identifier_char(s[i])) {
+      result.push_back(s[i++]);
+      continue;
+    }
+    std::size_t j = i;
+    while (j < s.size() && is_identifier_char(s[j]))
+      ++j;
+    std::string const token = s.substr(i, j - i);
+    auto it = renaming.find(token);
+    result.append(it == renaming.end() ? token : it->second);
+    i = j;
+  }
+  return result;
+}
+
+/*!
+ \brief Compute the description and the signature of a process
+ \param system : a system of timed processes
+ \param access_map : variable access map of system
+ \param pid : process identifier
+ \param process : symmetric process description
+ \post process describes process pid in system
+ \return a string that is equal for any two symmetric processes, and that is
+ different for any two non-symmetric processes (synchronizations aside)
+ */
+static std::string signature(tchecker::ta::system_t const & system, tchecker::variable_access_map_t const & access_map,
+                             tchecker::process_id_t pid, tchecker::ta::symmetric_process_t & process)
+{
+  std::ostringstream sig;
+  std::unordered_map<std::string, std::string> renaming;
+
+  process.pid = pid;
+
+  // Owned clocks and bounded integer variables, in declaration order
+  std::vector<tchecker::clock_id_t> clock_ids;
+  for (auto && [id, name] : system.clock_variables().index())
+    clock_ids.push_back(id);
+  std::sort(clock_ids.begin(), clock_ids.end());
+  for (tchecker::clock_id_t id : clock_ids) {
+    std::size_t const size = system.clock_variables().info(id).size();
+    if (!owned_variable(access_map, id, size, tchecker::VTYPE_CLOCK, pid))
+      continue;
+    renaming[system.clock_name(id)] = "$clock" + std::to_string(renaming.size());
+    sig << "clock:" << size << ";";
+    for (tchecker::clock_id_t flat_id = id; flat_id < id + size; ++flat_id)
+      process.clocks.push_back(flat_id);
+  }
+
+  std::vector<tchecker::intvar_id_t> intvar_ids;
+  for (auto && [id, name] : system.integer_variables().index())
+    intvar_ids.push_back(id);
+  std::sort(intvar_ids.begin(), intvar_ids.end());
+  for (tchecker::intvar_id_t id : intvar_ids) {
+    tchecker::intvar_info_t const & info = system.integer_variables().info(id);
+    if (!owned_variable(access_map, id, info.size(), tchecker::VTYPE_INTVAR, pid))
+      continue;
+    renaming[system.intvar_name(id)] = "$int" + std::to_string(renaming.size());
+    sig << "int:" << info.size() << ":" << info.min() << ":" << info.max() << ":" << info.initial_value() << ";";
+    for (tchecker::intvar_id_t flat_id = id; flat_id < id + info.size(); ++flat_id)
+      process.intvars.push_back(flat_id);
+  }
+
+  // Locations, sorted by name
+  std::map<std::string, tchecker::loc_id_t> locations;
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    if (loc->pid() == pid)
+      locations[loc->name()] = loc->id();
+
+  for (auto && [name, id] : locations) {
+    process.locations.push_back(id);
+    sig << "location:" << name << "{";
+    if (system.is_initial_location(id))
+      sig << "initial:";
+    if (system.is_committed(id))
+      sig << "committed:";
+    if (system.is_urgent(id))
+      sig << "urgent:";
+    boost::dynamic_bitset<> const & labels = system.labels(id);
+    for (std::size_t l = labels.find_first(); l != boost::dynamic_bitset<>::npos; l = labels.find_next(l))
+      sig << "label " << system.label_name(l) << ":";
+    sig << "invariant " << rename(system.invariant(id).to_string(), renaming) << "}";
+  }
+
+  // Edges, sorted
+  std::vector<std::string> edges;
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    if (edge->pid() != pid)
+      continue;
+    edges.push_back("edge:" + system.location(edge->src())->name() + ":" + system.location(edge->tgt())->name() + ":" +
+                    system.event_name(edge->event_id()) + "{provided " + rename(system.guard(edge->id()).to_string(), renaming) +
+                    " : do " + rename(system.statement(edge->id()).to_string(), renaming) + "}");
+  }
+  std::sort(edges.begin(), edges.end());
+  for (std::string const & edge : edges)
+    sig << edge;
+
+  return sig.str();
+}
+
+/*!
+ \brief Type of synchronizations as sorted tuples of (process identifier, event
+ identifier, strength)
+ */
+using sync_key_t = std::vector<std::tuple<tchecker::process_id_t, tchecker::event_id_t, tchecker::sync_strength_t>>;
+
+/*!
+ \brief Compute synchronization key
+ \param sync : a synchronization
+ \param pid1 : process identifier
+ \param pid2 : process identifier
+ \return key of sync where pid1 and pid2 have been exchanged
+ */
+static sync_key_t sync_key(tchecker::system::synchronization_t const & sync, tchecker::process_id_t pid1,
+                           tchecker::process_id_t pid2)
+{
+  sync_key_t key;
+  for (tchecker::system::sync_constraint_t const & c : sync.synchronization_constraints()) {
+    tchecker::process_id_t const pid = (c.pid() == pid1 ? pid2 : (c.pid() == pid2 ? pid1 : c.pid()));
+    key.emplace_back(pid, c.event_id(), c.strength());
+  }
+  std::sort(key.begin(), key.end());
+  return key;
+}
+
+/*!
+ \brief Check if a group of processes is invariant under synchronizations
+ \param system : a system of timed processes
+ \param group : group of processes
+ \return true if the synchronizations of system are invariant under every
+ permutation of the processes in group, false otherwise
+ \note it is sufficient to check invariance under the exchange of consecutive
+ processes in group, since these transpositions generate all the permutations
+ */
+static bool invariant_synchronizations(tchecker::ta::system_t const & system, tchecker::ta::symmetry_group_t const & group)
+{
+  std::set<sync_key_t> syncs;
+  for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+    syncs.insert(tchecker::ta::sync_key(sync, 0, 0));
+
+  for (std::size_t i = 1; i < group.size(); ++i)
+    for (tchecker::system::synchronization_t const & sync : system.synchronizations())
+      if (syncs.find(tchecker::ta::sync_key(sync, group[i - 1].pid, group[i].pid)) == syncs.end())
+        return false;
+  return true;
+}
+
+std::vector<tchecker::ta::symmetry_group_t> symmetry_groups(tchecker::ta::system_t const & system)
+{
+  tchecker::variable_access_map_t const access_map = tchecker::variable_access(system);
+  std::size_t const processes_count = system.processes_count();
+
+  // Signatures and declared groups of processes
+  std::vector<std::string> signatures(processes_count);
+  std::vector<tchecker::ta::symmetric_process_t> processes(processes_count);
+  std::map<std::string, std::vector<tchecker::process_id_t>> declared;
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid) {
+    signatures[pid] = tchecker::ta::signature(system, access_map, pid, processes[pid]);
+    for (auto && [key, value] : system.process_attributes(pid).values("symmetry"))
+      declared[value].push_back(pid);
+  }
+
+  std::vector<tchecker::ta::symmetry_group_t> groups;
+
+  if (!declared.empty()) {
+    for (auto && [name, pids] : declared) {
+      std::sort(pids.begin(), pids.end());
+      tchecker::ta::symmetry_group_t group;
+      for (tchecker::process_id_t pid : pids) {
+        if (signatures[pid] != signatures[pids[0]])
+          throw std::invalid_argument("Processes " + system.process_name(pids[0]) + " and " + system.process_name(pid) +
+                                      " in symmetry group " + name + " are not symmetric");
+        group.push_back(processes[pid]);
+      }
+      if (!tchecker::ta::invariant_synchronizations(system, group))
+        throw std::invalid_argument("Synchronizations are not invariant under permutations of symmetry group " + name);
+      if (group.size() > 1)
+        groups.push_back(std::move(group));
+    }
+    return groups;
+  }
+
+  std::map<std::string, tchecker::ta::symmetry_group_t> detected;
+  for (tchecker::process_id_t pid = 0; pid < processes_count; ++pid)
+    detected[signatures[pid]].push_back(processes[pid]);
+  for (auto && [sig, group] : detected)
+    if (group.size() > 1 && tchecker::ta::invariant_synchronizations(system, group))
+      groups.push_back(std::move(group));
+
+  std::sort(groups.begin(), groups.end(), [](tchecker::ta::symmetry_group_t const & g1, tchecker::ta::symmetry_group_t const & g2) {
+    return g1[0].pid < g2[0].pid;
+  });
+  return groups;
+}
+
+} // end of namespace ta
+
+} // end of namespace tchecker
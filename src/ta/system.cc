@@ -26,23 +26,27 @@ namespace tchecker {
 
 namespace ta {
 
-system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl) : tchecker::syncprod::system_t(sysdecl)
+system_t::system_t(tchecker::parsing::system_declaration_t const & sysdecl)
+    : tchecker::syncprod::system_t(sysdecl), _dead_intvars_reset(false)
 {
   compute_from_syncprod_system();
 }
 
-system_t::system_t(tchecker::system::system_t const & system) : tchecker::syncprod::system_t(system)
+system_t::system_t(tchecker::system::system_t const & system)
+    : tchecker::syncprod::system_t(system), _dead_intvars_reset(false)
 {
   compute_from_syncprod_system();
 }
 
-system_t::system_t(tchecker::syncprod::system_t const & system) : tchecker::syncprod::system_t(system)
+system_t::system_t(tchecker::syncprod::system_t const & system)
+    : tchecker::syncprod::system_t(system), _dead_intvars_reset(false)
 {
   compute_from_syncprod_system();
 }
 
 system_t::system_t(tchecker::ta::system_t const & system)
-    : tchecker::syncprod::system_t(system.as_syncprod_system()), _vm(system._vm)
+    : tchecker::syncprod::system_t(system.as_syncprod_system()), _vm(system._vm),
+      _dead_intvars_reset(system._dead_intvars_reset), _intvars_layout(system._intvars_layout)
 {
   compute_from_syncprod_system();
 }
@@ -52,6 +56,8 @@ tchecker::ta::system_t & system_t::operator=(tchecker::ta::system_t const & syst
   if (this != &system) {
     tchecker::syncprod::system_t::operator=(system);
     _vm = system._vm;
+    _dead_intvars_reset = system._dead_intvars_reset;
+    _intvars_layout = system._intvars_layout;
     compute_from_syncprod_system();
   }
   return *this;
@@ -65,6 +71,7 @@ tchecker::system::attribute_keys_map_t const & system_t::known_attributes()
     attr[tchecker::system::ATTR_EDGE].insert("provided");
     attr[tchecker::system::ATTR_LOCATION].insert("invariant");
     attr[tchecker::system::ATTR_LOCATION].insert("urgent");
+    attr[tchecker::system::ATTR_PROCESS].insert("symmetry");
     return attr;
   }()};
   return known_attr;
@@ -94,6 +101,28 @@ tchecker::bytecode_t const * system_t::statement_bytecode(tchecker::edge_id_t id
   return _statements[id]._compiled_stmt.get();
 }
 
+std::vector<tchecker::intvar_id_t> const & system_t::dead_intvars(tchecker::loc_id_t id) const
+{
+  assert(is_location(id));
+  return _dead_intvars[id];
+}
+
+void system_t::packed_intvars(bool packed)
+{
+  if (packed)
+    _intvars_layout = std::make_shared<tchecker::intvars_layout_t const>(integer_variables().flattened());
+  else
+    _intvars_layout.reset();
+  _vm.intvars_layout(_intvars_layout.get());
+}
+
+std::size_t system_t::intvars_valuation_capacity() const
+{
+  if (_intvars_layout != nullptr)
+    return _intvars_layout->capacity();
+  return intvars_count(tchecker::VK_FLATTENED);
+}
+
 bool system_t::is_urgent(tchecker::loc_id_t id) const
 {
   assert(is_location(id));
@@ -118,6 +147,7 @@ void system_t::compute_from_syncprod_system()
   _guards.clear();
   _statements.clear();
   _urgent.reset();
+  _dead_intvars.clear();
 
   tchecker::loc_id_t const locations_count = this->locations_count();
   tchecker::edge_id_t const edges_count = this->edges_count();
@@ -141,6 +171,8 @@ void system_t::compute_from_syncprod_system()
 
   if (tchecker::ta::has_guarded_weakly_synchronized_event(*this))
     throw std::invalid_argument("Transitions over weakly synchronized events should not have guards");
+
+  _dead_intvars = tchecker::ta::dead_intvars(*this);
 }
 
 static tchecker::expression_t *
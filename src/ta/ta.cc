@@ -45,9 +45,14 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
 
   // initialize intval
   auto const & intvars = system.integer_variables().flattened();
+  tchecker::intvars_layout_t const * layout = system.intvars_layout();
   tchecker::intvar_id_t intvars_size = intvars.size();
-  for (tchecker::intvar_id_t id = 0; id < intvars_size; ++id)
-    (*intval)[id] = intvars.info(id).initial_value();
+  for (tchecker::intvar_id_t id = 0; id < intvars_size; ++id) {
+    if (layout == nullptr)
+      (*intval)[id] = intvars.info(id).initial_value();
+    else
+      layout->store(*intval, id, intvars.info(id).initial_value());
+  }
 
   // check invariant
   tchecker::vm_t & vm = system.vm();
@@ -65,10 +70,12 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant,
-                              tchecker::ta::outgoing_edges_value_t const & edges)
+                              tchecker::ta::outgoing_edges_value_t const & edges, bool & intvars_reset)
 {
   tchecker::vm_t & vm = system.vm();
 
+  intvars_reset = false;
+
   // check source invariant
   for (tchecker::loc_id_t loc_id : *vloc)
     if (vm.run(system.invariant_bytecode(loc_id), *intval, src_invariant, throw_clkreset) == 0)
@@ -94,6 +101,26 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
     if (vm.run(system.invariant_bytecode(loc_id), *intval, tgt_invariant, throw_clkreset) == 0)
       return tchecker::STATE_INTVARS_TGT_INVARIANT_VIOLATED;
 
+  // reset dead variables in target locations (other processes have not moved)
+  if (system.dead_intvars_reset()) {
+    auto const & intvars = system.integer_variables().flattened();
+    tchecker::intvars_layout_t const * layout = system.intvars_layout();
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : edges)
+      for (tchecker::intvar_id_t id : system.dead_intvars(edge->tgt())) {
+        tchecker::integer_t const initial_value = intvars.info(id).initial_value();
+        if (layout == nullptr) {
+          if ((*intval)[id] != initial_value) {
+            (*intval)[id] = initial_value;
+            intvars_reset = true;
+          }
+        }
+        else if (layout->load(*intval, id) != initial_value) {
+          layout->store(*intval, id, initial_value);
+          intvars_reset = true;
+        }
+      }
+  }
+
   return tchecker::STATE_OK;
 }
 
@@ -101,23 +128,69 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
 
 bool delay_allowed(tchecker::ta::system_t const & system, tchecker::vloc_t const & vloc)
 {
+  tchecker::vloc_memo_t * memo = vloc.memo();
+  if (memo != nullptr && memo->has_delay_allowed())
+    return memo->delay_allowed();
+
+  bool allowed = true;
   for (tchecker::loc_id_t loc_id : vloc)
-    if (system.is_committed(loc_id) || system.is_urgent(loc_id))
-      return false;
-  return true;
+    if (system.is_committed(loc_id) || system.is_urgent(loc_id)) {
+      allowed = false;
+      break;
+    }
+
+  if (memo != nullptr)
+    memo->set_delay_allowed(allowed);
+  return allowed;
 }
 
-boost::dynamic_bitset<> delay_allowed(tchecker::ta::system_t const & system, tchecker::reference_clock_variables_t const & r,
-                                      tchecker::vloc_t const & vloc)
+/*!
+ \brief Compute the set of reference clocks that can let time elapse in a tuple
+ of locations
+ \param system : a system of timed processes
+ \param r : reference clocks
+ \param vloc : tuple of locations
+ \param allowed : a dynamic bitset
+ \post allowed has size r.refcount() and contains all reference clocks that can
+ delay from vloc
+ */
+static void compute_delay_allowed(tchecker::ta::system_t const & system, tchecker::reference_clock_variables_t const & r,
+                                  tchecker::vloc_t const & vloc, boost::dynamic_bitset<> & allowed)
 {
   std::size_t const size = vloc.size();
   std::vector<tchecker::clock_id_t> const & procmap = r.procmap();
-  boost::dynamic_bitset<> allowed{r.refcount()};
+  allowed.resize(r.refcount());
   allowed.set();
   for (std::size_t i = 0; i < size; ++i)
     if (system.is_urgent(vloc[i]) || system.is_committed(vloc[i]))
       allowed.reset(procmap[i]);
-  return allowed;
+}
+
+boost::dynamic_bitset<> delay_allowed(tchecker::ta::system_t const & system, tchecker::reference_clock_variables_t const & r,
+                                      tchecker::vloc_t const & vloc)
+{
+  boost::dynamic_bitset<> allowed;
+  return tchecker::ta::delay_allowed(system, r, vloc, allowed);
+}
+
+boost::dynamic_bitset<> const & delay_allowed(tchecker::ta::system_t const & system,
+                                              tchecker::reference_clock_variables_t const & r, tchecker::vloc_t const & vloc,
+                                              boost::dynamic_bitset<> & scratch)
+{
+  tchecker::vloc_memo_t * memo = vloc.memo();
+  if (memo == nullptr) {
+    tchecker::ta::compute_delay_allowed(system, r, vloc, scratch);
+    return scratch;
+  }
+
+  // Reference clocks are determined by the system, hence the memoized set does
+  // not depend on the zone that r comes from
+  if (!memo->has_refclocks_delay_allowed()) {
+    tchecker::ta::compute_delay_allowed(system, r, vloc, scratch);
+    memo->set_refclocks_delay_allowed(scratch);
+  }
+  assert(memo->refclocks_delay_allowed().size() == r.refcount());
+  return memo->refclocks_delay_allowed();
 }
 
 /* sync_refclocks */
@@ -140,6 +213,11 @@ boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::
   return tchecker::syncprod::labels(system.as_syncprod_system(), s);
 }
 
+bool satisfies(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s, boost::dynamic_bitset<> const & labels)
+{
+  return tchecker::syncprod::satisfies(system.as_syncprod_system(), s, labels);
+}
+
 /* is_valid_final */
 
 bool is_valid_final(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s)
@@ -147,12 +225,47 @@ bool is_valid_final(tchecker::ta::system_t const & system, tchecker::ta::state_t
   return tchecker::syncprod::is_valid_final(system.as_syncprod_system(), s);
 }
 
+bool is_well_formed(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s)
+{
+  tchecker::vloc_t const & vloc = s.vloc();
+  if (vloc.size() != system.processes_count())
+    return false;
+  for (tchecker::process_id_t pid = 0; pid < vloc.size(); ++pid)
+    if (vloc[pid] >= system.locations_count() || system.location(vloc[pid])->pid() != pid)
+      return false;
+
+  auto const & intvars = system.integer_variables().flattened();
+  tchecker::intvars_layout_t const * layout = system.intvars_layout();
+  tchecker::intvars_valuation_t const & intval = s.intval();
+  if (intval.size() != system.intvars_valuation_capacity())
+    return false;
+  for (tchecker::intvar_id_t id = 0; id < intvars.size(); ++id) {
+    tchecker::integer_t const value = (layout == nullptr ? intval[id] : layout->load(intval, id));
+    if (value < intvars.info(id).min() || value > intvars.info(id).max())
+      return false;
+  }
+
+  return true;
+}
+
+bool is_well_formed(tchecker::ta::system_t const & system, tchecker::ta::transition_t const & t)
+{
+  tchecker::vedge_t const & vedge = t.vedge();
+  if (vedge.size() != system.processes_count())
+    return false;
+  tchecker::process_id_t pid = 0;
+  for (auto it = vedge.begin_array(); it != vedge.end_array(); ++it, ++pid)
+    if (*it != tchecker::NO_EDGE && (*it >= system.edges_count() || system.edge(*it)->pid() != pid))
+      return false;
+  return true;
+}
+
 /* attributes */
 
 void attributes(tchecker::ta::system_t const & system, tchecker::ta::state_t const & s, std::map<std::string, std::string> & m)
 {
   tchecker::syncprod::attributes(system.as_syncprod_system(), s, m);
-  m["intval"] = tchecker::to_string(s.intval(), system.integer_variables().flattened().index());
+  m["intval"] = tchecker::to_string(s.intval(), system.integer_variables().flattened().index(), system.intvars_layout());
 }
 
 void attributes(tchecker::ta::system_t const & system, tchecker::ta::transition_t const & t,
@@ -170,7 +283,7 @@ void attributes(tchecker::ta::system_t const & system, tchecker::ta::transition_
 ta_impl_t::ta_impl_t(std::shared_ptr<tchecker::ta::system_t const> const & system, std::size_t block_size,
                      std::size_t table_size)
     : _system(system), _state_allocator(block_size, block_size, _system->processes_count(), block_size,
-                                        _system->intvars_count(tchecker::VK_FLATTENED), table_size),
+                                        _system->intvars_valuation_capacity(), table_size),
       _transition_allocator(block_size, block_size, _system->processes_count(), table_size)
 {
 }
@@ -199,11 +312,29 @@ void ta_impl_t::next(tchecker::ta::const_state_sptr_t const & s, tchecker::ta::o
   v.push_back(std::make_tuple(status, nexts, t));
 }
 
+void ta_impl_t::for_each_next(tchecker::ta::const_state_sptr_t const & s, tchecker::state_status_t mask,
+                              sst_callback_t const & callback)
+{
+  tchecker::ta::outgoing_edges_range_t out_edges = outgoing_edges(s);
+  for (tchecker::ta::outgoing_edges_value_t && out_edge : out_edges) {
+    tchecker::ta::state_sptr_t nexts = _state_allocator.clone(*s);
+    tchecker::ta::transition_sptr_t t = _transition_allocator.construct();
+    tchecker::state_status_t status = tchecker::ta::next(*_system, *nexts, *t, out_edge);
+    if (status & mask)
+      callback(status, nexts, t);
+  }
+}
+
 boost::dynamic_bitset<> ta_impl_t::labels(tchecker::ta::const_state_sptr_t const & s) const
 {
   return tchecker::ta::labels(*_system, *s);
 }
 
+bool ta_impl_t::satisfies(tchecker::ta::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const
+{
+  return tchecker::ta::satisfies(*_system, *s, labels);
+}
+
 bool ta_impl_t::is_valid_final(tchecker::ta::const_state_sptr_t const & s) const
 {
   return tchecker::ta::is_valid_final(*_system, *s);
@@ -223,6 +354,12 @@ void ta_impl_t::share(tchecker::ta::state_sptr_t & s) { _state_allocator.share(s
 
 void ta_impl_t::share(tchecker::ta::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+void ta_impl_t::collect()
+{
+  _transition_allocator.collect();
+  _state_allocator.collect();
+}
+
 tchecker::ta::system_t const & ta_impl_t::system() const { return *_system; }
 
 /* ta_t */
@@ -0,0 +1,359 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iomanip>
+#include <regex>
+#include <sstream>
+#include <stdexcept>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <tuple>
+#include <unistd.h>
+
+#include "bench.hh"
+
+namespace tchecker {
+
+namespace tck_bench {
+
+/* instance_t */
+
+instance_t::instance_t(enum tchecker::tck_bench::tool_t tool, std::string const & generator,
+                       std::vector<std::string> const & generator_args, std::string const & algorithm,
+                       std::string const & search_order)
+    : _tool(tool), _generator(generator), _generator_args(generator_args), _algorithm(algorithm), _search_order(search_order)
+{
+}
+
+std::string instance_t::model() const
+{
+  std::string model = _generator.substr(0, _generator.rfind(".sh"));
+  std::replace(model.begin(), model.end(), '-', '_');
+  for (std::string const & arg : _generator_args)
+    model += "_" + arg;
+  return model;
+}
+
+std::string instance_t::name() const
+{
+  std::string name = model() + "-" + _algorithm;
+  if (!_search_order.empty())
+    name += "-" + _search_order;
+  return name;
+}
+
+/* instances */
+
+std::vector<tchecker::tck_bench::instance_t> instances()
+{
+  using args_t = std::vector<std::string>;
+
+  // Models for tck-reach: (generator, arguments, asynchronous)
+  std::vector<std::tuple<std::string, args_t, bool>> const reach_models = {
+      {"fischer.sh", {"4", "10"}, false},
+      {"csmacd.sh", {"4"}, false},
+      {"train_gate.sh", {"3"}, false},
+      {"parallel-c.sh", {"3"}, false},
+      {"corsso.sh", {"2", "2", "10", "1", "2"}, false},
+      {"dining-philosophers.sh", {"3", "3", "10", "0"}, false},
+      {"critical-region-async.sh", {"2", "10"}, true},
+      {"fischer-async.sh", {"4", "10"}, true},
+  };
+
+  // Models for tck-liveness: (generator, arguments)
+  std::vector<std::tuple<std::string, args_t>> const liveness_models = {
+      {"fischer.sh", {"3", "10"}},
+      {"csmacd.sh", {"3"}},
+      {"train_gate.sh", {"3"}},
+  };
+
+  std::vector<std::string> const search_orders = {"bfs", "dfs"};
+  std::vector<std::string> const liveness_algorithms = {"couvscc", "ndfs"};
+
+  std::vector<tchecker::tck_bench::instance_t> v;
+
+  for (auto && [generator, args, async] : reach_models) {
+    std::vector<std::string> algorithms = {"reach", "covreach"};
+    if (async)
+      algorithms.push_back("concur19");
+    for (std::string const & algorithm : algorithms)
+      for (std::string const & search_order : search_orders)
+        v.emplace_back(tchecker::tck_bench::TOOL_REACH, generator, args, algorithm, search_order);
+  }
+
+  for (auto && [generator, args] : liveness_models)
+    for (std::string const & algorithm : liveness_algorithms)
+      v.emplace_back(tchecker::tck_bench::TOOL_LIVENESS, generator, args, algorithm, "");
+
+  return v;
+}
+
+/*!
+ \brief Run a program
+ \param argv : program path and arguments
+ \param output : file for the standard output of the program
+ \param usage : resource usage of the program
+ \return exit status of the program, -1 if it has not terminated normally
+ \throw std::runtime_error : if the program cannot be run
+ \note the standard error of the program is discarded
+ */
+static int spawn(std::vector<std::string> const & argv, std::string const & output, struct rusage & usage)
+{
+  std::vector<char *> args;
+  for (std::string const & arg : argv)
+    args.push_back(const_cast<char *>(arg.c_str()));
+  args.push_back(nullptr);
+
+  pid_t pid = fork();
+  if (pid == -1)
+    throw std::runtime_error("Unable to fork: " + std::string{std::strerror(errno)});
+
+  if (pid == 0) {
+    int out = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int null = open("/dev/null", O_WRONLY);
+    if (out == -1 || null == -1)
+      _exit(127);
+    dup2(out, STDOUT_FILENO);
+    dup2(null, STDERR_FILENO);
+    close(out);
+    close(null);
+    execvp(args[0], args.data());
+    _exit(127);
+  }
+
+  int status = 0;
+  if (wait4(pid, &status, 0, &usage) == -1)
+    throw std::runtime_error("Unable to wait for " + argv[0] + ": " + std::string{std::strerror(errno)});
+  return (WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+}
+
+/*!
+ \brief Extract searched labels from a generated model
+ \param filename : a model file
+ \return comma-separated list of labels declared by a line #labels=l1:l2:...
+ in filename, empty if no such line
+ */
+static std::string model_labels(std::string const & filename)
+{
+  static std::regex const labels_regex{"^#\\s*labels\\s*=\\s*([a-zA-Z0-9_:]*)\\s*$"};
+  std::ifstream ifs{filename};
+  std::string line;
+  std::smatch match;
+  while (std::getline(ifs, line))
+    if (std::regex_match(line, match, labels_regex)) {
+      std::string labels = match[1];
+      std::replace(labels.begin(), labels.end(), ':', ',');
+      return labels;
+    }
+  return "";
+}
+
+/*!
+ \brief Read statistics output by a tool
+ \param filename : output file of tck-reach or tck-liveness
+ \return map of statistics (KEY value) in filename
+ */
+static std::map<std::string, std::string> read_stats(std::string const & filename)
+{
+  std::map<std::string, std::string> stats;
+  std::ifstream ifs{filename};
+  std::string line;
+  while (std::getline(ifs, line)) {
+    std::size_t const space = line.find(' ');
+    if (space == std::string::npos || space == 0)
+      continue;
+    std::string const key = line.substr(0, space);
+    if (std::all_of(key.begin(), key.end(), [](char c) { return std::isupper(c) || std::isdigit(c) || c == '_'; }))
+      stats[key] = line.substr(space + 1);
+  }
+  return stats;
+}
+
+/* bench_t */
+
+bench_t::bench_t(std::string const & examples_dir, std::string const & tck_reach, std::string const & tck_liveness,
+                 unsigned int warmup, unsigned int repetitions)
+    : _examples_dir(examples_dir), _tck_reach(tck_reach), _tck_liveness(tck_liveness), _warmup(warmup),
+      _repetitions(repetitions)
+{
+  if (_repetitions == 0)
+    throw std::invalid_argument("Number of repetitions should be positive");
+
+  char tmp_dir[] = "/tmp/tck-bench.XXXXXX";
+  if (mkdtemp(tmp_dir) == nullptr)
+    throw std::runtime_error("Unable to create temporary directory: " + std::string{std::strerror(errno)});
+  _tmp_dir = tmp_dir;
+}
+
+bench_t::~bench_t()
+{
+  for (auto && [model, filename] : _models)
+    std::remove(filename.c_str());
+  std::remove((_tmp_dir + "/output").c_str());
+  rmdir(_tmp_dir.c_str());
+}
+
+std::string bench_t::model_file(tchecker::tck_bench::instance_t const & instance)
+{
+  std::string const model = instance.model();
+  auto it = _models.find(model);
+  if (it != _models.end())
+    return it->second;
+
+  std::string const filename = _tmp_dir + "/" + model + ".txt";
+  std::vector<std::string> argv{"bash", _examples_dir + "/" + instance.generator()};
+  argv.insert(argv.end(), instance.generator_args().begin(), instance.generator_args().end());
+  struct rusage usage;
+  if (tchecker::tck_bench::spawn(argv, filename, usage) != 0)
+    throw std::runtime_error("Unable to generate model " + model);
+
+  _models[model] = filename;
+  return filename;
+}
+
+tchecker::tck_bench::result_t bench_t::run(tchecker::tck_bench::instance_t const & instance)
+{
+  std::string const model = model_file(instance);
+  std::string const output = _tmp_dir + "/output";
+
+  std::vector<std::string> argv;
+  argv.push_back(instance.tool() == tchecker::tck_bench::TOOL_REACH ? _tck_reach : _tck_liveness);
+  argv.insert(argv.end(), {"-a", instance.algorithm()});
+  if (!instance.search_order().empty())
+    argv.insert(argv.end(), {"-s", instance.search_order()});
+  std::string const labels = tchecker::tck_bench::model_labels(model);
+  if (!labels.empty())
+    argv.insert(argv.end(), {"-l", labels});
+  argv.push_back(model);
+
+  tchecker::tck_bench::result_t result;
+  result.repetitions = _repetitions;
+  result.max_rss = 0;
+
+  std::vector<double> times;
+  for (unsigned int i = 0; i < _warmup + _repetitions; ++i) {
+    struct rusage usage;
+    std::chrono::time_point<std::chrono::steady_clock> const start = std::chrono::steady_clock::now();
+    int const status = tchecker::tck_bench::spawn(argv, output, usage);
+    std::chrono::duration<double> const time = std::chrono::steady_clock::now() - start;
+    if (status != 0)
+      throw std::runtime_error(argv[0] + " failed on instance " + instance.name());
+    if (i < _warmup)
+      continue;
+    times.push_back(time.count());
+    result.max_rss = std::max(result.max_rss, usage.ru_maxrss);
+  }
+
+  result.stats = tchecker::tck_bench::read_stats(output);
+
+  std::sort(times.begin(), times.end());
+  std::size_t const n = times.size();
+  result.time_min = times.front();
+  result.time_median = (n % 2 == 1 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2);
+  double sum = 0.0;
+  for (double t : times)
+    sum += t;
+  result.time_mean = sum / n;
+  double squares = 0.0;
+  for (double t : times)
+    squares += (t - result.time_mean) * (t - result.time_mean);
+  result.time_stddev = (n > 1 ? std::sqrt(squares / (n - 1)) : 0.0);
+
+  return result;
+}
+
+/* baseline */
+
+std::map<std::string, tchecker::tck_bench::baseline_t> load_baseline(std::string const & filename)
+{
+  std::ifstream ifs{filename};
+  if (!ifs)
+    throw std::runtime_error("Unable to read baseline file " + filename);
+
+  static std::regex const name_regex{"\"name\":\"([^\"]*)\""};
+  static std::regex const time_regex{"\"time_median\":([0-9.eE+-]+)"};
+  static std::regex const visited_regex{"\"VISITED_STATES\":([0-9]+)"};
+
+  std::map<std::string, tchecker::tck_bench::baseline_t> baseline;
+  std::string line;
+  std::smatch match;
+  while (std::getline(ifs, line)) {
+    if (!std::regex_search(line, match, name_regex))
+      continue;
+    std::string const name = match[1];
+    if (!std::regex_search(line, match, time_regex))
+      continue;
+    tchecker::tck_bench::baseline_t & b = baseline[name];
+    b.time_median = std::strtod(match[1].str().c_str(), nullptr);
+    b.visited_states = (std::regex_search(line, match, visited_regex) ? match[1].str() : "");
+  }
+  return baseline;
+}
+
+/* output */
+
+/*!
+ \brief Output a JSON value
+ \param os : output stream
+ \param value : a value
+ \return os after value has been output as a JSON number if it is a number,
+ as a JSON boolean if it is true or false, and as a JSON string otherwise
+ */
+static std::ostream & output_value(std::ostream & os, std::string const & value)
+{
+  static std::regex const number_regex{"-?[0-9]+(\\.[0-9]+)?([eE][+-]?[0-9]+)?"};
+  if (value == "true" || value == "false" || std::regex_match(value, number_regex))
+    return os << value;
+  os << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      os << '\\';
+    os << c;
+  }
+  return os << '"';
+}
+
+std::ostream & output(std::ostream & os, tchecker::tck_bench::instance_t const & instance,
+                      tchecker::tck_bench::result_t const & result, tchecker::tck_bench::baseline_t const * baseline,
+                      bool regression)
+{
+  os << "{\"name\":\"" << instance.name() << "\"";
+  os << ",\"tool\":\"" << (instance.tool() == tchecker::tck_bench::TOOL_REACH ? "tck-reach" : "tck-liveness") << "\"";
+  os << ",\"model\":\"" << instance.model() << "\"";
+  os << ",\"algorithm\":\"" << instance.algorithm() << "\"";
+  if (!instance.search_order().empty())
+    os << ",\"search_order\":\"" << instance.search_order() << "\"";
+  os << ",\"repetitions\":" << result.repetitions;
+  os << std::setprecision(6) << ",\"time_min\":" << result.time_min << ",\"time_median\":" << result.time_median
+     << ",\"time_mean\":" << result.time_mean << ",\"time_stddev\":" << result.time_stddev;
+  os << ",\"max_rss_kb\":" << result.max_rss;
+  os << ",\"stats\":{";
+  bool first = true;
+  for (auto && [key, value] : result.stats) {
+    os << (first ? "" : ",") << "\"" << key << "\":";
+    tchecker::tck_bench::output_value(os, value);
+    first = false;
+  }
+  os << "}";
+  if (baseline != nullptr)
+    os << ",\"baseline_time_median\":" << baseline->time_median << ",\"regression\":" << (regression ? "true" : "false");
+  return os << "}";
+}
+
+} // end of namespace tck_bench
+
+} // end of namespace tchecker
@@ -0,0 +1,224 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TCK_BENCH_BENCH_HH
+#define TCHECKER_TCK_BENCH_BENCH_HH
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ \file bench.hh
+ \brief Benchmarks of TChecker tools over generated models
+ */
+
+namespace tchecker {
+
+namespace tck_bench {
+
+/*!
+ \brief Tools
+ */
+enum tool_t {
+  TOOL_REACH,    /*!< tck-reach */
+  TOOL_LIVENESS, /*!< tck-liveness */
+};
+
+/*!
+ \class instance_t
+ \brief Benchmark instance: a tool run with some options on a generated model
+ */
+class instance_t {
+public:
+  /*!
+   \brief Constructor
+   \param tool : a tool
+   \param generator : model generator script (in examples directory)
+   \param generator_args : arguments to generator
+   \param algorithm : algorithm
+   \param search_order : search order (empty if none)
+   */
+  instance_t(enum tchecker::tck_bench::tool_t tool, std::string const & generator,
+             std::vector<std::string> const & generator_args, std::string const & algorithm,
+             std::string const & search_order);
+
+  /*!
+   \brief Accessor
+   \return tool
+   */
+  inline enum tchecker::tck_bench::tool_t tool() const { return _tool; }
+
+  /*!
+   \brief Accessor
+   \return model generator script
+   */
+  inline std::string const & generator() const { return _generator; }
+
+  /*!
+   \brief Accessor
+   \return arguments to the model generator
+   */
+  inline std::vector<std::string> const & generator_args() const { return _generator_args; }
+
+  /*!
+   \brief Accessor
+   \return name of the generated model, e.g. fischer_4_10 for generator
+   fischer.sh with arguments 4 and 10
+   */
+  std::string model() const;
+
+  /*!
+   \brief Accessor
+   \return algorithm
+   */
+  inline std::string const & algorithm() const { return _algorithm; }
+
+  /*!
+   \brief Accessor
+   \return search order, empty if none
+   */
+  inline std::string const & search_order() const { return _search_order; }
+
+  /*!
+   \brief Accessor
+   \return name of the instance, unique in tchecker::tck_bench::instances()
+   */
+  std::string name() const;
+
+private:
+  enum tchecker::tck_bench::tool_t _tool;   /*!< Tool */
+  std::string _generator;                   /*!< Model generator script */
+  std::vector<std::string> _generator_args; /*!< Arguments to model generator */
+  std::string _algorithm;                   /*!< Algorithm */
+  std::string _search_order;                /*!< Search order */
+};
+
+/*!
+ \brief Accessor
+ \return fixed matrix of benchmark instances: each reachability algorithm and
+ search order of tck-reach, and each algorithm of tck-liveness, on a fixed set
+ of generated models
+ */
+std::vector<tchecker::tck_bench::instance_t> instances();
+
+/*!
+ \class result_t
+ \brief Summary of repeated runs of an instance
+ */
+class result_t {
+public:
+  unsigned int repetitions;                 /*!< Number of measured runs */
+  double time_min;                          /*!< Minimal wall-clock time (seconds) */
+  double time_median;                       /*!< Median wall-clock time (seconds) */
+  double time_mean;                         /*!< Mean wall-clock time (seconds) */
+  double time_stddev;                       /*!< Standard deviation of wall-clock time (seconds) */
+  long max_rss;                             /*!< Maximal resident set size over runs (kilobytes) */
+  std::map<std::string, std::string> stats; /*!< Statistics output by the tool on the last run */
+};
+
+/*!
+ \class baseline_t
+ \brief Result of an instance in a baseline file
+ */
+class baseline_t {
+public:
+  double time_median;         /*!< Median wall-clock time (seconds) */
+  std::string visited_states; /*!< Number of visited states (empty if unknown) */
+};
+
+/*!
+ \class bench_t
+ \brief Benchmark runner
+ */
+class bench_t {
+public:
+  /*!
+   \brief Constructor
+   \param examples_dir : directory of model generators
+   \param tck_reach : path to tck-reach
+   \param tck_liveness : path to tck-liveness
+   \param warmup : number of unmeasured runs before measures
+   \param repetitions : number of measured runs
+   \pre repetitions > 0
+   \throw std::invalid_argument : if repetitions is 0
+   \throw std::runtime_error : if a temporary directory cannot be created
+   */
+  bench_t(std::string const & examples_dir, std::string const & tck_reach, std::string const & tck_liveness,
+          unsigned int warmup, unsigned int repetitions);
+
+  /*!
+   \brief Copy constructor (deleted)
+   */
+  bench_t(tchecker::tck_bench::bench_t const &) = delete;
+
+  /*!
+   \brief Destructor
+   \post the temporary directory and the generated models have been removed
+   */
+  ~bench_t();
+
+  /*!
+   \brief Assignment operator (deleted)
+   */
+  tchecker::tck_bench::bench_t & operator=(tchecker::tck_bench::bench_t const &) = delete;
+
+  /*!
+   \brief Run an instance
+   \param instance : an instance
+   \return summary of warmup + repetitions runs of instance
+   \throw std::runtime_error : if the model cannot be generated, or if the tool
+   fails
+   \note models are generated once, and cached in a temporary directory
+   */
+  tchecker::tck_bench::result_t run(tchecker::tck_bench::instance_t const & instance);
+
+private:
+  /*!
+   \brief Generate a model
+   \param instance : an instance
+   \return path to the model of instance
+   \throw std::runtime_error : if the model cannot be generated
+   */
+  std::string model_file(tchecker::tck_bench::instance_t const & instance);
+
+  std::string _examples_dir;                      /*!< Directory of model generators */
+  std::string _tck_reach;                         /*!< Path to tck-reach */
+  std::string _tck_liveness;                      /*!< Path to tck-liveness */
+  unsigned int _warmup;                           /*!< Number of unmeasured runs */
+  unsigned int _repetitions;                      /*!< Number of measured runs */
+  std::string _tmp_dir;                           /*!< Temporary directory */
+  std::map<std::string, std::string> _models;     /*!< Map : model name -> generated model file */
+};
+
+/*!
+ \brief Load a baseline file
+ \param filename : name of a file output by tchecker::tck_bench::output
+ \return map from instance names to baseline results
+ \throw std::runtime_error : if filename cannot be read
+ */
+std::map<std::string, tchecker::tck_bench::baseline_t> load_baseline(std::string const & filename);
+
+/*!
+ \brief Output the result of an instance as a JSON object on a single line
+ \param os : output stream
+ \param instance : an instance
+ \param result : result of instance
+ \param baseline : baseline result for instance (nullptr if none)
+ \param regression : true if result is a regression w.r.t. baseline
+ \return os after output
+ */
+std::ostream & output(std::ostream & os, tchecker::tck_bench::instance_t const & instance,
+                      tchecker::tck_bench::result_t const & result, tchecker::tck_bench::baseline_t const * baseline,
+                      bool regression);
+
+} // end of namespace tck_bench
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TCK_BENCH_BENCH_HH
@@ -0,0 +1,224 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <regex>
+#include <string>
+
+#include "bench.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-bench.cc
+ \brief Benchmarks of TChecker tools over generated models
+ */
+
+static struct option long_options[] = {{"baseline", required_argument, 0, 'b'},
+                                       {"examples", required_argument, 0, 'e'},
+                                       {"filter", required_argument, 0, 'f'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"list", no_argument, 0, 'l'},
+                                       {"output", required_argument, 0, 'o'},
+                                       {"repetitions", required_argument, 0, 'r'},
+                                       {"threshold", required_argument, 0, 't'},
+                                       {"warmup", required_argument, 0, 'w'},
+                                       {"tck-reach", required_argument, 0, 0},
+                                       {"tck-liveness", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"b:e:f:hlo:r:t:w:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options]" << std::endl;
+  std::cerr << "   -b file       baseline file (output of a previous run) to compare with" << std::endl;
+  std::cerr << "   -e dir        directory of model generators (default: " << TCK_BENCH_EXAMPLES_DIR << ")" << std::endl;
+  std::cerr << "   -f regex      only run instances whose name matches regex" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -l            list instances and exit" << std::endl;
+  std::cerr << "   -o out_file   output file for results (default is standard output)" << std::endl;
+  std::cerr << "   -r n          number of measured runs per instance (default: 5)" << std::endl;
+  std::cerr << "   -t percent    regression threshold on median time w.r.t. baseline (default: 10)" << std::endl;
+  std::cerr << "   -w n          number of warmup runs per instance (default: 1)" << std::endl;
+  std::cerr << "   --tck-reach path     path to tck-reach (default: " << TCK_BENCH_TCK_REACH << ")" << std::endl;
+  std::cerr << "   --tck-liveness path  path to tck-liveness (default: " << TCK_BENCH_TCK_LIVENESS << ")" << std::endl;
+  std::cerr << "outputs one JSON object per instance and per line, with wall-clock time summary, maximal" << std::endl;
+  std::cerr << "resident set size, and statistics output by the tool (including profiling counters if" << std::endl;
+  std::cerr << "TChecker has been built with TCHECKER_PROFILING). Exits with failure if a regression is found" << std::endl;
+}
+
+static std::string baseline_file = "";                    /*!< Baseline file (empty means no baseline) */
+static std::string examples_dir = TCK_BENCH_EXAMPLES_DIR; /*!< Directory of model generators */
+static std::string filter = "";                           /*!< Filter on instance names */
+static bool help = false;                                 /*!< Help flag */
+static bool list = false;                                 /*!< List flag */
+static std::string output_file = "";                      /*!< Output file name (empty means standard output) */
+static unsigned int repetitions = 5;                      /*!< Number of measured runs */
+static double threshold = 10.0;                           /*!< Regression threshold (percent) */
+static unsigned int warmup = 1;                           /*!< Number of warmup runs */
+static std::string tck_reach = TCK_BENCH_TCK_REACH;       /*!< Path to tck-reach */
+static std::string tck_liveness = TCK_BENCH_TCK_LIVENESS; /*!< Path to tck-liveness */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'b':
+        baseline_file = optarg;
+        break;
+      case 'e':
+        examples_dir = optarg;
+        break;
+      case 'f':
+        filter = optarg;
+        break;
+      case 'h':
+        help = true;
+        break;
+      case 'l':
+        list = true;
+        break;
+      case 'o':
+        output_file = optarg;
+        break;
+      case 'r':
+        repetitions = std::strtoul(optarg, nullptr, 10);
+        break;
+      case 't':
+        threshold = std::strtod(optarg, nullptr);
+        break;
+      case 'w':
+        warmup = std::strtoul(optarg, nullptr, 10);
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "tck-reach") == 0)
+        tck_reach = optarg;
+      else if (strcmp(long_options[long_option_index].name, "tck-liveness") == 0)
+        tck_liveness = optarg;
+      else
+        throw std::runtime_error("This also should never be executed");
+    }
+  }
+
+  return optind;
+}
+
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (optindex != argc) {
+      std::cerr << "Unexpected arguments" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    std::regex const filter_regex{filter};
+    std::vector<tchecker::tck_bench::instance_t> instances;
+    for (tchecker::tck_bench::instance_t const & instance : tchecker::tck_bench::instances())
+      if (std::regex_search(instance.name(), filter_regex))
+        instances.push_back(instance);
+
+    if (list) {
+      for (tchecker::tck_bench::instance_t const & instance : instances)
+        std::cout << instance.name() << std::endl;
+      return EXIT_SUCCESS;
+    }
+
+    std::map<std::string, tchecker::tck_bench::baseline_t> baseline;
+    if (baseline_file != "")
+      baseline = tchecker::tck_bench::load_baseline(baseline_file);
+
+    std::ostream * os = &std::cout;
+    std::shared_ptr<std::ofstream> os_ptr{nullptr};
+    if (output_file != "") {
+      os_ptr = std::make_shared<std::ofstream>(output_file);
+      if (!*os_ptr)
+        throw std::runtime_error("Unable to open output file " + output_file);
+      os = os_ptr.get();
+    }
+
+    tchecker::tck_bench::bench_t bench{examples_dir, tck_reach, tck_liveness, warmup, repetitions};
+
+    std::size_t regressions = 0, i = 0;
+    for (tchecker::tck_bench::instance_t const & instance : instances) {
+      ++i;
+      tchecker::tck_bench::result_t result = bench.run(instance);
+
+      std::cerr << "[" << i << "/" << instances.size() << "] " << instance.name() << ": " << result.time_median << "s";
+
+      auto it = baseline.find(instance.name());
+      tchecker::tck_bench::baseline_t const * b = (it == baseline.end() ? nullptr : &it->second);
+      bool regression = false;
+      if (b != nullptr) {
+        double const change = (b->time_median > 0 ? 100.0 * (result.time_median - b->time_median) / b->time_median : 0.0);
+        regression = (change > threshold);
+        std::cerr << " (" << (change >= 0 ? "+" : "") << change << "% w.r.t. baseline)";
+        if (regression)
+          std::cerr << " REGRESSION";
+        if (b->visited_states != "" && b->visited_states != result.stats["VISITED_STATES"]) {
+          std::cerr << " VISITED_STATES " << b->visited_states << " -> " << result.stats["VISITED_STATES"];
+          regression = true;
+        }
+      }
+      std::cerr << std::endl;
+
+      tchecker::tck_bench::output(*os, instance, result, b, regression) << std::endl;
+      if (regression)
+        ++regressions;
+    }
+
+    if (regressions > 0) {
+      std::cerr << tchecker::log_error << regressions << " regression(s) w.r.t. baseline " << baseline_file << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,261 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstring>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+
+#include "tchecker/graph/binary_certificate.hh"
+#include "tchecker/graph/output.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-certificate.cc
+ \brief Conversion of binary certificates to graphviz DOT or JSON
+ */
+
+static struct option long_options[] = {{"format", required_argument, 0, 'f'},
+                                       {"output", required_argument, 0, 'o'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"f:ho:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options] file" << std::endl;
+  std::cerr << "   -f format     output format" << std::endl;
+  std::cerr << "          dot        graphviz DOT language (default)" << std::endl;
+  std::cerr << "          json       JSON" << std::endl;
+  std::cerr << "          stats      numbers of nodes and edges" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -o out_file   output file (default is standard output)" << std::endl;
+  std::cerr << "converts the binary certificate file (tck-reach -C binary, tck-liveness --binary)" << std::endl;
+}
+
+/*!
+ \brief Type of output format
+ */
+enum format_t {
+  FORMAT_DOT,   /*!< graphviz DOT language */
+  FORMAT_JSON,  /*!< JSON */
+  FORMAT_STATS, /*!< Statistics */
+};
+
+static bool help = false;                    /*!< Help flag */
+static enum format_t format = FORMAT_DOT;    /*!< Output format */
+static std::string output_file = "";         /*!< Output file name (empty means standard output) */
+static std::ostream * os = &std::cout;       /*!< Default output stream */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables help, format and output_file have been set from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'f':
+        if (strcmp(optarg, "dot") == 0)
+          format = FORMAT_DOT;
+        else if (strcmp(optarg, "json") == 0)
+          format = FORMAT_JSON;
+        else if (strcmp(optarg, "stats") == 0)
+          format = FORMAT_STATS;
+        else
+          throw std::runtime_error("Unknown output format: " + std::string(optarg));
+        break;
+      case 'h':
+        help = true;
+        break;
+      case 'o':
+        output_file = optarg;
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else
+      throw std::runtime_error("This also should never be executed");
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Output a certificate in graphviz DOT language
+ \param os : output stream
+ \param c : a certificate
+ \post c has been output to os. Nodes are named by their number in c
+ */
+static void dot_output(std::ostream & os, tchecker::graph::binary::certificate_t const & c)
+{
+  std::map<std::string, std::string> attr;
+
+  tchecker::graph::dot_output_header(os, std::string(c.name()));
+  for (std::uint64_t n = 0; n < c.nodes_count(); ++n) {
+    std::string const src = std::to_string(n);
+    attr.clear();
+    c.attributes(n, attr);
+    tchecker::graph::dot_output_node(os, src, attr);
+
+    auto && [first, last] = c.outgoing_edges(n);
+    for (std::uint64_t e = first; e < last; ++e) {
+      attr.clear();
+      c.edge_attributes(e, attr);
+      tchecker::graph::dot_output_edge(os, src, std::to_string(c.edge_tgt(e)), attr);
+    }
+  }
+  tchecker::graph::dot_output_footer(os);
+}
+
+/*!
+ \brief Output a JSON string
+ \param os : output stream
+ \param s : a string
+ \post s has been output to os as a JSON string literal
+ */
+static void json_output_string(std::ostream & os, std::string_view s)
+{
+  static char const hex[] = "0123456789abcdef";
+  os << '"';
+  for (char c : s) {
+    if (c == '"' || c == '\\')
+      os << '\\' << c;
+    else if (static_cast<unsigned char>(c) < 0x20)
+      os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+    else
+      os << c;
+  }
+  os << '"';
+}
+
+/*!
+ \brief Output attributes in JSON
+ \param os : output stream
+ \param attr : attributes
+ \post attr have been output to os as members of a JSON object
+ */
+static void json_output_attributes(std::ostream & os, std::map<std::string, std::string> const & attr)
+{
+  for (auto && [key, value] : attr) {
+    os << ", ";
+    json_output_string(os, key);
+    os << ": ";
+    json_output_string(os, value);
+  }
+}
+
+/*!
+ \brief Output a certificate in JSON
+ \param os : output stream
+ \param c : a certificate
+ \post c has been output to os as a JSON object with the name of the graph,
+ the array of nodes and the array of edges. Nodes and edges are output one per
+ line
+ */
+static void json_output(std::ostream & os, tchecker::graph::binary::certificate_t const & c)
+{
+  std::map<std::string, std::string> attr;
+
+  os << "{\"name\": ";
+  json_output_string(os, c.name());
+  os << "," << std::endl << "\"nodes\": [" << std::endl;
+  for (std::uint64_t n = 0; n < c.nodes_count(); ++n) {
+    attr.clear();
+    c.attributes(n, attr);
+    os << "  {\"id\": " << n;
+    json_output_attributes(os, attr);
+    os << "}" << (n + 1 < c.nodes_count() ? "," : "") << std::endl;
+  }
+  os << "]," << std::endl << "\"edges\": [" << std::endl;
+  for (std::uint64_t n = 0; n < c.nodes_count(); ++n) {
+    auto && [first, last] = c.outgoing_edges(n);
+    for (std::uint64_t e = first; e < last; ++e) {
+      attr.clear();
+      c.edge_attributes(e, attr);
+      os << "  {\"src\": " << n << ", \"tgt\": " << c.edge_tgt(e);
+      json_output_attributes(os, attr);
+      os << "}" << (e + 1 < c.edges_count() ? "," : "") << std::endl;
+    }
+  }
+  os << "]}" << std::endl;
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (optindex + 1 != argc) {
+      std::cerr << "Expected exactly one certificate file" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    tchecker::graph::binary::certificate_t certificate{argv[optindex]};
+
+    std::shared_ptr<std::ofstream> os_ptr{nullptr};
+    if (output_file != "") {
+      os_ptr = std::make_shared<std::ofstream>(output_file);
+      if (!*os_ptr)
+        throw std::runtime_error("Unable to open output file " + output_file);
+      os = os_ptr.get();
+    }
+
+    switch (format) {
+    case FORMAT_DOT:
+      dot_output(*os, certificate);
+      break;
+    case FORMAT_JSON:
+      json_output(*os, certificate);
+      break;
+    case FORMAT_STATS:
+      *os << "NAME " << certificate.name() << std::endl;
+      *os << "NODES " << certificate.nodes_count() << std::endl;
+      *os << "EDGES " << certificate.edges_count() << std::endl;
+      break;
+    }
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -10,8 +10,11 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 
+#include "tchecker/algorithms/checkpoint.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/parsing/parsing.hh"
 #include "tchecker/utils/log.hh"
 #include "zg-couvscc.hh"
@@ -27,8 +30,15 @@ static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"help", no_argument, 0, 'h'},
                                        {"labels", required_argument, 0, 'l'},
                                        {"output", required_argument, 0, 'o'},
+                                       {"progress", required_argument, 0, 0},
+                                       {"progress-file", required_argument, 0, 0},
+                                       {"checkpoint", required_argument, 0, 0},
+                                       {"checkpoint-period", required_argument, 0, 0},
+                                       {"resume", required_argument, 0, 0},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
+                                       {"unsorted", no_argument, 0, 0},
+                                       {"binary", no_argument, 0, 0},
                                        {0, 0, 0, 0}};
 
 static char const * const options = (char *)"a:Chl:o:";
@@ -49,8 +59,16 @@ void usage(char * progname)
   std::cerr << "   -h            help" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of accepting labels" << std::endl;
   std::cerr << "   -o out_file   output file for certificate (default is standard output)" << std::endl;
+  std::cerr << "   --progress seconds  report progress every seconds on standard error (or in progress file)" << std::endl;
+  std::cerr << "   --progress-file f   report progress as JSON lines in file f (every second by default)" << std::endl;
+  std::cerr << "   --checkpoint f      save the state of the algorithm to file f periodically" << std::endl;
+  std::cerr << "   --checkpoint-period seconds  time between two checkpoints (default: 600)" << std::endl;
+  std::cerr << "   --resume f          resume from checkpoint file f (same model and options)" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
+  std::cerr << "   --unsorted    output the certificate without sorting: nodes are named in exploration order" << std::endl;
+  std::cerr << "                 and output without building a sorted copy of the graph (faster, less memory)" << std::endl;
+  std::cerr << "   --binary      output the certificate as a binary certificate (requires -o)" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
 }
 
@@ -73,6 +91,13 @@ static std::string output_file = "";                      /*!< Output file name
 static std::ostream * os = &std::cout;                    /*!< Default output stream */
 static std::size_t block_size = 10000;                    /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;                    /*!< Size of hash tables */
+static double progress_period = 0;                        /*!< Period of progress reports in seconds (0 to disable) */
+static std::string progress_file = "";                    /*!< Progress reports file (empty means standard error) */
+static std::string checkpoint_file = "";                  /*!< Checkpoint file (empty to disable checkpoints) */
+static double checkpoint_period = 600;                    /*!< Period of checkpoints in seconds */
+static bool sorted_certificate = true;                    /*!< Sort certificate graph */
+static bool binary_certificate = false;                   /*!< Output certificate graph in binary format */
+static std::string resume_file = "";                      /*!< Resume file (empty to start from initial states) */
 
 /*!
  \brief Parse command-line arguments
@@ -127,6 +152,20 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "unsorted") == 0)
+        sorted_certificate = false;
+      else if (strcmp(long_options[long_option_index].name, "binary") == 0)
+        binary_certificate = true;
+      else if (strcmp(long_options[long_option_index].name, "progress") == 0)
+        progress_period = std::strtod(optarg, nullptr);
+      else if (strcmp(long_options[long_option_index].name, "progress-file") == 0)
+        progress_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "checkpoint") == 0)
+        checkpoint_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "checkpoint-period") == 0)
+        checkpoint_period = std::strtod(optarg, nullptr);
+      else if (strcmp(long_options[long_option_index].name, "resume") == 0)
+        resume_file = optarg;
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -174,8 +213,12 @@ void ndfs(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysde
     std::cout << key << " " << value << std::endl;
 
   // certificate
-  if (certificate == CERTIFICATE_GRAPH)
+  if (certificate == CERTIFICATE_GRAPH && binary_certificate)
+    tchecker::tck_liveness::zg_ndfs::binary_output(*os, *graph, sysdecl->name());
+  else if (certificate == CERTIFICATE_GRAPH && sorted_certificate)
     tchecker::tck_liveness::zg_ndfs::dot_output(*os, *graph, sysdecl->name());
+  else if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_liveness::zg_ndfs::dot_output_unsorted(*os, *graph, sysdecl->name());
 }
 
 /*!
@@ -196,8 +239,12 @@ void couvscc(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sy
     std::cout << key << " " << value << std::endl;
 
   // certificate
-  if (certificate == CERTIFICATE_GRAPH)
+  if (certificate == CERTIFICATE_GRAPH && binary_certificate)
+    tchecker::tck_liveness::zg_couvscc::binary_output(*os, *graph, sysdecl->name());
+  else if (certificate == CERTIFICATE_GRAPH && sorted_certificate)
     tchecker::tck_liveness::zg_couvscc::dot_output(*os, *graph, sysdecl->name());
+  else if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_liveness::zg_couvscc::dot_output_unsorted(*os, *graph, sysdecl->name());
 }
 
 /*!
@@ -226,11 +273,15 @@ int main(int argc, char * argv[])
     if (tchecker::log_error_count() > 0)
       return EXIT_FAILURE;
 
+    if (certificate != CERTIFICATE_NONE && binary_certificate && output_file == "")
+      throw std::runtime_error("Binary certificates must be output to a file (-o)");
+
     std::shared_ptr<std::ofstream> os_ptr{nullptr};
 
     if (certificate != CERTIFICATE_NONE && output_file != "") {
       try {
-        os_ptr = std::make_shared<std::ofstream>(output_file);
+        os_ptr = std::make_shared<std::ofstream>(output_file,
+                                                 (binary_certificate ? std::ios::out | std::ios::binary : std::ios::out));
         os = os_ptr.get();
       }
       catch (std::exception & e) {
@@ -239,6 +290,28 @@ int main(int argc, char * argv[])
       }
     }
 
+    std::shared_ptr<std::ofstream> progress_os_ptr{nullptr};
+
+    if (progress_file != "") {
+      progress_os_ptr = std::make_shared<std::ofstream>(progress_file);
+      if (!*progress_os_ptr)
+        throw std::runtime_error("Unable to open progress file " + progress_file);
+      tchecker::algorithms::set_progress(std::make_shared<tchecker::algorithms::progress_t>(
+          *progress_os_ptr, tchecker::algorithms::PROGRESS_JSON, (progress_period > 0 ? progress_period : 1.0)));
+    }
+    else if (progress_period > 0)
+      tchecker::algorithms::set_progress(
+          std::make_shared<tchecker::algorithms::progress_t>(std::cerr, tchecker::algorithms::PROGRESS_TEXT, progress_period));
+
+    if (checkpoint_file != "" || resume_file != "") {
+      if (checkpoint_period <= 0)
+        throw std::runtime_error("Checkpoint period should be positive");
+      std::ostringstream configuration;
+      configuration << "tck-liveness " << algorithm << " " << labels << std::endl << *sysdecl;
+      tchecker::algorithms::set_checkpoint(std::make_shared<tchecker::algorithms::checkpoint_t>(
+          checkpoint_file, checkpoint_period, resume_file, configuration.str()));
+    }
+
     switch (algorithm) {
     case ALGO_NDFS:
       ndfs(sysdecl);
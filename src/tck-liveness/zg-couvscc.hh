@@ -9,18 +9,20 @@
 #define TCHECKER_ZG_COUVREUR_SCC_ALGORITHM_HH
 
 #include <memory>
-#include <ostream>
+#include <iostream>
 #include <string>
 #include <tuple>
 
 #include "tchecker/algorithms/couvreur_scc/algorithm.hh"
 #include "tchecker/algorithms/couvreur_scc/graph.hh"
 #include "tchecker/algorithms/couvreur_scc/stats.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
@@ -125,10 +127,51 @@ public:
   */
   virtual ~graph_t();
 
+  /*!
+   \brief Accessor
+   \return internal zone graph
+  */
+  inline tchecker::zg::sharing_zg_t const & zg() const { return *_zg; }
+
   using tchecker::graph::reachability::graph_t<
       tchecker::tck_liveness::zg_couvscc::node_t, tchecker::tck_liveness::zg_couvscc::edge_t,
       tchecker::tck_liveness::zg_couvscc::node_hash_t, tchecker::tck_liveness::zg_couvscc::node_equal_to_t>::attributes;
 
+  /*!
+   \brief Save a node to a checkpoint
+   \param os : output stream
+   \param n : a node
+   \post the state, the flags, the DFS number and the current flag of n have been written to os
+   */
+  void save_node(std::ostream & os, node_sptr_t const & n) const;
+
+  /*!
+   \brief Load a node from a checkpoint
+   \param is : input stream
+   \return a new node in this graph, read from is (see save_node)
+   \throw std::runtime_error : if is does not contain a node of this graph
+   */
+  node_sptr_t load_node(std::istream & is);
+
+  /*!
+   \brief Save an edge to a checkpoint
+   \param os : output stream
+   \param e : an edge
+   \post the tuple of edges of e have been written to os
+   */
+  void save_edge(std::ostream & os, edge_sptr_t const & e) const;
+
+  /*!
+   \brief Load an edge from a checkpoint
+   \param is : input stream
+   \param src : source node
+   \param tgt : target node
+   \post an edge from src to tgt read from is (see save_edge) has been added to
+   this graph
+   \throw std::runtime_error : if is does not contain an edge of this graph
+   */
+  void load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt);
+
 protected:
   /*!
    \brief Accessor to node attributes
@@ -159,6 +202,26 @@ private:
 */
 std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name);
 
+/*!
+ \brief Graph output without sorting
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os, with nodes named by their
+ identifiers in exploration order (see tchecker::graph::dot_output_unsorted)
+*/
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name);
+
+/*!
+ \brief Graph output as a binary certificate
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os as a binary certificate (see
+ tchecker::graph::binary::binary_output)
+*/
+std::ostream & binary_output(std::ostream & os, tchecker::tck_liveness::zg_couvscc::graph_t const & g, std::string const & name);
+
 /*!
  \class algorithm_t
  \brief Couvreur's liveness algorithm over the zone graph
@@ -170,6 +233,23 @@ public:
                                                    tchecker::tck_liveness::zg_couvscc::graph_t>::algorithm_t;
 };
 
+/*!
+ \brief Run Couvreur's algorithm on the zone graph of a system
+ \param system : a system of timed processes
+ \param clock_bounds : clock bounds of system
+ \param labels : comma-separated string of labels
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \pre labels must appear as node attributes in system
+ \return statistics on the run and the liveness graph
+ \note system and clock_bounds are not modified, and can be reused by subsequent
+ runs
+ */
+std::tuple<tchecker::algorithms::couvscc::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_couvscc::graph_t>>
+run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::string const & labels,
+    std::size_t block_size, std::size_t table_size);
+
 /*!
  \brief Run Couvreur's algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -5,11 +5,17 @@
  *
  */
 
+#include <cstdint>
+#include <stdexcept>
+
 #include <boost/dynamic_bitset.hpp>
 
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/graph/binary_certificate.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/serialization.hh"
 #include "zg-ndfs.hh"
 
 namespace tchecker {
@@ -79,6 +85,36 @@ void graph_t::attributes(tchecker::tck_liveness::zg_ndfs::edge_t const & e, std:
   m["vedge"] = tchecker::to_string(e.vedge(), _zg->system().as_system_system());
 }
 
+void graph_t::save_node(std::ostream & os, node_sptr_t const & n) const
+{
+  tchecker::zg::serialize(os, n->state());
+  tchecker::graph::serialize(os, static_cast<tchecker::graph::node_flags_t const &>(*n));
+  tchecker::serialization::write(os, static_cast<std::uint8_t>(n->color()));
+}
+
+graph_t::node_sptr_t graph_t::load_node(std::istream & is)
+{
+  auto && [is_new_node, n] = add_node(_zg->deserialize_state(is));
+  if (!is_new_node)
+    throw std::runtime_error("Duplicate state in checkpoint");
+  tchecker::graph::deserialize(is, static_cast<tchecker::graph::node_flags_t &>(*n));
+  std::uint8_t const color = tchecker::serialization::read<std::uint8_t>(is);
+  if (color > tchecker::algorithms::ndfs::RED)
+    throw std::runtime_error("Invalid node color in checkpoint");
+  n->color() = static_cast<enum tchecker::algorithms::ndfs::color_t>(color);
+  return n;
+}
+
+void graph_t::save_edge(std::ostream & os, edge_sptr_t const & e) const
+{
+  tchecker::serialize(os, e->vedge());
+}
+
+void graph_t::load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt)
+{
+  add_edge(src, tgt, *_zg->deserialize_transition(is));
+}
+
 /* dot_output */
 
 /*!
@@ -131,18 +167,28 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::gr
                                                    tchecker::tck_liveness::zg_ndfs::edge_lexical_less_t>(os, g, name);
 }
 
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_liveness::zg_ndfs::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::reachability::dot_output_unsorted<tchecker::tck_liveness::zg_ndfs::graph_t>(os, g, name);
+}
+
+std::ostream & binary_output(std::ostream & os, tchecker::tck_liveness::zg_ndfs::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::binary::binary_output(os, g, name, g.zg().system());
+}
+
 /* run */
 
 std::tuple<tchecker::algorithms::ndfs::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::string const & labels,
     std::size_t block_size, std::size_t table_size)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
   std::shared_ptr<tchecker::zg::sharing_zg_t> zg{tchecker::zg::factory_sharing(
-      system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+      system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, *clock_bounds, block_size, table_size)};
 
   std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t> graph{
       new tchecker::tck_liveness::zg_ndfs::graph_t{zg, block_size, table_size}};
@@ -156,6 +202,19 @@ run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, st
   return std::make_tuple(stats, graph);
 }
 
+std::tuple<tchecker::algorithms::ndfs::stats_t, std::shared_ptr<tchecker::tck_liveness::zg_ndfs::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+    std::size_t block_size, std::size_t table_size)
+{
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Unable to compute clock bounds");
+
+  return tchecker::tck_liveness::zg_ndfs::run(system, clock_bounds, labels, block_size, table_size);
+}
+
 } // namespace zg_ndfs
 
 } // namespace tck_liveness
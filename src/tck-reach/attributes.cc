@@ -0,0 +1,49 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include "attributes.hh"
+#include "tchecker/zg/extrapolation.hh"
+#include "tchecker/zg/symmetry.hh"
+
+namespace tchecker {
+
+namespace tck_reach {
+
+void active_clocks_attributes(tchecker::zg::sharing_zg_t const & zg, std::map<std::string, std::string> & m)
+{
+  auto extrapolation = std::dynamic_pointer_cast<tchecker::zg::active_clocks_extrapolation_t const>(zg.extrapolation());
+  if (extrapolation.get() == nullptr)
+    return;
+  m["FREED_CLOCKS"] = std::to_string(extrapolation->freed_clocks());
+}
+
+void intvars_reset_attributes(tchecker::zg::sharing_zg_t const & zg, std::map<std::string, std::string> & m)
+{
+  if (zg.intvars_reset_successors() != 0)
+    m["INTVARS_RESET_SUCCESSORS"] = std::to_string(zg.intvars_reset_successors());
+}
+
+void intvars_reset_attributes(tchecker::refzg::sharing_refzg_t const & refzg, std::map<std::string, std::string> & m)
+{
+  if (refzg.intvars_reset_successors() != 0)
+    m["INTVARS_RESET_SUCCESSORS"] = std::to_string(refzg.intvars_reset_successors());
+}
+
+void symmetry_attributes(tchecker::zg::sharing_zg_t const & zg, std::map<std::string, std::string> & m)
+{
+  std::shared_ptr<tchecker::zg::symmetry_t const> symmetry = zg.symmetry();
+  if (symmetry.get() == nullptr)
+    return;
+  m["SYMMETRY_GROUPS"] = std::to_string(symmetry->groups().size());
+  m["SYMMETRY_PERMUTED_STATES"] = std::to_string(symmetry->permuted_states());
+}
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
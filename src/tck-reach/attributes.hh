@@ -0,0 +1,66 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TCK_REACH_ATTRIBUTES_HH
+#define TCHECKER_TCK_REACH_ATTRIBUTES_HH
+
+#include <map>
+#include <string>
+
+#include "tchecker/refzg/refzg.hh"
+#include "tchecker/zg/zg.hh"
+
+/*!
+ \file attributes.hh
+ \brief Statistics on the zone graphs explored by reachability algorithms
+ */
+
+namespace tchecker {
+
+namespace tck_reach {
+
+/*!
+ \brief Add statistics on inactive clocks
+ \param zg : a zone graph
+ \param m : attributes map
+ \post the number of clocks freed in zones has been added to m if zg frees
+ inactive clocks
+ */
+void active_clocks_attributes(tchecker::zg::sharing_zg_t const & zg, std::map<std::string, std::string> & m);
+
+/*!
+ \brief Add statistics on the reset of dead bounded integer variables
+ \param zg : a zone graph
+ \param m : attributes map
+ \post the number of successors where dead bounded integer variables have been
+ reset has been added to m if it is not zero
+ */
+void intvars_reset_attributes(tchecker::zg::sharing_zg_t const & zg, std::map<std::string, std::string> & m);
+
+/*!
+ \brief Add statistics on the reset of dead bounded integer variables
+ \param refzg : a zone graph with reference clocks
+ \param m : attributes map
+ \post the number of successors where dead bounded integer variables have been
+ reset has been added to m if it is not zero
+ */
+void intvars_reset_attributes(tchecker::refzg::sharing_refzg_t const & refzg, std::map<std::string, std::string> & m);
+
+/*!
+ \brief Add statistics on symmetry reduction
+ \param zg : a zone graph
+ \param m : attributes map
+ \post the number of groups of symmetric processes and the number of permuted
+ states have been added to m if zg has symmetry reduction
+ */
+void symmetry_attributes(tchecker::zg::sharing_zg_t const & zg, std::map<std::string, std::string> & m);
+
+} // end of namespace tck_reach
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_TCK_REACH_ATTRIBUTES_HH
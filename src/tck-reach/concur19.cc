@@ -5,14 +5,20 @@
  *
  */
 
+#include <cstdint>
+#include <stdexcept>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "concur19.hh"
 #include "counter_example.hh"
+#include "tchecker/algorithms/heuristics.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/graph/binary_certificate.hh"
 #include "tchecker/system/static_analysis.hh"
 #include "tchecker/ta/state.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/serialization.hh"
 
 namespace tchecker {
 
@@ -43,65 +49,24 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::concur19::node_t const
 
 /* node_le_t */
 
-node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds) : _clockbounds(clockbounds)
-{
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-}
-
-node_le_t::node_le_t(tchecker::ta::system_t const & system) : _clockbounds(tchecker::clockbounds::compute_clockbounds(system))
-{
-  _l = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clockbounds->clock_number());
-}
-
-node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le) : _clockbounds(node_le._clockbounds)
-{
-  _l = tchecker::clockbounds::clone_map(*node_le._l);
-  _u = tchecker::clockbounds::clone_map(*node_le._u);
-}
-
-node_le_t::node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le) : _clockbounds(std::move(node_le._clockbounds))
-{
-  _l = node_le._l;
-  node_le._l = nullptr;
-  _u = node_le._u;
-  node_le._u = nullptr;
-}
-
-node_le_t::~node_le_t()
-{
-  tchecker::clockbounds::deallocate_map(_l);
-  tchecker::clockbounds::deallocate_map(_u);
-}
-
-tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t const & node_le)
+node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t> const & clockbounds)
+    : _clockbounds(clockbounds),
+      _lu_cache(std::make_shared<tchecker::clockbounds::local_lu_cache_t>(_clockbounds->local_lu_map()))
 {
-  if (this != &node_le) {
-    _clockbounds = node_le._clockbounds;
-    _l = tchecker::clockbounds::clone_map(*node_le._l);
-    _u = tchecker::clockbounds::clone_map(*node_le._u);
-  }
-  return *this;
 }
 
-tchecker::tck_reach::concur19::node_le_t & node_le_t::operator=(tchecker::tck_reach::concur19::node_le_t && node_le)
+node_le_t::node_le_t(tchecker::ta::system_t const & system)
+    : node_le_t(std::shared_ptr<tchecker::clockbounds::clockbounds_t>{tchecker::clockbounds::compute_clockbounds(system)})
 {
-  if (this != &node_le) {
-    _clockbounds = std::move(node_le._clockbounds);
-    _l = node_le._l;
-    node_le._l = nullptr;
-    _u = node_le._u;
-    node_le._u = nullptr;
-  }
-  return *this;
 }
 
 bool node_le_t::operator()(tchecker::tck_reach::concur19::node_t const & n1,
                            tchecker::tck_reach::concur19::node_t const & n2) const
 {
-  _clockbounds->local_lu(n2.state().vloc(), *_l, *_u);
-  return tchecker::refzg::shared_is_sync_alu_le(n1.state(), n2.state(), *_l, *_u);
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _lu_cache->bounds(n2.state().vloc(), l, u);
+  return tchecker::refzg::shared_is_sync_alu_le(n1.state(), n2.state(), *l, *u);
 }
 
 /* edge_t */
@@ -139,6 +104,33 @@ void graph_t::attributes(tchecker::tck_reach::concur19::edge_t const & e, std::m
   m["vedge"] = tchecker::to_string(e.vedge(), _refzg->system().as_system_system());
 }
 
+void graph_t::save_node(std::ostream & os, node_sptr_t const & n) const
+{
+  tchecker::refzg::serialize(os, n->state());
+  tchecker::graph::serialize(os, static_cast<tchecker::graph::node_flags_t const &>(*n));
+}
+
+graph_t::node_sptr_t graph_t::load_node(std::istream & is)
+{
+  node_sptr_t n = add_node(_refzg->deserialize_state(is));
+  tchecker::graph::deserialize(is, static_cast<tchecker::graph::node_flags_t &>(*n));
+  return n;
+}
+
+void graph_t::save_edge(std::ostream & os, edge_sptr_t const & e) const
+{
+  tchecker::serialization::write(os, static_cast<std::uint8_t>(edge_type(e)));
+  tchecker::serialize(os, e->vedge());
+}
+
+void graph_t::load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt)
+{
+  std::uint8_t const type = tchecker::serialization::read<std::uint8_t>(is);
+  if (type > tchecker::graph::subsumption::EDGE_SUBSUMPTION)
+    throw std::runtime_error("Invalid edge type in checkpoint");
+  add_edge(src, tgt, static_cast<enum tchecker::graph::subsumption::edge_type_t>(type), *_refzg->deserialize_transition(is));
+}
+
 /* dot_output */
 
 /*!
@@ -191,6 +183,16 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::grap
                                                   tchecker::tck_reach::concur19::edge_lexical_less_t>(os, g, name);
 }
 
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_reach::concur19::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::subsumption::dot_output_unsorted<tchecker::tck_reach::concur19::graph_t>(os, g, name);
+}
+
+std::ostream & binary_output(std::ostream & os, tchecker::tck_reach::concur19::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::binary::binary_output(os, g, name, g.refzg().system());
+}
+
 /* counter example */
 namespace cex {
 
@@ -214,39 +216,79 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::cex:
 
 /* run */
 
+/*!
+ \brief Run covering reachability algorithm with a waiting container
+ \tparam WAITING : type of waiting container
+ \param ts : transition system
+ \param graph : subsumption graph
+ \param labels : accepting labels
+ \param covering : covering policy
+ \param waiting : an empty waiting container
+ \return statistics on the run
+ \throw std::invalid_argument : if covering is unknown
+ */
+template <class WAITING>
+static tchecker::algorithms::covreach::stats_t run_algorithm(tchecker::refzg::sharing_refzg_t & ts, tchecker::tck_reach::concur19::graph_t & graph,
+                                                             boost::dynamic_bitset<> const & labels,
+                                                             tchecker::algorithms::covreach::covering_t covering, WAITING & waiting)
+{
+  tchecker::tck_reach::concur19::algorithm_t<WAITING> algorithm;
+  if (covering == tchecker::algorithms::covreach::COVERING_FULL)
+    return algorithm.template run_from_initial_states<tchecker::algorithms::covreach::COVERING_FULL>(ts, graph, labels, waiting);
+  else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
+    return algorithm.template run_from_initial_states<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(ts, graph, labels,
+                                                                                                           waiting);
+  throw std::invalid_argument("Unknown covering policy for covreach algorithm");
+}
+
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, tchecker::algorithms::covreach::covering_t covering, std::size_t block_size,
-    std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels, std::string const & search_order,
+    tchecker::algorithms::covreach::covering_t covering, std::size_t block_size, std::size_t table_size, bool por)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
+  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
+
+  std::shared_ptr<tchecker::refzg::por_t> refzg_por{por ? std::make_shared<tchecker::refzg::por_t>(*system, accepting_labels)
+                                                        : nullptr};
+
   std::shared_ptr<tchecker::refzg::sharing_refzg_t> refzg{tchecker::refzg::factory_sharing(
       system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS, tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
-      tchecker::refdbm::UNBOUNDED_SPREAD, block_size, table_size)};
+      tchecker::refdbm::UNBOUNDED_SPREAD, block_size, table_size, refzg_por)};
 
   std ::shared_ptr<tchecker::tck_reach::concur19::graph_t> graph{
       new tchecker::tck_reach::concur19::graph_t{refzg, block_size, table_size}};
 
-  boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
-
-  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
-
+  using node_sptr_t = tchecker::tck_reach::concur19::graph_t::node_sptr_t;
   tchecker::algorithms::covreach::stats_t stats;
-  tchecker::tck_reach::concur19::algorithm_t algorithm;
 
-  if (covering == tchecker::algorithms::covreach::COVERING_FULL)
-    stats = algorithm.run<tchecker::algorithms::covreach::COVERING_FULL>(*refzg, *graph, accepting_labels, policy);
-  else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
-    stats = algorithm.run<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(*refzg, *graph, accepting_labels, policy);
+  if (tchecker::algorithms::guided_search_order(search_order)) {
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::algorithms::guided_waiting_factory<node_sptr_t, true>(
+        search_order,
+        std::make_shared<tchecker::algorithms::labels_heuristics_t const>(system->as_syncprod_system(), accepting_labels))};
+    stats = tchecker::tck_reach::concur19::run_algorithm(*refzg, *graph, accepting_labels, covering, *waiting);
+  }
   else
-    throw std::invalid_argument("Unknown covering policy for covreach algorithm");
+    stats = tchecker::waiting::static_dispatch<node_sptr_t>(
+        tchecker::algorithms::fast_remove_waiting_policy(search_order), [&](auto & waiting) {
+          return tchecker::tck_reach::concur19::run_algorithm(*refzg, *graph, accepting_labels, covering, waiting);
+        });
 
   return std::make_tuple(stats, graph);
 }
 
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+    std::string const & search_order, tchecker::algorithms::covreach::covering_t covering, std::size_t block_size,
+    std::size_t table_size, bool intvars_reduction, bool por, bool packed_intvars)
+{
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+  system->dead_intvars_reset(intvars_reduction);
+  system->packed_intvars(packed_intvars);
+  return tchecker::tck_reach::concur19::run(system, labels, search_order, covering, block_size, table_size, por);
+}
+
 } // end of namespace concur19
 
 } // end of namespace tck_reach
@@ -8,11 +8,13 @@
 #ifndef TCHECKER_CONCUR19_ALGORITHM_HH
 #define TCHECKER_CONCUR19_ALGORITHM_HH
 
+#include <iostream>
 #include <memory>
 #include <string>
 
 #include "tchecker/algorithms/covreach/algorithm.hh"
 #include "tchecker/algorithms/covreach/stats.hh"
+#include "tchecker/clockbounds/cache.hh"
 #include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/clockbounds/solver.hh"
 #include "tchecker/graph/edge.hh"
@@ -106,28 +108,30 @@ public:
 
   /*!
   \brief Copy constructor
+  \note this shares the cache of clock bounds with node_le
   */
-  node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le);
+  node_le_t(tchecker::tck_reach::concur19::node_le_t const & node_le) = default;
 
   /*!
   \brief Move constructor
   */
-  node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le);
+  node_le_t(tchecker::tck_reach::concur19::node_le_t && node_le) = default;
 
   /*!
    \brief Destructor
   */
-  ~node_le_t();
+  ~node_le_t() = default;
 
   /*!
    \brief Assignment operator
+   \note this shares the cache of clock bounds with node_le
   */
-  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t const & node_le);
+  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t const & node_le) = default;
 
   /*!
    \brief Move-assignment operator
   */
-  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t && node_le);
+  tchecker::tck_reach::concur19::node_le_t & operator=(tchecker::tck_reach::concur19::node_le_t && node_le) = default;
 
   /*!
   \brief Covering predicate for nodes
@@ -139,9 +143,8 @@ public:
   bool operator()(tchecker::tck_reach::concur19::node_t const & n1, tchecker::tck_reach::concur19::node_t const & n2) const;
 
 private:
-  std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds; /*!< Clock bounds */
-  tchecker::clockbounds::map_t * _l;                                  /*!< Clock lower bounds */
-  tchecker::clockbounds::map_t * _u;                                  /*!< Clock upper bounds */
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t> _clockbounds;   /*!< Clock bounds */
+  std::shared_ptr<tchecker::clockbounds::local_lu_cache_t> _lu_cache; /*!< Cache of local LU clock bounds */
 };
 
 /*!
@@ -197,6 +200,41 @@ public:
                                               tchecker::tck_reach::concur19::node_hash_t,
                                               tchecker::tck_reach::concur19::node_le_t>::attributes;
 
+  /*!
+   \brief Save a node to a checkpoint
+   \param os : output stream
+   \param n : a node
+   \post the state and the flags of n have been written to os
+   */
+  void save_node(std::ostream & os, node_sptr_t const & n) const;
+
+  /*!
+   \brief Load a node from a checkpoint
+   \param is : input stream
+   \return a new node in this graph, read from is (see save_node)
+   \throw std::runtime_error : if is does not contain a node of this graph
+   */
+  node_sptr_t load_node(std::istream & is);
+
+  /*!
+   \brief Save an edge to a checkpoint
+   \param os : output stream
+   \param e : an edge
+   \post the type and the tuple of edges of e have been written to os
+   */
+  void save_edge(std::ostream & os, edge_sptr_t const & e) const;
+
+  /*!
+   \brief Load an edge from a checkpoint
+   \param is : input stream
+   \param src : source node
+   \param tgt : target node
+   \post an edge from src to tgt read from is (see save_edge) has been added to
+   this graph
+   \throw std::runtime_error : if is does not contain an edge of this graph
+   */
+  void load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt);
+
 protected:
   /*!
    \brief Accessor to node attributes
@@ -227,6 +265,26 @@ private:
 */
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::graph_t const & g, std::string const & name);
 
+/*!
+ \brief Graph output without sorting
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os, with nodes named by their
+ identifiers in exploration order (see tchecker::graph::dot_output_unsorted)
+*/
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_reach::concur19::graph_t const & g, std::string const & name);
+
+/*!
+ \brief Graph output as a binary certificate
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os as a binary certificate (see
+ tchecker::graph::binary::binary_output)
+*/
+std::ostream & binary_output(std::ostream & os, tchecker::tck_reach::concur19::graph_t const & g, std::string const & name);
+
 namespace cex {
 
 namespace symbolic {
@@ -263,14 +321,36 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::concur19::cex:
 /*!
  \class algorithm_t
  \brief Covering reachability algorithm over the local-time zone graph
+ \tparam WAITING : type of waiting container
 */
-class algorithm_t : public tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::sharing_refzg_t,
-                                                                       tchecker::tck_reach::concur19::graph_t> {
+template <class WAITING = tchecker::waiting::waiting_t<tchecker::tck_reach::concur19::graph_t::node_sptr_t>>
+class algorithm_t
+    : public tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::sharing_refzg_t, tchecker::tck_reach::concur19::graph_t, WAITING> {
 public:
-  using tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::sharing_refzg_t,
-                                                    tchecker::tck_reach::concur19::graph_t>::algorithm_t;
+  using tchecker::algorithms::covreach::algorithm_t<tchecker::refzg::sharing_refzg_t, tchecker::tck_reach::concur19::graph_t,
+                                                 WAITING>::algorithm_t;
 };
 
+/*!
+ \brief Run covering reachability algorithm on the local-time zone graph of a
+ system
+ \param system : a system of timed processes
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param covering : covering policy
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param por : partial-order reduction w.r.t. labels when true (see
+ tchecker::refzg::por_t)
+ \pre labels must appear as node attributes in system
+ search_order must be one of "bfs", "dfs", "best", "astar" or "random"
+ \return statistics on the run and the covering reachability graph
+ \note system is not modified, and can be reused by subsequent runs
+ */
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
+run(std::shared_ptr<tchecker::ta::system_t const> const & system, std::string const & labels, std::string const & search_order,
+    tchecker::algorithms::covreach::covering_t covering, std::size_t block_size, std::size_t table_size, bool por);
+
 /*!
  \brief Run covering reachability algorithm on the local-time zone graph of a
  system
@@ -280,15 +360,22 @@ public:
  \param covering : covering policy
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param intvars_reduction : reset dead bounded integer variables when true (see
+ tchecker::ta::system_t::dead_intvars_reset)
+ \param por : partial-order reduction w.r.t. labels when true (see
+ tchecker::refzg::por_t)
+ \param packed_intvars : store valuations of bounded integer variables as packed
+ bit-fields when true (see tchecker::ta::system_t::packed_intvars)
  \pre labels must appear as node attributes in sysdecl
- search_order must be either "dfs" or "bfs"
+ search_order must be one of "bfs", "dfs", "best", "astar" or "random"
  \return statistics on the run and the covering reachability graph
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::concur19::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
     std::string const & search_order = "bfs",
     tchecker::algorithms::covreach::covering_t covering = tchecker::algorithms::covreach::COVERING_FULL,
-    std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::size_t block_size = 10000, std::size_t table_size = 65536, bool intvars_reduction = true, bool por = false,
+    bool packed_intvars = false);
 
 } // end of namespace concur19
 
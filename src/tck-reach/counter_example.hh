@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "tchecker/algorithms/path/algorithm.hh"
+#include "tchecker/graph/frozen_graph.hh"
 #include "tchecker/refzg/path.hh"
 #include "tchecker/refzg/refzg.hh"
 #include "tchecker/syncprod/vedge.hh"
@@ -65,10 +66,11 @@ template <class GRAPH, class CEX> CEX * counter_example_zg(GRAPH const & g)
       tchecker::zg::factory(g.zg().system_ptr(), tchecker::zg::STANDARD_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, 128, 128)};
 
   // compute sequence of edges from initial to final node in g
-  tchecker::algorithms::path::finite::algorithm_t<GRAPH> algorithm;
+  tchecker::graph::frozen::graph_t<GRAPH> frozen_g = tchecker::graph::frozen::freeze(g);
+  tchecker::algorithms::path::finite::algorithm_t<tchecker::graph::frozen::graph_t<GRAPH>> algorithm;
 
   std::vector<typename GRAPH::edge_sptr_t> seq =
-      algorithm.run(g, &tchecker::tck_reach::initial_node<GRAPH>, &tchecker::tck_reach::final_node<GRAPH>,
+      algorithm.run(frozen_g, &tchecker::tck_reach::initial_node<GRAPH>, &tchecker::tck_reach::final_node<GRAPH>,
                     &tchecker::tck_reach::true_edge<GRAPH>);
 
   if (seq.empty())
@@ -104,10 +106,11 @@ template <class GRAPH, class CEX> CEX * counter_example_refzg(GRAPH const & g)
                                tchecker::refzg::STANDARD_SEMANTICS, g.refzg().spread(), 128, 128)};
 
   // compute sequence of edges from initial to final node in g
-  tchecker::algorithms::path::finite::algorithm_t<GRAPH> algorithm;
+  tchecker::graph::frozen::graph_t<GRAPH> frozen_g = tchecker::graph::frozen::freeze(g);
+  tchecker::algorithms::path::finite::algorithm_t<tchecker::graph::frozen::graph_t<GRAPH>> algorithm;
 
   std::vector<typename GRAPH::edge_sptr_t> seq =
-      algorithm.run(g, &tchecker::tck_reach::initial_node<GRAPH>, &tchecker::tck_reach::final_node<GRAPH>,
+      algorithm.run(frozen_g, &tchecker::tck_reach::initial_node<GRAPH>, &tchecker::tck_reach::final_node<GRAPH>,
                     &tchecker::tck_reach::true_edge<GRAPH>);
 
   if (seq.empty())
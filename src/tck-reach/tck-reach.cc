@@ -5,15 +5,28 @@
  *
  */
 
+#include <algorithm>
+#include <cctype>
 #include <fstream>
+#include <functional>
 #include <getopt.h>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
+#include "attributes.hh"
 #include "concur19.hh"
+#include "tchecker/algorithms/checkpoint.hh"
+#include "tchecker/algorithms/memory_limit.hh"
+#include "tchecker/algorithms/progress.hh"
 #include "tchecker/algorithms/reach/algorithm.hh"
+#include "tchecker/algorithms/stop.hh"
+#include "tchecker/clockbounds/solver.hh"
 #include "tchecker/parsing/parsing.hh"
 #include "tchecker/utils/log.hh"
 #include "zg-covreach.hh"
@@ -30,6 +43,21 @@ static struct option long_options[] = {{"algorithm", required_argument, 0, 'a'},
                                        {"help", no_argument, 0, 'h'},
                                        {"labels", required_argument, 0, 'l'},
                                        {"search-order", no_argument, 0, 's'},
+                                       {"subsumption", required_argument, 0, 0},
+                                       {"extrapolation", required_argument, 0, 0},
+                                       {"active-clocks", no_argument, 0, 0},
+                                       {"no-intvars-reduction", no_argument, 0, 0},
+                                       {"packed-intvars", no_argument, 0, 0},
+                                       {"symmetry", no_argument, 0, 0},
+                                       {"por", no_argument, 0, 0},
+                                       {"progress", required_argument, 0, 0},
+                                       {"progress-file", required_argument, 0, 0},
+                                       {"checkpoint", required_argument, 0, 0},
+                                       {"checkpoint-period", required_argument, 0, 0},
+                                       {"resume", required_argument, 0, 0},
+                                       {"portfolio", required_argument, 0, 0},
+                                       {"memory-limit", required_argument, 0, 0},
+                                       {"unsorted", no_argument, 0, 0},
                                        {"block-size", required_argument, 0, 0},
                                        {"table-size", required_argument, 0, 0},
                                        {0, 0, 0, 0}};
@@ -47,14 +75,51 @@ void usage(char * progname)
   std::cerr << "          reach      standard reachability algorithm over the zone graph" << std::endl;
   std::cerr << "          concur19   reachability algorithm with covering over the local-time zone graph" << std::endl;
   std::cerr << "          covreach   reachability algorithm with covering over the zone graph" << std::endl;
+  std::cerr << "          portfolio  run several algorithms and search orders concurrently (see --portfolio)," << std::endl;
+  std::cerr << "                     and report the result of the first one that completes" << std::endl;
   std::cerr << "   -C type       type of certificate" << std::endl;
   std::cerr << "          none       no certificate (default)" << std::endl;
   std::cerr << "          graph      graph of explored state-space" << std::endl;
+  std::cerr << "          binary     graph of explored state-space as a binary certificate (requires -o)" << std::endl;
   std::cerr << "          symbolic   symbolic run to a state with searched labels (if any)" << std::endl;
   std::cerr << "   -h            help" << std::endl;
   std::cerr << "   -l l1,l2,...  comma-separated list of searched labels" << std::endl;
   std::cerr << "   -o out_file   output file for certificate (default is standard output)" << std::endl;
-  std::cerr << "   -s bfs|dfs    search order" << std::endl;
+  std::cerr << "   -s order      search order" << std::endl;
+  std::cerr << "          bfs        breadth-first search (default)" << std::endl;
+  std::cerr << "          dfs        depth-first search" << std::endl;
+  std::cerr << "          best       best-first search guided by the distance to searched labels" << std::endl;
+  std::cerr << "          astar      A* search guided by the distance to searched labels" << std::endl;
+  std::cerr << "          random     random-restart depth-first search" << std::endl;
+  std::cerr << "   --subsumption inclusion|alu  subsumption between zones for algorithm covreach" << std::endl;
+  std::cerr << "          inclusion  zone inclusion (default)" << std::endl;
+  std::cerr << "          alu        aLU subsumption w.r.t. local LU clock bounds" << std::endl;
+  std::cerr << "   --extrapolation e  zone extrapolation for algorithms reach and covreach" << std::endl;
+  std::cerr << "          lu-local   ExtraLU+ w.r.t. local LU clock bounds (default)" << std::endl;
+  std::cerr << "          lu-global  ExtraLU+ w.r.t. global LU clock bounds" << std::endl;
+  std::cerr << "          m-local    ExtraM+ w.r.t. local M clock bounds" << std::endl;
+  std::cerr << "          m-global   ExtraM+ w.r.t. global M clock bounds" << std::endl;
+  std::cerr << "   --active-clocks  free inactive clocks in zones for algorithms reach and covreach: clocks that are" << std::endl;
+  std::cerr << "                 reset before being read (local extrapolations already abstract these clocks)" << std::endl;
+  std::cerr << "   --no-intvars-reduction  do not reset dead bounded integer variables" << std::endl;
+  std::cerr << "   --packed-intvars  store bounded integer variables as bit-fields in states" << std::endl;
+  std::cerr << "   --symmetry    symmetry reduction for algorithms reach and covreach: groups of symmetric processes" << std::endl;
+  std::cerr << "                 are declared by process attribute symmetry, or detected automatically otherwise" << std::endl;
+  std::cerr << "                 (certificates are not supported)" << std::endl;
+  std::cerr << "   --por         partial-order reduction for algorithm concur19: successors are restricted to the" << std::endl;
+  std::cerr << "                 local steps of one process when they are independent and do not change the labels" << std::endl;
+  std::cerr << "   --progress seconds  report progress every seconds on standard error (or in progress file)" << std::endl;
+  std::cerr << "   --progress-file f   report progress as JSON lines in file f (every second by default)" << std::endl;
+  std::cerr << "   --checkpoint f      save the state of the algorithm to file f periodically" << std::endl;
+  std::cerr << "   --checkpoint-period seconds  time between two checkpoints (default: 600)" << std::endl;
+  std::cerr << "   --resume f          resume from checkpoint file f (same model and options)" << std::endl;
+  std::cerr << "   --portfolio algo:order,...  configurations run by algorithm portfolio" << std::endl;
+  std::cerr << "                 (default: reach:bfs,reach:dfs,covreach:bfs,covreach:dfs,concur19:bfs,concur19:dfs)" << std::endl;
+  std::cerr << "   --unsorted    output certificate graphs without sorting: nodes are named in exploration order" << std::endl;
+  std::cerr << "                 and output without building a sorted copy of the graph (faster, less memory)" << std::endl;
+  std::cerr << "   --memory-limit n[K|M|G]  limit on the memory used by states, nodes, edges and hash tables:" << std::endl;
+  std::cerr << "                 close to the limit, edges are dropped, then unused memory is collected, and the" << std::endl;
+  std::cerr << "                 algorithm stops with a partial result (STOPPED) if the limit is reached" << std::endl;
   std::cerr << "   --block-size  size of allocation blocks" << std::endl;
   std::cerr << "   --table-size  size of hash tables" << std::endl;
   std::cerr << "reads from standard input if file is not provided" << std::endl;
@@ -64,11 +129,13 @@ enum algorithm_t {
   ALGO_REACH,    /*!< Reachability algorithm */
   ALGO_CONCUR19, /*!< Covering reachability algorithm over the local-time zone graph */
   ALGO_COVREACH, /*!< Covering reachability algorithm */
+  ALGO_PORTFOLIO, /*!< Portfolio of algorithms */
   ALGO_NONE,     /*!< No algorithm */
 };
 
 enum certificate_t {
   CERTIFICATE_GRAPH,        /*!< Graph of state-space */
+  CERTIFICATE_BINARY,       /*!< Graph of state-space as a binary certificate */
   CERTIFICATE_SYMBOLIC_RUN, /*!< Symbolic counter-example run */
   CERTIFICATE_NONE,         /*!< No certificate */
 };
@@ -82,6 +149,24 @@ static std::string output_file = "";                      /*!< Output file name
 static std::ostream * os = &std::cout;                    /*!< Default output stream */
 static std::size_t block_size = 10000;                    /*!< Size of allocated blocks */
 static std::size_t table_size = 65536;                    /*!< Size of hash tables */
+static enum tchecker::tck_reach::zg_covreach::subsumption_t subsumption =
+    tchecker::tck_reach::zg_covreach::SUBSUMPTION_INCLUSION; /*!< Subsumption for covreach */
+static enum tchecker::zg::extrapolation_type_t extrapolation =
+    tchecker::zg::EXTRA_LU_PLUS_LOCAL; /*!< Zone extrapolation for reach and covreach */
+static bool active_clocks = false;                           /*!< Free inactive clocks in zones */
+static bool intvars_reduction = true;                        /*!< Reset dead bounded integer variables */
+static bool packed_intvars = false;                          /*!< Store bounded integer variables as bit-fields */
+static bool symmetry = false;                                /*!< Symmetry reduction */
+static bool por = false;                                     /*!< Partial-order reduction */
+static double progress_period = 0;                           /*!< Period of progress reports in seconds (0 to disable) */
+static std::string progress_file = "";                       /*!< Progress reports file (empty means standard error) */
+static std::string checkpoint_file = "";                     /*!< Checkpoint file (empty to disable checkpoints) */
+static double checkpoint_period = 600;                       /*!< Period of checkpoints in seconds */
+static std::string resume_file = "";                         /*!< Resume file (empty to start from initial states) */
+static std::string portfolio_configurations =
+    "reach:bfs,reach:dfs,covreach:bfs,covreach:dfs,concur19:bfs,concur19:dfs"; /*!< Configurations of portfolio */
+static std::size_t memory_limit = 0; /*!< Memory limit in bytes (0 means no limit) */
+static bool sorted_certificate = true; /*!< Sort certificate graphs */
 
 /*!
  \brief Parse command-line arguments
@@ -113,6 +198,8 @@ int parse_command_line(int argc, char * argv[])
           algorithm = ALGO_CONCUR19;
         else if (strcmp(optarg, "covreach") == 0)
           algorithm = ALGO_COVREACH;
+        else if (strcmp(optarg, "portfolio") == 0)
+          algorithm = ALGO_PORTFOLIO;
         else
           throw std::runtime_error("Unknown algorithm: " + std::string(optarg));
         break;
@@ -121,6 +208,8 @@ int parse_command_line(int argc, char * argv[])
           certificate = CERTIFICATE_NONE;
         else if (strcmp(optarg, "graph") == 0)
           certificate = CERTIFICATE_GRAPH;
+        else if (strcmp(optarg, "binary") == 0)
+          certificate = CERTIFICATE_BINARY;
         else if (strcmp(optarg, "symbolic") == 0)
           certificate = CERTIFICATE_SYMBOLIC_RUN;
         else
@@ -148,6 +237,42 @@ int parse_command_line(int argc, char * argv[])
         block_size = std::strtoull(optarg, nullptr, 10);
       else if (strcmp(long_options[long_option_index].name, "table-size") == 0)
         table_size = std::strtoull(optarg, nullptr, 10);
+      else if (strcmp(long_options[long_option_index].name, "subsumption") == 0) {
+        if (strcmp(optarg, "inclusion") == 0)
+          subsumption = tchecker::tck_reach::zg_covreach::SUBSUMPTION_INCLUSION;
+        else if (strcmp(optarg, "alu") == 0)
+          subsumption = tchecker::tck_reach::zg_covreach::SUBSUMPTION_ALU;
+        else
+          throw std::runtime_error("Unknown subsumption: " + std::string(optarg));
+      }
+      else if (strcmp(long_options[long_option_index].name, "extrapolation") == 0)
+        extrapolation = tchecker::tck_reach::zg_reach::extrapolation_type(optarg);
+      else if (strcmp(long_options[long_option_index].name, "active-clocks") == 0)
+        active_clocks = true;
+      else if (strcmp(long_options[long_option_index].name, "no-intvars-reduction") == 0)
+        intvars_reduction = false;
+      else if (strcmp(long_options[long_option_index].name, "packed-intvars") == 0)
+        packed_intvars = true;
+      else if (strcmp(long_options[long_option_index].name, "symmetry") == 0)
+        symmetry = true;
+      else if (strcmp(long_options[long_option_index].name, "por") == 0)
+        por = true;
+      else if (strcmp(long_options[long_option_index].name, "progress") == 0)
+        progress_period = std::strtod(optarg, nullptr);
+      else if (strcmp(long_options[long_option_index].name, "progress-file") == 0)
+        progress_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "checkpoint") == 0)
+        checkpoint_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "checkpoint-period") == 0)
+        checkpoint_period = std::strtod(optarg, nullptr);
+      else if (strcmp(long_options[long_option_index].name, "resume") == 0)
+        resume_file = optarg;
+      else if (strcmp(long_options[long_option_index].name, "portfolio") == 0)
+        portfolio_configurations = optarg;
+      else if (strcmp(long_options[long_option_index].name, "memory-limit") == 0)
+        memory_limit = tchecker::algorithms::parse_memory_size(optarg);
+      else if (strcmp(long_options[long_option_index].name, "unsorted") == 0)
+        sorted_certificate = false;
       else
         throw std::runtime_error("This also should never be executed");
     }
@@ -177,6 +302,56 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
   return sysdecl;
 }
 
+/*!
+ \brief Check that a certificate can be output from a graph
+ \param edges : false if the edges of the graph have been dropped under the
+ memory limit, true otherwise
+ \param reachable : reachability of searched labels
+ \post a warning has been output if a certificate graph without edges will be
+ output
+ \throw std::runtime_error : if a symbolic certificate is required and edges
+ have been dropped
+ */
+static void check_certificate_edges(bool edges, bool reachable)
+{
+  if (edges)
+    return;
+  if (certificate == CERTIFICATE_GRAPH || certificate == CERTIFICATE_BINARY)
+    std::cerr << tchecker::log_warning << "edges have been dropped under the memory limit, the certificate has no edge"
+              << std::endl;
+  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && reachable)
+    throw std::runtime_error("Unable to compute a symbolic counter example: edges have been dropped under the memory limit");
+}
+
+/*!
+ \brief Output a certificate of reachability analysis
+ \param graph : reachability graph
+ \param reachable : reachability of searched labels
+ \param edges : false if the edges of graph have been dropped under the memory
+ limit, true otherwise
+ \param name : name of the system
+ \post the certificate of the selected type has been output to os
+ \throw std::runtime_error : if a symbolic certificate cannot be computed
+ */
+static void reach_certificate(tchecker::tck_reach::zg_reach::graph_t const & graph, bool reachable, bool edges,
+                              std::string const & name)
+{
+  check_certificate_edges(edges, reachable);
+  if (certificate == CERTIFICATE_GRAPH && sorted_certificate)
+    tchecker::tck_reach::zg_reach::dot_output(*os, graph, name);
+  else if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::zg_reach::dot_output_unsorted(*os, graph, name);
+  else if (certificate == CERTIFICATE_BINARY)
+    tchecker::tck_reach::zg_reach::binary_output(*os, graph, name);
+  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && reachable) {
+    std::unique_ptr<tchecker::tck_reach::zg_reach::cex::symbolic::cex_t> cex{
+        tchecker::tck_reach::zg_reach::cex::symbolic::counter_example(graph)};
+    if (cex->empty())
+      throw std::runtime_error("Unable to compute a symbolic counter example");
+    tchecker::tck_reach::zg_reach::cex::symbolic::dot_output(*os, *cex, name);
+  }
+}
+
 /*!
  \brief Perform reachability analysis
  \param sysdecl : system declaration
@@ -186,23 +361,50 @@ tchecker::parsing::system_declaration_t * load_system_declaration(std::string co
 */
 void reach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
 {
-  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size);
+  auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(sysdecl, labels, search_order, block_size, table_size, extrapolation,
+                                                              active_clocks, intvars_reduction, symmetry, packed_intvars);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
+  tchecker::tck_reach::intvars_reset_attributes(graph->zg(), m);
+  tchecker::tck_reach::active_clocks_attributes(graph->zg(), m);
+  tchecker::tck_reach::symmetry_attributes(graph->zg(), m);
   for (auto && [key, value] : m)
     std::cout << key << " " << value << std::endl;
 
   // certificate
-  if (certificate == CERTIFICATE_GRAPH)
-    tchecker::tck_reach::zg_reach::dot_output(*os, *graph, sysdecl->name());
-  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && stats.reachable()) {
-    std::unique_ptr<tchecker::tck_reach::zg_reach::cex::symbolic::cex_t> cex{
-        tchecker::tck_reach::zg_reach::cex::symbolic::counter_example(*graph)};
+  reach_certificate(*graph, stats.reachable(), stats.memory_degradation() < tchecker::algorithms::MEMORY_DROP_EDGES,
+                    sysdecl->name());
+}
+
+/*!
+ \brief Output a certificate of covering reachability analysis over the
+ local-time zone graph
+ \param graph : covering reachability graph
+ \param reachable : reachability of searched labels
+ \param edges : false if the edges of graph have been dropped under the memory
+ limit, true otherwise
+ \param name : name of the system
+ \post the certificate of the selected type has been output to os
+ \throw std::runtime_error : if a symbolic certificate cannot be computed
+ */
+static void concur19_certificate(tchecker::tck_reach::concur19::graph_t const & graph, bool reachable, bool edges,
+                                 std::string const & name)
+{
+  check_certificate_edges(edges, reachable);
+  if (certificate == CERTIFICATE_GRAPH && sorted_certificate)
+    tchecker::tck_reach::concur19::dot_output(*os, graph, name);
+  else if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::concur19::dot_output_unsorted(*os, graph, name);
+  else if (certificate == CERTIFICATE_BINARY)
+    tchecker::tck_reach::concur19::binary_output(*os, graph, name);
+  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && reachable) {
+    std::unique_ptr<tchecker::tck_reach::concur19::cex::symbolic::cex_t> cex{
+        tchecker::tck_reach::concur19::cex::symbolic::counter_example(graph)};
     if (cex->empty())
       throw std::runtime_error("Unable to compute a symbolic counter example");
-    tchecker::tck_reach::zg_reach::cex::symbolic::dot_output(*os, *cex, sysdecl->name());
+    tchecker::tck_reach::concur19::cex::symbolic::dot_output(*os, *cex, name);
   }
 }
 
@@ -223,26 +425,53 @@ void concur19(std::shared_ptr<tchecker::parsing::system_declaration_t> const & s
 
   if (certificate == CERTIFICATE_SYMBOLIC_RUN)
     std::tie(stats, graph) = tchecker::tck_reach::concur19::run(
-        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_LEAF_NODES, block_size, table_size);
+        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_LEAF_NODES, block_size, table_size,
+        intvars_reduction, por, packed_intvars);
   else
     std::tie(stats, graph) = tchecker::tck_reach::concur19::run(
-        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_FULL, block_size, table_size);
+        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_FULL, block_size, table_size,
+        intvars_reduction, por, packed_intvars);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
+  tchecker::tck_reach::intvars_reset_attributes(graph->refzg(), m);
+  if (graph->refzg().por().get() != nullptr)
+    m["POR_REDUCED_STATES"] = std::to_string(graph->refzg().por()->reduced_states());
   for (auto && [key, value] : m)
     std::cout << key << " " << value << std::endl;
 
   // certificate
-  if (certificate == CERTIFICATE_GRAPH)
-    tchecker::tck_reach::concur19::dot_output(*os, *graph, sysdecl->name());
-  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && stats.reachable()) {
-    std::unique_ptr<tchecker::tck_reach::concur19::cex::symbolic::cex_t> cex{
-        tchecker::tck_reach::concur19::cex::symbolic::counter_example(*graph)};
+  concur19_certificate(*graph, stats.reachable(), stats.memory_degradation() < tchecker::algorithms::MEMORY_DROP_EDGES,
+                       sysdecl->name());
+}
+
+/*!
+ \brief Output a certificate of covering reachability analysis
+ \param graph : covering reachability graph
+ \param reachable : reachability of searched labels
+ \param edges : false if the edges of graph have been dropped under the memory
+ limit, true otherwise
+ \param name : name of the system
+ \post the certificate of the selected type has been output to os
+ \throw std::runtime_error : if a symbolic certificate cannot be computed
+ */
+static void covreach_certificate(tchecker::tck_reach::zg_covreach::graph_t const & graph, bool reachable, bool edges,
+                                 std::string const & name)
+{
+  check_certificate_edges(edges, reachable);
+  if (certificate == CERTIFICATE_GRAPH && sorted_certificate)
+    tchecker::tck_reach::zg_covreach::dot_output(*os, graph, name);
+  else if (certificate == CERTIFICATE_GRAPH)
+    tchecker::tck_reach::zg_covreach::dot_output_unsorted(*os, graph, name);
+  else if (certificate == CERTIFICATE_BINARY)
+    tchecker::tck_reach::zg_covreach::binary_output(*os, graph, name);
+  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && reachable) {
+    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::symbolic::cex_t> cex{
+        tchecker::tck_reach::zg_covreach::cex::symbolic::counter_example(graph)};
     if (cex->empty())
       throw std::runtime_error("Unable to compute a symbolic counter example");
-    tchecker::tck_reach::concur19::cex::symbolic::dot_output(*os, *cex, sysdecl->name());
+    tchecker::tck_reach::zg_covreach::cex::symbolic::dot_output(*os, *cex, name);
   }
 }
 
@@ -259,30 +488,200 @@ void covreach(std::shared_ptr<tchecker::parsing::system_declaration_t> const & s
   std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t> graph;
 
   if (certificate == CERTIFICATE_SYMBOLIC_RUN)
-    std::tie(stats, graph) = tchecker::tck_reach::zg_covreach::run(
-        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_LEAF_NODES, block_size, table_size);
+    std::tie(stats, graph) =
+        tchecker::tck_reach::zg_covreach::run(sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_LEAF_NODES,
+                                              block_size, table_size, subsumption, extrapolation, active_clocks,
+                                              intvars_reduction, symmetry, packed_intvars);
   else
     std::tie(stats, graph) = tchecker::tck_reach::zg_covreach::run(
-        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_FULL, block_size, table_size);
+        sysdecl, labels, search_order, tchecker::algorithms::covreach::COVERING_FULL, block_size, table_size, subsumption, extrapolation,
+        active_clocks, intvars_reduction, symmetry, packed_intvars);
 
   // stats
   std::map<std::string, std::string> m;
   stats.attributes(m);
+  tchecker::tck_reach::intvars_reset_attributes(graph->zg(), m);
+  tchecker::tck_reach::active_clocks_attributes(graph->zg(), m);
+  tchecker::tck_reach::symmetry_attributes(graph->zg(), m);
   for (auto && [key, value] : m)
     std::cout << key << " " << value << std::endl;
 
   // certificate
-  if (certificate == CERTIFICATE_GRAPH)
-    tchecker::tck_reach::zg_covreach::dot_output(*os, *graph, sysdecl->name());
-  else if ((certificate == CERTIFICATE_SYMBOLIC_RUN) && stats.reachable()) {
-    std::unique_ptr<tchecker::tck_reach::zg_covreach::cex::symbolic::cex_t> cex{
-        tchecker::tck_reach::zg_covreach::cex::symbolic::counter_example(*graph)};
-    if (cex->empty())
-      throw std::runtime_error("Unable to compute a symbolic counter example");
-    tchecker::tck_reach::zg_covreach::cex::symbolic::dot_output(*os, *cex, sysdecl->name());
+  covreach_certificate(*graph, stats.reachable(), stats.memory_degradation() < tchecker::algorithms::MEMORY_DROP_EDGES,
+                       sysdecl->name());
+}
+
+/*!
+ \class portfolio_result_t
+ \brief Result of a configuration of algorithm portfolio
+ */
+class portfolio_result_t {
+public:
+  std::string algorithm;                       /*!< Algorithm */
+  std::string search_order;                    /*!< Search order */
+  std::map<std::string, std::string> stats;    /*!< Statistics */
+  bool completed = false;                      /*!< Completion of the run */
+  std::string error;                           /*!< Error message (empty if no error) */
+  std::function<void(std::string const &)> certificate; /*!< Certificate output */
+};
+
+/*!
+ \brief Run a configuration of algorithm portfolio
+ \param system : a system of timed processes
+ \param clock_bounds : clock bounds of system (nullptr if they cannot be
+ inferred)
+ \param r : result of the configuration, with algorithm and search order set
+ \post the algorithm of r has been run on system with the search order of r, and
+ the statistics, the completion flag and the certificate output of r have been
+ set, or the error message of r has been set if the run failed
+ */
+static void portfolio_run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+                          std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds,
+                          portfolio_result_t & r)
+{
+  try {
+    if (r.algorithm != "concur19" && clock_bounds.get() == nullptr)
+      throw std::runtime_error("Unable to compute clock bounds");
+
+    if (r.algorithm == "reach") {
+      auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(system, clock_bounds, labels, r.search_order, block_size,
+                                                                  table_size, extrapolation, active_clocks, symmetry);
+      stats.attributes(r.stats);
+      tchecker::tck_reach::intvars_reset_attributes(graph->zg(), r.stats);
+      tchecker::tck_reach::active_clocks_attributes(graph->zg(), r.stats);
+      tchecker::tck_reach::symmetry_attributes(graph->zg(), r.stats);
+      r.completed = !stats.stopped();
+      r.certificate = [graph = graph, reachable = stats.reachable(),
+                       edges = stats.memory_degradation() < tchecker::algorithms::MEMORY_DROP_EDGES](std::string const & name) {
+        reach_certificate(*graph, reachable, edges, name);
+      };
+    }
+    else if (r.algorithm == "covreach") {
+      auto && [stats, graph] = tchecker::tck_reach::zg_covreach::run(
+          system, clock_bounds, labels, r.search_order,
+          (certificate == CERTIFICATE_SYMBOLIC_RUN ? tchecker::algorithms::covreach::COVERING_LEAF_NODES
+                                                   : tchecker::algorithms::covreach::COVERING_FULL),
+          block_size, table_size, subsumption, extrapolation, active_clocks, symmetry);
+      stats.attributes(r.stats);
+      tchecker::tck_reach::intvars_reset_attributes(graph->zg(), r.stats);
+      tchecker::tck_reach::active_clocks_attributes(graph->zg(), r.stats);
+      tchecker::tck_reach::symmetry_attributes(graph->zg(), r.stats);
+      r.completed = !stats.stopped();
+      r.certificate = [graph = graph, reachable = stats.reachable(),
+                       edges = stats.memory_degradation() < tchecker::algorithms::MEMORY_DROP_EDGES](std::string const & name) {
+        covreach_certificate(*graph, reachable, edges, name);
+      };
+    }
+    else if (r.algorithm == "concur19") {
+      if (symmetry)
+        throw std::runtime_error("Symmetry reduction is not supported by algorithm concur19");
+      auto && [stats, graph] = tchecker::tck_reach::concur19::run(
+          system, labels, r.search_order,
+          (certificate == CERTIFICATE_SYMBOLIC_RUN ? tchecker::algorithms::covreach::COVERING_LEAF_NODES
+                                                   : tchecker::algorithms::covreach::COVERING_FULL),
+          block_size, table_size, por);
+      stats.attributes(r.stats);
+      tchecker::tck_reach::intvars_reset_attributes(graph->refzg(), r.stats);
+      if (graph->refzg().por().get() != nullptr)
+        r.stats["POR_REDUCED_STATES"] = std::to_string(graph->refzg().por()->reduced_states());
+      r.completed = !stats.stopped();
+      r.certificate = [graph = graph, reachable = stats.reachable(),
+                       edges = stats.memory_degradation() < tchecker::algorithms::MEMORY_DROP_EDGES](std::string const & name) {
+        concur19_certificate(*graph, reachable, edges, name);
+      };
+    }
+    else
+      throw std::runtime_error("Unknown algorithm: " + r.algorithm);
+  }
+  catch (std::exception const & e) {
+    r.error = e.what();
   }
 }
 
+/*!
+ \brief Perform reachability analysis with a portfolio of algorithms
+ \param sysdecl : system declaration
+ \post the configurations in portfolio_configurations have been run concurrently
+ on the system declared by sysdecl, until one of them completed. The other ones
+ have been stopped. The statistics of the first completed configuration have
+ been output to standard output, followed by the statistics of every
+ configuration (prefixed by PORTFOLIO_ALGORITHM_ORDER_). A certificate from the
+ first completed configuration has been output if required
+ \throw std::runtime_error : if no configuration completed
+ \note each configuration works on its own copy of the system (hence its own
+ bytecode interpreter) and allocates its own states and graph
+ */
+void portfolio(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl)
+{
+  std::vector<portfolio_result_t> results;
+  std::istringstream iss(portfolio_configurations);
+  for (std::string configuration; std::getline(iss, configuration, ',');) {
+    std::size_t const colon = configuration.find(':');
+    portfolio_result_t r;
+    r.algorithm = configuration.substr(0, colon);
+    r.search_order = (colon == std::string::npos ? "bfs" : configuration.substr(colon + 1));
+    results.push_back(r);
+  }
+  if (results.empty())
+    throw std::runtime_error("Empty portfolio");
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+  system->dead_intvars_reset(intvars_reduction);
+  system->packed_intvars(packed_intvars);
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+
+  std::vector<std::shared_ptr<tchecker::ta::system_t const>> systems;
+  for (std::size_t i = 0; i < results.size(); ++i)
+    systems.push_back(std::make_shared<tchecker::ta::system_t>(*system));
+
+  std::mutex mutex;
+  std::size_t winner = results.size();
+  tchecker::algorithms::clear_stop();
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < results.size(); ++i)
+    threads.emplace_back([&, i]() {
+      portfolio_run(systems[i], clock_bounds, results[i]);
+      std::lock_guard<std::mutex> lock(mutex);
+      if (results[i].completed && results[i].error.empty() && winner == results.size()) {
+        winner = i;
+        tchecker::algorithms::request_stop();
+      }
+    });
+  for (std::thread & t : threads)
+    t.join();
+  tchecker::algorithms::clear_stop();
+
+  if (winner == results.size()) {
+    for (portfolio_result_t const & r : results) {
+      if (!r.error.empty())
+        std::cerr << tchecker::log_error << r.algorithm << ":" << r.search_order << ": " << r.error << std::endl;
+      else
+        std::cerr << tchecker::log_warning << r.algorithm << ":" << r.search_order << ": stopped" << std::endl;
+    }
+    throw std::runtime_error("No configuration of the portfolio has completed");
+  }
+
+  // stats
+  std::map<std::string, std::string> m{results[winner].stats};
+  m["PORTFOLIO_WINNER"] = results[winner].algorithm + ":" + results[winner].search_order;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    portfolio_result_t const & r = results[i];
+    std::string prefix = "PORTFOLIO_" + r.algorithm + "_" + r.search_order + "_";
+    std::transform(prefix.begin(), prefix.end(), prefix.begin(), [](unsigned char c) { return std::toupper(c); });
+    for (auto && [key, value] : r.stats)
+      m[prefix + key] = value;
+    m[prefix + "STATUS"] = (i == winner ? "winner" : (!r.error.empty() ? "error" : (r.completed ? "completed" : "stopped")));
+    if (!r.error.empty())
+      m[prefix + "ERROR"] = r.error;
+  }
+  for (auto && [key, value] : m)
+    std::cout << key << " " << value << std::endl;
+
+  // certificate
+  results[winner].certificate(sysdecl->name());
+}
+
 /*!
  \brief Main function
 */
@@ -309,11 +708,28 @@ int main(int argc, char * argv[])
     if (tchecker::log_error_count() > 0)
       return EXIT_FAILURE;
 
+    if (symmetry && algorithm == ALGO_CONCUR19)
+      throw std::runtime_error("Symmetry reduction is not supported by algorithm concur19");
+
+    if (por && algorithm != ALGO_CONCUR19 && algorithm != ALGO_PORTFOLIO)
+      throw std::runtime_error("Partial-order reduction is only supported by algorithm concur19");
+
+    if (algorithm == ALGO_PORTFOLIO && (progress_period > 0 || progress_file != "" || checkpoint_file != "" || resume_file != ""))
+      throw std::runtime_error("Progress reports and checkpoints are not supported by algorithm portfolio");
+
+    // Transitions may lead to a permutation of the stored (canonical) successor
+    if (symmetry && certificate != CERTIFICATE_NONE)
+      throw std::runtime_error("Certificates are not supported with symmetry reduction");
+
+    if (certificate == CERTIFICATE_BINARY && output_file == "")
+      throw std::runtime_error("Binary certificates must be output to a file (-o)");
+
     std::shared_ptr<std::ofstream> os_ptr{nullptr};
 
     if (certificate != CERTIFICATE_NONE && output_file != "") {
       try {
-        os_ptr = std::make_shared<std::ofstream>(output_file);
+        os_ptr = std::make_shared<std::ofstream>(
+            output_file, (certificate == CERTIFICATE_BINARY ? std::ios::out | std::ios::binary : std::ios::out));
         os = os_ptr.get();
       }
       catch (std::exception & e) {
@@ -322,6 +738,33 @@ int main(int argc, char * argv[])
       }
     }
 
+    if (memory_limit > 0)
+      tchecker::algorithms::set_memory_limit(std::make_shared<tchecker::algorithms::memory_limit_t>(memory_limit));
+
+    std::shared_ptr<std::ofstream> progress_os_ptr{nullptr};
+
+    if (progress_file != "") {
+      progress_os_ptr = std::make_shared<std::ofstream>(progress_file);
+      if (!*progress_os_ptr)
+        throw std::runtime_error("Unable to open progress file " + progress_file);
+      tchecker::algorithms::set_progress(std::make_shared<tchecker::algorithms::progress_t>(
+          *progress_os_ptr, tchecker::algorithms::PROGRESS_JSON, (progress_period > 0 ? progress_period : 1.0)));
+    }
+    else if (progress_period > 0)
+      tchecker::algorithms::set_progress(
+          std::make_shared<tchecker::algorithms::progress_t>(std::cerr, tchecker::algorithms::PROGRESS_TEXT, progress_period));
+
+    if (checkpoint_file != "" || resume_file != "") {
+      if (checkpoint_period <= 0)
+        throw std::runtime_error("Checkpoint period should be positive");
+      std::ostringstream configuration;
+      configuration << "tck-reach " << algorithm << " " << search_order << " " << labels << " " << subsumption << " "
+                    << extrapolation << " " << active_clocks << intvars_reduction << symmetry << por << packed_intvars << std::endl
+                    << *sysdecl;
+      tchecker::algorithms::set_checkpoint(std::make_shared<tchecker::algorithms::checkpoint_t>(
+          checkpoint_file, checkpoint_period, resume_file, configuration.str()));
+    }
+
     switch (algorithm) {
     case ALGO_REACH:
       reach(sysdecl);
@@ -332,6 +775,9 @@ int main(int argc, char * argv[])
     case ALGO_COVREACH:
       covreach(sysdecl);
       break;
+    case ALGO_PORTFOLIO:
+      portfolio(sysdecl);
+      break;
     default:
       throw std::runtime_error("No algorithm specified");
     }
@@ -5,14 +5,22 @@
  *
  */
 
+#include <cstdint>
+#include <stdexcept>
+
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
 #include "tchecker/algorithms/path/algorithm.hh"
+#include "tchecker/algorithms/heuristics.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/graph/binary_certificate.hh"
 #include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/symmetry.hh"
 #include "tchecker/ta/state.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/serialization.hh"
 #include "zg-covreach.hh"
 
 namespace tchecker {
@@ -44,10 +52,18 @@ std::size_t node_hash_t::operator()(tchecker::tck_reach::zg_covreach::node_t con
 
 /* node_le_t */
 
+node_le_t::node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_cache_t> const & lu_cache) : _lu_cache(lu_cache) {}
+
 bool node_le_t::operator()(tchecker::tck_reach::zg_covreach::node_t const & n1,
                            tchecker::tck_reach::zg_covreach::node_t const & n2) const
 {
-  return tchecker::zg::shared_is_le(n1.state(), n2.state());
+  if (_lu_cache.get() == nullptr)
+    return tchecker::zg::shared_is_le(n1.state(), n2.state());
+
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _lu_cache->bounds(n2.state().vloc(), l, u);
+  return tchecker::zg::shared_is_alu_le(n1.state(), n2.state(), *l, *u);
 }
 
 /* edge_t */
@@ -66,6 +82,16 @@ graph_t::graph_t(std::shared_ptr<tchecker::zg::sharing_zg_t> const & zg, std::si
 {
 }
 
+graph_t::graph_t(std::shared_ptr<tchecker::zg::sharing_zg_t> const & zg, tchecker::tck_reach::zg_covreach::node_le_t const & node_le,
+                 std::size_t block_size, std::size_t table_size)
+    : tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
+                                            tchecker::tck_reach::zg_covreach::node_hash_t,
+                                            tchecker::tck_reach::zg_covreach::node_le_t>(
+          block_size, table_size, tchecker::tck_reach::zg_covreach::node_hash_t(), node_le),
+      _zg(zg)
+{
+}
+
 graph_t::~graph_t()
 {
   tchecker::graph::subsumption::graph_t<tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
@@ -84,6 +110,33 @@ void graph_t::attributes(tchecker::tck_reach::zg_covreach::edge_t const & e, std
   m["vedge"] = tchecker::to_string(e.vedge(), _zg->system().as_system_system());
 }
 
+void graph_t::save_node(std::ostream & os, node_sptr_t const & n) const
+{
+  tchecker::zg::serialize(os, n->state());
+  tchecker::graph::serialize(os, static_cast<tchecker::graph::node_flags_t const &>(*n));
+}
+
+graph_t::node_sptr_t graph_t::load_node(std::istream & is)
+{
+  node_sptr_t n = add_node(_zg->deserialize_state(is));
+  tchecker::graph::deserialize(is, static_cast<tchecker::graph::node_flags_t &>(*n));
+  return n;
+}
+
+void graph_t::save_edge(std::ostream & os, edge_sptr_t const & e) const
+{
+  tchecker::serialization::write(os, static_cast<std::uint8_t>(edge_type(e)));
+  tchecker::serialize(os, e->vedge());
+}
+
+void graph_t::load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt)
+{
+  std::uint8_t const type = tchecker::serialization::read<std::uint8_t>(is);
+  if (type > tchecker::graph::subsumption::EDGE_SUBSUMPTION)
+    throw std::runtime_error("Invalid edge type in checkpoint");
+  add_edge(src, tgt, static_cast<enum tchecker::graph::subsumption::edge_type_t>(type), *_zg->deserialize_transition(is));
+}
+
 /* dot_output */
 
 /*!
@@ -136,6 +189,16 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::g
                                                   tchecker::tck_reach::zg_covreach::edge_lexical_less_t>(os, g, name);
 }
 
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::subsumption::dot_output_unsorted<tchecker::tck_reach::zg_covreach::graph_t>(os, g, name);
+}
+
+std::ostream & binary_output(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::binary::binary_output(os, g, name, g.zg().system());
+}
+
 /* counter example */
 namespace cex {
 
@@ -159,38 +222,110 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::c
 
 /* run */
 
+/*!
+ \brief Run covering reachability algorithm with a waiting container
+ \tparam WAITING : type of waiting container
+ \param ts : transition system
+ \param graph : subsumption graph
+ \param labels : accepting labels
+ \param covering : covering policy
+ \param waiting : an empty waiting container
+ \return statistics on the run
+ \throw std::invalid_argument : if covering is unknown
+ */
+template <class WAITING>
+static tchecker::algorithms::covreach::stats_t run_algorithm(tchecker::zg::sharing_zg_t & ts, tchecker::tck_reach::zg_covreach::graph_t & graph,
+                                                             boost::dynamic_bitset<> const & labels,
+                                                             tchecker::algorithms::covreach::covering_t covering, WAITING & waiting)
+{
+  tchecker::tck_reach::zg_covreach::algorithm_t<WAITING> algorithm;
+  if (covering == tchecker::algorithms::covreach::COVERING_FULL)
+    return algorithm.template run_from_initial_states<tchecker::algorithms::covreach::COVERING_FULL>(ts, graph, labels, waiting);
+  else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
+    return algorithm.template run_from_initial_states<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(ts, graph, labels,
+                                                                                                           waiting);
+  throw std::invalid_argument("Unknown covering policy for covreach algorithm");
+}
+
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::string const & labels,
     std::string const & search_order, tchecker::algorithms::covreach::covering_t covering, std::size_t block_size,
-    std::size_t table_size)
+    std::size_t table_size, enum tchecker::tck_reach::zg_covreach::subsumption_t subsumption,
+    enum tchecker::zg::extrapolation_type_t extrapolation_type, bool active_clocks, bool symmetry)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
-  std::shared_ptr<tchecker::zg::sharing_zg_t> zg{tchecker::zg::factory_sharing(
-      system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+  std::shared_ptr<tchecker::zg::extrapolation_t> zg_extrapolation;
+  if (!active_clocks)
+    zg_extrapolation.reset(tchecker::zg::extrapolation_factory(extrapolation_type, *clock_bounds));
+  else
+    zg_extrapolation.reset(tchecker::zg::active_clocks_extrapolation_factory(extrapolation_type, *system, *clock_bounds));
+  std::shared_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(tchecker::zg::ELAPSED_SEMANTICS)};
+  std::shared_ptr<tchecker::zg::symmetry_t> zg_symmetry;
+  if (symmetry)
+    zg_symmetry = std::make_shared<tchecker::zg::symmetry_t>(*system, tchecker::ta::symmetry_groups(*system));
+  std::shared_ptr<tchecker::zg::sharing_zg_t> zg{
+      new tchecker::zg::sharing_zg_t{system, semantics, zg_extrapolation, block_size, table_size, zg_symmetry}};
+
+  // The covering predicate shares the cache of local LU clock bounds with the
+  // extrapolation when it has one, as nodes are covered right after their zone
+  // is extrapolated. aLU subsumption is sound w.r.t. any extrapolation
+  tchecker::tck_reach::zg_covreach::node_le_t node_le;
+  if (subsumption == tchecker::tck_reach::zg_covreach::SUBSUMPTION_ALU) {
+    auto local_lu = std::dynamic_pointer_cast<tchecker::zg::details::local_lu_extrapolation_t>(zg_extrapolation);
+    if (local_lu.get() != nullptr)
+      node_le = tchecker::tck_reach::zg_covreach::node_le_t{local_lu->cache()};
+    else
+      node_le = tchecker::tck_reach::zg_covreach::node_le_t{
+          std::make_shared<tchecker::clockbounds::local_lu_cache_t>(clock_bounds->local_lu_map())};
+  }
+  else if (subsumption != tchecker::tck_reach::zg_covreach::SUBSUMPTION_INCLUSION)
+    throw std::invalid_argument("Unknown subsumption for covreach algorithm");
 
   std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t> graph{
-      new tchecker::tck_reach::zg_covreach::graph_t{zg, block_size, table_size}};
+      new tchecker::tck_reach::zg_covreach::graph_t{zg, node_le, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  enum tchecker::waiting::policy_t policy = tchecker::algorithms::fast_remove_waiting_policy(search_order);
-
+  using node_sptr_t = tchecker::tck_reach::zg_covreach::graph_t::node_sptr_t;
   tchecker::algorithms::covreach::stats_t stats;
-  tchecker::tck_reach::zg_covreach::algorithm_t algorithm;
 
-  if (covering == tchecker::algorithms::covreach::COVERING_FULL)
-    stats = algorithm.run<tchecker::algorithms::covreach::COVERING_FULL>(*zg, *graph, accepting_labels, policy);
-  else if (covering == tchecker::algorithms::covreach::COVERING_LEAF_NODES)
-    stats = algorithm.run<tchecker::algorithms::covreach::COVERING_LEAF_NODES>(*zg, *graph, accepting_labels, policy);
+  if (tchecker::algorithms::guided_search_order(search_order)) {
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::algorithms::guided_waiting_factory<node_sptr_t, true>(
+        search_order,
+        std::make_shared<tchecker::algorithms::labels_heuristics_t const>(system->as_syncprod_system(), accepting_labels))};
+    stats = tchecker::tck_reach::zg_covreach::run_algorithm(*zg, *graph, accepting_labels, covering, *waiting);
+  }
   else
-    throw std::invalid_argument("Unknown covering policy for covreach algorithm");
+    stats = tchecker::waiting::static_dispatch<node_sptr_t>(
+        tchecker::algorithms::fast_remove_waiting_policy(search_order), [&](auto & waiting) {
+          return tchecker::tck_reach::zg_covreach::run_algorithm(*zg, *graph, accepting_labels, covering, waiting);
+        });
 
   return std::make_tuple(stats, graph);
 }
 
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+    std::string const & search_order, tchecker::algorithms::covreach::covering_t covering, std::size_t block_size,
+    std::size_t table_size, enum tchecker::tck_reach::zg_covreach::subsumption_t subsumption,
+    enum tchecker::zg::extrapolation_type_t extrapolation, bool active_clocks, bool intvars_reduction, bool symmetry,
+    bool packed_intvars)
+{
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+  system->dead_intvars_reset(intvars_reduction);
+  system->packed_intvars(packed_intvars);
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Unable to compute clock bounds");
+
+  return tchecker::tck_reach::zg_covreach::run(system, clock_bounds, labels, search_order, covering, block_size, table_size,
+                                               subsumption, extrapolation, active_clocks, symmetry);
+}
+
 } // namespace zg_covreach
 
 } // end of namespace tck_reach
@@ -11,15 +11,23 @@
 /*!
  \file zg-covreach.hh
  \brief Covering reachability algorithm over the zone graph with zone inclusion
+ or aLU subsumption
 */
 
+#include <iostream>
+#include <memory>
+
 #include "tchecker/algorithms/covreach/algorithm.hh"
+#include "tchecker/clockbounds/cache.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/subsumption_graph.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
+#include "tchecker/zg/extrapolation.hh"
 #include "tchecker/zg/path.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
@@ -74,21 +82,47 @@ public:
   std::size_t operator()(tchecker::tck_reach::zg_covreach::node_t const & n) const;
 };
 
+/*!
+ \brief Type of subsumption between zones
+ */
+enum subsumption_t {
+  SUBSUMPTION_INCLUSION, /*!< Zone inclusion */
+  SUBSUMPTION_ALU,       /*!< aLU subsumption w.r.t. local LU clock bounds */
+};
+
 /*!
 \class node_le_t
 \brief Covering predicate for nodes
 */
 class node_le_t {
 public:
+  /*!
+  \brief Constructor
+  \post this covering predicate checks zone inclusion
+  */
+  node_le_t() = default;
+
+  /*!
+  \brief Constructor
+  \param lu_cache : cache of local LU clock bounds
+  \post this covering predicate checks aLU subsumption w.r.t. the local LU clock
+  bounds in lu_cache
+  \note this keeps a shared pointer on lu_cache
+  */
+  node_le_t(std::shared_ptr<tchecker::clockbounds::local_lu_cache_t> const & lu_cache);
+
   /*!
   \brief Covering predicate for nodes
   \param n1 : a node
   \param n2 : a node
   \return true if n1 and n2 have same discrete part and the zone of n1 is
-  included in the zone of n2, false otherwise
+  included in (or aLU subsumed by) the zone of n2, false otherwise
   */
   bool operator()(tchecker::tck_reach::zg_covreach::node_t const & n1,
                   tchecker::tck_reach::zg_covreach::node_t const & n2) const;
+
+private:
+  std::shared_ptr<tchecker::clockbounds::local_lu_cache_t> _lu_cache; /*!< Local LU clock bounds (nullptr for zone inclusion) */
 };
 
 /*!
@@ -122,6 +156,17 @@ public:
   */
   graph_t(std::shared_ptr<tchecker::zg::sharing_zg_t> const & zg, std::size_t block_size, std::size_t table_size);
 
+  /*!
+   \brief Constructor
+   \param zg : zone graph
+   \param node_le : covering predicate for nodes
+   \param block_size : number of objects allocated in a block
+   \param table_size : size of hash table
+   \note this keeps a pointer on zg
+  */
+  graph_t(std::shared_ptr<tchecker::zg::sharing_zg_t> const & zg, tchecker::tck_reach::zg_covreach::node_le_t const & node_le,
+          std::size_t block_size, std::size_t table_size);
+
   /*!
    \brief Destructor
   */
@@ -143,6 +188,41 @@ public:
       tchecker::tck_reach::zg_covreach::node_t, tchecker::tck_reach::zg_covreach::edge_t,
       tchecker::tck_reach::zg_covreach::node_hash_t, tchecker::tck_reach::zg_covreach::node_le_t>::attributes;
 
+  /*!
+   \brief Save a node to a checkpoint
+   \param os : output stream
+   \param n : a node
+   \post the state and the flags of n have been written to os
+   */
+  void save_node(std::ostream & os, node_sptr_t const & n) const;
+
+  /*!
+   \brief Load a node from a checkpoint
+   \param is : input stream
+   \return a new node in this graph, read from is (see save_node)
+   \throw std::runtime_error : if is does not contain a node of this graph
+   */
+  node_sptr_t load_node(std::istream & is);
+
+  /*!
+   \brief Save an edge to a checkpoint
+   \param os : output stream
+   \param e : an edge
+   \post the type and the tuple of edges of e have been written to os
+   */
+  void save_edge(std::ostream & os, edge_sptr_t const & e) const;
+
+  /*!
+   \brief Load an edge from a checkpoint
+   \param is : input stream
+   \param src : source node
+   \param tgt : target node
+   \post an edge from src to tgt read from is (see save_edge) has been added to
+   this graph
+   \throw std::runtime_error : if is does not contain an edge of this graph
+   */
+  void load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt);
+
 protected:
   /*!
    \brief Accessor to node attributes
@@ -173,6 +253,26 @@ private:
 */
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name);
 
+/*!
+ \brief Graph output without sorting
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os, with nodes named by their
+ identifiers in exploration order (see tchecker::graph::dot_output_unsorted)
+*/
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name);
+
+/*!
+ \brief Graph output as a binary certificate
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os as a binary certificate (see
+ tchecker::graph::binary::binary_output)
+*/
+std::ostream & binary_output(std::ostream & os, tchecker::tck_reach::zg_covreach::graph_t const & g, std::string const & name);
+
 namespace cex {
 
 namespace symbolic {
@@ -208,14 +308,46 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_covreach::c
 /*!
  \class algorithm_t
  \brief Covering reachability algorithm over the zone graph
+ \tparam WAITING : type of waiting container
 */
-class algorithm_t : public tchecker::algorithms::covreach::algorithm_t<tchecker::zg::sharing_zg_t,
-                                                                       tchecker::tck_reach::zg_covreach::graph_t> {
+template <class WAITING = tchecker::waiting::waiting_t<tchecker::tck_reach::zg_covreach::graph_t::node_sptr_t>>
+class algorithm_t
+    : public tchecker::algorithms::covreach::algorithm_t<tchecker::zg::sharing_zg_t, tchecker::tck_reach::zg_covreach::graph_t, WAITING> {
 public:
-  using tchecker::algorithms::covreach::algorithm_t<tchecker::zg::sharing_zg_t,
-                                                    tchecker::tck_reach::zg_covreach::graph_t>::algorithm_t;
+  using tchecker::algorithms::covreach::algorithm_t<tchecker::zg::sharing_zg_t, tchecker::tck_reach::zg_covreach::graph_t,
+                                                 WAITING>::algorithm_t;
 };
 
+/*!
+ \brief Run covering reachability algorithm on the zone graph of a system
+ \param system : a system of timed processes
+ \param clock_bounds : clock bounds of system
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param covering : covering policy
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param subsumption : subsumption between zones used for covering
+ \param extrapolation : zone extrapolation
+ \param active_clocks : free inactive clocks in zones when true (see
+ tchecker::zg::active_clocks_extrapolation_t)
+ \param symmetry : canonicalize states w.r.t. groups of symmetric processes when
+ true (see tchecker::ta::symmetry_groups)
+ \pre labels must appear as node attributes in system
+ search_order must be one of "bfs", "dfs", "best", "astar" or "random"
+ \return statistics on the run and the covering reachability graph
+ \throw std::invalid_argument : if symmetry is true and some declared group of
+ symmetric processes is not symmetric
+ \note system and clock_bounds are not modified, and can be reused by subsequent
+ runs
+ */
+std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
+run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::string const & labels,
+    std::string const & search_order, tchecker::algorithms::covreach::covering_t covering, std::size_t block_size,
+    std::size_t table_size, enum tchecker::tck_reach::zg_covreach::subsumption_t subsumption,
+    enum tchecker::zg::extrapolation_type_t extrapolation, bool active_clocks, bool symmetry);
+
 /*!
  \brief Run covering reachability algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -224,15 +356,31 @@ public:
  \param covering : covering policy
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param subsumption : subsumption between zones used for covering
+ \param extrapolation : zone extrapolation
+ \param active_clocks : free inactive clocks in zones when true (see
+ tchecker::zg::active_clocks_extrapolation_t)
+ \param intvars_reduction : reset dead bounded integer variables when true (see
+ tchecker::ta::system_t::dead_intvars_reset)
+ \param symmetry : canonicalize states w.r.t. groups of symmetric processes when
+ true (see tchecker::ta::symmetry_groups)
+ \param packed_intvars : store valuations of bounded integer variables as packed
+ bit-fields when true (see tchecker::ta::system_t::packed_intvars)
  \pre labels must appear as node attributes in sysdecl
- search_order must be either "dfs" or "bfs"
+ search_order must be one of "bfs", "dfs", "best", "astar" or "random"
  \return statistics on the run and the covering reachability graph
+ \throw std::runtime_error : if clock bounds cannot be inferred from sysdecl
+ \throw std::invalid_argument : if symmetry is true and some declared group of
+ symmetric processes is not symmetric
  */
 std::tuple<tchecker::algorithms::covreach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_covreach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
     std::string const & search_order = "bfs",
     tchecker::algorithms::covreach::covering_t covering = tchecker::algorithms::covreach::COVERING_FULL,
-    std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::tck_reach::zg_covreach::subsumption_t subsumption = tchecker::tck_reach::zg_covreach::SUBSUMPTION_INCLUSION,
+    enum tchecker::zg::extrapolation_type_t extrapolation = tchecker::zg::EXTRA_LU_PLUS_LOCAL, bool active_clocks = false,
+    bool intvars_reduction = true, bool symmetry = false, bool packed_intvars = false);
 
 } // end of namespace zg_covreach
 
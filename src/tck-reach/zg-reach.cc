@@ -5,15 +5,23 @@
  *
  */
 
+#include <cstdint>
 #include <ranges>
+#include <stdexcept>
+#include <type_traits>
 
 #include <boost/dynamic_bitset.hpp>
 
 #include "counter_example.hh"
+#include "tchecker/algorithms/heuristics.hh"
 #include "tchecker/algorithms/search_order.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/graph/binary_certificate.hh"
 #include "tchecker/system/static_analysis.hh"
+#include "tchecker/ta/symmetry.hh"
 #include "tchecker/ta/system.hh"
 #include "tchecker/utils/log.hh"
+#include "tchecker/utils/serialization.hh"
 #include "zg-reach.hh"
 
 namespace tchecker {
@@ -83,6 +91,31 @@ void graph_t::attributes(tchecker::tck_reach::zg_reach::edge_t const & e, std::m
   m["vedge"] = tchecker::to_string(e.vedge(), _zg->system().as_system_system());
 }
 
+void graph_t::save_node(std::ostream & os, node_sptr_t const & n) const
+{
+  tchecker::zg::serialize(os, n->state());
+  tchecker::graph::serialize(os, static_cast<tchecker::graph::node_flags_t const &>(*n));
+}
+
+graph_t::node_sptr_t graph_t::load_node(std::istream & is)
+{
+  auto && [is_new_node, n] = add_node(_zg->deserialize_state(is));
+  if (!is_new_node)
+    throw std::runtime_error("Duplicate state in checkpoint");
+  tchecker::graph::deserialize(is, static_cast<tchecker::graph::node_flags_t &>(*n));
+  return n;
+}
+
+void graph_t::save_edge(std::ostream & os, edge_sptr_t const & e) const
+{
+  tchecker::serialize(os, e->vedge());
+}
+
+void graph_t::load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt)
+{
+  add_edge(src, tgt, *_zg->deserialize_transition(is));
+}
+
 /* dot_output */
 
 /*!
@@ -135,6 +168,16 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::grap
                                                    tchecker::tck_reach::zg_reach::edge_lexical_less_t>(os, g, name);
 }
 
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::reachability::dot_output_unsorted<tchecker::tck_reach::zg_reach::graph_t>(os, g, name);
+}
+
+std::ostream & binary_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name)
+{
+  return tchecker::graph::binary::binary_output(os, g, name, g.zg().system());
+}
+
 /* counter example */
 namespace cex {
 
@@ -156,33 +199,87 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex:
 
 } // namespace cex
 
+/* extrapolation */
+
+enum tchecker::zg::extrapolation_type_t extrapolation_type(std::string const & name)
+{
+  if (name == "lu-local")
+    return tchecker::zg::EXTRA_LU_PLUS_LOCAL;
+  else if (name == "lu-global")
+    return tchecker::zg::EXTRA_LU_PLUS_GLOBAL;
+  else if (name == "m-local")
+    return tchecker::zg::EXTRA_M_PLUS_LOCAL;
+  else if (name == "m-global")
+    return tchecker::zg::EXTRA_M_PLUS_GLOBAL;
+  throw std::invalid_argument("Unknown extrapolation: " + name);
+}
+
 /* run */
 
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
-run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
-    std::string const & search_order, std::size_t block_size, std::size_t table_size)
+run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::zg::extrapolation_type_t extrapolation_type, bool active_clocks, bool symmetry)
 {
-  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
   if (!tchecker::system::every_process_has_initial_location(system->as_system_system()))
     std::cerr << tchecker::log_warning << "system has no initial state" << std::endl;
 
-  std::shared_ptr<tchecker::zg::sharing_zg_t> zg{tchecker::zg::factory_sharing(
-      system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, block_size, table_size)};
+  std::shared_ptr<tchecker::zg::extrapolation_t> extrapolation;
+  if (!active_clocks)
+    extrapolation.reset(tchecker::zg::extrapolation_factory(extrapolation_type, *clock_bounds));
+  else
+    extrapolation.reset(tchecker::zg::active_clocks_extrapolation_factory(extrapolation_type, *system, *clock_bounds));
+  std::shared_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(tchecker::zg::ELAPSED_SEMANTICS)};
+  std::shared_ptr<tchecker::zg::symmetry_t> zg_symmetry;
+  if (symmetry)
+    zg_symmetry = std::make_shared<tchecker::zg::symmetry_t>(*system, tchecker::ta::symmetry_groups(*system));
+  std::shared_ptr<tchecker::zg::sharing_zg_t> zg{
+      new tchecker::zg::sharing_zg_t{system, semantics, extrapolation, block_size, table_size, zg_symmetry}};
 
   std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t> graph{
       new tchecker::tck_reach::zg_reach::graph_t{zg, block_size, table_size}};
 
   boost::dynamic_bitset<> accepting_labels = system->as_syncprod_system().labels(labels);
 
-  tchecker::tck_reach::zg_reach::algorithm_t algorithm;
-
-  enum tchecker::waiting::policy_t policy = tchecker::algorithms::waiting_policy(search_order);
+  using node_sptr_t = tchecker::tck_reach::zg_reach::graph_t::node_sptr_t;
+  tchecker::algorithms::reach::stats_t stats;
 
-  tchecker::algorithms::reach::stats_t stats = algorithm.run(*zg, *graph, accepting_labels, policy);
+  if (tchecker::algorithms::guided_search_order(search_order)) {
+    std::unique_ptr<tchecker::waiting::waiting_t<node_sptr_t>> waiting{tchecker::algorithms::guided_waiting_factory<node_sptr_t, false>(
+        search_order,
+        std::make_shared<tchecker::algorithms::labels_heuristics_t const>(system->as_syncprod_system(), accepting_labels))};
+    tchecker::tck_reach::zg_reach::algorithm_t<> algorithm;
+    stats = algorithm.run_from_initial_states(*zg, *graph, accepting_labels, *waiting);
+  }
+  else
+    stats = tchecker::waiting::static_dispatch<node_sptr_t>(
+        tchecker::algorithms::waiting_policy(search_order), [&](auto & waiting) {
+          tchecker::tck_reach::zg_reach::algorithm_t<std::remove_reference_t<decltype(waiting)>> algorithm;
+          return algorithm.run_from_initial_states(*zg, *graph, accepting_labels, waiting);
+        });
 
   return std::make_tuple(stats, graph);
 }
 
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
+run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::zg::extrapolation_type_t extrapolation, bool active_clocks, bool intvars_reduction, bool symmetry,
+    bool packed_intvars)
+{
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+  system->dead_intvars_reset(intvars_reduction);
+  system->packed_intvars(packed_intvars);
+
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+  if (clock_bounds.get() == nullptr)
+    throw std::runtime_error("Unable to compute clock bounds");
+
+  return tchecker::tck_reach::zg_reach::run(system, clock_bounds, labels, search_order, block_size, table_size, extrapolation,
+                                            active_clocks, symmetry);
+}
+
 } // namespace zg_reach
 
 } // end of namespace tck_reach
@@ -9,19 +9,22 @@
 #define TCHECKER_ZG_REACH_ALGORITHM_HH
 
 #include <memory>
-#include <ostream>
+#include <iostream>
 #include <string>
 #include <tuple>
 
 #include "tchecker/algorithms/reach/algorithm.hh"
 #include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
 #include "tchecker/graph/edge.hh"
 #include "tchecker/graph/node.hh"
 #include "tchecker/graph/reachability_graph.hh"
 #include "tchecker/parsing/declaration.hh"
 #include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
 #include "tchecker/utils/shared_objects.hh"
 #include "tchecker/waiting/waiting.hh"
+#include "tchecker/zg/extrapolation.hh"
 #include "tchecker/zg/path.hh"
 #include "tchecker/zg/state.hh"
 #include "tchecker/zg/transition.hh"
@@ -141,6 +144,41 @@ public:
                                                tchecker::tck_reach::zg_reach::node_hash_t,
                                                tchecker::tck_reach::zg_reach::node_equal_to_t>::attributes;
 
+  /*!
+   \brief Save a node to a checkpoint
+   \param os : output stream
+   \param n : a node
+   \post the state and the flags of n have been written to os
+   */
+  void save_node(std::ostream & os, node_sptr_t const & n) const;
+
+  /*!
+   \brief Load a node from a checkpoint
+   \param is : input stream
+   \return a new node in this graph, read from is (see save_node)
+   \throw std::runtime_error : if is does not contain a node of this graph
+   */
+  node_sptr_t load_node(std::istream & is);
+
+  /*!
+   \brief Save an edge to a checkpoint
+   \param os : output stream
+   \param e : an edge
+   \post the tuple of edges of e have been written to os
+   */
+  void save_edge(std::ostream & os, edge_sptr_t const & e) const;
+
+  /*!
+   \brief Load an edge from a checkpoint
+   \param is : input stream
+   \param src : source node
+   \param tgt : target node
+   \post an edge from src to tgt read from is (see save_edge) has been added to
+   this graph
+   \throw std::runtime_error : if is does not contain an edge of this graph
+   */
+  void load_edge(std::istream & is, node_sptr_t const & src, node_sptr_t const & tgt);
+
 protected:
   /*!
    \brief Accessor to node attributes
@@ -171,6 +209,26 @@ private:
 */
 std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name);
 
+/*!
+ \brief Graph output without sorting
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os, with nodes named by their
+ identifiers in exploration order (see tchecker::graph::dot_output_unsorted)
+*/
+std::ostream & dot_output_unsorted(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name);
+
+/*!
+ \brief Graph output as a binary certificate
+ \param os : output stream
+ \param g : graph
+ \param name : graph name
+ \post graph g with name has been output to os as a binary certificate (see
+ tchecker::graph::binary::binary_output)
+*/
+std::ostream & binary_output(std::ostream & os, tchecker::tck_reach::zg_reach::graph_t const & g, std::string const & name);
+
 namespace cex {
 
 namespace symbolic {
@@ -206,14 +264,53 @@ std::ostream & dot_output(std::ostream & os, tchecker::tck_reach::zg_reach::cex:
 /*!
  \class algorithm_t
  \brief Reachability algorithm over the zone graph
+ \tparam WAITING : type of waiting container
 */
+template <class WAITING = tchecker::waiting::waiting_t<tchecker::tck_reach::zg_reach::graph_t::node_sptr_t>>
 class algorithm_t
-    : public tchecker::algorithms::reach::algorithm_t<tchecker::zg::sharing_zg_t, tchecker::tck_reach::zg_reach::graph_t> {
+    : public tchecker::algorithms::reach::algorithm_t<tchecker::zg::sharing_zg_t, tchecker::tck_reach::zg_reach::graph_t, WAITING> {
 public:
-  using tchecker::algorithms::reach::algorithm_t<tchecker::zg::sharing_zg_t,
-                                                 tchecker::tck_reach::zg_reach::graph_t>::algorithm_t;
+  using tchecker::algorithms::reach::algorithm_t<tchecker::zg::sharing_zg_t, tchecker::tck_reach::zg_reach::graph_t,
+                                                 WAITING>::algorithm_t;
 };
 
+/*!
+ \brief Zone extrapolation from its name
+ \param name : name of an extrapolation
+ \return ExtraLU+ with local (resp. global) LU clock bounds if name is "lu-local"
+ (resp. "lu-global"), ExtraM+ with local (resp. global) M clock bounds if name is
+ "m-local" (resp. "m-global")
+ \throw std::invalid_argument : if name is not a name of extrapolation
+ */
+enum tchecker::zg::extrapolation_type_t extrapolation_type(std::string const & name);
+
+/*!
+ \brief Run reachability algorithm on the zone graph of a system
+ \param system : a system of timed processes
+ \param clock_bounds : clock bounds of system
+ \param labels : comma-separated string of labels
+ \param search_order : search order
+ \param block_size : number of elements allocated in one block
+ \param table_size : size of hash tables
+ \param extrapolation : zone extrapolation
+ \param active_clocks : free inactive clocks in zones when true (see
+ tchecker::zg::active_clocks_extrapolation_t)
+ \param symmetry : canonicalize states w.r.t. groups of symmetric processes when
+ true (see tchecker::ta::symmetry_groups)
+ \pre labels must appear as node attributes in system
+ search_order must be one of "bfs", "dfs", "best", "astar" or "random"
+ \return statistics on the run and the reachability graph
+ \throw std::invalid_argument : if symmetry is true and some declared group of
+ symmetric processes is not symmetric
+ \note system and clock_bounds are not modified, and can be reused by subsequent
+ runs
+ */
+std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
+run(std::shared_ptr<tchecker::ta::system_t const> const & system,
+    std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds, std::string const & labels,
+    std::string const & search_order, std::size_t block_size, std::size_t table_size,
+    enum tchecker::zg::extrapolation_type_t extrapolation, bool active_clocks, bool symmetry);
+
 /*!
  \brief Run reachability algorithm on the zone graph of a system
  \param sysdecl : system declaration
@@ -221,13 +318,27 @@ public:
  \param search_order : search order
  \param block_size : number of elements allocated in one block
  \param table_size : size of hash tables
+ \param extrapolation : zone extrapolation
+ \param active_clocks : free inactive clocks in zones when true (see
+ tchecker::zg::active_clocks_extrapolation_t)
+ \param intvars_reduction : reset dead bounded integer variables when true (see
+ tchecker::ta::system_t::dead_intvars_reset)
+ \param symmetry : canonicalize states w.r.t. groups of symmetric processes when
+ true (see tchecker::ta::symmetry_groups)
+ \param packed_intvars : store valuations of bounded integer variables as packed
+ bit-fields when true (see tchecker::ta::system_t::packed_intvars)
  \pre labels must appear as node attributes in sysdecl
- search_order must be either "dfs" or "bfs"
+ search_order must be one of "bfs", "dfs", "best", "astar" or "random"
  \return statistics on the run and the reachability graph
+ \throw std::runtime_error : if clock bounds cannot be inferred from sysdecl
+ \throw std::invalid_argument : if symmetry is true and some declared group of
+ symmetric processes is not symmetric
  */
 std::tuple<tchecker::algorithms::reach::stats_t, std::shared_ptr<tchecker::tck_reach::zg_reach::graph_t>>
 run(std::shared_ptr<tchecker::parsing::system_declaration_t> const & sysdecl, std::string const & labels = "",
-    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536);
+    std::string const & search_order = "bfs", std::size_t block_size = 10000, std::size_t table_size = 65536,
+    enum tchecker::zg::extrapolation_type_t extrapolation = tchecker::zg::EXTRA_LU_PLUS_LOCAL, bool active_clocks = false,
+    bool intvars_reduction = true, bool symmetry = false, bool packed_intvars = false);
 
 } // end of namespace zg_reach
 
@@ -0,0 +1,300 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../tck-liveness/zg-couvscc.hh"
+#include "../tck-liveness/zg-ndfs.hh"
+#include "../tck-reach/attributes.hh"
+#include "../tck-reach/concur19.hh"
+#include "../tck-reach/zg-covreach.hh"
+#include "../tck-reach/zg-reach.hh"
+#include "server.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/parsing/parsing.hh"
+
+namespace tchecker {
+
+namespace tck_server {
+
+/* model_hash */
+
+std::uint64_t model_hash(std::string const & content)
+{
+  std::uint64_t h = 14695981039346656037ULL;
+  for (unsigned char c : content) {
+    h ^= c;
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+/* model_t */
+
+model_t::model_t(std::string const & content, std::string const & filename) : _content(content), _compile_time(0)
+{
+  std::chrono::time_point<std::chrono::steady_clock> const start = std::chrono::steady_clock::now();
+
+  std::FILE * f = std::tmpfile();
+  if (f == nullptr)
+    throw std::runtime_error("Unable to create temporary file");
+  std::fwrite(content.data(), 1, content.size(), f);
+  std::fseek(f, 0, SEEK_SET);
+
+  tchecker::parsing::system_declaration_t * sysdecl = nullptr;
+  try {
+    sysdecl = tchecker::parsing::parse_system_declaration(f, filename);
+  }
+  catch (...) {
+    std::fclose(f);
+    throw;
+  }
+  std::fclose(f);
+  if (sysdecl == nullptr)
+    throw std::runtime_error("Syntax error in " + filename);
+  _sysdecl.reset(sysdecl);
+
+  _system = std::make_shared<tchecker::ta::system_t>(*_sysdecl);
+  _clock_bounds.reset(tchecker::clockbounds::compute_clockbounds(*_system));
+
+  std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+  _compile_time = duration.count();
+}
+
+/* model_cache_t */
+
+model_cache_t::model_cache_t(std::size_t capacity, std::function<std::uint64_t(std::string const &)> hash)
+    : _capacity(capacity), _hash(std::move(hash)), _hits(0), _misses(0)
+{
+  if (_capacity == 0)
+    throw std::invalid_argument("Model cache capacity should be positive");
+}
+
+std::shared_ptr<tchecker::tck_server::model_t const> model_cache_t::get(std::string const & filename, bool & hit)
+{
+  std::ifstream ifs(filename, std::ios::binary);
+  if (!ifs)
+    throw std::runtime_error("Unable to read " + filename);
+  std::ostringstream oss;
+  oss << ifs.rdbuf();
+  std::string const content = oss.str();
+  std::uint64_t const hash = _hash(content);
+
+  auto it = _index.find(hash);
+  if (it != _index.end() && it->second->second->content() == content) {
+    _models.splice(_models.begin(), _models, it->second);
+    ++_hits;
+    hit = true;
+    return _models.front().second;
+  }
+
+  std::shared_ptr<tchecker::tck_server::model_t const> model{new tchecker::tck_server::model_t{content, filename}};
+  ++_misses;
+  hit = false;
+
+  if (it != _index.end()) { // hash collision: replace
+    _models.erase(it->second);
+    _index.erase(it);
+  }
+  _models.emplace_front(hash, model);
+  _index[hash] = _models.begin();
+  if (_models.size() > _capacity) {
+    _index.erase(_models.back().first);
+    _models.pop_back();
+  }
+  return model;
+}
+
+/* parse_request */
+
+tchecker::tck_server::request_t parse_request(std::vector<std::string> const & tokens)
+{
+  tchecker::tck_server::request_t r;
+  r.tool = tokens[0];
+  r.algorithm = (r.tool == "reach" ? "reach" : "ndfs");
+
+  auto argument = [&](std::size_t & i) -> std::string const & {
+    if (i + 1 >= tokens.size())
+      throw std::invalid_argument("Missing parameter for option " + tokens[i]);
+    return tokens[++i];
+  };
+
+  for (std::size_t i = 1; i < tokens.size(); ++i) {
+    std::string const & t = tokens[i];
+    if (t == "-a")
+      r.algorithm = argument(i);
+    else if (t == "-l")
+      r.labels = argument(i);
+    else if (t == "-s" && r.tool == "reach")
+      r.search_order = argument(i);
+    else if (t == "--subsumption" && r.tool == "reach") {
+      std::string const & s = argument(i);
+      if (s == "inclusion")
+        r.subsumption = tchecker::tck_reach::zg_covreach::SUBSUMPTION_INCLUSION;
+      else if (s == "alu")
+        r.subsumption = tchecker::tck_reach::zg_covreach::SUBSUMPTION_ALU;
+      else
+        throw std::invalid_argument("Unknown subsumption: " + s);
+    }
+    else if (t == "--extrapolation" && r.tool == "reach")
+      r.extrapolation = tchecker::tck_reach::zg_reach::extrapolation_type(argument(i));
+    else if (t == "--active-clocks" && r.tool == "reach")
+      r.active_clocks = true;
+    else if (t == "--no-intvars-reduction" && r.tool == "reach")
+      r.intvars_reduction = false;
+    else if (t == "--symmetry" && r.tool == "reach")
+      r.symmetry = true;
+    else if (t == "--por" && r.tool == "reach")
+      r.por = true;
+    else if (t == "--block-size")
+      r.block_size = std::stoull(argument(i));
+    else if (t == "--table-size")
+      r.table_size = std::stoull(argument(i));
+    else if (!t.empty() && t[0] == '-')
+      throw std::invalid_argument("Unknown option: " + t);
+    else if (r.filename.empty())
+      r.filename = t;
+    else
+      throw std::invalid_argument("Too many input files");
+  }
+
+  if (r.filename.empty())
+    throw std::invalid_argument("No input file");
+  if (r.symmetry && r.algorithm == "concur19")
+    throw std::invalid_argument("Symmetry reduction is not supported by algorithm concur19");
+  if (r.por && r.algorithm != "concur19")
+    throw std::invalid_argument("Partial-order reduction is only supported by algorithm concur19");
+  return r;
+}
+
+/*!
+ \brief Run a verification request
+ \param r : a request
+ \param model : compiled model of r
+ \param m : attributes map
+ \post the statistics of the run of r on model have been added to m
+ \throw std::runtime_error : if r cannot be run on model
+ \note the system of model is shared by all the requests on model, and requests
+ are served one at a time. The reset of dead bounded integer variables, which
+ is the only setting of the system that depends on the request, is set before
+ each run. Statistics are read from the graph of the run, not from the system
+ */
+static void run(tchecker::tck_server::request_t const & r, tchecker::tck_server::model_t const & model,
+                std::map<std::string, std::string> & m)
+{
+  std::shared_ptr<tchecker::ta::system_t> const & system = model.system();
+  system->dead_intvars_reset(r.tool == "reach" && r.intvars_reduction);
+
+  if (r.algorithm != "concur19" && model.clock_bounds().get() == nullptr)
+    throw std::runtime_error("Unable to compute clock bounds");
+
+  if (r.tool == "reach" && r.algorithm == "reach") {
+    auto && [stats, graph] = tchecker::tck_reach::zg_reach::run(system, model.clock_bounds(), r.labels, r.search_order,
+                                                                r.block_size, r.table_size, r.extrapolation, r.active_clocks,
+                                                                r.symmetry);
+    stats.attributes(m);
+    tchecker::tck_reach::intvars_reset_attributes(graph->zg(), m);
+    tchecker::tck_reach::active_clocks_attributes(graph->zg(), m);
+    tchecker::tck_reach::symmetry_attributes(graph->zg(), m);
+  }
+  else if (r.tool == "reach" && r.algorithm == "covreach") {
+    auto && [stats, graph] = tchecker::tck_reach::zg_covreach::run(
+        system, model.clock_bounds(), r.labels, r.search_order, tchecker::algorithms::covreach::COVERING_FULL, r.block_size,
+        r.table_size, r.subsumption, r.extrapolation, r.active_clocks, r.symmetry);
+    stats.attributes(m);
+    tchecker::tck_reach::intvars_reset_attributes(graph->zg(), m);
+    tchecker::tck_reach::active_clocks_attributes(graph->zg(), m);
+    tchecker::tck_reach::symmetry_attributes(graph->zg(), m);
+  }
+  else if (r.tool == "reach" && r.algorithm == "concur19") {
+    auto && [stats, graph] = tchecker::tck_reach::concur19::run(system, r.labels, r.search_order,
+                                                                tchecker::algorithms::covreach::COVERING_FULL, r.block_size,
+                                                                r.table_size, r.por);
+    stats.attributes(m);
+    tchecker::tck_reach::intvars_reset_attributes(graph->refzg(), m);
+    if (graph->refzg().por().get() != nullptr)
+      m["POR_REDUCED_STATES"] = std::to_string(graph->refzg().por()->reduced_states());
+  }
+  else if (r.tool == "liveness" && r.algorithm == "ndfs") {
+    auto && [stats, graph] =
+        tchecker::tck_liveness::zg_ndfs::run(system, model.clock_bounds(), r.labels, r.block_size, r.table_size);
+    stats.attributes(m);
+  }
+  else if (r.tool == "liveness" && r.algorithm == "couvscc") {
+    auto && [stats, graph] =
+        tchecker::tck_liveness::zg_couvscc::run(system, model.clock_bounds(), r.labels, r.block_size, r.table_size);
+    stats.attributes(m);
+  }
+  else
+    throw std::invalid_argument("Unknown algorithm: " + r.algorithm);
+}
+
+/* serve */
+
+enum tchecker::tck_server::request_status_t serve(tchecker::tck_server::model_cache_t & cache, std::string const & request,
+                                                  std::ostream & os)
+{
+  std::vector<std::string> tokens;
+  std::istringstream iss(request);
+  for (std::string t; iss >> t;)
+    tokens.push_back(t);
+
+  enum tchecker::tck_server::request_status_t status = tchecker::tck_server::REQUEST_OK;
+  std::map<std::string, std::string> m;
+
+  try {
+    if (tokens.empty())
+      throw std::invalid_argument("Empty request");
+    else if (tokens[0] == "shutdown")
+      status = tchecker::tck_server::REQUEST_SHUTDOWN;
+    else if (tokens[0] == "stats") {
+      m["MODEL_CACHE_SIZE"] = std::to_string(cache.size());
+      m["MODEL_CACHE_HITS"] = std::to_string(cache.hits());
+      m["MODEL_CACHE_MISSES"] = std::to_string(cache.misses());
+    }
+    else if (tokens[0] == "reach" || tokens[0] == "liveness") {
+      std::chrono::time_point<std::chrono::steady_clock> const start = std::chrono::steady_clock::now();
+      tchecker::tck_server::request_t const r = parse_request(tokens);
+
+      bool hit = false;
+      std::shared_ptr<tchecker::tck_server::model_t const> model = cache.get(r.filename, hit);
+      tchecker::tck_server::run(r, *model, m);
+
+      std::ostringstream hash;
+      hash << std::hex << std::setw(16) << std::setfill('0') << tchecker::tck_server::model_hash(model->content());
+      std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+      m["MODEL_CACHE"] = (hit ? "hit" : "miss");
+      m["MODEL_HASH"] = hash.str();
+      m["MODEL_COMPILE_TIME_SECONDS"] = (hit ? "0" : std::to_string(model->compile_time()));
+      m["REQUEST_TIME_SECONDS"] = std::to_string(duration.count());
+    }
+    else
+      throw std::invalid_argument("Unknown request: " + tokens[0]);
+  }
+  catch (std::exception const & e) {
+    m.clear();
+    os << "ERROR " << e.what() << std::endl;
+    status = tchecker::tck_server::REQUEST_ERROR;
+  }
+
+  for (auto && [key, value] : m)
+    os << key << " " << value << std::endl;
+  os << "END" << std::endl;
+  return status;
+}
+
+} // namespace tck_server
+
+} // namespace tchecker
@@ -0,0 +1,225 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_TCK_SERVER_SERVER_HH
+#define TCHECKER_TCK_SERVER_SERVER_HH
+
+/*!
+ \file server.hh
+ \brief Verification requests on cached compiled models
+*/
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../tck-reach/zg-covreach.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/extrapolation.hh"
+
+namespace tchecker {
+
+namespace tck_server {
+
+/*!
+ \brief Hash of a model
+ \param content : content of a model file
+ \return 64-bits FNV-1a hash of content
+ */
+std::uint64_t model_hash(std::string const & content);
+
+/*!
+ \class model_t
+ \brief Compiled model: system declaration, system of timed processes and clock
+ bounds
+ */
+class model_t {
+public:
+  /*!
+   \brief Constructor
+   \param content : content of a model file
+   \param filename : name of the model file (used in error messages)
+   \post content has been parsed and compiled into a system of timed processes,
+   and the clock bounds of this system have been computed
+   \throw std::runtime_error : if content cannot be parsed or compiled
+   */
+  model_t(std::string const & content, std::string const & filename);
+
+  /*!
+   \brief Accessor
+   \return content of the model file
+   */
+  inline std::string const & content() const { return _content; }
+
+  /*!
+   \brief Accessor
+   \return system declaration
+   */
+  inline tchecker::parsing::system_declaration_t const & sysdecl() const { return *_sysdecl; }
+
+  /*!
+   \brief Accessor
+   \return system of timed processes
+   \note the system is shared by all the requests on this model: the reset of
+   dead bounded integer variables shall be set before each run (see
+   tchecker::ta::system_t::dead_intvars_reset)
+   */
+  inline std::shared_ptr<tchecker::ta::system_t> const & system() const { return _system; }
+
+  /*!
+   \brief Accessor
+   \return clock bounds of system(), nullptr if clock bounds cannot be inferred
+   */
+  inline std::shared_ptr<tchecker::clockbounds::clockbounds_t const> const & clock_bounds() const { return _clock_bounds; }
+
+  /*!
+   \brief Accessor
+   \return time to parse and compile the model (in seconds)
+   */
+  inline double compile_time() const { return _compile_time; }
+
+private:
+  std::string _content;                                                  /*!< Content of the model file */
+  std::shared_ptr<tchecker::parsing::system_declaration_t const> _sysdecl; /*!< System declaration */
+  std::shared_ptr<tchecker::ta::system_t> _system;                       /*!< System of timed processes */
+  std::shared_ptr<tchecker::clockbounds::clockbounds_t const> _clock_bounds; /*!< Clock bounds */
+  double _compile_time;                                                  /*!< Time to parse and compile */
+};
+
+/*!
+ \class model_cache_t
+ \brief Cache of compiled models keyed by the hash of their content
+ \note The least recently used model is evicted when the cache is full
+ */
+class model_cache_t {
+public:
+  /*!
+   \brief Constructor
+   \param capacity : maximal number of models in the cache
+   \param hash : hash function on the content of model files
+   \pre capacity > 0
+   \throw std::invalid_argument : if capacity is 0
+   \note a model replaces the cached model with the same hash and another
+   content
+   */
+  explicit model_cache_t(std::size_t capacity,
+                         std::function<std::uint64_t(std::string const &)> hash = tchecker::tck_server::model_hash);
+
+  /*!
+   \brief Get a compiled model
+   \param filename : name of a model file
+   \param hit : set to true if the model was found in the cache, false otherwise
+   \return the compiled model of the content of filename
+   \post the model is the most recently used one in the cache
+   \throw std::runtime_error : if filename cannot be read, or if its content
+   cannot be compiled
+   */
+  std::shared_ptr<tchecker::tck_server::model_t const> get(std::string const & filename, bool & hit);
+
+  /*!
+   \brief Accessor
+   \return number of models in the cache
+   */
+  inline std::size_t size() const { return _models.size(); }
+
+  /*!
+   \brief Accessor
+   \return number of requests that found their model in the cache
+   */
+  inline unsigned long hits() const { return _hits; }
+
+  /*!
+   \brief Accessor
+   \return number of requests that compiled their model
+   */
+  inline unsigned long misses() const { return _misses; }
+
+private:
+  using entry_t = std::pair<std::uint64_t, std::shared_ptr<tchecker::tck_server::model_t const>>;
+
+  std::size_t _capacity;                                                       /*!< Capacity */
+  std::function<std::uint64_t(std::string const &)> _hash;                     /*!< Hash function on contents */
+  std::list<entry_t> _models;                                                  /*!< Models, most recently used first */
+  std::unordered_map<std::uint64_t, std::list<entry_t>::iterator> _index;      /*!< Map from hashes to models */
+  unsigned long _hits;                                                         /*!< Number of hits */
+  unsigned long _misses;                                                       /*!< Number of misses */
+};
+
+/*!
+ \class request_t
+ \brief Verification request
+ */
+class request_t {
+public:
+  std::string tool;                     /*!< Tool: reach or liveness */
+  std::string algorithm;                /*!< Algorithm */
+  std::string labels;                   /*!< Searched labels */
+  std::string search_order = "bfs";     /*!< Search order */
+  enum tchecker::tck_reach::zg_covreach::subsumption_t subsumption =
+      tchecker::tck_reach::zg_covreach::SUBSUMPTION_INCLUSION; /*!< Subsumption for covreach */
+  enum tchecker::zg::extrapolation_type_t extrapolation = tchecker::zg::EXTRA_LU_PLUS_LOCAL; /*!< Zone extrapolation */
+  bool active_clocks = false;           /*!< Free inactive clocks in zones */
+  bool intvars_reduction = true;        /*!< Reset dead bounded integer variables */
+  bool symmetry = false;                /*!< Symmetry reduction */
+  bool por = false;                     /*!< Partial-order reduction */
+  std::size_t block_size = 10000;       /*!< Size of allocated blocks */
+  std::size_t table_size = 65536;       /*!< Size of hash tables */
+  std::string filename;                 /*!< Model file */
+};
+
+/*!
+ \brief Parse a verification request
+ \param tokens : words of a request
+ \pre tokens[0] is "reach" or "liveness"
+ \return request parsed from tokens
+ \throw std::invalid_argument : if tokens is not a valid request
+ */
+tchecker::tck_server::request_t parse_request(std::vector<std::string> const & tokens);
+
+/*!
+ \brief Status of a request
+ */
+enum request_status_t {
+  REQUEST_OK,       /*!< Request has been served */
+  REQUEST_ERROR,    /*!< Request has failed */
+  REQUEST_SHUTDOWN, /*!< Request to shut the server down */
+};
+
+/*!
+ \brief Serve a request
+ \param cache : cache of compiled models
+ \param request : a request (one line)
+ \param os : output stream
+ \return status of request
+ \post the response to request has been output to os: one "KEY VALUE" line per
+ statistics, or a line "ERROR message", followed by a line "END"
+ \note requests are:
+ reach [-a reach|covreach|concur19] [-l labels] [-s order] [--subsumption inclusion|alu]
+       [--extrapolation lu-local|lu-global|m-local|m-global] [--active-clocks]
+       [--no-intvars-reduction] [--symmetry] [--por]
+       [--block-size n] [--table-size n] file
+ liveness [-a ndfs|couvscc] [-l labels] [--block-size n] [--table-size n] file
+ stats
+ shutdown
+ Options have the same meaning as for tck-reach and tck-liveness. file should be
+ an absolute path, or a path relative to the working directory of the server
+ */
+enum tchecker::tck_server::request_status_t serve(tchecker::tck_server::model_cache_t & cache, std::string const & request,
+                                                  std::ostream & os);
+
+} // namespace tck_server
+
+} // namespace tchecker
+
+#endif // TCHECKER_TCK_SERVER_SERVER_HH
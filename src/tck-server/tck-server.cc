@@ -0,0 +1,343 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "server.hh"
+#include "tchecker/utils/log.hh"
+
+/*!
+ \file tck-server.cc
+ \brief Verification server: serves reachability and liveness requests on a
+ Unix socket, keeping compiled models in a cache
+ */
+
+static struct option long_options[] = {{"socket", required_argument, 0, 'S'},
+                                       {"query", required_argument, 0, 'q'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"cache-size", required_argument, 0, 0},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"hq:S:";
+
+/*!
+  \brief Display usage
+  \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options]" << std::endl;
+  std::cerr << "   -S socket     Unix socket (default: tck-server.sock)" << std::endl;
+  std::cerr << "   -q request    send request to the server listening on socket, and output the response" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   --cache-size n  maximal number of compiled models in the cache (default: 16)" << std::endl;
+  std::cerr << "serves requests on socket if -q is not provided. Requests are lines:" << std::endl;
+  std::cerr << "   reach [-a reach|covreach|concur19] [-l labels] [-s order] [--subsumption inclusion|alu]" << std::endl;
+  std::cerr << "         [--extrapolation lu-local|lu-global|m-local|m-global] [--active-clocks]" << std::endl;
+  std::cerr << "         [--no-intvars-reduction] [--symmetry] [--por]" << std::endl;
+  std::cerr << "         [--block-size n] [--table-size n] file" << std::endl;
+  std::cerr << "   liveness [-a ndfs|couvscc] [-l labels] [--block-size n] [--table-size n] file" << std::endl;
+  std::cerr << "   stats         statistics of the cache of compiled models" << std::endl;
+  std::cerr << "   shutdown      stop the server" << std::endl;
+  std::cerr << "options are as for tck-reach and tck-liveness, file is relative to the working directory of the server"
+            << std::endl;
+  std::cerr << "responses are lines KEY VALUE (or ERROR message) followed by a line END" << std::endl;
+}
+
+static bool help = false;                         /*!< Help flag */
+static std::string socket_path = "tck-server.sock"; /*!< Unix socket */
+static std::string query = "";                    /*!< Request to send (empty means serve requests) */
+static std::size_t cache_size = 16;               /*!< Capacity of the cache of compiled models */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables help, socket_path, query and cache_size have been set
+ from argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'S':
+        socket_path = optarg;
+        break;
+      case 'q':
+        query = optarg;
+        break;
+      case 'h':
+        help = true;
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "cache-size") == 0)
+        cache_size = std::strtoull(optarg, nullptr, 10);
+      else
+        throw std::runtime_error("This also should never be executed");
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Address of a Unix socket
+ \param path : path of the socket
+ \return address of socket at path
+ \throw std::runtime_error : if path is too long
+ */
+static struct sockaddr_un socket_address(std::string const & path)
+{
+  struct sockaddr_un addr;
+  std::memset(&addr, 0, sizeof(addr));
+  addr.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(addr.sun_path))
+    throw std::runtime_error("Socket path too long: " + path);
+  std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+  return addr;
+}
+
+/*!
+ \brief Send a string on a socket
+ \param fd : socket
+ \param s : string
+ \return true if s has been sent, false otherwise
+ */
+static bool send_all(int fd, std::string const & s)
+{
+  std::size_t sent = 0;
+  while (sent < s.size()) {
+    ssize_t n = ::send(fd, s.data() + sent, s.size() - sent, 0);
+    if (n < 0 && errno == EINTR)
+      continue;
+    if (n <= 0)
+      return false;
+    sent += static_cast<std::size_t>(n);
+  }
+  return true;
+}
+
+/*!
+ \brief Stop flag, set by SIGINT and SIGTERM
+ */
+static volatile std::sig_atomic_t stop = 0;
+
+/*!
+ \brief Signal handler
+ */
+static void stop_handler(int) { stop = 1; }
+
+/*!
+ \brief Serve the requests of a client
+ \param fd : connection to a client
+ \param cache : cache of compiled models
+ \post the requests received on fd have been served until the client closed the
+ connection, or until a shutdown request
+ \return true if a shutdown request has been received, false otherwise
+ */
+static bool serve_client(int fd, tchecker::tck_server::model_cache_t & cache)
+{
+  std::string buffer;
+  char chunk[4096];
+  while (!stop) {
+    std::size_t eol = buffer.find('\n');
+    if (eol == std::string::npos) {
+      ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0)
+        return false;
+      buffer.append(chunk, static_cast<std::size_t>(n));
+      continue;
+    }
+
+    std::string const request = buffer.substr(0, eol);
+    buffer.erase(0, eol + 1);
+
+    std::ostringstream response;
+    enum tchecker::tck_server::request_status_t status = tchecker::tck_server::serve(cache, request, response);
+    if (!send_all(fd, response.str()))
+      return false;
+    if (status == tchecker::tck_server::REQUEST_SHUTDOWN)
+      return true;
+  }
+  return false;
+}
+
+/*!
+ \brief Serve requests on a Unix socket
+ \param path : path of the socket
+ \post requests have been served until a shutdown request or a SIGINT/SIGTERM
+ signal. The socket has been removed
+ \throw std::runtime_error : if the socket cannot be created
+ */
+static void server(std::string const & path)
+{
+  struct sockaddr_un addr = socket_address(path);
+
+  struct stat st;
+  if (::lstat(path.c_str(), &st) == 0) {
+    if (!S_ISSOCK(st.st_mode))
+      throw std::runtime_error(path + " exists and is not a socket");
+    ::unlink(path.c_str());
+  }
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    throw std::runtime_error("Unable to create socket: " + std::string(std::strerror(errno)));
+  if (::bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0 || ::listen(fd, 16) != 0) {
+    std::string const error = std::strerror(errno);
+    ::close(fd);
+    throw std::runtime_error("Unable to listen on " + path + ": " + error);
+  }
+
+  struct sigaction sa;
+  std::memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = stop_handler; // no SA_RESTART: interrupts accept()
+  ::sigaction(SIGINT, &sa, nullptr);
+  ::sigaction(SIGTERM, &sa, nullptr);
+  std::signal(SIGPIPE, SIG_IGN);
+
+  tchecker::tck_server::model_cache_t cache{cache_size};
+  bool shutdown = false;
+  while (!shutdown && !stop) {
+    int client = ::accept(fd, nullptr, nullptr);
+    if (client < 0) {
+      if (errno == EINTR)
+        continue;
+      std::cerr << tchecker::log_error << "accept: " << std::strerror(errno) << std::endl;
+      break;
+    }
+    shutdown = serve_client(client, cache);
+    ::close(client);
+  }
+
+  ::close(fd);
+  ::unlink(path.c_str());
+}
+
+/*!
+ \brief Send a request to a server
+ \param path : path of the socket of the server
+ \param request : a request
+ \post request has been sent to the server and the response has been output to
+ standard output (without the final END line)
+ \return true if the request succeeded, false otherwise
+ \throw std::runtime_error : if the server cannot be reached
+ */
+static bool client(std::string const & path, std::string const & request)
+{
+  struct sockaddr_un addr = socket_address(path);
+
+  int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+    throw std::runtime_error("Unable to create socket: " + std::string(std::strerror(errno)));
+  if (::connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+    std::string const error = std::strerror(errno);
+    ::close(fd);
+    throw std::runtime_error("Unable to connect to " + path + ": " + error);
+  }
+
+  if (!send_all(fd, request + "\n")) {
+    ::close(fd);
+    throw std::runtime_error("Unable to send request to " + path);
+  }
+
+  bool ok = true;
+  std::string buffer;
+  char chunk[4096];
+  while (true) {
+    std::size_t eol = buffer.find('\n');
+    if (eol == std::string::npos) {
+      ssize_t n = ::recv(fd, chunk, sizeof(chunk), 0);
+      if (n < 0 && errno == EINTR)
+        continue;
+      if (n <= 0) {
+        ::close(fd);
+        throw std::runtime_error("Connection to " + path + " closed before end of response");
+      }
+      buffer.append(chunk, static_cast<std::size_t>(n));
+      continue;
+    }
+    std::string const line = buffer.substr(0, eol);
+    buffer.erase(0, eol + 1);
+    if (line == "END")
+      break;
+    if (line.compare(0, 6, "ERROR ") == 0) {
+      std::cerr << tchecker::log_error << line.substr(6) << std::endl;
+      ok = false;
+    }
+    else
+      std::cout << line << std::endl;
+  }
+
+  ::close(fd);
+  return ok;
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (optindex != argc) {
+      std::cerr << "Unexpected arguments" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    if (query != "")
+      return (client(socket_path, query) ? EXIT_SUCCESS : EXIT_FAILURE);
+
+    if (cache_size == 0)
+      throw std::runtime_error("Cache size should be positive");
+
+    server(socket_path);
+  }
+  catch (std::exception & e) {
+    std::cerr << tchecker::log_error << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
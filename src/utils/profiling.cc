@@ -0,0 +1,79 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <sstream>
+
+#include "tchecker/utils/profiling.hh"
+
+namespace tchecker {
+
+namespace profiling {
+
+char const * name(enum tchecker::profiling::probe_t probe)
+{
+  switch (probe) {
+  case tchecker::profiling::PROBE_DBM_TIGHTEN:
+    return "DBM_TIGHTEN";
+  case tchecker::profiling::PROBE_EXTRAPOLATION:
+    return "EXTRAPOLATION";
+  case tchecker::profiling::PROBE_VM_RUN:
+    return "VM_RUN";
+  case tchecker::profiling::PROBE_HASH:
+    return "HASH";
+  case tchecker::profiling::PROBE_EQUAL:
+    return "EQUAL";
+  case tchecker::profiling::PROBE_COVERING:
+    return "COVERING";
+  case tchecker::profiling::PROBE_POOL_ALLOCATE:
+    return "POOL_ALLOCATE";
+  case tchecker::profiling::PROBE_POOL_COLLECT:
+    return "POOL_COLLECT";
+  default:
+    return "UNKNOWN";
+  }
+}
+
+#if defined(TCHECKER_PROFILING)
+
+void reset()
+{
+  for (std::size_t i = 0; i < tchecker::profiling::PROBES_COUNT; ++i) {
+    tchecker::profiling::details::calls[i].store(0, std::memory_order_relaxed);
+    tchecker::profiling::details::ticks[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void attributes(std::map<std::string, std::string> & m)
+{
+  std::stringstream sstream;
+  for (std::size_t i = 0; i < tchecker::profiling::PROBES_COUNT; ++i) {
+    enum tchecker::profiling::probe_t const probe = static_cast<enum tchecker::profiling::probe_t>(i);
+    std::uint64_t const calls = tchecker::profiling::calls(probe);
+    if (calls == 0)
+      continue;
+    std::uint64_t const ticks = tchecker::profiling::ticks(probe);
+    std::string const prefix = std::string{"PROFILE_"} + tchecker::profiling::name(probe);
+
+    sstream.str("");
+    sstream << calls;
+    m[prefix + "_CALLS"] = sstream.str();
+
+    sstream.str("");
+    sstream << ticks;
+    m[prefix + "_TICKS"] = sstream.str();
+
+    sstream.str("");
+    sstream << ticks / calls;
+    m[prefix + "_TICKS_PER_CALL"] = sstream.str();
+  }
+}
+
+#endif // TCHECKER_PROFILING
+
+} // end of namespace profiling
+
+} // end of namespace tchecker
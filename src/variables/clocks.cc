@@ -113,6 +113,8 @@ int lexical_cmp(tchecker::clock_constraint_container_t const & c1, tchecker::clo
       c1.begin(), c1.end(), c2.begin(), c2.end(), tchecker::lexical_cmp);
 }
 
+std::size_t hash_value(tchecker::clock_constraint_container_t const & c) { return boost::hash_range(c.begin(), c.end()); }
+
 std::string to_string(tchecker::clock_constraint_container_t const & c, tchecker::clock_index_t const & index)
 {
   std::stringstream ss;
@@ -194,6 +196,8 @@ int lexical_cmp(tchecker::clock_reset_container_t const & c1, tchecker::clock_re
       c1.begin(), c1.end(), c2.begin(), c2.end(), tchecker::lexical_cmp);
 }
 
+std::size_t hash_value(tchecker::clock_reset_container_t const & c) { return boost::hash_range(c.begin(), c.end()); }
+
 std::string to_string(tchecker::clock_reset_container_t const & c, tchecker::clock_index_t const & index)
 {
   std::stringstream ss;
@@ -5,10 +5,13 @@
  *
  */
 
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
 
 #include "tchecker/utils/ordering.hh"
+#include "tchecker/utils/serialization.hh"
 #include "tchecker/variables/intvars.hh"
 
 namespace tchecker {
@@ -42,23 +45,80 @@ void intvars_valuation_destruct_and_deallocate(tchecker::intvars_valuation_t * v
   delete[] reinterpret_cast<char *>(v);
 }
 
+/* intvars_layout_t */
+
+intvars_layout_t::intvars_layout_t(tchecker::flat_integer_variables_t const & intvars) : _capacity(0)
+{
+  tchecker::intvar_id_t const size = intvars.size();
+  if (size > std::numeric_limits<tchecker::intval_base_t::capacity_t>::max())
+    throw std::invalid_argument("intvars_layout_t: too many variables");
+
+  _fields.reserve(size);
+  unsigned int shift = WORD_BITS; // first field starts a new word
+  for (tchecker::intvar_id_t id = 0; id < size; ++id) {
+    tchecker::intvar_info_t const & info = intvars.info(id);
+    word_t const range = static_cast<word_t>(static_cast<word_t>(info.max()) - static_cast<word_t>(info.min()));
+    unsigned int width = 0;
+    while (width < WORD_BITS && (range >> width) != 0)
+      ++width;
+
+    if (width > 0 && shift + width > WORD_BITS) {
+      ++_capacity;
+      shift = 0;
+    }
+
+    field_t f;
+    f.word = (_capacity == 0 ? 0 : _capacity - 1);
+    f.shift = static_cast<unsigned char>(width == 0 ? 0 : shift);
+    f.width = static_cast<unsigned char>(width);
+    f.mask = (width == WORD_BITS ? static_cast<word_t>(~word_t{0}) : static_cast<word_t>((word_t{1} << width) - 1));
+    f.min = static_cast<word_t>(info.min());
+    _fields.push_back(f);
+
+    shift += width;
+  }
+
+  // Variables with a single value are stored in the first word
+  if (!_fields.empty() && _capacity == 0)
+    _capacity = 1;
+}
+
+void intvars_layout_t::pack(tchecker::intvars_valuation_t const & values, tchecker::intvars_valuation_t & v) const
+{
+  assert(values.size() == _fields.size());
+  assert(v.size() == _capacity);
+  for (tchecker::integer_t & w : v)
+    w = 0;
+  for (tchecker::intvar_id_t id = 0; id < _fields.size(); ++id)
+    store(v, id, values[id]);
+}
+
+void intvars_layout_t::unpack(tchecker::intvars_valuation_t const & v, tchecker::intvars_valuation_t & values) const
+{
+  assert(v.size() == _capacity);
+  assert(values.size() == _fields.size());
+  for (tchecker::intvar_id_t id = 0; id < _fields.size(); ++id)
+    values[id] = load(v, id);
+}
+
 std::ostream & output(std::ostream & os, tchecker::intvars_valuation_t const & intvars_val,
-                      tchecker::intvar_index_t const & index)
+                      tchecker::intvar_index_t const & index, tchecker::intvars_layout_t const * layout)
 {
   auto const size = index.size();
 
   for (tchecker::intvar_id_t id = 0; id < size; ++id) {
     if (id > 0)
       os << ",";
-    os << index.value(id) << "=" << intvars_val[id];
+    os << index.value(id) << "=" << (layout == nullptr ? intvars_val[id] : layout->load(intvars_val, id));
   }
   return os;
 }
 
-std::string to_string(tchecker::intvars_valuation_t const & intvars_val, tchecker::intvar_index_t const & index)
+std::string to_string(tchecker::intvars_valuation_t const & intvars_val, tchecker::intvar_index_t const & index,
+                      tchecker::intvars_layout_t const * layout)
 {
   std::stringstream sstream;
-  output(sstream, intvars_val, index);
+  output(sstream, intvars_val, index, layout);
   return sstream.str();
 }
 
@@ -69,4 +129,21 @@ int lexical_cmp(tchecker::intvars_valuation_t const & intvars_val1, tchecker::in
       [](tchecker::integer_t i1, tchecker::integer_t i2) -> int { return (i1 < i2 ? -1 : (i1 == i2 ? 0 : 1)); });
 }
 
+std::ostream & serialize(std::ostream & os, tchecker::intvars_valuation_t const & intvars_val)
+{
+  tchecker::serialization::write(os, static_cast<std::uint32_t>(intvars_val.size()));
+  for (tchecker::integer_t v : intvars_val)
+    tchecker::serialization::write(os, v);
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::intvars_valuation_t & intvars_val)
+{
+  if (tchecker::serialization::read<std::uint32_t>(is) != intvars_val.size())
+    throw std::runtime_error("Serialized integer variables valuation has wrong size");
+  for (tchecker::integer_t & v : intvars_val)
+    v = tchecker::serialization::read<tchecker::integer_t>(is);
+  return is;
+}
+
 } // end of namespace tchecker
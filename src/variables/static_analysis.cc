@@ -93,4 +93,141 @@ tchecker::variable_access_map_t variable_access(tchecker::ta::system_t const & s
   return map;
 }
 
+/*!
+ \brief Add integer variables in expression
+ \param expr : an expression
+ \param intvars : a set of flattened integer variables
+ \post All integer variables read in expr have been added to intvars
+ */
+static void add_read_intvars(tchecker::typed_expression_t const & expr, boost::dynamic_bitset<> & intvars)
+{
+  std::unordered_set<tchecker::clock_id_t> clock_ids;
+  std::unordered_set<tchecker::intvar_id_t> intvar_ids;
+  std::unordered_set<tchecker::param_id_t> param_ids;
+
+  tchecker::extract_variables(expr, clock_ids, intvar_ids, param_ids);
+
+  for (tchecker::intvar_id_t intvar_id : intvar_ids)
+    intvars.set(intvar_id);
+}
+
+std::vector<boost::dynamic_bitset<>> live_intvars(tchecker::ta::system_t const & system)
+{
+  std::size_t const intvars_count = system.intvars_count(tchecker::VK_FLATTENED);
+  tchecker::edge_id_t const edges_count = system.edges_count();
+
+  // Variables accessed by several processes are live everywhere
+  tchecker::variable_access_map_t const access_map = tchecker::variable_access(system);
+  boost::dynamic_bitset<> shared{intvars_count};
+  for (tchecker::intvar_id_t id = 0; id < intvars_count; ++id) {
+    auto range = access_map.accessing_processes(id, tchecker::VTYPE_INTVAR, tchecker::VACCESS_ANY);
+    if (std::distance(range.begin(), range.end()) > 1)
+      shared.set(id);
+  }
+
+  std::vector<boost::dynamic_bitset<>> live(system.locations_count(), shared);
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    tchecker::add_read_intvars(system.invariant(loc->id()), live[loc->id()]);
+
+  // Variables read by edges (gen) and written by every execution of edges (kill)
+  std::vector<boost::dynamic_bitset<>> gen(edges_count, boost::dynamic_bitset<>{intvars_count});
+  std::vector<boost::dynamic_bitset<>> notkill(edges_count, boost::dynamic_bitset<>{intvars_count});
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    std::unordered_set<tchecker::clock_id_t> clock_ids;
+    std::unordered_set<tchecker::intvar_id_t> intvar_ids;
+    std::unordered_set<tchecker::param_id_t> param_ids;
+
+    tchecker::add_read_intvars(system.guard(edge->id()), gen[edge->id()]);
+    tchecker::extract_read_variables(system.statement(edge->id()), clock_ids, intvar_ids, param_ids);
+    for (tchecker::intvar_id_t intvar_id : intvar_ids)
+      gen[edge->id()].set(intvar_id);
+
+    intvar_ids.clear();
+    tchecker::extract_must_written_variables(system.statement(edge->id()), clock_ids, intvar_ids, param_ids);
+    notkill[edge->id()].set();
+    for (tchecker::intvar_id_t intvar_id : intvar_ids)
+      notkill[edge->id()].reset(intvar_id);
+  }
+
+  // Backward propagation: live(src) includes gen(e) and live(tgt) \ kill(e)
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      boost::dynamic_bitset<> edge_live = live[edge->tgt()] & notkill[edge->id()];
+      edge_live |= gen[edge->id()];
+      if (!edge_live.is_subset_of(live[edge->src()])) {
+        live[edge->src()] |= edge_live;
+        changed = true;
+      }
+    }
+  }
+
+  return live;
+}
+
+/*!
+ \brief Add clocks in expression
+ \param expr : an expression
+ \param clocks : a set of flattened clocks
+ \post All clocks read in expr have been added to clocks
+ */
+static void add_read_clocks(tchecker::typed_expression_t const & expr, boost::dynamic_bitset<> & clocks)
+{
+  std::unordered_set<tchecker::clock_id_t> clock_ids;
+  std::unordered_set<tchecker::intvar_id_t> intvar_ids;
+  std::unordered_set<tchecker::param_id_t> param_ids;
+
+  tchecker::extract_variables(expr, clock_ids, intvar_ids, param_ids);
+
+  for (tchecker::clock_id_t clock_id : clock_ids)
+    clocks.set(clock_id);
+}
+
+std::vector<boost::dynamic_bitset<>> live_clocks(tchecker::ta::system_t const & system)
+{
+  std::size_t const clocks_count = system.clocks_count(tchecker::VK_FLATTENED);
+  tchecker::edge_id_t const edges_count = system.edges_count();
+
+  std::vector<boost::dynamic_bitset<>> live(system.locations_count(), boost::dynamic_bitset<>{clocks_count});
+  for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+    tchecker::add_read_clocks(system.invariant(loc->id()), live[loc->id()]);
+
+  // Clocks read by edges (gen) and reset by every execution of edges (kill)
+  std::vector<boost::dynamic_bitset<>> gen(edges_count, boost::dynamic_bitset<>{clocks_count});
+  std::vector<boost::dynamic_bitset<>> notkill(edges_count, boost::dynamic_bitset<>{clocks_count});
+  for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+    std::unordered_set<tchecker::clock_id_t> clock_ids;
+    std::unordered_set<tchecker::intvar_id_t> intvar_ids;
+    std::unordered_set<tchecker::param_id_t> param_ids;
+
+    tchecker::add_read_clocks(system.guard(edge->id()), gen[edge->id()]);
+    tchecker::extract_read_variables(system.statement(edge->id()), clock_ids, intvar_ids, param_ids);
+    for (tchecker::clock_id_t clock_id : clock_ids)
+      gen[edge->id()].set(clock_id);
+
+    clock_ids.clear();
+    tchecker::extract_must_written_variables(system.statement(edge->id()), clock_ids, intvar_ids, param_ids);
+    notkill[edge->id()].set();
+    for (tchecker::clock_id_t clock_id : clock_ids)
+      notkill[edge->id()].reset(clock_id);
+  }
+
+  // Backward propagation: live(src) includes gen(e) and live(tgt) \ kill(e)
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system.edges()) {
+      boost::dynamic_bitset<> edge_live = live[edge->tgt()] & notkill[edge->id()];
+      edge_live |= gen[edge->id()];
+      if (!edge_live.is_subset_of(live[edge->src()])) {
+        live[edge->src()] |= edge_live;
+        changed = true;
+      }
+    }
+  }
+
+  return live;
+}
+
 } // end of namespace tchecker
@@ -5,8 +5,11 @@
  *
  */
 
+#include <algorithm>
+
 #include "tchecker/zg/extrapolation.hh"
 #include "tchecker/clockbounds/solver.hh"
+#include "tchecker/variables/static_analysis.hh"
 
 namespace tchecker {
 
@@ -50,56 +53,8 @@ namespace details {
 
 local_lu_extrapolation_t::local_lu_extrapolation_t(
     std::shared_ptr<tchecker::clockbounds::local_lu_map_t const> const & clock_bounds)
-    : _l(nullptr), _u(nullptr), _clock_bounds(clock_bounds)
-{
-  _l = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
-  _u = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
-}
-
-local_lu_extrapolation_t::local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t const & e)
-    : _clock_bounds(e._clock_bounds)
-{
-  _l = tchecker::clockbounds::clone_map(*e._l);
-  _u = tchecker::clockbounds::clone_map(*e._u);
-}
-
-local_lu_extrapolation_t::local_lu_extrapolation_t(tchecker::zg::details::local_lu_extrapolation_t && e)
-    : _l(std::move(e._l)), _u(std::move(e._u)), _clock_bounds(std::move(e._clock_bounds))
-{
-  e._l = nullptr;
-  e._u = nullptr;
-}
-
-local_lu_extrapolation_t::~local_lu_extrapolation_t()
+    : _clock_bounds(clock_bounds), _cache(std::make_shared<tchecker::clockbounds::local_lu_cache_t>(clock_bounds))
 {
-  tchecker::clockbounds::deallocate_map(_l);
-  tchecker::clockbounds::deallocate_map(_u);
-}
-
-tchecker::zg::details::local_lu_extrapolation_t &
-local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolation_t const & e)
-{
-  if (this != &e) {
-    _clock_bounds = e._clock_bounds;
-    tchecker::clockbounds::deallocate_map(_l);
-    _l = tchecker::clockbounds::clone_map(*e._l);
-    tchecker::clockbounds::deallocate_map(_u);
-    _u = tchecker::clockbounds::clone_map(*e._u);
-  }
-  return *this;
-}
-
-tchecker::zg::details::local_lu_extrapolation_t &
-local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolation_t && e)
-{
-  if (this != &e) {
-    _clock_bounds = std::move(e._clock_bounds);
-    _l = std::move(e._l);
-    _u = std::move(e._u);
-    e._l = nullptr;
-    e._u = nullptr;
-  }
-  return *this;
 }
 
 } // end of namespace details
@@ -109,8 +64,10 @@ local_lu_extrapolation_t::operator=(tchecker::zg::details::local_lu_extrapolatio
 void local_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_l, *_u);
-  tchecker::dbm::extra_lu(dbm, dim, _l->ptr(), _u->ptr());
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _cache->bounds(vloc, l, u);
+  tchecker::dbm::extra_lu(dbm, dim, l->ptr(), u->ptr());
 }
 
 /* local_extra_lu_plus_t */
@@ -118,8 +75,10 @@ void local_extra_lu_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id
 void local_extra_lu_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_l, *_u);
-  tchecker::dbm::extra_lu_plus(dbm, dim, _l->ptr(), _u->ptr());
+  tchecker::clockbounds::map_t const * l = nullptr;
+  tchecker::clockbounds::map_t const * u = nullptr;
+  _cache->bounds(vloc, l, u);
+  tchecker::dbm::extra_lu_plus(dbm, dim, l->ptr(), u->ptr());
 }
 
 /* global_m_extrapolation_t */
@@ -156,45 +115,8 @@ namespace details {
 
 local_m_extrapolation_t::local_m_extrapolation_t(
     std::shared_ptr<tchecker::clockbounds::local_m_map_t const> const & clock_bounds)
-    : _m(nullptr), _clock_bounds(clock_bounds)
+    : _clock_bounds(clock_bounds), _cache(std::make_shared<tchecker::clockbounds::local_m_cache_t>(clock_bounds))
 {
-  _m = tchecker::clockbounds::allocate_map(_clock_bounds->clock_number());
-}
-
-local_m_extrapolation_t::local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t const & e)
-    : _m(nullptr), _clock_bounds(e._clock_bounds)
-{
-  _m = tchecker::clockbounds::clone_map(*e._m);
-}
-
-local_m_extrapolation_t::local_m_extrapolation_t(tchecker::zg::details::local_m_extrapolation_t && e)
-    : _m(std::move(e._m)), _clock_bounds(std::move(e._clock_bounds))
-{
-  e._m = nullptr;
-}
-
-local_m_extrapolation_t::~local_m_extrapolation_t() { tchecker::clockbounds::deallocate_map(_m); }
-
-tchecker::zg::details::local_m_extrapolation_t &
-local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_t const & e)
-{
-  if (this != &e) {
-    tchecker::clockbounds::deallocate_map(_m);
-    _m = tchecker::clockbounds::clone_map(*e._m);
-    _clock_bounds = e._clock_bounds;
-  }
-  return *this;
-}
-
-tchecker::zg::details::local_m_extrapolation_t &
-local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_t && e)
-{
-  if (this != &e) {
-    _m = std::move(e._m);
-    e._m = nullptr;
-    _clock_bounds = std::move(e._clock_bounds);
-  }
-  return *this;
 }
 
 } // namespace details
@@ -204,8 +126,7 @@ local_m_extrapolation_t::operator=(tchecker::zg::details::local_m_extrapolation_
 void local_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_m);
-  tchecker::dbm::extra_m(dbm, dim, _m->ptr());
+  tchecker::dbm::extra_m(dbm, dim, _cache->bounds(vloc)->ptr());
 }
 
 /* local_extra_m_plus_t */
@@ -213,8 +134,37 @@ void local_extra_m_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_
 void local_extra_m_plus_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, tchecker::vloc_t const & vloc)
 {
   assert(dim == _clock_bounds->clock_number() + 1);
-  _clock_bounds->bounds(vloc, *_m);
-  tchecker::dbm::extra_m_plus(dbm, dim, _m->ptr());
+  tchecker::dbm::extra_m_plus(dbm, dim, _cache->bounds(vloc)->ptr());
+}
+
+/* active_clocks_extrapolation_t */
+
+active_clocks_extrapolation_t::active_clocks_extrapolation_t(
+    std::shared_ptr<tchecker::zg::extrapolation_t> const & extrapolation,
+    std::shared_ptr<std::vector<boost::dynamic_bitset<>> const> const & live_clocks, tchecker::clock_id_t clock_nb)
+    : _extrapolation(extrapolation), _live_clocks(live_clocks), _active(clock_nb), _freed_clocks(0)
+{
+  assert(_extrapolation.get() != nullptr);
+  assert(_live_clocks.get() != nullptr);
+  assert(std::all_of(_live_clocks->begin(), _live_clocks->end(),
+                     [clock_nb](boost::dynamic_bitset<> const & live) { return live.size() == clock_nb; }));
+}
+
+void active_clocks_extrapolation_t::extrapolate(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim,
+                                                tchecker::vloc_t const & vloc)
+{
+  assert(dim == _active.size() + 1);
+  _extrapolation->extrapolate(dbm, dim, vloc);
+
+  _active.reset();
+  for (tchecker::loc_id_t id : vloc)
+    _active |= (*_live_clocks)[id];
+
+  for (tchecker::clock_id_t x = 0; x < dim - 1; ++x)
+    if (!_active[x]) {
+      tchecker::dbm::free_clock(dbm, dim, x + 1); // clock x is at index x+1 in dbm
+      ++_freed_clocks;
+    }
 }
 
 /* factories */
@@ -259,6 +209,18 @@ tchecker::zg::extrapolation_t * extrapolation_factory(enum extrapolation_type_t
   }
 }
 
+tchecker::zg::extrapolation_t * active_clocks_extrapolation_factory(enum extrapolation_type_t extrapolation_type,
+                                                                    tchecker::ta::system_t const & system,
+                                                                    tchecker::clockbounds::clockbounds_t const & clock_bounds)
+{
+  std::shared_ptr<tchecker::zg::extrapolation_t> extrapolation{
+      tchecker::zg::extrapolation_factory(extrapolation_type, clock_bounds)};
+  std::shared_ptr<std::vector<boost::dynamic_bitset<>> const> live_clocks{
+      std::make_shared<std::vector<boost::dynamic_bitset<>>>(tchecker::live_clocks(system))};
+  return new tchecker::zg::active_clocks_extrapolation_t{
+      extrapolation, live_clocks, static_cast<tchecker::clock_id_t>(system.clocks_count(tchecker::VK_FLATTENED))};
+}
+
 } // end of namespace zg
 
 } // end of namespace tchecker
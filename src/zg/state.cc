@@ -89,6 +89,22 @@ int lexical_cmp(tchecker::zg::state_t const & s1, tchecker::zg::state_t const &
   return s1.zone().lexical_cmp(s2.zone());
 }
 
+std::ostream & serialize(std::ostream & os, tchecker::zg::state_t const & s)
+{
+  tchecker::serialize(os, s.vloc());
+  tchecker::serialize(os, s.intval());
+  tchecker::zg::serialize(os, s.zone());
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::zg::state_t & s)
+{
+  tchecker::deserialize(is, *s.vloc_ptr());
+  tchecker::deserialize(is, *s.intval_ptr());
+  tchecker::zg::deserialize(is, *s.zone_ptr());
+  return is;
+}
+
 } // end of namespace zg
 
 } // end of namespace tchecker
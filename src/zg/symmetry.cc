@@ -0,0 +1,115 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <numeric>
+
+#include "tchecker/zg/symmetry.hh"
+
+namespace tchecker {
+
+namespace zg {
+
+symmetry_t::symmetry_t(tchecker::ta::system_t const & system, std::vector<tchecker::ta::symmetry_group_t> const & groups)
+    : _groups(groups), _local_location(system.locations_count(), 0), _intvars_layout(system.intvars_layout()),
+      _permuted_states(0)
+{
+  for (tchecker::ta::symmetry_group_t const & group : _groups)
+    for (tchecker::ta::symmetric_process_t const & process : group)
+      for (std::size_t i = 0; i < process.locations.size(); ++i)
+        _local_location[process.locations[i]] = i;
+}
+
+bool symmetry_t::less(tchecker::zg::state_t const & s, tchecker::ta::symmetric_process_t const & p1,
+                      tchecker::ta::symmetric_process_t const & p2) const
+{
+  std::size_t const l1 = _local_location[s.vloc()[p1.pid]], l2 = _local_location[s.vloc()[p2.pid]];
+  if (l1 != l2)
+    return l1 < l2;
+
+  for (std::size_t i = 0; i < p1.intvars.size(); ++i) {
+    tchecker::integer_t const v1 = value(s.intval(), p1.intvars[i]), v2 = value(s.intval(), p2.intvars[i]);
+    if (v1 != v2)
+      return v1 < v2;
+  }
+
+  tchecker::dbm::db_t const * dbm = s.zone().dbm();
+  std::size_t const dim = s.zone().dim();
+  for (std::size_t i = 0; i < p1.clocks.size(); ++i) {
+    std::size_t const x1 = p1.clocks[i] + 1, x2 = p2.clocks[i] + 1;
+    int cmp = tchecker::dbm::db_cmp(dbm[x1 * dim], dbm[x2 * dim]);
+    if (cmp != 0)
+      return cmp < 0;
+    cmp = tchecker::dbm::db_cmp(dbm[x1], dbm[x2]);
+    if (cmp != 0)
+      return cmp < 0;
+  }
+
+  return false;
+}
+
+bool symmetry_t::canonicalize(tchecker::zg::state_t & s)
+{
+  tchecker::vloc_t & vloc = *s.vloc_ptr();
+  tchecker::intvars_valuation_t & intval = *s.intval_ptr();
+  tchecker::zg::zone_t & zone = *s.zone_ptr();
+  std::size_t const dim = zone.dim();
+
+  _vloc.assign(vloc.begin(), vloc.end());
+  if (_intvars_layout == nullptr)
+    _intval.assign(intval.begin(), intval.end());
+  else {
+    _intval.resize(_intvars_layout->size());
+    for (tchecker::intvar_id_t id = 0; id < _intval.size(); ++id)
+      _intval[id] = _intvars_layout->load(intval, id);
+  }
+  _dbm_permutation.resize(dim);
+  std::iota(_dbm_permutation.begin(), _dbm_permutation.end(), 0);
+
+  // Sort the processes in each group, and permute locations and bounded integer
+  // variables accordingly. The permutation of the DBM is applied last
+  bool permuted = false;
+  for (tchecker::ta::symmetry_group_t const & group : _groups) {
+    _order.resize(group.size());
+    std::iota(_order.begin(), _order.end(), 0);
+    std::stable_sort(_order.begin(), _order.end(),
+                     [&](std::size_t i, std::size_t j) { return less(s, group[i], group[j]); });
+
+    for (std::size_t i = 0; i < group.size(); ++i) {
+      if (_order[i] == i)
+        continue;
+      permuted = true;
+      tchecker::ta::symmetric_process_t const & to = group[i];
+      tchecker::ta::symmetric_process_t const & from = group[_order[i]];
+      vloc[to.pid] = to.locations[_local_location[_vloc[from.pid]]];
+      for (std::size_t k = 0; k < to.intvars.size(); ++k) {
+        if (_intvars_layout == nullptr)
+          intval[to.intvars[k]] = _intval[from.intvars[k]];
+        else
+          _intvars_layout->store(intval, to.intvars[k], _intval[from.intvars[k]]);
+      }
+      for (std::size_t k = 0; k < to.clocks.size(); ++k)
+        _dbm_permutation[to.clocks[k] + 1] = from.clocks[k] + 1;
+    }
+  }
+
+  if (!permuted)
+    return false;
+
+  tchecker::dbm::db_t * dbm = zone.dbm();
+  _dbm.assign(dbm, dbm + dim * dim);
+  for (std::size_t i = 0; i < dim; ++i)
+    for (std::size_t j = 0; j < dim; ++j)
+      dbm[i * dim + j] = _dbm[_dbm_permutation[i] * dim + _dbm_permutation[j]];
+
+  ++_permuted_states;
+  return true;
+}
+
+} // end of namespace zg
+
+} // end of namespace tchecker
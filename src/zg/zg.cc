@@ -5,8 +5,11 @@
  *
  */
 
+#include <stdexcept>
+
 #include "tchecker/zg/zg.hh"
 #include "tchecker/dbm/db.hh"
+#include "tchecker/utils/profiling.hh"
 
 namespace tchecker {
 
@@ -35,7 +38,10 @@ tchecker::state_status_t initial(tchecker::ta::system_t const & system,
   if (status != tchecker::STATE_OK)
     return status;
 
-  extrapolation.extrapolate(dbm, dim, *vloc);
+  {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_EXTRAPOLATION);
+    extrapolation.extrapolate(dbm, dim, *vloc);
+  }
 
   return tchecker::STATE_OK;
 }
@@ -48,12 +54,13 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
                               tchecker::clock_constraint_container_t & src_invariant,
                               tchecker::clock_constraint_container_t & guard, tchecker::clock_reset_container_t & reset,
                               tchecker::clock_constraint_container_t & tgt_invariant, tchecker::zg::semantics_t & semantics,
-                              tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::outgoing_edges_value_t const & edges)
+                              tchecker::zg::extrapolation_t & extrapolation, tchecker::zg::outgoing_edges_value_t const & edges,
+                              bool & intvars_reset)
 {
   bool src_delay_allowed = tchecker::ta::delay_allowed(system, *vloc);
 
   tchecker::state_status_t status =
-      tchecker::ta::next(system, vloc, intval, vedge, src_invariant, guard, reset, tgt_invariant, edges);
+      tchecker::ta::next(system, vloc, intval, vedge, src_invariant, guard, reset, tgt_invariant, edges, intvars_reset);
   if (status != tchecker::STATE_OK)
     return status;
 
@@ -65,7 +72,10 @@ tchecker::state_status_t next(tchecker::ta::system_t const & system,
   if (status != tchecker::STATE_OK)
     return status;
 
-  extrapolation.extrapolate(dbm, dim, *vloc);
+  {
+    TCHECKER_PROFILE(tchecker::profiling::PROBE_EXTRAPOLATION);
+    extrapolation.extrapolate(dbm, dim, *vloc);
+  }
 
   return tchecker::STATE_OK;
 }
@@ -77,6 +87,12 @@ boost::dynamic_bitset<> labels(tchecker::ta::system_t const & system, tchecker::
   return tchecker::ta::labels(system, s);
 }
 
+bool satisfies(tchecker::ta::system_t const & system, tchecker::zg::state_t const & s,
+               boost::dynamic_bitset<> const & labels)
+{
+  return tchecker::ta::satisfies(system, s, labels);
+}
+
 /* is_valid_final */
 
 bool is_valid_final(tchecker::ta::system_t const & system, tchecker::zg::state_t const & s) { return !s.zone().is_empty(); }
@@ -100,10 +116,10 @@ void attributes(tchecker::ta::system_t const & system, tchecker::zg::transition_
 zg_impl_t::zg_impl_t(std::shared_ptr<tchecker::ta::system_t const> const & system,
                      std::shared_ptr<tchecker::zg::semantics_t> const & semantics,
                      std::shared_ptr<tchecker::zg::extrapolation_t> const & extrapolation, std::size_t block_size,
-                     std::size_t table_size)
-    : _system(system), _semantics(semantics), _extrapolation(extrapolation),
+                     std::size_t table_size, std::shared_ptr<tchecker::zg::symmetry_t> const & symmetry)
+    : _system(system), _semantics(semantics), _extrapolation(extrapolation), _symmetry(symmetry), _intvars_reset_successors(0),
       _state_allocator(block_size, block_size, _system->processes_count(), block_size,
-                       _system->intvars_count(tchecker::VK_FLATTENED), block_size,
+                       _system->intvars_valuation_capacity(), block_size,
                        _system->clocks_count(tchecker::VK_FLATTENED) + 1, table_size),
       _transition_allocator(block_size, block_size, _system->processes_count(), table_size)
 {
@@ -116,6 +132,8 @@ void zg_impl_t::initial(tchecker::zg::initial_value_t const & init_edge, std::ve
   tchecker::zg::state_sptr_t s = _state_allocator.construct();
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
   tchecker::state_status_t status = tchecker::zg::initial(*_system, *s, *t, *_semantics, *_extrapolation, init_edge);
+  if (status == tchecker::STATE_OK && _symmetry.get() != nullptr)
+    _symmetry->canonicalize(*s);
   v.push_back(std::make_tuple(status, s, t));
 }
 
@@ -129,15 +147,46 @@ void zg_impl_t::next(tchecker::zg::const_state_sptr_t const & s, tchecker::zg::o
 {
   tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
   tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
-  tchecker::state_status_t status = tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_extrapolation, out_edge);
+  bool intvars_reset = false;
+  tchecker::state_status_t status =
+      tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_extrapolation, out_edge, intvars_reset);
+  if (intvars_reset)
+    ++_intvars_reset_successors;
+  if (status == tchecker::STATE_OK && _symmetry.get() != nullptr)
+    _symmetry->canonicalize(*nexts);
   v.push_back(std::make_tuple(status, nexts, t));
 }
 
+void zg_impl_t::for_each_next(tchecker::zg::const_state_sptr_t const & s, tchecker::state_status_t mask,
+                              sst_callback_t const & callback)
+{
+  tchecker::zg::outgoing_edges_range_t out_edges = outgoing_edges(s);
+  for (tchecker::zg::outgoing_edges_value_t && out_edge : out_edges) {
+    tchecker::zg::state_sptr_t nexts = _state_allocator.clone(*s);
+    tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
+    bool intvars_reset = false;
+    tchecker::state_status_t status =
+        tchecker::zg::next(*_system, *nexts, *t, *_semantics, *_extrapolation, out_edge, intvars_reset);
+    if (intvars_reset)
+      ++_intvars_reset_successors;
+    if ((status & mask) == 0)
+      continue;
+    if (status == tchecker::STATE_OK && _symmetry.get() != nullptr)
+      _symmetry->canonicalize(*nexts);
+    callback(status, nexts, t);
+  }
+}
+
 boost::dynamic_bitset<> zg_impl_t::labels(tchecker::zg::const_state_sptr_t const & s) const
 {
   return tchecker::zg::labels(*_system, *s);
 }
 
+bool zg_impl_t::satisfies(tchecker::zg::const_state_sptr_t const & s, boost::dynamic_bitset<> const & labels) const
+{
+  return tchecker::zg::satisfies(*_system, *s, labels);
+}
+
 bool zg_impl_t::is_valid_final(tchecker::zg::const_state_sptr_t const & s) const
 {
   return tchecker::zg::is_valid_final(*_system, *s);
@@ -157,22 +206,90 @@ void zg_impl_t::share(tchecker::zg::state_sptr_t & s) { _state_allocator.share(s
 
 void zg_impl_t::share(tchecker::zg::transition_sptr_t & t) { _transition_allocator.share(t); }
 
+void zg_impl_t::collect()
+{
+  _transition_allocator.collect();
+  _state_allocator.collect();
+}
+
+tchecker::zg::state_sptr_t zg_impl_t::deserialize_state(std::istream & is)
+{
+  tchecker::zg::state_sptr_t s = _state_allocator.construct();
+  tchecker::zg::deserialize(is, *s);
+  if (!tchecker::ta::is_well_formed(*_system, *s))
+    throw std::runtime_error("Serialized state does not belong to the system");
+  return s;
+}
+
+tchecker::zg::transition_sptr_t zg_impl_t::deserialize_transition(std::istream & is)
+{
+  tchecker::zg::transition_sptr_t t = _transition_allocator.construct();
+  tchecker::deserialize(is, *t->vedge_ptr());
+  if (!tchecker::ta::is_well_formed(*_system, *t))
+    throw std::runtime_error("Serialized transition does not belong to the system");
+  return t;
+}
+
 std::shared_ptr<tchecker::ta::system_t const> zg_impl_t::system_ptr() const { return _system; }
 
 tchecker::ta::system_t const & zg_impl_t::system() const { return *_system; }
 
+std::shared_ptr<tchecker::zg::symmetry_t const> zg_impl_t::symmetry() const { return _symmetry; }
+
+std::shared_ptr<tchecker::zg::extrapolation_t const> zg_impl_t::extrapolation() const { return _extrapolation; }
+
+unsigned long zg_impl_t::intvars_reset_successors() const { return _intvars_reset_successors; }
+
 /* zg_t */
 
 std::shared_ptr<tchecker::ta::system_t const> zg_t::system_ptr() const { return ts_impl().system_ptr(); }
 
 tchecker::ta::system_t const & zg_t::system() const { return ts_impl().system(); }
 
+std::shared_ptr<tchecker::zg::symmetry_t const> zg_t::symmetry() const { return ts_impl().symmetry(); }
+
+std::shared_ptr<tchecker::zg::extrapolation_t const> zg_t::extrapolation() const { return ts_impl().extrapolation(); }
+
+unsigned long zg_t::intvars_reset_successors() const { return ts_impl().intvars_reset_successors(); }
+
+tchecker::zg::state_sptr_t zg_t::deserialize_state(std::istream & is)
+{
+  tchecker::zg::state_sptr_t s = ts_impl().deserialize_state(is);
+  return s;
+}
+
+tchecker::zg::transition_sptr_t zg_t::deserialize_transition(std::istream & is)
+{
+  tchecker::zg::transition_sptr_t t = ts_impl().deserialize_transition(is);
+  return t;
+}
+
 /* sharing_zg_t */
 
 std::shared_ptr<tchecker::ta::system_t const> sharing_zg_t::system_ptr() const { return ts_impl().system_ptr(); }
 
 tchecker::ta::system_t const & sharing_zg_t::system() const { return ts_impl().system(); }
 
+std::shared_ptr<tchecker::zg::symmetry_t const> sharing_zg_t::symmetry() const { return ts_impl().symmetry(); }
+
+std::shared_ptr<tchecker::zg::extrapolation_t const> sharing_zg_t::extrapolation() const { return ts_impl().extrapolation(); }
+
+unsigned long sharing_zg_t::intvars_reset_successors() const { return ts_impl().intvars_reset_successors(); }
+
+tchecker::zg::state_sptr_t sharing_zg_t::deserialize_state(std::istream & is)
+{
+  tchecker::zg::state_sptr_t s = ts_impl().deserialize_state(is);
+  ts_impl().share(s);
+  return s;
+}
+
+tchecker::zg::transition_sptr_t sharing_zg_t::deserialize_transition(std::istream & is)
+{
+  tchecker::zg::transition_sptr_t t = ts_impl().deserialize_transition(is);
+  ts_impl().share(t);
+  return t;
+}
+
 /* factory */
 
 /*!
@@ -5,10 +5,13 @@
  *
  */
 
+#include <cstdint>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 
 #include "tchecker/dbm/dbm.hh"
+#include "tchecker/utils/serialization.hh"
 #include "tchecker/zg/zone.hh"
 
 namespace tchecker {
@@ -108,6 +111,26 @@ void zone_destruct_and_deallocate(tchecker::zg::zone_t * zone)
   delete[] reinterpret_cast<char *>(zone);
 }
 
+// Serialization
+
+std::ostream & serialize(std::ostream & os, tchecker::zg::zone_t const & zone)
+{
+  tchecker::serialization::write(os, static_cast<std::uint32_t>(zone.dim()));
+  tchecker::serialization::write(os, zone.dbm(), zone.dim() * zone.dim());
+  return os;
+}
+
+std::istream & deserialize(std::istream & is, tchecker::zg::zone_t & zone)
+{
+  if (tchecker::serialization::read<std::uint32_t>(is) != zone.dim())
+    throw std::runtime_error("Serialized zone has wrong dimension");
+  tchecker::clock_id_t const dim = static_cast<tchecker::clock_id_t>(zone.dim());
+  tchecker::serialization::read(is, zone.dbm(), zone.dim() * zone.dim());
+  if (!tchecker::dbm::is_consistent(zone.dbm(), dim) || !tchecker::dbm::is_tight(zone.dbm(), dim))
+    throw std::runtime_error("Serialized zone is not a consistent tight DBM");
+  return is;
+}
+
 } // end of namespace zg
 
 std::string to_string(tchecker::zg::zone_t const & zone, tchecker::clock_index_t const & index)
@@ -0,0 +1,123 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "microbench.hh"
+#include "tchecker/dbm/dbm.hh"
+
+/*!
+ \brief Random canonical DBM
+ \param dbm : a DBM
+ \param dim : dimension of dbm
+ \param gen : random generator
+ \post dbm is a tight non-empty DBM obtained by adding 2*dim random constraints
+ to the positive universal zone
+ */
+static void random_dbm(tchecker::dbm::db_t * dbm, tchecker::clock_id_t dim, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+  std::uniform_int_distribution<tchecker::integer_t> value(0, 100);
+  std::bernoulli_distribution strict(0.3);
+  std::vector<tchecker::dbm::db_t> backup(dim * dim);
+
+  tchecker::dbm::universal_positive(dbm, dim);
+  for (tchecker::clock_id_t k = 0; k < 2 * dim; ++k) {
+    tchecker::clock_id_t const x = clock(gen), y = clock(gen);
+    if (x == y)
+      continue;
+    // upper bounds x - 0 <= c, lower bounds 0 - y <= -c, diagonals x - y <= c - 50
+    tchecker::integer_t const c = (y == 0 ? value(gen) : (x == 0 ? -value(gen) : value(gen) - 50));
+    std::memcpy(backup.data(), dbm, dim * dim * sizeof(*dbm));
+    if (tchecker::dbm::constrain(dbm, dim, x, y, (strict(gen) ? tchecker::dbm::LT : tchecker::dbm::LE), c) ==
+        tchecker::dbm::EMPTY)
+      std::memcpy(dbm, backup.data(), dim * dim * sizeof(*dbm));
+  }
+}
+
+/*!
+ \brief DBM microbenchmarks
+ \param runner : a runner
+ \param gen : random generator
+ \note operations that modify a DBM work on a copy of a random DBM. The cost of
+ the copy is measured by benchmark dbm/copy
+ */
+void bench_dbm(tchecker::microbench::runner_t & runner, std::mt19937 & gen)
+{
+  std::size_t const DBMS = 64; // number of random DBMs per dimension
+
+  for (tchecker::clock_id_t dim : {2, 4, 8, 16, 32, 64}) {
+    std::string const suffix = "/dim=" + std::to_string(dim);
+    std::size_t const size = dim * dim;
+
+    std::vector<tchecker::dbm::db_t> dbms(DBMS * size);
+    for (std::size_t i = 0; i < DBMS; ++i)
+      random_dbm(&dbms[i * size], dim, gen);
+    std::vector<tchecker::dbm::db_t> scratch(size);
+
+    std::uniform_int_distribution<tchecker::clock_id_t> clock(0, dim - 1);
+    std::uniform_int_distribution<tchecker::integer_t> value(-20, 100);
+    std::vector<std::tuple<tchecker::clock_id_t, tchecker::clock_id_t, tchecker::integer_t>> constraints(DBMS);
+    for (auto & [x, y, c] : constraints) {
+      x = clock(gen);
+      y = (x + 1 + clock(gen) % (dim - 1)) % dim;
+      c = value(gen);
+    }
+
+    // clock bounds in [0,100], or no bound (-tchecker::dbm::INF_VALUE)
+    std::uniform_int_distribution<tchecker::integer_t> bound(-1, 100);
+    std::vector<tchecker::integer_t> l(DBMS * dim), u(DBMS * dim);
+    for (std::size_t i = 0; i < DBMS * dim; ++i) {
+      l[i] = bound(gen);
+      u[i] = std::max(l[i], bound(gen));
+      l[i] = (l[i] < 0 ? -tchecker::dbm::INF_VALUE : l[i]);
+      u[i] = (u[i] < 0 ? -tchecker::dbm::INF_VALUE : u[i]);
+    }
+
+    runner.run("dbm/copy" + suffix, [&](std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i) {
+        std::memcpy(scratch.data(), &dbms[(i % DBMS) * size], size * sizeof(tchecker::dbm::db_t));
+        tchecker::microbench::do_not_optimize(scratch[0]);
+      }
+    });
+
+    runner.run("dbm/tighten" + suffix, [&](std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i) {
+        std::memcpy(scratch.data(), &dbms[(i % DBMS) * size], size * sizeof(tchecker::dbm::db_t));
+        tchecker::microbench::do_not_optimize(tchecker::dbm::tighten(scratch.data(), dim));
+      }
+    });
+
+    runner.run("dbm/constrain" + suffix, [&](std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i) {
+        std::memcpy(scratch.data(), &dbms[(i % DBMS) * size], size * sizeof(tchecker::dbm::db_t));
+        auto const & [x, y, c] = constraints[(i / DBMS + i) % DBMS];
+        tchecker::microbench::do_not_optimize(tchecker::dbm::constrain(scratch.data(), dim, x, y, tchecker::dbm::LE, c));
+      }
+    });
+
+    runner.run("dbm/is_le" + suffix, [&](std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i)
+        tchecker::microbench::do_not_optimize(
+            tchecker::dbm::is_le(&dbms[(i % DBMS) * size], &dbms[((i / DBMS + i + 1) % DBMS) * size], dim));
+    });
+
+    runner.run("dbm/extra_lu_plus" + suffix, [&](std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i) {
+        std::memcpy(scratch.data(), &dbms[(i % DBMS) * size], size * sizeof(tchecker::dbm::db_t));
+        std::size_t const b = ((i / DBMS + i) % DBMS) * dim;
+        tchecker::dbm::extra_lu_plus(scratch.data(), dim, &l[b], &u[b]);
+        tchecker::microbench::do_not_optimize(scratch[0]);
+      }
+    });
+  }
+}
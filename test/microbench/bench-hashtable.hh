@@ -0,0 +1,105 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "microbench.hh"
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+/*!
+ \class bench_hto_t
+ \brief Object stored in hashtables
+ */
+class bench_hto_t : public tchecker::hashtable_object_t {
+public:
+  bench_hto_t(std::uint64_t key) : _key(key) {}
+  std::uint64_t key() const { return _key; }
+
+private:
+  std::uint64_t _key;
+};
+
+namespace tchecker {
+template <> class allocation_size_t<bench_hto_t> {
+public:
+  static constexpr std::size_t alloc_size() { return sizeof(bench_hto_t); }
+
+  template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... /*args*/) { return sizeof(bench_hto_t); }
+};
+} // namespace tchecker
+
+using shared_bench_hto_t = tchecker::make_shared_t<bench_hto_t>;
+
+using bench_hto_sptr_t = tchecker::intrusive_shared_ptr_t<shared_bench_hto_t>;
+
+class bench_hto_sptr_hash_t {
+public:
+  std::size_t operator()(bench_hto_sptr_t const & p) const { return static_cast<std::size_t>(p->key() * 0x9e3779b97f4a7c15ULL); }
+};
+
+class bench_hto_sptr_equal_t {
+public:
+  bool operator()(bench_hto_sptr_t const & p1, bench_hto_sptr_t const & p2) const { return p1->key() == p2->key(); }
+};
+
+using bench_hashtable_t = tchecker::hashtable_t<bench_hto_sptr_t, bench_hto_sptr_hash_t, bench_hto_sptr_equal_t>;
+
+/*!
+ \brief Hashtable microbenchmarks
+ \param runner : a runner
+ \param gen : random generator
+ \note the load factor is the ratio between the number of stored objects and
+ the initial capacity of the table. Hits look up objects equal to stored
+ ones, while inserts fill an empty table
+ */
+void bench_hashtable(tchecker::microbench::runner_t & runner, std::mt19937 & gen)
+{
+  std::size_t const TABLE_SIZE = 65536;
+
+  for (double load : {0.25, 0.5, 1.0, 2.0, 4.0}) {
+    std::string const suffix = "/load=" + std::to_string(load).substr(0, 4);
+    std::size_t const count = static_cast<std::size_t>(load * TABLE_SIZE);
+
+    if (!runner.selected("hashtable/find_else_add/hit" + suffix) &&
+        !runner.selected("hashtable/find_else_add/insert" + suffix))
+      continue;
+
+    std::uniform_int_distribution<std::uint64_t> key;
+    std::vector<bench_hto_sptr_t> stored, probes;
+    for (std::size_t i = 0; i < count; ++i) {
+      std::uint64_t const k = key(gen);
+      stored.emplace_back(shared_bench_hto_t::allocate_and_construct(k));
+      probes.emplace_back(shared_bench_hto_t::allocate_and_construct(k));
+    }
+    std::shuffle(probes.begin(), probes.end(), gen);
+
+    bench_hashtable_t table{TABLE_SIZE, bench_hto_sptr_hash_t{}, bench_hto_sptr_equal_t{}};
+    for (bench_hto_sptr_t const & o : stored)
+      table.find_else_add(o);
+
+    runner.run("hashtable/find_else_add/hit" + suffix, [&](std::size_t n) {
+      for (std::size_t i = 0; i < n; ++i)
+        tchecker::microbench::do_not_optimize(table.find_else_add(probes[i % count]).ptr());
+    });
+
+    runner.run("hashtable/find_else_add/insert" + suffix, [&](std::size_t n) {
+      bench_hashtable_t t{TABLE_SIZE, bench_hto_sptr_hash_t{}, bench_hto_sptr_equal_t{}};
+      for (std::size_t i = 0; i < n; ++i) {
+        if (i % count == 0)
+          t.clear();
+        tchecker::microbench::do_not_optimize(t.find_else_add(stored[i % count]).ptr());
+      }
+    });
+
+    table.clear();
+  }
+}
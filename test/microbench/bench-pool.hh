@@ -0,0 +1,90 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "microbench.hh"
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+/*!
+ \class bench_pool_object_t
+ \brief Object allocated from pools (about the size of a small state)
+ */
+class bench_pool_object_t {
+public:
+  bench_pool_object_t(std::uint64_t x) : _x{x, x, x, x} {}
+  std::uint64_t x() const { return _x[0]; }
+
+private:
+  std::uint64_t _x[4];
+};
+
+namespace tchecker {
+template <> class allocation_size_t<bench_pool_object_t> {
+public:
+  static constexpr std::size_t alloc_size() { return sizeof(bench_pool_object_t); }
+
+  template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... /*args*/)
+  {
+    return sizeof(bench_pool_object_t);
+  }
+};
+} // namespace tchecker
+
+using shared_bench_pool_object_t = tchecker::make_shared_t<bench_pool_object_t>;
+
+/*!
+ \brief Pool microbenchmarks
+ \param runner : a runner
+ \param gen : random generator
+ \note pool/construct_destruct measures an allocation that is immediately
+ released. pool/construct_collect measures batches of allocations that are
+ released by garbage collection, as done by graphs of states. Allocations with
+ new/delete are measured for comparison
+ */
+void bench_pool(tchecker::microbench::runner_t & runner, std::mt19937 & gen)
+{
+  std::size_t const ALLOC_NB = 1024;
+  std::size_t const BATCH = 1024;
+  std::uint64_t const seed = gen();
+
+  runner.run("pool/construct_destruct", [&](std::size_t n) {
+    tchecker::pool_t<shared_bench_pool_object_t> pool{
+        ALLOC_NB, tchecker::allocation_size_t<shared_bench_pool_object_t>::alloc_size()};
+    for (std::size_t i = 0; i < n; ++i) {
+      tchecker::intrusive_shared_ptr_t<shared_bench_pool_object_t> p = pool.construct(seed + i);
+      tchecker::microbench::do_not_optimize(p->x());
+      pool.destruct(p);
+    }
+  });
+
+  runner.run("pool/construct_collect/batch=" + std::to_string(BATCH), [&](std::size_t n) {
+    tchecker::pool_t<shared_bench_pool_object_t> pool{
+        ALLOC_NB, tchecker::allocation_size_t<shared_bench_pool_object_t>::alloc_size()};
+    std::vector<tchecker::intrusive_shared_ptr_t<shared_bench_pool_object_t>> batch;
+    batch.reserve(BATCH);
+    for (std::size_t i = 0; i < n; ++i) {
+      batch.push_back(pool.construct(seed + i));
+      if (batch.size() == BATCH) {
+        batch.clear();
+        tchecker::microbench::do_not_optimize(pool.collect());
+      }
+    }
+  });
+
+  runner.run("pool/new_delete", [&](std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      shared_bench_pool_object_t * p = shared_bench_pool_object_t::allocate_and_construct(seed + i);
+      tchecker::microbench::do_not_optimize(p->x());
+      shared_bench_pool_object_t::destruct_and_deallocate(p);
+    }
+  });
+}
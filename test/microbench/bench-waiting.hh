@@ -0,0 +1,116 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "microbench.hh"
+#include "tchecker/waiting/priority.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/ring.hh"
+#include "tchecker/waiting/stack.hh"
+#include "tchecker/waiting/waiting.hh"
+
+/*!
+ \class bench_element_t
+ \brief Element of waiting containers
+ */
+class bench_element_t : public tchecker::waiting::element_t {
+public:
+  bench_element_t(std::size_t x) : _x(x) {}
+  std::size_t x() const { return _x; }
+
+private:
+  std::size_t _x;
+};
+
+using bench_element_sptr_t = std::shared_ptr<bench_element_t>;
+
+/*!
+ \brief Steady-state benchmark of a waiting container
+ \param runner : a runner
+ \param name : name of the benchmark
+ \param waiting : a waiting container
+ \param elements : elements
+ \param size : number of waiting elements
+ \pre elements.size() > size
+ \note each operation inserts an element and removes the first one
+ */
+template <class W>
+void bench_waiting_container(tchecker::microbench::runner_t & runner, std::string const & name, W & waiting,
+                             std::vector<bench_element_sptr_t> const & elements, std::size_t size)
+{
+  if (!runner.selected(name))
+    return;
+  waiting.clear();
+  for (std::size_t i = 0; i < size; ++i)
+    waiting.insert(elements[i]);
+  runner.run(name, [&](std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+      waiting.insert(elements[(size + i) % elements.size()]);
+      tchecker::microbench::do_not_optimize(waiting.first()->x());
+      waiting.remove_first();
+    }
+  });
+  waiting.clear();
+}
+
+/*!
+ \brief Waiting containers microbenchmarks
+ \param runner : a runner
+ \param gen : random generator
+ \note containers hold a fixed number of elements, and each operation inserts
+ an element and removes the first one. Fast remove containers additionally
+ remove an element that is not first
+ */
+void bench_waiting(tchecker::microbench::runner_t & runner, std::mt19937 & gen)
+{
+  std::uniform_int_distribution<std::size_t> value(0, 1000);
+  std::vector<bench_element_sptr_t> elements;
+  for (std::size_t i = 0; i < 65536; ++i)
+    elements.push_back(std::make_shared<bench_element_t>(value(gen)));
+
+  auto priority = [](bench_element_sptr_t const & e, std::size_t depth) { return e->x() + depth; };
+
+  for (std::size_t size : {16, 4096}) {
+    std::string const suffix = "/size=" + std::to_string(size);
+
+    tchecker::waiting::queue_t<bench_element_sptr_t> queue;
+    bench_waiting_container(runner, "waiting/queue" + suffix, queue, elements, size);
+
+    tchecker::waiting::stack_t<bench_element_sptr_t> stack;
+    bench_waiting_container(runner, "waiting/stack" + suffix, stack, elements, size);
+
+    tchecker::waiting::ring_queue_t<bench_element_sptr_t> ring_queue;
+    bench_waiting_container(runner, "waiting/ring_queue" + suffix, ring_queue, elements, size);
+
+    tchecker::waiting::ring_stack_t<bench_element_sptr_t> ring_stack;
+    bench_waiting_container(runner, "waiting/ring_stack" + suffix, ring_stack, elements, size);
+
+    tchecker::waiting::priority_queue_t<bench_element_sptr_t> priority_queue{priority};
+    bench_waiting_container(runner, "waiting/priority_queue" + suffix, priority_queue, elements, size);
+
+    std::string const name = "waiting/fast_remove_queue/remove" + suffix;
+    if (runner.selected(name)) {
+      tchecker::waiting::fast_remove_queue_t<bench_element_sptr_t> waiting;
+      for (std::size_t i = 0; i < size; ++i)
+        waiting.insert(elements[i]);
+      runner.run(name, [&](std::size_t n) {
+        for (std::size_t i = 0; i < n; ++i) {
+          bench_element_sptr_t const & e = elements[(2 * i + size) % elements.size()];
+          waiting.insert(e);
+          waiting.insert(elements[(2 * i + size + 1) % elements.size()]);
+          waiting.remove(e);
+          tchecker::microbench::do_not_optimize(waiting.first()->x());
+          waiting.remove_first();
+        }
+      });
+    }
+  }
+}
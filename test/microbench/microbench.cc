@@ -0,0 +1,153 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <getopt.h>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "microbench.hh"
+
+#include "bench-dbm.hh"
+#include "bench-hashtable.hh"
+#include "bench-pool.hh"
+#include "bench-waiting.hh"
+
+/*!
+ \file microbench.cc
+ \brief Microbenchmarks of TChecker primitives
+ */
+
+static struct option long_options[] = {{"filter", required_argument, 0, 'f'},
+                                       {"help", no_argument, 0, 'h'},
+                                       {"json", no_argument, 0, 'j'},
+                                       {"list", no_argument, 0, 'l'},
+                                       {"samples", required_argument, 0, 's'},
+                                       {"seed", required_argument, 0, 0},
+                                       {"time", required_argument, 0, 't'},
+                                       {0, 0, 0, 0}};
+
+static char const * const options = (char *)"f:hjls:t:";
+
+/*!
+ \brief Display usage
+ \param progname : programme name
+*/
+void usage(char * progname)
+{
+  std::cerr << "Usage: " << progname << " [options]" << std::endl;
+  std::cerr << "   -f regex      only run benchmarks with names matching regex" << std::endl;
+  std::cerr << "   -h            help" << std::endl;
+  std::cerr << "   -j            output JSON lines instead of a table" << std::endl;
+  std::cerr << "   -l            list benchmarks and exit" << std::endl;
+  std::cerr << "   -s n          number of samples per benchmark (default: 15)" << std::endl;
+  std::cerr << "   -t ms         minimal duration of a sample in milliseconds (default: 20)" << std::endl;
+  std::cerr << "   --seed n      seed of the random generator (default: 0)" << std::endl;
+  std::cerr << "Results are in nanoseconds per operation" << std::endl;
+}
+
+static std::string filter = "";         /*!< Filter on benchmark names */
+static bool help = false;               /*!< Help flag */
+static bool json = false;               /*!< JSON output flag */
+static bool list = false;               /*!< List flag */
+static std::size_t samples = 15;        /*!< Number of samples per benchmark */
+static double min_sample_time = 0.020;  /*!< Minimal duration of a sample (seconds) */
+static std::mt19937::result_type seed = 0; /*!< Seed of the random generator */
+
+/*!
+ \brief Parse command-line arguments
+ \param argc : number of arguments
+ \param argv : array of arguments
+ \pre argv[0] up to argv[argc-1] are valid accesses
+ \post global variables have been set according to argv
+*/
+int parse_command_line(int argc, char * argv[])
+{
+  while (true) {
+    int long_option_index = -1;
+    int c = getopt_long(argc, argv, options, long_options, &long_option_index);
+
+    if (c == -1)
+      break;
+
+    if (c == ':')
+      throw std::runtime_error("Missing option parameter");
+    else if (c == '?')
+      throw std::runtime_error("Unknown command-line option");
+    else if (c != 0) {
+      switch (c) {
+      case 'f':
+        filter = optarg;
+        break;
+      case 'h':
+        help = true;
+        break;
+      case 'j':
+        json = true;
+        break;
+      case 'l':
+        list = true;
+        break;
+      case 's':
+        samples = std::stoul(optarg);
+        break;
+      case 't':
+        min_sample_time = std::stod(optarg) / 1000.0;
+        break;
+      default:
+        throw std::runtime_error("This should never be executed");
+        break;
+      }
+    }
+    else {
+      if (strcmp(long_options[long_option_index].name, "seed") == 0)
+        seed = static_cast<std::mt19937::result_type>(std::stoul(optarg));
+      else
+        throw std::runtime_error("This also should never be executed");
+    }
+  }
+
+  return optind;
+}
+
+/*!
+ \brief Main function
+*/
+int main(int argc, char * argv[])
+{
+  try {
+    int optindex = parse_command_line(argc, argv);
+
+    if (argc - optindex > 0) {
+      std::cerr << "Too many arguments" << std::endl;
+      usage(argv[0]);
+      return EXIT_FAILURE;
+    }
+
+    if (help) {
+      usage(argv[0]);
+      return EXIT_SUCCESS;
+    }
+
+    tchecker::microbench::runner_t runner{std::cout, filter, samples, min_sample_time, json, list};
+    std::mt19937 gen{seed};
+
+    bench_dbm(runner, gen);
+    bench_hashtable(runner, gen);
+    bench_pool(runner, gen);
+    bench_waiting(runner, gen);
+  }
+  catch (std::exception & e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
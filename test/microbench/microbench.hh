@@ -0,0 +1,191 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#ifndef TCHECKER_MICROBENCH_HH
+#define TCHECKER_MICROBENCH_HH
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <regex>
+#include <string>
+#include <vector>
+
+/*!
+ \file microbench.hh
+ \brief Microbenchmarks framework
+ */
+
+namespace tchecker {
+
+namespace microbench {
+
+/*!
+ \brief Prevent the compiler from optimizing away the computation of a value
+ \param value : a value
+ */
+template <class T> inline void do_not_optimize(T const & value) { asm volatile("" : : "r,m"(value) : "memory"); }
+
+/*!
+ \class summary_t
+ \brief Statistical summary of samples (in nanoseconds per operation)
+ */
+class summary_t {
+public:
+  std::size_t samples; /*!< Number of samples */
+  double min;          /*!< Minimum */
+  double median;       /*!< Median */
+  double mean;         /*!< Mean */
+  double stddev;       /*!< Standard deviation */
+  double ci95;         /*!< Half-width of the 95% confidence interval of the mean */
+};
+
+/*!
+ \brief Summarize samples
+ \param samples : samples
+ \pre samples is not empty
+ \return statistical summary of samples
+ */
+inline tchecker::microbench::summary_t summarize(std::vector<double> samples)
+{
+  tchecker::microbench::summary_t s;
+  std::sort(samples.begin(), samples.end());
+  std::size_t const n = samples.size();
+  s.samples = n;
+  s.min = samples.front();
+  s.median = (n % 2 == 1 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2);
+  double sum = 0.0;
+  for (double x : samples)
+    sum += x;
+  s.mean = sum / static_cast<double>(n);
+  double squares = 0.0;
+  for (double x : samples)
+    squares += (x - s.mean) * (x - s.mean);
+  s.stddev = (n > 1 ? std::sqrt(squares / static_cast<double>(n - 1)) : 0.0);
+  s.ci95 = 1.96 * s.stddev / std::sqrt(static_cast<double>(n));
+  return s;
+}
+
+/*!
+ \class runner_t
+ \brief Microbenchmarks runner
+ \note A benchmark is a function that takes a number of iterations, and runs
+ that many operations. The runner calibrates the number of iterations such that
+ a sample lasts at least the minimal sample time, then measures a warmup sample
+ and the requested number of samples
+ */
+class runner_t {
+public:
+  /*!
+   \brief Constructor
+   \param os : output stream
+   \param filter : regular expression on names of benchmarks to run
+   \param samples : number of samples per benchmark
+   \param min_sample_time : minimal duration of a sample (in seconds)
+   \param json : output JSON lines if true, a table otherwise
+   \param list : only list names of benchmarks if true
+   */
+  runner_t(std::ostream & os, std::string const & filter, std::size_t samples, double min_sample_time, bool json, bool list)
+      : _os(os), _filter(filter), _samples(std::max<std::size_t>(samples, 1)), _min_sample_time(min_sample_time),
+        _json(json), _list(list), _header(false)
+  {
+  }
+
+  /*!
+   \brief Check if a benchmark is selected
+   \param name : name of a benchmark
+   \return true if name matches the filter, false otherwise
+   \note benchmarks that need an expensive setup should check selected(name)
+   before setup
+   */
+  bool selected(std::string const & name) const { return std::regex_search(name, _filter); }
+
+  /*!
+   \brief Run a benchmark
+   \param name : name of the benchmark
+   \param fun : benchmark function, fun(n) runs n operations
+   \post fun has been measured and the summary of its samples has been output if
+   name is selected. Only name has been output if runner lists benchmarks
+   */
+  template <class FUN> void run(std::string const & name, FUN && fun)
+  {
+    if (!selected(name))
+      return;
+    if (_list) {
+      _os << name << std::endl;
+      return;
+    }
+
+    std::size_t iterations = 1;
+    while (measure(fun, iterations) < _min_sample_time && iterations < (std::size_t{1} << 40))
+      iterations *= 2;
+
+    measure(fun, iterations); // warmup
+
+    std::vector<double> samples;
+    for (std::size_t i = 0; i < _samples; ++i)
+      samples.push_back(1e9 * measure(fun, iterations) / static_cast<double>(iterations));
+
+    output(name, iterations, tchecker::microbench::summarize(samples));
+  }
+
+private:
+  /*!
+   \brief Measure a benchmark
+   \param fun : benchmark function
+   \param iterations : number of iterations
+   \return duration of fun(iterations) in seconds
+   */
+  template <class FUN> double measure(FUN && fun, std::size_t iterations)
+  {
+    std::chrono::time_point<std::chrono::steady_clock> const start = std::chrono::steady_clock::now();
+    fun(iterations);
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+    return duration.count();
+  }
+
+  /*!
+   \brief Output the summary of a benchmark
+   \param name : name of the benchmark
+   \param iterations : number of iterations per sample
+   \param s : summary
+   */
+  void output(std::string const & name, std::size_t iterations, tchecker::microbench::summary_t const & s)
+  {
+    if (_json) {
+      _os << "{\"name\":\"" << name << "\",\"iterations\":" << iterations << ",\"samples\":" << s.samples
+          << ",\"min_ns\":" << s.min << ",\"median_ns\":" << s.median << ",\"mean_ns\":" << s.mean
+          << ",\"stddev_ns\":" << s.stddev << ",\"ci95_ns\":" << s.ci95 << "}" << std::endl;
+      return;
+    }
+    if (!_header) {
+      _os << std::left << std::setw(52) << "benchmark (ns/op)" << std::right << std::setw(12) << "min" << std::setw(12)
+          << "median" << std::setw(12) << "mean" << std::setw(12) << "stddev" << std::setw(12) << "ci95" << std::endl;
+      _header = true;
+    }
+    _os << std::left << std::setw(52) << name << std::right << std::fixed << std::setprecision(2) << std::setw(12) << s.min
+        << std::setw(12) << s.median << std::setw(12) << s.mean << std::setw(12) << s.stddev << std::setw(12) << s.ci95
+        << std::defaultfloat << std::endl;
+  }
+
+  std::ostream & _os;      /*!< Output stream */
+  std::regex _filter;      /*!< Filter on benchmark names */
+  std::size_t _samples;    /*!< Number of samples per benchmark */
+  double _min_sample_time; /*!< Minimal duration of a sample (seconds) */
+  bool _json;              /*!< JSON output flag */
+  bool _list;              /*!< List flag */
+  bool _header;            /*!< Table header has been output */
+};
+
+} // end of namespace microbench
+
+} // end of namespace tchecker
+
+#endif // TCHECKER_MICROBENCH_HH
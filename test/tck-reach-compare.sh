@@ -0,0 +1,91 @@
+#!/usr/bin/env bash
+
+# This script compares two runs of tck-reach on the same TChecker file. Labels
+# are extracted from the file as in tck-reach.sh. Both runs must agree on the
+# reachability of the labels, and the value of statistics KEY in the second
+# run must not be greater than in the first run (with -s: must be smaller).
+# Options of each run are comma-separated lists of words, e.g.
+# -a,covreach,-s,bfs
+# Nothing is output if the comparison succeeds.
+#
+# Usage: tck-reach-compare.sh [-s] KEY options1 options2 file
+#
+
+if ! test -n "${TCK_REACH}";
+then
+    echo 1>&2 "missing variable TCK_REACH"
+    exit 1
+fi
+
+STRICT="no"
+if test "$1" = "-s";
+then
+    STRICT="yes"
+    shift
+fi
+
+if test $# != 4;
+then
+    echo 1>&2 "usage: $0 [-s] KEY options1 options2 file"
+    exit 1
+fi
+
+KEY="$1"
+OPTIONS1=$(echo "$2" | tr , ' ')
+OPTIONS2=$(echo "$3" | tr , ' ')
+INPUTFILE="$4"
+
+if ! test -f "${INPUTFILE}";
+then
+    echo 1>&2 "missing input file '${INPUTFILE}'"
+    exit 1
+fi
+
+LABELS=$(grep -e "^# *labels *= *\([a-zA-Z0-9_:]*\) *\$" "${INPUTFILE}" | sed -e 's/^# *labels *= *//g' | tr : ,)
+if test -n "${LABELS}";
+then
+    LABELS="-l ${LABELS}"
+fi
+
+# run options : run tck-reach with options on the input file
+run() {
+    if ! eval "${TCK_REACH}" $1 ${LABELS} "\"${INPUTFILE}\"";
+    then
+        echo 1>&2 "tck-reach failed with options: $1"
+        exit 1
+    fi
+}
+
+# value output key : value of statistics key in output
+value() {
+    echo "$1" | sed -n -e "s/^$2 //p"
+}
+
+OUTPUT1=$(run "${OPTIONS1}") || exit 1
+OUTPUT2=$(run "${OPTIONS2}") || exit 1
+
+REACHABLE1=$(value "${OUTPUT1}" REACHABLE)
+REACHABLE2=$(value "${OUTPUT2}" REACHABLE)
+if test -z "${REACHABLE1}" -o "${REACHABLE1}" != "${REACHABLE2}";
+then
+    echo 1>&2 "REACHABLE differs: ${REACHABLE1} with options ${OPTIONS1}, ${REACHABLE2} with options ${OPTIONS2}"
+    exit 1
+fi
+
+VALUE1=$(value "${OUTPUT1}" "${KEY}")
+VALUE2=$(value "${OUTPUT2}" "${KEY}")
+if test -z "${VALUE1}" -o -z "${VALUE2}";
+then
+    echo 1>&2 "missing ${KEY} in outputs of tck-reach"
+    exit 1
+fi
+
+if test "${STRICT}" = "yes" -a "${VALUE2}" -ge "${VALUE1}";
+then
+    echo 1>&2 "${KEY} is not reduced: ${VALUE1} with options ${OPTIONS1}, ${VALUE2} with options ${OPTIONS2}"
+    exit 1
+elif test "${VALUE2}" -gt "${VALUE1}";
+then
+    echo 1>&2 "${KEY} is increased: ${VALUE1} with options ${OPTIONS1}, ${VALUE2} with options ${OPTIONS2}"
+    exit 1
+fi
@@ -0,0 +1,184 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tchecker/graph/binary_certificate.hh"
+#include "tchecker/graph/edge.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/graph/reachability_graph.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/syncprod/vedge.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+// Reachability graph over the zone graph, with public attributes
+class bc_node_t : public tchecker::graph::node_flags_t, public tchecker::graph::node_zg_state_t {
+public:
+  bc_node_t(tchecker::zg::state_sptr_t const & s, bool initial = false)
+      : tchecker::graph::node_flags_t(initial, false), tchecker::graph::node_zg_state_t(s)
+  {
+  }
+};
+
+class bc_node_hash_t {
+public:
+  std::size_t operator()(bc_node_t const & n) const { return tchecker::zg::shared_hash_value(n.state()); }
+};
+
+class bc_node_equal_to_t {
+public:
+  bool operator()(bc_node_t const & n1, bc_node_t const & n2) const
+  {
+    return tchecker::zg::shared_equal_to(n1.state(), n2.state());
+  }
+};
+
+class bc_edge_t : public tchecker::graph::edge_vedge_t {
+public:
+  bc_edge_t(tchecker::zg::transition_t const & t) : tchecker::graph::edge_vedge_t(t.vedge_ptr()) {}
+};
+
+class bc_graph_t
+    : public tchecker::graph::reachability::graph_t<bc_node_t, bc_edge_t, bc_node_hash_t, bc_node_equal_to_t> {
+public:
+  bc_graph_t(std::shared_ptr<tchecker::zg::zg_t> const & zg)
+      : tchecker::graph::reachability::graph_t<bc_node_t, bc_edge_t, bc_node_hash_t, bc_node_equal_to_t>(
+            16, 16, bc_node_hash_t(), bc_node_equal_to_t()),
+        _zg(zg)
+  {
+  }
+
+  virtual ~bc_graph_t() { clear(); }
+
+  virtual void attributes(bc_node_t const & n, std::map<std::string, std::string> & m) const
+  {
+    _zg->attributes(n.state_ptr(), m);
+    tchecker::graph::attributes(static_cast<tchecker::graph::node_flags_t const &>(n), m);
+  }
+
+  virtual void attributes(bc_edge_t const & e, std::map<std::string, std::string> & m) const
+  {
+    m["vedge"] = tchecker::to_string(e.vedge(), _zg->system().as_system_system());
+  }
+
+private:
+  std::shared_ptr<tchecker::zg::zg_t> _zg;
+};
+
+TEST_CASE("binary certificates", "[binary_certificate]")
+{
+  std::string declarations = "system:binary_certificate \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  int:1:0:3:0:i \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:l0{initial: : labels: start} \n\
+  location:P:l1{invariant: x<=5 : labels: end,green} \n\
+  edge:P:l0:l1:a{do: x=0; i=i+1} \n\
+  edge:P:l1:l0:b{provided: x>=2} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(declarations)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  std::shared_ptr<tchecker::zg::zg_t> zg{
+      tchecker::zg::factory(system, tchecker::zg::STANDARD_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, 100, 128)};
+  bc_graph_t g{zg};
+
+  // l0,i=0 -a-> l1,i=1 -b-> l0,i=1
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+  zg->initial(v, tchecker::STATE_OK);
+  REQUIRE(v.size() == 1);
+  auto && [new0, n0] = g.add_node(zg->state(v[0]), true);
+  v.clear();
+  zg->next(n0->state_ptr(), v, tchecker::STATE_OK);
+  REQUIRE(v.size() == 1);
+  auto && [new1, n1] = g.add_node(zg->state(v[0]));
+  g.add_edge(n0, n1, *zg->transition(v[0]));
+  v.clear();
+  zg->next(n1->state_ptr(), v, tchecker::STATE_OK);
+  REQUIRE(v.size() == 1);
+  auto && [new2, n2] = g.add_node(zg->state(v[0]));
+  g.add_edge(n1, n2, *zg->transition(v[0]));
+
+  std::string const filename = "test-binary-certificate.bin";
+  {
+    std::ofstream ofs{filename, std::ios::binary};
+    tchecker::graph::binary::binary_output(ofs, g, "bc", *system);
+  }
+
+  SECTION("round-trip")
+  {
+    tchecker::graph::binary::certificate_t c{filename};
+    REQUIRE(c.name() == "bc");
+    REQUIRE(c.nodes_count() == 3);
+    REQUIRE(c.edges_count() == 2);
+
+    // Nodes are numbered in the order of g.nodes()
+    std::uint64_t n = 0;
+    for (bc_graph_t::node_sptr_t const & node : g.nodes()) {
+      std::map<std::string, std::string> expected, actual;
+      g.attributes(*node, expected);
+      c.attributes(n, actual);
+      REQUIRE(actual == expected);
+      REQUIRE(c.initial(n) == node->initial());
+
+      auto && [first, last] = c.outgoing_edges(n);
+      std::uint64_t e = first;
+      for (bc_graph_t::edge_sptr_t const & edge : g.outgoing_edges(node)) {
+        REQUIRE(e < last);
+        expected.clear();
+        actual.clear();
+        g.attributes(*edge, expected);
+        c.edge_attributes(e, actual);
+        REQUIRE(actual == expected);
+        REQUIRE(c.edge_type(e) == tchecker::graph::binary::EDGE_UNTYPED);
+        ++e;
+      }
+      REQUIRE(e == last);
+      ++n;
+    }
+  }
+
+  SECTION("truncated certificate")
+  {
+    std::string data;
+    {
+      std::ifstream ifs{filename, std::ios::binary};
+      data.assign(std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{});
+    }
+    {
+      std::ofstream ofs{filename, std::ios::binary | std::ios::trunc};
+      ofs.write(data.data(), data.size() / 2);
+    }
+    REQUIRE_THROWS_AS(tchecker::graph::binary::certificate_t{filename}, std::runtime_error);
+  }
+
+  SECTION("not a certificate")
+  {
+    {
+      std::ofstream ofs{filename, std::ios::binary | std::ios::trunc};
+      ofs << "digraph bc {}" << std::endl;
+    }
+    REQUIRE_THROWS_AS(tchecker::graph::binary::certificate_t{filename}, std::runtime_error);
+  }
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,120 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tchecker/algorithms/checkpoint.hh"
+#include "tchecker/graph/node.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/stack.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("serialization of zone graph states", "[checkpoint]")
+{
+  std::string declarations = "system:serialization \n\
+  event:a \n\
+  \n\
+  int:1:0:3:0:i \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{invariant: x<=5} \n\
+  edge:P:l0:l1:a{provided: y>=2 : do: x=0; i=i+1} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(declarations)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+  std::shared_ptr<tchecker::zg::extrapolation_t> extrapolation{
+      tchecker::zg::extrapolation_factory(tchecker::zg::NO_EXTRAPOLATION, *system)};
+  std::shared_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(tchecker::zg::STANDARD_SEMANTICS)};
+  tchecker::zg::zg_t zg{system, semantics, extrapolation, 100, 128, nullptr};
+
+  std::vector<tchecker::zg::zg_t::sst_t> initial, next;
+  zg.initial(initial, tchecker::STATE_OK);
+  REQUIRE(initial.size() == 1);
+  zg.next(tchecker::zg::const_state_sptr_t{zg.state(initial[0])}, next, tchecker::STATE_OK);
+  REQUIRE(next.size() == 1);
+  tchecker::zg::state_sptr_t s = zg.state(next[0]);
+
+  SECTION("round-trip")
+  {
+    std::stringstream ss;
+    tchecker::zg::serialize(ss, *s);
+    tchecker::zg::state_sptr_t t = zg.deserialize_state(ss);
+    REQUIRE(*t == *s);
+    REQUIRE(ss.peek() == std::char_traits<char>::eof());
+  }
+
+  SECTION("truncated data")
+  {
+    std::stringstream ss;
+    tchecker::zg::serialize(ss, *s);
+    std::string data = ss.str();
+    std::stringstream truncated{data.substr(0, data.size() - 1)};
+    REQUIRE_THROWS_AS(zg.deserialize_state(truncated), std::runtime_error);
+  }
+
+  SECTION("out-of-range integer variable")
+  {
+    (*s->intval_ptr())[0] = 7; // i ranges over [0,3]
+    std::stringstream corrupted;
+    tchecker::zg::serialize(corrupted, *s);
+    REQUIRE_THROWS_AS(zg.deserialize_state(corrupted), std::runtime_error);
+  }
+}
+
+TEST_CASE("serialization of node flags", "[checkpoint]")
+{
+  tchecker::graph::node_flags_t flags{true, false}, read_flags{false, true};
+  std::stringstream ss;
+  tchecker::graph::serialize(ss, flags);
+  tchecker::graph::deserialize(ss, read_flags);
+  REQUIRE(read_flags.initial());
+  REQUIRE_FALSE(read_flags.final());
+
+  std::stringstream invalid{std::string(1, static_cast<char>(4))};
+  REQUIRE_THROWS_AS(tchecker::graph::deserialize(invalid, read_flags), std::runtime_error);
+}
+
+TEST_CASE("restore waiting containers", "[checkpoint]")
+{
+  std::vector<int> const elements{3, 1, 4, 1, 5};
+
+  SECTION("queue")
+  {
+    tchecker::waiting::queue_t<int> queue;
+    tchecker::algorithms::restore_waiting(queue, elements);
+    for (int x : elements) {
+      REQUIRE(queue.first() == x);
+      queue.remove_first();
+    }
+    REQUIRE(queue.empty());
+  }
+
+  SECTION("stack")
+  {
+    tchecker::waiting::stack_t<int> stack;
+    tchecker::algorithms::restore_waiting(stack, elements);
+    for (int x : elements) {
+      REQUIRE(stack.first() == x);
+      stack.remove_first();
+    }
+    REQUIRE(stack.empty());
+  }
+}
@@ -0,0 +1,176 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include "tchecker/basictypes.hh"
+#include "tchecker/clockbounds/cache.hh"
+#include "tchecker/clockbounds/clockbounds.hh"
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/parsing/declaration.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/zone.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("Cache of local clock bounds", "[clockbounds]")
+{
+  std::string model = "system:clockbounds_cache \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  event:a \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial: : invariant: x<=4} \n\
+  location:P1:l1{} \n\
+  edge:P1:l0:l1:a{provided: x>=2} \n\
+  edge:P1:l1:l0:a{do: x=0} \n\
+  \n\
+  process:P2 \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1{invariant: y<7} \n\
+  edge:P2:l0:l1:a{do: y=0} \n\
+  edge:P2:l1:l0:a{provided: y>3} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  assert(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clockbounds{tchecker::clockbounds::compute_clockbounds(system)};
+  REQUIRE(clockbounds.get() != nullptr);
+
+  tchecker::process_id_t const P1 = system.process_id("P1");
+  tchecker::process_id_t const P2 = system.process_id("P2");
+
+  tchecker::vloc_t * vloc =
+      tchecker::vloc_allocate_and_construct(static_cast<tchecker::process_id_t>(system.processes_count()),
+                                            static_cast<tchecker::process_id_t>(system.processes_count()));
+
+  tchecker::clock_id_t const clock_nb = clockbounds->clock_number();
+  tchecker::clockbounds::map_t * L = tchecker::clockbounds::allocate_map(clock_nb);
+  tchecker::clockbounds::map_t * U = tchecker::clockbounds::allocate_map(clock_nb);
+  tchecker::clockbounds::map_t * M = tchecker::clockbounds::allocate_map(clock_nb);
+
+  SECTION("Cached bounds are the local bounds")
+  {
+    // A cache with one entry ensures that all tuples of locations collide
+    tchecker::clockbounds::local_lu_cache_t lu_cache{clockbounds->local_lu_map(), 1};
+    tchecker::clockbounds::local_m_cache_t m_cache{clockbounds->local_m_map(), 1};
+
+    for (char const * l1 : {"l0", "l1"})
+      for (char const * l2 : {"l0", "l1"}) {
+        (*vloc)[P1] = system.location(P1, l1)->id();
+        (*vloc)[P2] = system.location(P2, l2)->id();
+
+        clockbounds->local_lu(*vloc, *L, *U);
+        clockbounds->local_m(*vloc, *M);
+
+        tchecker::clockbounds::map_t const * cached_L = nullptr;
+        tchecker::clockbounds::map_t const * cached_U = nullptr;
+        lu_cache.bounds(*vloc, cached_L, cached_U);
+        REQUIRE(*cached_L == *L);
+        REQUIRE(*cached_U == *U);
+        REQUIRE(*m_cache.bounds(*vloc) == *M);
+      }
+
+    REQUIRE(lu_cache.hits() == 0);
+    REQUIRE(lu_cache.misses() == 4);
+  }
+
+  SECTION("Cached bounds are reused")
+  {
+    tchecker::clockbounds::local_lu_cache_t lu_cache{clockbounds->local_lu_map()};
+
+    (*vloc)[P1] = system.location(P1, "l0")->id();
+    (*vloc)[P2] = system.location(P2, "l1")->id();
+    clockbounds->local_lu(*vloc, *L, *U);
+
+    tchecker::clockbounds::map_t const * cached_L = nullptr;
+    tchecker::clockbounds::map_t const * cached_U = nullptr;
+    lu_cache.bounds(*vloc, cached_L, cached_U);
+    lu_cache.bounds(*vloc, cached_L, cached_U);
+    REQUIRE(*cached_L == *L);
+    REQUIRE(*cached_U == *U);
+    REQUIRE(lu_cache.hits() == 1);
+    REQUIRE(lu_cache.misses() == 1);
+
+    lu_cache.clear();
+    lu_cache.bounds(*vloc, cached_L, cached_U);
+    REQUIRE(*cached_L == *L);
+    REQUIRE(lu_cache.misses() == 2);
+  }
+
+  tchecker::clockbounds::deallocate_map(L);
+  tchecker::clockbounds::deallocate_map(U);
+  tchecker::clockbounds::deallocate_map(M);
+  tchecker::vloc_destruct_and_deallocate(vloc);
+}
+
+TEST_CASE("aLU subsumption with cached local clock bounds", "[clockbounds]")
+{
+  std::string model = "system:alu_subsumption \n\
+  clock:1:x \n\
+  event:a \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{} \n\
+  edge:P:l0:l1:a{provided: x==1} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  assert(sysdecl != nullptr);
+
+  tchecker::ta::system_t system{*sysdecl};
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clockbounds{tchecker::clockbounds::compute_clockbounds(system)};
+  REQUIRE(clockbounds.get() != nullptr);
+
+  tchecker::process_id_t const P = system.process_id("P");
+  tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(1, 1);
+  (*vloc)[P] = system.location(P, "l0")->id();
+
+  tchecker::clockbounds::local_lu_cache_t lu_cache{clockbounds->local_lu_map()};
+  tchecker::clockbounds::map_t const * L = nullptr;
+  tchecker::clockbounds::map_t const * U = nullptr;
+  lu_cache.bounds(*vloc, L, U);
+  REQUIRE((*L)[0] == 1);
+  REQUIRE((*U)[0] == 1);
+
+  // zones x == 2 and x == 3: both are above the bounds of x in l0
+  tchecker::clock_id_t const dim = 2;
+  tchecker::zg::zone_t * z1 = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  tchecker::zg::zone_t * z2 = tchecker::zg::zone_allocate_and_construct(dim, dim);
+  for (auto && [zone, value] : {std::make_pair(z1, 2), std::make_pair(z2, 3)}) {
+    tchecker::dbm::db_t * dbm = zone->dbm();
+    tchecker::dbm::universal_positive(dbm, dim);
+    dbm[1 * dim + 0] = tchecker::dbm::db(tchecker::dbm::LE, value);
+    dbm[0 * dim + 1] = tchecker::dbm::db(tchecker::dbm::LE, -value);
+    REQUIRE(tchecker::dbm::tighten(dbm, dim) == tchecker::dbm::NON_EMPTY);
+  }
+
+  SECTION("zones are not included in each other")
+  {
+    REQUIRE(!(*z1 <= *z2));
+    REQUIRE(!(*z2 <= *z1));
+  }
+
+  SECTION("zones are aLU-subsumed by each other w.r.t. cached bounds")
+  {
+    REQUIRE(z1->is_alu_le(*z2, *L, *U));
+    REQUIRE(z2->is_alu_le(*z1, *L, *U));
+    lu_cache.bounds(*vloc, L, U);
+    REQUIRE(z1->is_alu_le(*z2, *L, *U));
+    REQUIRE(lu_cache.hits() == 1);
+  }
+
+  tchecker::zg::zone_destruct_and_deallocate(z1);
+  tchecker::zg::zone_destruct_and_deallocate(z2);
+  tchecker::vloc_destruct_and_deallocate(vloc);
+}
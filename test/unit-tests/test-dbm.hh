@@ -1145,6 +1145,66 @@ TEST_CASE("DBM open_up (delay)", "[dbm]")
   }
 }
 
+TEST_CASE("DBM free_clock", "[dbm]")
+{
+  SECTION("free_clock on universal positive zone has no effect")
+  {
+    tchecker::clock_id_t const dim = 4;
+    tchecker::dbm::db_t dbm[dim * dim];
+    tchecker::dbm::universal_positive(dbm, dim);
+
+    tchecker::dbm::db_t dbm2[dim * dim];
+    memcpy(dbm2, dbm, dim * dim * sizeof(tchecker::dbm::db_t));
+
+    tchecker::dbm::free_clock(dbm, dim, 2);
+
+    REQUIRE(tchecker::dbm::is_tight(dbm, dim));
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("free_clock on zero zone")
+  {
+    tchecker::clock_id_t const dim = 3;
+    tchecker::dbm::db_t dbm[dim * dim];
+    tchecker::dbm::zero(dbm, dim);
+
+    tchecker::dbm::free_clock(dbm, dim, 1);
+
+    // x1 >= 0 and x2 = 0
+    tchecker::dbm::db_t dbm2[dim * dim];
+    tchecker::dbm::zero(dbm2, dim);
+    DBM2(1, 0) = tchecker::dbm::LT_INFINITY;
+    DBM2(1, 2) = tchecker::dbm::LT_INFINITY;
+
+    REQUIRE(tchecker::dbm::is_tight(dbm, dim));
+    REQUIRE(tchecker::dbm::is_equal(dbm, dbm2, dim));
+  }
+
+  SECTION("free_clock removes constraints on the freed clock only")
+  {
+    tchecker::clock_id_t const dim = 3;
+    tchecker::dbm::db_t dbm[dim * dim];
+    tchecker::dbm::universal_positive(dbm, dim);
+    // 1 <= x1 <= 3 & 2 <= x2 <= 4 & x1 - x2 <= 0
+    DBM(0, 1) = tchecker::dbm::db(tchecker::dbm::LE, -1);
+    DBM(1, 0) = tchecker::dbm::db(tchecker::dbm::LE, 3);
+    DBM(0, 2) = tchecker::dbm::db(tchecker::dbm::LE, -2);
+    DBM(2, 0) = tchecker::dbm::db(tchecker::dbm::LE, 4);
+    DBM(1, 2) = tchecker::dbm::LE_ZERO;
+    tchecker::dbm::tighten(dbm, dim);
+
+    tchecker::dbm::free_clock(dbm, dim, 1);
+
+    REQUIRE(tchecker::dbm::is_tight(dbm, dim));
+    REQUIRE(DBM(0, 1) == tchecker::dbm::LE_ZERO);
+    REQUIRE(DBM(1, 0) == tchecker::dbm::LT_INFINITY);
+    REQUIRE(DBM(1, 2) == tchecker::dbm::LT_INFINITY);
+    REQUIRE(DBM(2, 1) == tchecker::dbm::db(tchecker::dbm::LE, 4));
+    REQUIRE(DBM(0, 2) == tchecker::dbm::db(tchecker::dbm::LE, -2));
+    REQUIRE(DBM(2, 0) == tchecker::dbm::db(tchecker::dbm::LE, 4));
+  }
+}
+
 TEST_CASE("DBM intersection", "[dbm]")
 {
 
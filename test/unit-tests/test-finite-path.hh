@@ -5,6 +5,9 @@
  *
  */
 
+#include <sstream>
+
+#include "tchecker/graph/output.hh"
 #include "tchecker/graph/path.hh"
 
 class path_node_t {
@@ -281,4 +284,33 @@ TEST_CASE("Path with more than one edge", "[finite_path]")
       --i;
     }
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Unsorted output of a path", "[finite_path]")
+{
+  finite_path_t path;
+
+  path.add_first_node(7);
+  path.extend_front(1, 5);
+  path.extend_back(2, 9);
+
+  SECTION("Nodes are numbered in the order they have been added")
+  {
+    REQUIRE(path.first()->graph_id() == 1);
+    REQUIRE(path.last()->graph_id() == 2);
+    REQUIRE(path.edge_tgt(path.outgoing_edge(path.first()))->graph_id() == 0);
+  }
+
+  SECTION("Nodes and edges are named by node numbers")
+  {
+    std::ostringstream os;
+    tchecker::graph::dot_output_unsorted(os, path, "foo");
+    std::string const s = os.str();
+    REQUIRE(s.find("digraph foo {") == 0);
+    REQUIRE(s.find("  0 [id=\"7\"]") != std::string::npos);
+    REQUIRE(s.find("  1 [id=\"5\"]") != std::string::npos);
+    REQUIRE(s.find("  2 [id=\"9\"]") != std::string::npos);
+    REQUIRE(s.find("  1 -> 0 [event=\"1\"]") != std::string::npos);
+    REQUIRE(s.find("  0 -> 2 [event=\"2\"]") != std::string::npos);
+  }
+}
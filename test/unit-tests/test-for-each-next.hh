@@ -0,0 +1,117 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/refzg/por.hh"
+#include "tchecker/refzg/refzg.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/ta/ta.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+// Checks that for_each_next visits the same successors as next, in the same order
+template <class TS> std::size_t check_for_each_next(TS & ts, tchecker::state_status_t mask)
+{
+  std::vector<typename TS::sst_t> v;
+  ts.initial(v, tchecker::STATE_OK);
+  REQUIRE(v.size() == 1);
+  typename TS::const_state_t s{ts.state(v[0])};
+
+  std::vector<typename TS::sst_t> expected;
+  ts.next(s, expected, mask);
+
+  std::size_t i = 0;
+  ts.for_each_next(s, mask,
+                   [&](tchecker::state_status_t status, typename TS::state_t const & nexts,
+                       typename TS::transition_t const & nextt) {
+                     REQUIRE(i < expected.size());
+                     REQUIRE(status == ts.status(expected[i]));
+                     REQUIRE(*nexts == *ts.state(expected[i]));
+                     REQUIRE(nextt->vedge() == ts.transition(expected[i])->vedge());
+                     ++i;
+                   });
+  REQUIRE(i == expected.size());
+  return i;
+}
+
+TEST_CASE("visiting next states and transitions", "[for_each_next]")
+{
+  std::string declarations = "system:for_each_next \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  event:d \n\
+  \n\
+  int:1:0:1:0:i \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:l0{initial: : invariant: x<=1} \n\
+  location:P:l1{labels: goal} \n\
+  edge:P:l0:l1:a{provided: x>=2} \n\
+  edge:P:l0:l1:b{do: i=1} \n\
+  edge:P:l0:l0:c{provided: i==1} \n\
+  edge:P:l0:l1:d \n\
+  \n\
+  process:Q \n\
+  clock:1:y \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1 \n\
+  edge:Q:m0:m1:a{do: y=0} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(declarations)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t const> system{new tchecker::ta::system_t{*sysdecl}};
+
+  tchecker::state_status_t const all = tchecker::STATE_OK | tchecker::STATE_INTVARS_GUARD_VIOLATED |
+                                       tchecker::STATE_CLOCKS_GUARD_VIOLATED | tchecker::STATE_CLOCKS_SRC_INVARIANT_VIOLATED |
+                                       tchecker::STATE_CLOCKS_TGT_INVARIANT_VIOLATED;
+
+  SECTION("timed automaton")
+  {
+    tchecker::ta::ta_t ta{system, 100, 128};
+    REQUIRE(check_for_each_next(ta, tchecker::STATE_OK) == 4);
+    REQUIRE(check_for_each_next(ta, all) == 5);
+
+    tchecker::ta::sharing_ta_t sharing_ta{system, 100, 128};
+    REQUIRE(check_for_each_next(sharing_ta, tchecker::STATE_OK) == 4);
+  }
+
+  SECTION("zone graph")
+  {
+    std::unique_ptr<tchecker::zg::zg_t> zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, 128)};
+    REQUIRE(check_for_each_next(*zg, tchecker::STATE_OK) == 3);
+    REQUIRE(check_for_each_next(*zg, all) == 5);
+
+    std::unique_ptr<tchecker::zg::sharing_zg_t> sharing_zg{tchecker::zg::factory_sharing(
+        system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, 128)};
+    REQUIRE(check_for_each_next(*sharing_zg, tchecker::STATE_OK) == 3);
+    REQUIRE(check_for_each_next(*sharing_zg, all) == 5);
+  }
+
+  SECTION("zone graph with reference clocks")
+  {
+    std::unique_ptr<tchecker::refzg::refzg_t> refzg{
+        tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS, tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+                                 tchecker::refdbm::UNBOUNDED_SPREAD, 100, 128)};
+    REQUIRE(check_for_each_next(*refzg, tchecker::STATE_OK) == 3);
+
+    std::shared_ptr<tchecker::refzg::por_t> por{std::make_shared<tchecker::refzg::por_t>(*system, system->labels("goal"))};
+    std::unique_ptr<tchecker::refzg::refzg_t> por_refzg{
+        tchecker::refzg::factory(system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS, tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+                                 tchecker::refdbm::UNBOUNDED_SPREAD, 100, 128, por)};
+    check_for_each_next(*por_refzg, tchecker::STATE_OK);
+  }
+}
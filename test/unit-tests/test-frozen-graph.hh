@@ -0,0 +1,155 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "tchecker/algorithms/path/algorithm.hh"
+#include "tchecker/graph/frozen_graph.hh"
+#include "tchecker/graph/output.hh"
+#include "tchecker/graph/reachability_graph.hh"
+
+class frozen_node_t {
+public:
+  frozen_node_t(int id, bool final = false) : id(id), final(final) {}
+  int id;
+  bool final;
+};
+
+class frozen_node_hash_t {
+public:
+  std::size_t operator()(frozen_node_t const & n) const { return static_cast<std::size_t>(n.id); }
+};
+
+class frozen_node_equal_to_t {
+public:
+  bool operator()(frozen_node_t const & n1, frozen_node_t const & n2) const { return n1.id == n2.id; }
+};
+
+class frozen_edge_t {
+public:
+  frozen_edge_t(int event) : event(event) {}
+  int event;
+};
+
+class frozen_test_graph_t : public tchecker::graph::reachability::graph_t<frozen_node_t, frozen_edge_t, frozen_node_hash_t,
+                                                                          frozen_node_equal_to_t> {
+public:
+  frozen_test_graph_t()
+      : tchecker::graph::reachability::graph_t<frozen_node_t, frozen_edge_t, frozen_node_hash_t, frozen_node_equal_to_t>(
+            16, 16, frozen_node_hash_t(), frozen_node_equal_to_t())
+  {
+  }
+
+  virtual ~frozen_test_graph_t() { clear(); }
+
+  using tchecker::graph::reachability::graph_t<frozen_node_t, frozen_edge_t, frozen_node_hash_t,
+                                               frozen_node_equal_to_t>::attributes;
+
+protected:
+  virtual void attributes(frozen_node_t const & n, std::map<std::string, std::string> & m) const
+  {
+    m["id"] = std::to_string(n.id);
+  }
+
+  virtual void attributes(frozen_edge_t const & e, std::map<std::string, std::string> & m) const
+  {
+    m["event"] = std::to_string(e.event);
+  }
+};
+
+class frozen_node_le_t {
+public:
+  bool operator()(frozen_test_graph_t::node_sptr_t const & n1, frozen_test_graph_t::node_sptr_t const & n2) const
+  {
+    return n1->id < n2->id;
+  }
+};
+
+class frozen_edge_le_t {
+public:
+  bool operator()(frozen_test_graph_t::edge_sptr_t const & e1, frozen_test_graph_t::edge_sptr_t const & e2) const
+  {
+    return e1->event < e2->event;
+  }
+};
+
+TEST_CASE("Frozen graphs", "[frozen_graph]")
+{
+  // 0 -1-> 1 -2-> 2 -3-> 3 (final), 0 -4-> 2, 2 -5-> 0, 1 -6-> 1
+  frozen_test_graph_t g;
+  std::vector<frozen_test_graph_t::node_sptr_t> n;
+  for (int i = 0; i < 4; ++i) {
+    auto && [is_new, node] = g.add_node(i, i == 3);
+    REQUIRE(is_new);
+    n.push_back(node);
+  }
+  g.add_edge(n[0], n[1], 1);
+  g.add_edge(n[1], n[2], 2);
+  g.add_edge(n[2], n[3], 3);
+  g.add_edge(n[0], n[2], 4);
+  g.add_edge(n[2], n[0], 5);
+  g.add_edge(n[1], n[1], 6);
+
+  tchecker::graph::frozen::graph_t<frozen_test_graph_t> frozen = tchecker::graph::frozen::freeze(g);
+
+  SECTION("Compressed sparse rows")
+  {
+    REQUIRE(frozen.nodes_count() == 4);
+    REQUIRE(frozen.edges_count() == 6);
+
+    // nodes and edges are in the order of g
+    tchecker::graph::frozen::node_index_t i = 0;
+    for (frozen_test_graph_t::node_sptr_t const & node : g.nodes()) {
+      REQUIRE(frozen.node(i) == node);
+      auto && [first, last] = frozen.outgoing_edges(i);
+      tchecker::graph::frozen::edge_index_t e = first;
+      for (frozen_test_graph_t::edge_sptr_t const & edge : g.outgoing_edges(node)) {
+        REQUIRE(e < last);
+        REQUIRE(frozen.edge(e) == edge);
+        REQUIRE(frozen.edge_src(e) == i);
+        REQUIRE(frozen.node(frozen.edge_tgt(e)) == g.edge_tgt(edge));
+        ++e;
+      }
+      REQUIRE(e == last);
+      ++i;
+    }
+  }
+
+  SECTION("Path extraction")
+  {
+    auto first = [&](frozen_test_graph_t::node_sptr_t const & node) { return node->id == 0; };
+    auto last = [&](frozen_test_graph_t::node_sptr_t const & node) { return node->final; };
+    auto edge = [&](frozen_test_graph_t::edge_sptr_t const & e) { return e->event != 4; };
+
+    tchecker::algorithms::path::finite::algorithm_t<frozen_test_graph_t> algorithm;
+    std::vector<frozen_test_graph_t::edge_sptr_t> seq = algorithm.run(g, first, last, edge);
+
+    tchecker::algorithms::path::finite::algorithm_t<tchecker::graph::frozen::graph_t<frozen_test_graph_t>> frozen_algorithm;
+    std::vector<frozen_test_graph_t::edge_sptr_t> frozen_seq = frozen_algorithm.run(frozen, first, last, edge);
+
+    REQUIRE(frozen_seq == seq);
+    REQUIRE(frozen_seq.size() == 3);
+    REQUIRE(frozen_seq[0]->event == 1);
+    REQUIRE(frozen_seq[1]->event == 2);
+    REQUIRE(frozen_seq[2]->event == 3);
+
+    // no path without edge 3
+    auto no_edge_3 = [&](frozen_test_graph_t::edge_sptr_t const & e) { return e->event != 3; };
+    REQUIRE(frozen_algorithm.run(frozen, first, last, no_edge_3).empty());
+  }
+
+  SECTION("Output")
+  {
+    std::stringstream expected, actual;
+    tchecker::graph::dot_output<frozen_test_graph_t, frozen_node_le_t, frozen_edge_le_t>(expected, g, "frozen");
+    tchecker::graph::frozen::dot_output<frozen_test_graph_t, frozen_node_le_t, frozen_edge_le_t>(actual, frozen, "frozen");
+    REQUIRE(actual.str() == expected.str());
+  }
+}
@@ -0,0 +1,77 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include "tchecker/algorithms/heuristics.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/syncprod/system.hh"
+#include "tchecker/syncprod/vloc.hh"
+
+TEST_CASE("labels heuristics", "[heuristics]")
+{
+  std::string declarations = "system:labels_heuristics \n\
+  event:a \n\
+  \n\
+  process:P \n\
+  location:P:p0{initial:} \n\
+  location:P:p1 \n\
+  location:P:p2{labels: goal} \n\
+  location:P:p3 \n\
+  edge:P:p0:p1:a \n\
+  edge:P:p1:p2:a \n\
+  edge:P:p2:p3:a \n\
+  \n\
+  process:Q \n\
+  location:Q:q0{initial:} \n\
+  location:Q:q1{labels: other} \n\
+  edge:Q:q0:q1:a \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::syncprod::system_t system(*sysdecl);
+
+  tchecker::process_id_t P = system.process_id("P");
+  tchecker::process_id_t Q = system.process_id("Q");
+
+  tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(2, 2);
+  (*vloc)[P] = system.location(P, "p0")->id();
+  (*vloc)[Q] = system.location(Q, "q0")->id();
+
+  SECTION("distance to a single label")
+  {
+    tchecker::algorithms::labels_heuristics_t h{system, system.labels("goal")};
+    REQUIRE(h.distance(*vloc) == 2);
+    REQUIRE(h.processes_not_in_target(*vloc) == 1);
+    (*vloc)[P] = system.location(P, "p2")->id();
+    REQUIRE(h.distance(*vloc) == 0);
+    REQUIRE(h.processes_not_in_target(*vloc) == 0);
+    (*vloc)[P] = system.location(P, "p3")->id();
+    REQUIRE(h.distance(*vloc) == h.infinity());
+  }
+
+  SECTION("distance to several labels")
+  {
+    tchecker::algorithms::labels_heuristics_t h{system, system.labels("goal,other")};
+    REQUIRE(h.distance(*vloc) == 2);
+    REQUIRE(h.processes_not_in_target(*vloc) == 2);
+    (*vloc)[P] = system.location(P, "p2")->id();
+    REQUIRE(h.distance(*vloc) == 1);
+    REQUIRE(h.processes_not_in_target(*vloc) == 1);
+  }
+
+  SECTION("no searched label")
+  {
+    tchecker::algorithms::labels_heuristics_t h{system, system.labels("")};
+    REQUIRE(h.distance(*vloc) == 0);
+    REQUIRE(h.processes_not_in_target(*vloc) == 0);
+  }
+
+  tchecker::vloc_destruct_and_deallocate(vloc);
+  delete sysdecl;
+}
@@ -180,3 +180,66 @@ TEST_CASE("Labels from comma-separated strings", "[labels]")
 
   SECTION("Bad label") { REQUIRE_THROWS_AS(system.labels("a,c,s,d"), std::invalid_argument); }
 }
+
+TEST_CASE("Memoized labels and satisfaction of labels", "[labels]")
+{
+  std::string model = "system:labels_memo \n\
+  \n\
+  process:P1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1{labels: a,b} \n\
+  \n\
+  process:P2 \n\
+  location:P2:l0{initial: : labels: c} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(model)};
+  assert(sysdecl != nullptr);
+
+  tchecker::syncprod::system_t system{*sysdecl};
+
+  tchecker::process_id_t const P1 = system.process_id("P1");
+  tchecker::process_id_t const P2 = system.process_id("P2");
+
+  tchecker::loc_id_t const P1_l0 = system.location(P1, "l0")->id();
+  tchecker::loc_id_t const P1_l1 = system.location(P1, "l1")->id();
+  tchecker::loc_id_t const P2_l0 = system.location(P2, "l0")->id();
+
+  boost::dynamic_bitset<> ac = system.labels("a,c");
+  boost::dynamic_bitset<> b = system.labels("b");
+
+  tchecker::vloc_t * vloc =
+      tchecker::vloc_allocate_and_construct(static_cast<tchecker::process_id_t>(system.processes_count()),
+                                            static_cast<tchecker::process_id_t>(system.processes_count()));
+  (*vloc)[P1] = P1_l0;
+  (*vloc)[P2] = P2_l0;
+
+  SECTION("Without memo")
+  {
+    REQUIRE(vloc->memo() == nullptr);
+    REQUIRE(!tchecker::syncprod::satisfies(system, *vloc, ac));
+    REQUIRE(!tchecker::syncprod::satisfies(system, *vloc, b));
+    REQUIRE(tchecker::syncprod::satisfies(system, *vloc, boost::dynamic_bitset<>(system.labels_count())));
+  }
+
+  SECTION("With memo")
+  {
+    vloc->attach_memo();
+    REQUIRE(vloc->memo() != nullptr);
+    REQUIRE(tchecker::syncprod::labels(system, *vloc) == system.labels(P2_l0));
+    REQUIRE(vloc->memo()->has_labels());
+    REQUIRE(!tchecker::syncprod::satisfies(system, *vloc, ac));
+
+    // modification detaches memoized labels
+    (*vloc)[P1] = P1_l1;
+    REQUIRE(vloc->memo() == nullptr);
+    REQUIRE(tchecker::syncprod::satisfies(system, *vloc, ac));
+    REQUIRE(tchecker::syncprod::satisfies(system, *vloc, b));
+
+    vloc->attach_memo();
+    REQUIRE(tchecker::syncprod::satisfies(system, *vloc, ac));
+    REQUIRE(tchecker::syncprod::labels(system, *vloc).count() == 3);
+  }
+
+  tchecker::vloc_destruct_and_deallocate(vloc);
+}
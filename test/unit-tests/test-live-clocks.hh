@@ -0,0 +1,283 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+
+#include "tchecker/clockbounds/solver.hh"
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/syncprod/vloc.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/static_analysis.hh"
+#include "tchecker/zg/extrapolation.hh"
+
+TEST_CASE("live clocks - 1 process", "[live clocks]")
+{
+  std::string declarations = "system:live_clocks_1_process \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x==2 : do: y=0} \n\
+  edge:P:l1:l0:b{provided: y==3 : do: x=0} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  tchecker::clock_id_t x = system.clock_id("x");
+  tchecker::clock_id_t y = system.clock_id("y");
+  tchecker::loc_id_t l0 = system.location(system.process_id("P"), "l0")->id();
+  tchecker::loc_id_t l1 = system.location(system.process_id("P"), "l1")->id();
+
+  std::vector<boost::dynamic_bitset<>> live = tchecker::live_clocks(system);
+
+  SECTION("only x is live in l0")
+  {
+    REQUIRE(live[l0][x]);
+    REQUIRE(!live[l0][y]);
+  }
+
+  SECTION("only y is live in l1")
+  {
+    REQUIRE(!live[l1][x]);
+    REQUIRE(live[l1][y]);
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("live clocks - invariants and clock assignments", "[live clocks]")
+{
+  std::string declarations = "system:live_clocks_invariants \n\
+  event:a \n\
+  \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  clock:1:z \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1{invariant: z<=4} \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:a{do: z=0} \n\
+  edge:P:l1:l2:a{do: x=y} \n\
+  edge:P:l2:l0:a{provided: x>=1 : do: x=0; y=0} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  tchecker::clock_id_t x = system.clock_id("x");
+  tchecker::clock_id_t y = system.clock_id("y");
+  tchecker::clock_id_t z = system.clock_id("z");
+  tchecker::loc_id_t l0 = system.location(system.process_id("P"), "l0")->id();
+  tchecker::loc_id_t l1 = system.location(system.process_id("P"), "l1")->id();
+  tchecker::loc_id_t l2 = system.location(system.process_id("P"), "l2")->id();
+
+  std::vector<boost::dynamic_bitset<>> live = tchecker::live_clocks(system);
+
+  SECTION("clocks read by an invariant are live")
+  {
+    REQUIRE(live[l1][z]);
+    REQUIRE(!live[l0][z]);
+    REQUIRE(!live[l2][z]);
+  }
+
+  SECTION("clocks read by an assignment are live, assigned clocks are dead")
+  {
+    REQUIRE(live[l1][y]);
+    REQUIRE(!live[l1][x]);
+    REQUIRE(live[l0][y]);
+    REQUIRE(!live[l0][x]);
+  }
+
+  SECTION("clocks read by a guard are live")
+  {
+    REQUIRE(live[l2][x]);
+    REQUIRE(!live[l2][y]);
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("live clocks - shared clock", "[live clocks]")
+{
+  std::string declarations = "system:live_clocks_shared \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  clock:1:x \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{do: x=0} \n\
+  edge:P:l1:l0:a{provided: x<=1} \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  location:Q:m1 \n\
+  edge:Q:m0:m1:b{provided: x>=3} \n\
+  edge:Q:m1:m0:b \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  tchecker::clock_id_t x = system.clock_id("x");
+  tchecker::process_id_t P = system.process_id("P");
+  tchecker::process_id_t Q = system.process_id("Q");
+  tchecker::loc_id_t l0 = system.location(P, "l0")->id();
+  tchecker::loc_id_t l1 = system.location(P, "l1")->id();
+  tchecker::loc_id_t m0 = system.location(Q, "m0")->id();
+  tchecker::loc_id_t m1 = system.location(Q, "m1")->id();
+
+  std::vector<boost::dynamic_bitset<>> live = tchecker::live_clocks(system);
+
+  SECTION("liveness only depends on the process of the location")
+  {
+    REQUIRE(!live[l0][x]);
+    REQUIRE(live[l1][x]);
+    REQUIRE(live[m0][x]);
+    REQUIRE(live[m1][x]);
+  }
+
+  SECTION("x is active in every tuple of locations since Q may read it")
+  {
+    std::shared_ptr<tchecker::zg::extrapolation_t> no_extrapolation{new tchecker::zg::no_extrapolation_t};
+    tchecker::zg::active_clocks_extrapolation_t extrapolation{
+        no_extrapolation, std::make_shared<std::vector<boost::dynamic_bitset<>>>(live), 1};
+
+    tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(2, 2);
+    (*vloc)[P] = l0;
+    (*vloc)[Q] = m0;
+
+    tchecker::clock_id_t const dim = 2;
+    tchecker::dbm::db_t dbm[dim * dim];
+    tchecker::dbm::zero(dbm, dim);
+
+    extrapolation.extrapolate(dbm, dim, *vloc);
+
+    tchecker::dbm::db_t zero[dim * dim];
+    tchecker::dbm::zero(zero, dim);
+    REQUIRE(tchecker::dbm::is_equal(dbm, zero, dim));
+    REQUIRE(extrapolation.freed_clocks() == 0);
+
+    tchecker::vloc_destruct_and_deallocate(vloc);
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("active clocks extrapolation", "[live clocks]")
+{
+  std::string declarations = "system:active_clocks_extrapolation \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  clock:1:x \n\
+  clock:1:y \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{provided: x==2 : do: y=0} \n\
+  edge:P:l1:l0:b{provided: y==3 : do: x=0} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t(*sysdecl)};
+
+  tchecker::process_id_t P = system->process_id("P");
+  tchecker::loc_id_t l0 = system->location(P, "l0")->id();
+  tchecker::loc_id_t l1 = system->location(P, "l1")->id();
+
+  std::unique_ptr<tchecker::clockbounds::clockbounds_t> clock_bounds{tchecker::clockbounds::compute_clockbounds(*system)};
+  REQUIRE(clock_bounds.get() != nullptr);
+
+  std::unique_ptr<tchecker::zg::extrapolation_t> extrapolation{
+      tchecker::zg::active_clocks_extrapolation_factory(tchecker::zg::EXTRA_LU_PLUS_GLOBAL, *system, *clock_bounds)};
+  auto & active_clocks = dynamic_cast<tchecker::zg::active_clocks_extrapolation_t &>(*extrapolation);
+
+  tchecker::vloc_t * vloc = tchecker::vloc_allocate_and_construct(1, 1);
+
+  tchecker::clock_id_t const dim = 3;
+  tchecker::clock_id_t const x = system->clock_id("x") + 1;
+  tchecker::clock_id_t const y = system->clock_id("y") + 1;
+
+  SECTION("inactive clocks are freed")
+  {
+    // Zones reached in l0 from the initial state and after a cycle: x = y and
+    // y - x = 3. Global ExtraLU+ keeps them apart since y has bound 3, whereas
+    // y is inactive in l0
+    tchecker::dbm::db_t dbm1[dim * dim];
+    tchecker::dbm::universal_positive(dbm1, dim);
+    dbm1[x * dim + y] = tchecker::dbm::LE_ZERO;
+    dbm1[y * dim + x] = tchecker::dbm::LE_ZERO;
+    tchecker::dbm::tighten(dbm1, dim);
+
+    tchecker::dbm::db_t dbm2[dim * dim];
+    tchecker::dbm::universal_positive(dbm2, dim);
+    dbm2[x * dim + y] = tchecker::dbm::db(tchecker::dbm::LE, -3);
+    dbm2[y * dim + x] = tchecker::dbm::db(tchecker::dbm::LE, 3);
+    tchecker::dbm::tighten(dbm2, dim);
+
+    REQUIRE(!tchecker::dbm::is_equal(dbm1, dbm2, dim));
+
+    (*vloc)[P] = l0;
+    extrapolation->extrapolate(dbm1, dim, *vloc);
+    extrapolation->extrapolate(dbm2, dim, *vloc);
+
+    tchecker::dbm::db_t universal[dim * dim];
+    tchecker::dbm::universal_positive(universal, dim);
+
+    REQUIRE(tchecker::dbm::is_equal(dbm1, dbm2, dim));
+    REQUIRE(tchecker::dbm::is_equal(dbm1, universal, dim));
+    REQUIRE(active_clocks.freed_clocks() == 2);
+  }
+
+  SECTION("active clocks are kept")
+  {
+    // x = y & y <= 1
+    tchecker::dbm::db_t dbm[dim * dim];
+    tchecker::dbm::universal_positive(dbm, dim);
+    dbm[x * dim + y] = tchecker::dbm::LE_ZERO;
+    dbm[y * dim + x] = tchecker::dbm::LE_ZERO;
+    dbm[y * dim + 0] = tchecker::dbm::db(tchecker::dbm::LE, 1);
+    tchecker::dbm::tighten(dbm, dim);
+
+    (*vloc)[P] = l1;
+    extrapolation->extrapolate(dbm, dim, *vloc);
+
+    REQUIRE(tchecker::dbm::is_tight(dbm, dim));
+    REQUIRE(dbm[y * dim + 0] == tchecker::dbm::db(tchecker::dbm::LE, 1));
+    REQUIRE(dbm[x * dim + 0] == tchecker::dbm::LT_INFINITY);
+    REQUIRE(dbm[x * dim + y] == tchecker::dbm::LT_INFINITY);
+    REQUIRE(active_clocks.freed_clocks() == 1);
+  }
+
+  tchecker::vloc_destruct_and_deallocate(vloc);
+  delete sysdecl;
+}
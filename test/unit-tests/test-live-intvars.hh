@@ -0,0 +1,239 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <algorithm>
+#include <memory>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/static_analysis.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/utils/log.hh"
+#include "tchecker/variables/static_analysis.hh"
+#include "tchecker/zg/zg.hh"
+
+TEST_CASE("live bounded integer variables - 1 process", "[live intvars]")
+{
+  std::string declarations = "system:live_intvars_1_process \n\
+  event:a \n\
+  \n\
+  int:1:0:3:0:i \n\
+  int:1:0:3:0:j \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:a{do: i=1} \n\
+  edge:P:l1:l2:a{provided: i==1 : do: j=i} \n\
+  edge:P:l2:l0:a{provided: j>0} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  tchecker::intvar_id_t i = system.intvar_id("i");
+  tchecker::intvar_id_t j = system.intvar_id("j");
+  tchecker::loc_id_t l0 = system.location(system.process_id("P"), "l0")->id();
+  tchecker::loc_id_t l1 = system.location(system.process_id("P"), "l1")->id();
+  tchecker::loc_id_t l2 = system.location(system.process_id("P"), "l2")->id();
+
+  std::vector<boost::dynamic_bitset<>> live = tchecker::live_intvars(system);
+
+  SECTION("no variable is live in l0")
+  {
+    REQUIRE(!live[l0][i]);
+    REQUIRE(!live[l0][j]);
+  }
+
+  SECTION("only i is live in l1")
+  {
+    REQUIRE(live[l1][i]);
+    REQUIRE(!live[l1][j]);
+  }
+
+  SECTION("only j is live in l2")
+  {
+    REQUIRE(!live[l2][i]);
+    REQUIRE(live[l2][j]);
+  }
+
+  SECTION("dead variables are stored in the system")
+  {
+    REQUIRE(system.dead_intvars(l0).size() == 2);
+    REQUIRE(system.dead_intvars(l1) == std::vector<tchecker::intvar_id_t>{j});
+    REQUIRE(system.dead_intvars(l2) == std::vector<tchecker::intvar_id_t>{i});
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("live bounded integer variables - conditional writes", "[live intvars]")
+{
+  std::string declarations = "system:live_intvars_conditional \n\
+  event:a \n\
+  \n\
+  int:1:0:3:0:i \n\
+  int:1:0:3:0:j \n\
+  int:1:0:3:0:k \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{do: if (i>0) then j=1; k=1 else j=2 end} \n\
+  edge:P:l1:l0:a{provided: j>0 && k>0 : do: i=j} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  tchecker::intvar_id_t i = system.intvar_id("i");
+  tchecker::intvar_id_t j = system.intvar_id("j");
+  tchecker::intvar_id_t k = system.intvar_id("k");
+  tchecker::loc_id_t l0 = system.location(system.process_id("P"), "l0")->id();
+  tchecker::loc_id_t l1 = system.location(system.process_id("P"), "l1")->id();
+
+  std::vector<boost::dynamic_bitset<>> live = tchecker::live_intvars(system);
+
+  SECTION("variables read in conditions are live") { REQUIRE(live[l0][i]); }
+
+  SECTION("variables written in both branches are killed") { REQUIRE(!live[l0][j]); }
+
+  SECTION("variables written in one branch are not killed") { REQUIRE(live[l0][k]); }
+
+  SECTION("variables read by guards and statements are live")
+  {
+    REQUIRE(live[l1][j]);
+    REQUIRE(live[l1][k]);
+    REQUIRE(!live[l1][i]);
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("live bounded integer variables - shared variables", "[live intvars]")
+{
+  std::string declarations = "system:live_intvars_shared \n\
+  event:a \n\
+  \n\
+  int:1:0:3:0:s \n\
+  int:1:0:3:0:t \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  edge:P:l0:l1:a{do: s=1; t=1} \n\
+  edge:P:l1:l0:a{provided: t>0 : do: s=0} \n\
+  \n\
+  process:Q \n\
+  location:Q:m0{initial:} \n\
+  edge:Q:m0:m0:a{provided: s==1} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  tchecker::intvar_id_t s = system.intvar_id("s");
+  tchecker::intvar_id_t t = system.intvar_id("t");
+  tchecker::loc_id_t l0 = system.location(system.process_id("P"), "l0")->id();
+
+  std::vector<boost::dynamic_bitset<>> live = tchecker::live_intvars(system);
+
+  SECTION("shared variables are live everywhere")
+  {
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations())
+      REQUIRE(live[loc->id()][s]);
+  }
+
+  SECTION("shared variables are never dead")
+  {
+    for (tchecker::system::loc_const_shared_ptr_t const & loc : system.locations()) {
+      std::vector<tchecker::intvar_id_t> const & dead = system.dead_intvars(loc->id());
+      REQUIRE(std::find(dead.begin(), dead.end(), s) == dead.end());
+    }
+  }
+
+  SECTION("local variables are only dead in locations of their process")
+  {
+    REQUIRE(system.dead_intvars(l0) == std::vector<tchecker::intvar_id_t>{t});
+    tchecker::loc_id_t m0 = system.location(system.process_id("Q"), "m0")->id();
+    REQUIRE(system.dead_intvars(m0).empty());
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("reset of dead bounded integer variables", "[live intvars]")
+{
+  std::string declarations = "system:reset_dead_intvars \n\
+  event:a \n\
+  \n\
+  int:1:0:3:0:i \n\
+  int:1:0:3:0:j \n\
+  \n\
+  process:P \n\
+  location:P:l0{initial:} \n\
+  location:P:l1 \n\
+  location:P:l2 \n\
+  edge:P:l0:l1:a{do: i=1} \n\
+  edge:P:l1:l2:a{provided: i==1 : do: j=i} \n\
+  edge:P:l2:l0:a{provided: j>0} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(declarations)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+  REQUIRE(!system->dead_intvars_reset());
+
+  // Runs the cycle l0 -> l1 -> l2 -> l0 and returns the attributes of the
+  // states along the cycle
+  auto cycle = [](tchecker::zg::zg_t & zg) {
+    std::vector<std::string> intvals;
+    std::vector<tchecker::zg::zg_t::sst_t> v;
+    zg.initial(v, tchecker::STATE_OK);
+    REQUIRE(v.size() == 1);
+    for (std::size_t k = 0; k < 4; ++k) {
+      tchecker::zg::const_state_sptr_t s{std::get<1>(v[0])};
+      std::map<std::string, std::string> m;
+      zg.attributes(s, m);
+      intvals.push_back(m["intval"]);
+      v.clear();
+      zg.next(s, v, tchecker::STATE_OK);
+      REQUIRE(v.size() == 1);
+    }
+    return intvals;
+  };
+
+  SECTION("no variable is reset by default")
+  {
+    std::unique_ptr<tchecker::zg::zg_t> zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, 100, 128)};
+    std::vector<std::string> intvals = cycle(*zg);
+    REQUIRE(intvals[3] != intvals[0]);
+    REQUIRE(zg->intvars_reset_successors() == 0);
+  }
+
+  SECTION("dead variables are reset to their initial value")
+  {
+    system->dead_intvars_reset(true);
+    std::unique_ptr<tchecker::zg::zg_t> zg{
+        tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::NO_EXTRAPOLATION, 100, 128)};
+    std::vector<std::string> intvals = cycle(*zg);
+    REQUIRE(intvals[3] == intvals[0]);
+    // i is reset when entering l2, and j when entering l0
+    REQUIRE(zg->intvars_reset_successors() == 2);
+  }
+}
@@ -0,0 +1,75 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <vector>
+
+#include "tchecker/system/attribute.hh"
+#include "tchecker/system/edge.hh"
+
+TEST_CASE("location and event maps of edges", "[loc_edges_maps]")
+{
+  tchecker::system::edges_t edges;
+  tchecker::system::attributes_t attr;
+
+  // Location 0: events 7, 2, 7, 0 (in order of insertion). Location 1: event 2
+  edges.add_edge(0, 0, 1, 7, attr); // edge 0
+  edges.add_edge(0, 0, 1, 2, attr); // edge 1
+  edges.add_edge(0, 0, 0, 7, attr); // edge 2
+  edges.add_edge(0, 0, 1, 0, attr); // edge 3
+  edges.add_edge(0, 1, 0, 2, attr); // edge 4
+
+  auto ids = [](auto && range) {
+    std::vector<tchecker::edge_id_t> v;
+    for (tchecker::system::edge_const_shared_ptr_t const & e : range)
+      v.push_back(e->id());
+    return v;
+  };
+
+  SECTION("edges of a location are in order of insertion")
+  {
+    REQUIRE(ids(edges.outgoing_edges(0)) == std::vector<tchecker::edge_id_t>{0, 1, 2, 3});
+    REQUIRE(ids(edges.outgoing_edges(1)) == std::vector<tchecker::edge_id_t>{4});
+    REQUIRE(ids(edges.incoming_edges(1)) == std::vector<tchecker::edge_id_t>{0, 1, 3});
+    REQUIRE(ids(edges.outgoing_edges(5)).empty());
+  }
+
+  SECTION("edges of a location with an event are in order of insertion")
+  {
+    REQUIRE(ids(edges.outgoing_edges(0, 7)) == std::vector<tchecker::edge_id_t>{0, 2});
+    REQUIRE(ids(edges.outgoing_edges(0, 2)) == std::vector<tchecker::edge_id_t>{1});
+    REQUIRE(ids(edges.outgoing_edges(0, 0)) == std::vector<tchecker::edge_id_t>{3});
+    REQUIRE(ids(edges.outgoing_edges(0, 5)).empty());
+    REQUIRE(ids(edges.outgoing_edges(0, 1000)).empty());
+    REQUIRE(ids(edges.outgoing_edges(5, 2)).empty());
+    REQUIRE(ids(edges.incoming_edges(0, 2)) == std::vector<tchecker::edge_id_t>{4});
+  }
+
+  SECTION("events of a location")
+  {
+    REQUIRE(edges.outgoing_event(0, 0));
+    REQUIRE(edges.outgoing_event(0, 2));
+    REQUIRE(edges.outgoing_event(0, 7));
+    REQUIRE_FALSE(edges.outgoing_event(0, 1));
+    REQUIRE_FALSE(edges.outgoing_event(0, 1000));
+    REQUIRE_FALSE(edges.outgoing_event(1, 7));
+    REQUIRE_FALSE(edges.outgoing_event(5, 2));
+    REQUIRE(edges.incoming_event(0, 7));
+    REQUIRE_FALSE(edges.incoming_event(0, 0));
+  }
+
+  SECTION("copies preserve the order of edges")
+  {
+    tchecker::system::edges_t copy{edges};
+    REQUIRE(ids(copy.outgoing_edges(0)) == std::vector<tchecker::edge_id_t>{0, 1, 2, 3});
+    REQUIRE(ids(copy.outgoing_edges(0, 7)) == std::vector<tchecker::edge_id_t>{0, 2});
+    REQUIRE(ids(copy.outgoing_edges(0, 0)) == std::vector<tchecker::edge_id_t>{3});
+    REQUIRE(ids(copy.incoming_edges(1, 2)) == std::vector<tchecker::edge_id_t>{1});
+    REQUIRE(ids(copy.incoming_edges(0, 2)) == std::vector<tchecker::edge_id_t>{4});
+    REQUIRE(copy.outgoing_event(0, 2));
+    REQUIRE_FALSE(copy.outgoing_event(0, 1));
+  }
+}
@@ -0,0 +1,160 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <stdexcept>
+#include <string>
+
+#include "tchecker/algorithms/memory_limit.hh"
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/hashtable.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+// Object for testing memory accounting
+class mlo_t : public tchecker::collision_table_object_t {
+public:
+  mlo_t(int x) : _x(x) {}
+  int x() const { return _x; }
+
+private:
+  int _x;
+};
+
+namespace tchecker {
+template <> class allocation_size_t<mlo_t> {
+public:
+  static constexpr std::size_t alloc_size() { return sizeof(mlo_t); }
+
+  template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... /*args*/) { return sizeof(mlo_t); }
+};
+} // namespace tchecker
+
+using shared_mlo_t = tchecker::make_shared_t<mlo_t>;
+
+using mlo_sptr_t = tchecker::intrusive_shared_ptr_t<shared_mlo_t>;
+
+class mlo_sptr_hash_t {
+public:
+  std::size_t operator()(mlo_sptr_t const & p) const { return static_cast<std::size_t>(p->x()); }
+};
+
+// Transition system and graph that count degradation steps
+class mlo_ts_t {
+public:
+  void collect() { ++collects; }
+  unsigned collects = 0;
+};
+
+class mlo_graph_t {
+public:
+  void clear_edges() { ++clear_edges_calls; }
+  void collect() { ++collects; }
+  unsigned clear_edges_calls = 0;
+  unsigned collects = 0;
+};
+
+// Call check() until the memory is measured
+static bool mlo_measure(tchecker::algorithms::memory_guard_t & guard, mlo_ts_t & ts, mlo_graph_t & graph)
+{
+  for (unsigned i = 0; i < 255; ++i)
+    REQUIRE(guard.check(ts, graph));
+  return guard.check(ts, graph);
+}
+
+TEST_CASE("parse memory sizes", "[memory_limit]")
+{
+  REQUIRE(tchecker::algorithms::parse_memory_size("1024") == 1024);
+  REQUIRE(tchecker::algorithms::parse_memory_size("4K") == 4096);
+  REQUIRE(tchecker::algorithms::parse_memory_size("2m") == 2 * (1UL << 20));
+  REQUIRE(tchecker::algorithms::parse_memory_size("1G") == (1UL << 30));
+
+  REQUIRE_THROWS_AS(tchecker::algorithms::parse_memory_size(""), std::invalid_argument);
+  REQUIRE_THROWS_AS(tchecker::algorithms::parse_memory_size("K"), std::invalid_argument);
+  REQUIRE_THROWS_AS(tchecker::algorithms::parse_memory_size("0"), std::invalid_argument);
+  REQUIRE_THROWS_AS(tchecker::algorithms::parse_memory_size("12X"), std::invalid_argument);
+  REQUIRE_THROWS_AS(tchecker::algorithms::parse_memory_size("1KB"), std::invalid_argument);
+  REQUIRE_THROWS_AS(tchecker::algorithms::parse_memory_size("99999999999999999999"), std::invalid_argument);
+}
+
+TEST_CASE("memory accounting of collision tables", "[memory_limit]")
+{
+  std::size_t const memsize = tchecker::hashtables_memsize();
+  tchecker::pool_t<shared_mlo_t> pool(4, tchecker::allocation_size_t<shared_mlo_t>::alloc_size());
+  {
+    mlo_sptr_hash_t hash;
+    tchecker::collision_table_t<mlo_sptr_t, mlo_sptr_hash_t> t(16, hash);
+    std::size_t const empty_memsize = tchecker::hashtables_memsize();
+    REQUIRE(empty_memsize >= memsize + 16 * sizeof(std::vector<mlo_sptr_t>));
+
+    for (int i = 0; i < 10; ++i)
+      t.add(pool.construct(0)); // same collision list
+    REQUIRE(tchecker::hashtables_memsize() >= empty_memsize + 10 * sizeof(mlo_sptr_t));
+  }
+  REQUIRE(tchecker::hashtables_memsize() == memsize);
+}
+
+TEST_CASE("graceful degradation under memory limit", "[memory_limit]")
+{
+  mlo_ts_t ts;
+  mlo_graph_t graph;
+
+  SECTION("no memory limit")
+  {
+    tchecker::algorithms::memory_guard_t guard{nullptr};
+    REQUIRE(mlo_measure(guard, ts, graph));
+    REQUIRE(guard.store_edges());
+    REQUIRE(guard.degradation() == tchecker::algorithms::MEMORY_NO_DEGRADATION);
+    REQUIRE(graph.clear_edges_calls == 0);
+  }
+
+  SECTION("degradation steps")
+  {
+    tchecker::pool_t<shared_mlo_t> pool(4, tchecker::allocation_size_t<shared_mlo_t>::alloc_size());
+    mlo_sptr_t p = pool.construct(0); // ensures memory is above the limit
+    tchecker::algorithms::memory_limit_t limit{1};
+    tchecker::algorithms::memory_guard_t guard{&limit};
+
+    REQUIRE(mlo_measure(guard, ts, graph));
+    REQUIRE_FALSE(guard.store_edges());
+    REQUIRE(guard.degradation() == tchecker::algorithms::MEMORY_DROP_EDGES);
+    REQUIRE(graph.clear_edges_calls == 1);
+    REQUIRE(graph.collects == 0);
+
+    REQUIRE(mlo_measure(guard, ts, graph));
+    REQUIRE(guard.degradation() == tchecker::algorithms::MEMORY_COLLECT);
+    REQUIRE(graph.collects == 1);
+    REQUIRE(ts.collects == 1);
+
+    // no allocation since last collection
+    REQUIRE(mlo_measure(guard, ts, graph));
+    REQUIRE(guard.degradation() == tchecker::algorithms::MEMORY_COLLECT);
+    REQUIRE(graph.collects == 1);
+
+    // allocate a new block
+    std::vector<mlo_sptr_t> v;
+    for (int i = 0; i < 4; ++i)
+      v.push_back(pool.construct(i));
+    REQUIRE_FALSE(mlo_measure(guard, ts, graph));
+    REQUIRE(guard.degradation() == tchecker::algorithms::MEMORY_EXHAUSTED);
+    REQUIRE(graph.clear_edges_calls == 1);
+  }
+}
+
+TEST_CASE("memory degradation statistics", "[memory_limit]")
+{
+  tchecker::algorithms::reach::stats_t stats;
+  std::map<std::string, std::string> m;
+
+  stats.attributes(m);
+  REQUIRE(m.find("MEMORY_DEGRADATION") == m.end());
+
+  stats.memory_degradation() = tchecker::algorithms::MEMORY_DROP_EDGES;
+  stats.attributes(m);
+  REQUIRE(m["MEMORY_DEGRADATION"] == "drop-edges");
+}
@@ -0,0 +1,180 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/variables/intvars.hh"
+#include "tchecker/zg/zg.hh"
+
+#include "testutils/utils.hh"
+
+TEST_CASE("layout of packed integer variables valuations", "[packed_intvars]")
+{
+  tchecker::integer_variables_t intvars;
+  intvars.declare("b", 1, 0, 1, 0);      // 1 bit
+  intvars.declare("c", 1, 5, 5, 5);      // 0 bit
+  intvars.declare("t", 3, -3, 4, 0);     // 3 x 3 bits
+  intvars.declare("n", 1, -100, 100, 0); // 8 bits
+
+  tchecker::flat_integer_variables_t const & flat = intvars.flattened();
+  REQUIRE(flat.size() == 6);
+
+  tchecker::intvars_layout_t layout{flat};
+
+  SECTION("widths, offsets and capacity")
+  {
+    REQUIRE(layout.size() == 6);
+    REQUIRE(layout.width(0) == 1);
+    REQUIRE(layout.width(1) == 0);
+    REQUIRE(layout.width(2) == 3);
+    REQUIRE(layout.width(5) == 8);
+    REQUIRE(layout.offset(0) == 0);
+    REQUIRE(layout.offset(2) == 1);
+    REQUIRE(layout.offset(3) == 4);
+    REQUIRE(layout.offset(4) == 7);
+    REQUIRE(layout.offset(5) == 10);
+    REQUIRE(layout.capacity() == 1);
+  }
+
+  SECTION("load and store")
+  {
+    tchecker::intvars_valuation_t * v = tchecker::intvars_valuation_allocate_and_construct(layout.capacity(), layout.capacity());
+
+    std::vector<tchecker::integer_t> values{1, 5, -3, 4, 0, -100};
+    for (tchecker::intvar_id_t id = 0; id < values.size(); ++id)
+      layout.store(*v, id, values[id]);
+    for (tchecker::intvar_id_t id = 0; id < values.size(); ++id)
+      REQUIRE(layout.load(*v, id) == values[id]);
+
+    layout.store(*v, 3, -1);
+    layout.store(*v, 5, 100);
+    REQUIRE(layout.load(*v, 2) == -3);
+    REQUIRE(layout.load(*v, 3) == -1);
+    REQUIRE(layout.load(*v, 4) == 0);
+    REQUIRE(layout.load(*v, 5) == 100);
+
+    tchecker::intvars_valuation_destruct_and_deallocate(v);
+  }
+
+  SECTION("pack and unpack")
+  {
+    tchecker::intvars_valuation_t * values = tchecker::intvars_valuation_allocate_and_construct(6, 6);
+    tchecker::intvars_valuation_t * v = tchecker::intvars_valuation_allocate_and_construct(layout.capacity(), layout.capacity());
+    tchecker::intvars_valuation_t * w = tchecker::intvars_valuation_allocate_and_construct(6, 6);
+
+    std::vector<tchecker::integer_t> expected{0, 5, 4, -2, 1, 42};
+    for (tchecker::intvar_id_t id = 0; id < expected.size(); ++id)
+      (*values)[id] = expected[id];
+
+    layout.pack(*values, *v);
+    layout.unpack(*v, *w);
+    REQUIRE(*w == *values);
+
+    tchecker::intvars_valuation_destruct_and_deallocate(w);
+    tchecker::intvars_valuation_destruct_and_deallocate(v);
+    tchecker::intvars_valuation_destruct_and_deallocate(values);
+  }
+}
+
+TEST_CASE("layout of packed integer variables valuations spanning several words", "[packed_intvars]")
+{
+  tchecker::integer_variables_t intvars;
+  intvars.declare("a", 4, -100, 100, 0); // 4 x 8 bits
+
+  tchecker::intvars_layout_t layout{intvars.flattened()};
+
+  unsigned int const word_bits = 8 * sizeof(tchecker::integer_t);
+  REQUIRE(layout.capacity() == (4 * 8 + word_bits - 1) / word_bits);
+  for (tchecker::intvar_id_t id = 0; id < 4; ++id) {
+    // fields do not cross word boundaries
+    REQUIRE(layout.offset(id) / word_bits == (layout.offset(id) + layout.width(id) - 1) / word_bits);
+  }
+
+  tchecker::intvars_valuation_t * v = tchecker::intvars_valuation_allocate_and_construct(layout.capacity(), layout.capacity());
+  for (tchecker::intvar_id_t id = 0; id < 4; ++id)
+    layout.store(*v, id, static_cast<tchecker::integer_t>(25 * id - 50));
+  for (tchecker::intvar_id_t id = 0; id < 4; ++id)
+    REQUIRE(layout.load(*v, id) == static_cast<tchecker::integer_t>(25 * id - 50));
+  tchecker::intvars_valuation_destruct_and_deallocate(v);
+}
+
+// Computes the attributes of the states reachable in the zone graph of system
+static std::set<std::string> reachable_states(std::shared_ptr<tchecker::ta::system_t const> const & system)
+{
+  std::unique_ptr<tchecker::zg::zg_t> zg{
+      tchecker::zg::factory(system, tchecker::zg::ELAPSED_SEMANTICS, tchecker::zg::EXTRA_LU_PLUS_LOCAL, 100, 128)};
+
+  std::set<std::string> visited;
+  std::vector<tchecker::zg::const_state_sptr_t> waiting;
+  auto visit = [&](tchecker::zg::const_state_sptr_t const & s) {
+    std::map<std::string, std::string> m;
+    zg->attributes(s, m);
+    REQUIRE(tchecker::ta::is_well_formed(zg->system(), *s));
+    if (visited.insert(m["vloc"] + " " + m["intval"] + " " + m["zone"]).second)
+      waiting.push_back(s);
+  };
+
+  std::vector<tchecker::zg::zg_t::sst_t> v;
+  zg->initial(v, tchecker::STATE_OK);
+  for (auto && [status, s, t] : v)
+    visit(tchecker::zg::const_state_sptr_t{s});
+
+  while (!waiting.empty()) {
+    tchecker::zg::const_state_sptr_t s = waiting.back();
+    waiting.pop_back();
+    v.clear();
+    zg->next(s, v, tchecker::STATE_OK);
+    for (auto && [status, nexts, nextt] : v)
+      visit(tchecker::zg::const_state_sptr_t{nexts});
+  }
+
+  return visited;
+}
+
+TEST_CASE("zone graph with packed integer variables valuations", "[packed_intvars]")
+{
+  std::string declarations = "system:packed_intvars \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  int:1:0:3:0:i \n\
+  int:2:-2:2:-2:t \n\
+  int:1:-2000:2000:0:n \n\
+  \n\
+  process:P \n\
+  clock:1:x \n\
+  location:P:l0{initial: : invariant: x<=2} \n\
+  location:P:l1 \n\
+  edge:P:l0:l0:a{provided: i<3 && x>=1 : do: i=i+1; t[1]=t[1]+1; n=n-300; x=0} \n\
+  edge:P:l0:l1:b{provided: i==3 && t[1]==1 : do: t[0]=t[1]; n=n*2} \n\
+  edge:P:l1:l0:a{do: i=0; t[1]=-2; n=n+1800} \n\
+  ";
+
+  std::unique_ptr<tchecker::parsing::system_declaration_t const> sysdecl{tchecker::test::parse(declarations)};
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t{*sysdecl}};
+  system->dead_intvars_reset(false);
+  std::set<std::string> expected = reachable_states(system);
+
+  std::shared_ptr<tchecker::ta::system_t> packed_system{new tchecker::ta::system_t{*sysdecl}};
+  packed_system->dead_intvars_reset(false);
+  packed_system->packed_intvars(true);
+  REQUIRE(packed_system->intvars_layout() != nullptr);
+  REQUIRE(packed_system->intvars_valuation_capacity() < packed_system->intvars_count(tchecker::VK_FLATTENED));
+
+  std::set<std::string> actual = reachable_states(packed_system);
+
+  REQUIRE(expected.size() > 4);
+  REQUIRE(actual == expected);
+}
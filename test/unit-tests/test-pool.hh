@@ -0,0 +1,64 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include "tchecker/utils/allocation_size.hh"
+#include "tchecker/utils/pool.hh"
+#include "tchecker/utils/shared_objects.hh"
+
+// Object for testing pools
+class po_t {
+public:
+  po_t(int x) : _x(x) {}
+  int x() const { return _x; }
+
+private:
+  int _x;
+};
+
+namespace tchecker {
+template <> class allocation_size_t<po_t> {
+public:
+  static constexpr std::size_t alloc_size() { return sizeof(po_t); }
+
+  template <class... ARGS> static constexpr std::size_t alloc_size(ARGS &&... /*args*/) { return sizeof(po_t); }
+};
+} // namespace tchecker
+
+using shared_po_t = tchecker::make_shared_t<po_t>;
+
+TEST_CASE("Destruct objects allocated by a pool", "[pool]")
+{
+  tchecker::pool_t<shared_po_t> pool(4, tchecker::allocation_size_t<shared_po_t>::alloc_size());
+
+  SECTION("Destructed objects are not referenced anymore")
+  {
+    tchecker::intrusive_shared_ptr_t<shared_po_t> p = pool.construct(1);
+    REQUIRE(pool.destruct(p));
+    REQUIRE(p.ptr() == nullptr);
+    pool.destruct_all();
+  }
+
+  SECTION("Objects with several references are not destructed")
+  {
+    tchecker::intrusive_shared_ptr_t<shared_po_t> p = pool.construct(1);
+    tchecker::intrusive_shared_ptr_t<shared_po_t> q = p;
+    REQUIRE_FALSE(pool.destruct(p));
+    REQUIRE(p->x() == 1);
+    q = nullptr;
+    REQUIRE(pool.destruct(p));
+  }
+
+  SECTION("Destructed and live objects are destructed by destruct_all")
+  {
+    for (int i = 0; i < 10; ++i) {
+      tchecker::intrusive_shared_ptr_t<shared_po_t> p = pool.construct(i);
+      if (i % 2 == 0)
+        REQUIRE(pool.destruct(p));
+    }
+    pool.destruct_all();
+  }
+}
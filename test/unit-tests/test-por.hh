@@ -0,0 +1,124 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/refzg/por.hh"
+#include "tchecker/refzg/refzg.hh"
+#include "tchecker/ta/system.hh"
+
+TEST_CASE("partial-order reduction", "[por]")
+{
+  std::string declarations = "system:por \n\
+  event:a \n\
+  event:b \n\
+  event:c \n\
+  \n\
+  process:P1 \n\
+  clock:1:x1 \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1 \n\
+  edge:P1:l0:l1:a{do: x1=0} \n\
+  edge:P1:l1:l0:b{provided: x1>=1} \n\
+  \n\
+  process:P2 \n\
+  clock:1:x2 \n\
+  location:P2:m0{initial:} \n\
+  location:P2:m1{labels: goal} \n\
+  location:P2:m2 \n\
+  edge:P2:m0:m1:a{do: x2=0} \n\
+  edge:P2:m1:m2:c \n\
+  \n\
+  process:P3 \n\
+  location:P3:n0{initial:} \n\
+  location:P3:n1 \n\
+  edge:P3:n0:n1:c \n\
+  \n\
+  sync:P2@c:P3@c \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t(*sysdecl)};
+
+  tchecker::process_id_t P1 = system->process_id("P1");
+  tchecker::process_id_t P2 = system->process_id("P2");
+  tchecker::process_id_t P3 = system->process_id("P3");
+
+  auto edge_id = [&](tchecker::process_id_t pid, std::string const & src) {
+    tchecker::loc_id_t src_id = system->location(pid, src)->id();
+    for (tchecker::system::edge_const_shared_ptr_t const & edge : system->edges())
+      if (edge->src() == src_id)
+        return edge->id();
+    FAIL("no edge from " + src);
+    return tchecker::edge_id_t{0};
+  };
+
+  boost::dynamic_bitset<> labels = system->labels("goal");
+
+  SECTION("independence of edges")
+  {
+    tchecker::refzg::por_t por{*system, labels};
+    REQUIRE(por.independent(edge_id(P1, "l0"), edge_id(P2, "m0")));
+    REQUIRE(por.independent(edge_id(P1, "l1"), edge_id(P3, "n0")));
+    REQUIRE_FALSE(por.independent(edge_id(P1, "l0"), edge_id(P1, "l1")));
+    REQUIRE_FALSE(por.independent(edge_id(P2, "m1"), edge_id(P3, "n0")));
+  }
+
+  SECTION("ample locations")
+  {
+    tchecker::refzg::por_t por{*system, labels};
+    REQUIRE(por.uniformly_enabled(edge_id(P1, "l0")));
+    REQUIRE_FALSE(por.uniformly_enabled(edge_id(P1, "l1")));
+    REQUIRE(por.ample(system->location(P1, "l0")->id()));
+    REQUIRE_FALSE(por.ample(system->location(P1, "l1")->id())); // no uniformly enabled edge
+    REQUIRE_FALSE(por.ample(system->location(P2, "m0")->id())); // visible edge
+    REQUIRE_FALSE(por.ample(system->location(P2, "m1")->id())); // synchronized edge
+  }
+
+  SECTION("successors are restricted to ample sets")
+  {
+    std::shared_ptr<tchecker::refzg::por_t> por{std::make_shared<tchecker::refzg::por_t>(*system, labels)};
+    std::unique_ptr<tchecker::refzg::refzg_t> refzg{tchecker::refzg::factory(
+        system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS, tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+        tchecker::refdbm::UNBOUNDED_SPREAD, 100, 128, por)};
+    std::unique_ptr<tchecker::refzg::refzg_t> full_refzg{tchecker::refzg::factory(
+        system, tchecker::refzg::PROCESS_REFERENCE_CLOCKS, tchecker::refzg::SYNC_ELAPSED_SEMANTICS,
+        tchecker::refdbm::UNBOUNDED_SPREAD, 100, 128)};
+
+    std::vector<tchecker::refzg::refzg_t::sst_t> initial, next;
+    refzg->initial(initial, tchecker::STATE_OK);
+    REQUIRE(initial.size() == 1);
+    refzg->next(tchecker::refzg::const_state_sptr_t{refzg->state(initial[0])}, next, tchecker::STATE_OK);
+    REQUIRE(next.size() == 1);
+    REQUIRE(refzg->state(next[0])->vloc()[P1] == system->location(P1, "l1")->id());
+    REQUIRE(por->reduced_states() == 1);
+
+    initial.clear();
+    next.clear();
+    full_refzg->initial(initial, tchecker::STATE_OK);
+    REQUIRE(initial.size() == 1);
+    full_refzg->next(tchecker::refzg::const_state_sptr_t{full_refzg->state(initial[0])}, next, tchecker::STATE_OK);
+    REQUIRE(next.size() == 2);
+  }
+
+  SECTION("partial-order reduction requires process reference clocks")
+  {
+    std::shared_ptr<tchecker::refzg::por_t> por{std::make_shared<tchecker::refzg::por_t>(*system, labels)};
+    REQUIRE_THROWS_AS(tchecker::refzg::factory(system, tchecker::refzg::SINGLE_REFERENCE_CLOCKS,
+                                               tchecker::refzg::SYNC_ELAPSED_SEMANTICS, tchecker::refdbm::UNBOUNDED_SPREAD,
+                                               100, 128, por),
+                      std::invalid_argument);
+  }
+
+  delete sysdecl;
+}
@@ -0,0 +1,49 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <string>
+
+#include "tchecker/dbm/dbm.hh"
+#include "tchecker/utils/profiling.hh"
+
+TEST_CASE("profiling counters", "[profiling]")
+{
+  std::map<std::string, std::string> m;
+
+  SECTION("probes have names")
+  {
+    REQUIRE(std::string{tchecker::profiling::name(tchecker::profiling::PROBE_DBM_TIGHTEN)} == "DBM_TIGHTEN");
+    REQUIRE(std::string{tchecker::profiling::name(tchecker::profiling::PROBE_POOL_COLLECT)} == "POOL_COLLECT");
+  }
+
+#if defined(TCHECKER_PROFILING)
+  SECTION("calls to tighten are counted")
+  {
+    tchecker::clock_id_t const dim = 3;
+    tchecker::dbm::db_t dbm[dim * dim];
+    tchecker::dbm::universal_positive(dbm, dim);
+
+    tchecker::profiling::reset();
+    tchecker::dbm::tighten(dbm, dim);
+    tchecker::dbm::tighten(dbm, dim);
+    REQUIRE(tchecker::profiling::calls(tchecker::profiling::PROBE_DBM_TIGHTEN) == 2);
+    REQUIRE(tchecker::profiling::calls(tchecker::profiling::PROBE_VM_RUN) == 0);
+
+    tchecker::profiling::attributes(m);
+    REQUIRE(m["PROFILE_DBM_TIGHTEN_CALLS"] == "2");
+    REQUIRE(m.find("PROFILE_DBM_TIGHTEN_TICKS") != m.end());
+    REQUIRE(m.find("PROFILE_VM_RUN_CALLS") == m.end());
+  }
+#else
+  SECTION("profiling is compiled away")
+  {
+    tchecker::profiling::attributes(m);
+    REQUIRE(m.empty());
+  }
+#endif
+}
@@ -0,0 +1,50 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <sstream>
+#include <string>
+
+#include "tchecker/algorithms/progress.hh"
+
+TEST_CASE("progress reports", "[progress]")
+{
+  std::ostringstream os;
+
+  SECTION("JSON lines")
+  {
+    tchecker::algorithms::progress_t progress{os, tchecker::algorithms::PROGRESS_JSON, 1.0};
+    progress.report("reach", 10, 12, 3, 11);
+    progress.report("reach", 20, 25, 0, 21, true);
+
+    std::istringstream is{os.str()};
+    std::string line;
+    REQUIRE(static_cast<bool>(std::getline(is, line)));
+    REQUIRE(line.front() == '{');
+    REQUIRE(line.back() == '}');
+    REQUIRE(line.find("\"algorithm\":\"reach\"") != std::string::npos);
+    REQUIRE(line.find("\"visited_states\":10,") != std::string::npos);
+    REQUIRE(line.find("\"waiting\":3,") != std::string::npos);
+    REQUIRE(line.find("\"stored_nodes\":11,") != std::string::npos);
+    REQUIRE(line.find("\"terminated\":false") != std::string::npos);
+    REQUIRE(static_cast<bool>(std::getline(is, line)));
+    REQUIRE(line.find("\"terminated\":true") != std::string::npos);
+    REQUIRE_FALSE(static_cast<bool>(std::getline(is, line)));
+  }
+
+  SECTION("reports are not due before the period has elapsed")
+  {
+    tchecker::algorithms::progress_t progress{os, tchecker::algorithms::PROGRESS_TEXT, 3600.0};
+    for (int i = 0; i < 10000; ++i)
+      REQUIRE_FALSE(progress.due());
+    REQUIRE(os.str().empty());
+  }
+
+  SECTION("progress reports are disabled by default")
+  {
+    REQUIRE(tchecker::algorithms::progress() == nullptr);
+  }
+}
@@ -0,0 +1,186 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "tck-server/server.hh"
+
+/*!
+ \class model_file_t
+ \brief Temporary model file, removed on destruction
+ */
+class model_file_t {
+public:
+  model_file_t(std::string const & name, std::string const & label)
+      : _path((std::filesystem::temp_directory_path() / ("tck-server-" + name + ".tck")).string())
+  {
+    std::ofstream ofs(_path);
+    ofs << "system:" << name << "\n"
+        << "event:a\n"
+        << "process:P\n"
+        << "location:P:l0{initial:}\n"
+        << "location:P:l1{labels: " << label << "}\n"
+        << "edge:P:l0:l1:a\n";
+  }
+
+  ~model_file_t() { std::filesystem::remove(_path); }
+
+  std::string const & path() const { return _path; }
+
+private:
+  std::string _path;
+};
+
+TEST_CASE("model cache evicts the least recently used model", "[server]")
+{
+  model_file_t a{"cache_a", "green"}, b{"cache_b", "green"}, c{"cache_c", "green"};
+  tchecker::tck_server::model_cache_t cache{2};
+  bool hit = false;
+
+  auto model_a = cache.get(a.path(), hit);
+  REQUIRE(!hit);
+  cache.get(b.path(), hit);
+  REQUIRE(!hit);
+  REQUIRE(cache.get(a.path(), hit) == model_a);
+  REQUIRE(hit);
+
+  // b is the least recently used model
+  cache.get(c.path(), hit);
+  REQUIRE(!hit);
+  REQUIRE(cache.size() == 2);
+
+  REQUIRE(cache.get(a.path(), hit) == model_a);
+  REQUIRE(hit);
+  cache.get(b.path(), hit);
+  REQUIRE(!hit);
+
+  REQUIRE(cache.hits() == 2);
+  REQUIRE(cache.misses() == 4);
+}
+
+TEST_CASE("model cache replaces models with colliding hashes", "[server]")
+{
+  model_file_t a{"collision_a", "green"}, b{"collision_b", "green"};
+  tchecker::tck_server::model_cache_t cache{2, [](std::string const &) -> std::uint64_t { return 0; }};
+  bool hit = false;
+
+  auto model_a = cache.get(a.path(), hit);
+  REQUIRE(!hit);
+
+  auto model_b = cache.get(b.path(), hit);
+  REQUIRE(!hit);
+  REQUIRE(model_b != model_a);
+  REQUIRE(model_b->content() != model_a->content());
+  REQUIRE(cache.size() == 1);
+
+  REQUIRE(cache.get(b.path(), hit) == model_b);
+  REQUIRE(hit);
+  cache.get(a.path(), hit);
+  REQUIRE(!hit);
+  REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("parsing of verification requests", "[server]")
+{
+  SECTION("default options")
+  {
+    tchecker::tck_server::request_t r = tchecker::tck_server::parse_request({"reach", "model.tck"});
+    REQUIRE(r.tool == "reach");
+    REQUIRE(r.algorithm == "reach");
+    REQUIRE(r.search_order == "bfs");
+    REQUIRE(r.intvars_reduction);
+    REQUIRE(r.filename == "model.tck");
+
+    r = tchecker::tck_server::parse_request({"liveness", "model.tck"});
+    REQUIRE(r.algorithm == "ndfs");
+  }
+
+  SECTION("reachability options")
+  {
+    tchecker::tck_server::request_t r = tchecker::tck_server::parse_request(
+        {"reach", "-a", "covreach", "-l", "green", "-s", "dfs", "--subsumption", "alu", "--extrapolation", "lu-global",
+         "--active-clocks", "--no-intvars-reduction", "--block-size", "100", "model.tck"});
+    REQUIRE(r.algorithm == "covreach");
+    REQUIRE(r.labels == "green");
+    REQUIRE(r.search_order == "dfs");
+    REQUIRE(r.subsumption == tchecker::tck_reach::zg_covreach::SUBSUMPTION_ALU);
+    REQUIRE(r.extrapolation == tchecker::zg::EXTRA_LU_PLUS_GLOBAL);
+    REQUIRE(r.active_clocks);
+    REQUIRE(!r.intvars_reduction);
+    REQUIRE(r.block_size == 100);
+    REQUIRE(r.filename == "model.tck");
+  }
+
+  SECTION("invalid requests")
+  {
+    using tokens_t = std::vector<std::string>;
+    REQUIRE_THROWS_AS(tchecker::tck_server::parse_request(tokens_t{"reach"}), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::tck_server::parse_request(tokens_t{"reach", "a.tck", "b.tck"}), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::tck_server::parse_request(tokens_t{"reach", "-l"}), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::tck_server::parse_request(tokens_t{"reach", "--subsumption", "none", "model.tck"}),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::tck_server::parse_request(tokens_t{"reach", "--por", "model.tck"}), std::invalid_argument);
+    REQUIRE_THROWS_AS(tchecker::tck_server::parse_request(tokens_t{"liveness", "-s", "dfs", "model.tck"}),
+                      std::invalid_argument);
+  }
+}
+
+TEST_CASE("responses to requests", "[server]")
+{
+  model_file_t model{"serve", "green"};
+  tchecker::tck_server::model_cache_t cache{4};
+
+  SECTION("statistics of the cache")
+  {
+    std::ostringstream os;
+    REQUIRE(tchecker::tck_server::serve(cache, "stats", os) == tchecker::tck_server::REQUEST_OK);
+    REQUIRE(os.str() == "MODEL_CACHE_HITS 0\nMODEL_CACHE_MISSES 0\nMODEL_CACHE_SIZE 0\nEND\n");
+  }
+
+  SECTION("errors")
+  {
+    std::ostringstream os;
+    REQUIRE(tchecker::tck_server::serve(cache, "  ", os) == tchecker::tck_server::REQUEST_ERROR);
+    REQUIRE(os.str() == "ERROR Empty request\nEND\n");
+
+    os.str("");
+    REQUIRE(tchecker::tck_server::serve(cache, "check model.tck", os) == tchecker::tck_server::REQUEST_ERROR);
+    REQUIRE(os.str() == "ERROR Unknown request: check\nEND\n");
+  }
+
+  SECTION("shutdown")
+  {
+    std::ostringstream os;
+    REQUIRE(tchecker::tck_server::serve(cache, "shutdown", os) == tchecker::tck_server::REQUEST_SHUTDOWN);
+    REQUIRE(os.str() == "END\n");
+  }
+
+  SECTION("reachability requests")
+  {
+    std::string const request = "reach -a covreach -l green " + model.path();
+
+    std::ostringstream os;
+    REQUIRE(tchecker::tck_server::serve(cache, request, os) == tchecker::tck_server::REQUEST_OK);
+    std::string const response = os.str();
+    REQUIRE(response.find("REACHABLE true\n") != std::string::npos);
+    REQUIRE(response.find("MODEL_CACHE miss\n") != std::string::npos);
+    REQUIRE(response.find("ERROR") == std::string::npos);
+    REQUIRE(response.size() >= 4);
+    REQUIRE(response.substr(response.size() - 4) == "END\n");
+
+    os.str("");
+    REQUIRE(tchecker::tck_server::serve(cache, request, os) == tchecker::tck_server::REQUEST_OK);
+    REQUIRE(os.str().find("MODEL_CACHE hit\n") != std::string::npos);
+    REQUIRE(os.str().find("MODEL_COMPILE_TIME_SECONDS 0\n") != std::string::npos);
+  }
+}
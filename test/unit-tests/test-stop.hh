@@ -0,0 +1,46 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <map>
+#include <string>
+#include <thread>
+
+#include "tchecker/algorithms/reach/stats.hh"
+#include "tchecker/algorithms/stop.hh"
+
+TEST_CASE("stop flag", "[stop]")
+{
+  tchecker::algorithms::clear_stop();
+  REQUIRE_FALSE(tchecker::algorithms::stop_requested());
+
+  std::thread t{[]() { tchecker::algorithms::request_stop(); }};
+  t.join();
+  REQUIRE(tchecker::algorithms::stop_requested());
+
+  tchecker::algorithms::clear_stop();
+  REQUIRE_FALSE(tchecker::algorithms::stop_requested());
+}
+
+TEST_CASE("stopped statistics", "[stop]")
+{
+  tchecker::algorithms::reach::stats_t stats;
+  std::map<std::string, std::string> m;
+
+  SECTION("completed run")
+  {
+    REQUIRE_FALSE(stats.stopped());
+    stats.attributes(m);
+    REQUIRE(m.find("STOPPED") == m.end());
+  }
+
+  SECTION("stopped run")
+  {
+    stats.stopped() = true;
+    stats.attributes(m);
+    REQUIRE(m["STOPPED"] == "true");
+  }
+}
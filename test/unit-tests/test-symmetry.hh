@@ -0,0 +1,141 @@
+/*
+ * This file is a part of the TChecker project.
+ *
+ * See files AUTHORS and LICENSE for copyright details.
+ *
+ */
+
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "tchecker/parsing/parsing.hh"
+#include "tchecker/ta/symmetry.hh"
+#include "tchecker/ta/system.hh"
+#include "tchecker/zg/symmetry.hh"
+#include "tchecker/zg/zg.hh"
+
+TEST_CASE("symmetry groups", "[symmetry]")
+{
+  std::string declarations = "system:symmetry_groups \n\
+  event:a \n\
+  event:b \n\
+  \n\
+  int:1:0:1:0:lock \n\
+  \n\
+  process:P1 \n\
+  clock:1:x1 \n\
+  int:1:0:3:0:i1 \n\
+  location:P1:idle{initial:} \n\
+  location:P1:cs{invariant: x1<=2 : labels: cs} \n\
+  edge:P1:idle:cs:a{provided: lock==0 && x1>=1 : do: lock=1; x1=0; i1=i1+1} \n\
+  edge:P1:cs:idle:b{do: lock=0} \n\
+  \n\
+  process:P2 \n\
+  clock:1:x2 \n\
+  int:1:0:3:0:i2 \n\
+  location:P2:idle{initial:} \n\
+  location:P2:cs{invariant: x2<=2 : labels: cs} \n\
+  edge:P2:idle:cs:a{provided: lock==0 && x2>=1 : do: lock=1; x2=0; i2=i2+1} \n\
+  edge:P2:cs:idle:b{do: lock=0} \n\
+  \n\
+  process:P3 \n\
+  clock:1:x3 \n\
+  int:1:0:3:0:i3 \n\
+  location:P3:idle{initial:} \n\
+  location:P3:cs{invariant: x3<=3 : labels: cs} \n\
+  edge:P3:idle:cs:a{provided: lock==0 && x3>=1 : do: lock=1; x3=0; i3=i3+1} \n\
+  edge:P3:cs:idle:b{do: lock=0} \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  std::shared_ptr<tchecker::ta::system_t> system{new tchecker::ta::system_t(*sysdecl)};
+
+  tchecker::process_id_t P1 = system->process_id("P1");
+  tchecker::process_id_t P2 = system->process_id("P2");
+  tchecker::process_id_t P3 = system->process_id("P3");
+
+  SECTION("detection of symmetric processes")
+  {
+    std::vector<tchecker::ta::symmetry_group_t> groups = tchecker::ta::symmetry_groups(*system);
+    REQUIRE(groups.size() == 1);
+    REQUIRE(groups[0].size() == 2);
+    REQUIRE(groups[0][0].pid == P1);
+    REQUIRE(groups[0][1].pid == P2);
+    REQUIRE(groups[0][0].clocks == std::vector<tchecker::clock_id_t>{system->clock_id("x1")});
+    REQUIRE(groups[0][1].intvars == std::vector<tchecker::intvar_id_t>{system->intvar_id("i2")});
+    REQUIRE(groups[0][0].locations.size() == 2);
+    REQUIRE(system->location(groups[0][1].locations[0])->name() == "cs");
+  }
+
+  SECTION("symmetric successors are canonicalized to the same state")
+  {
+    std::shared_ptr<tchecker::zg::symmetry_t> symmetry{
+        std::make_shared<tchecker::zg::symmetry_t>(*system, tchecker::ta::symmetry_groups(*system))};
+    std::shared_ptr<tchecker::zg::extrapolation_t> extrapolation{
+        tchecker::zg::extrapolation_factory(tchecker::zg::NO_EXTRAPOLATION, *system)};
+    std::shared_ptr<tchecker::zg::semantics_t> semantics{tchecker::zg::semantics_factory(tchecker::zg::STANDARD_SEMANTICS)};
+    tchecker::zg::zg_t zg{system, semantics, extrapolation, 100, 128, symmetry};
+
+    std::vector<tchecker::zg::zg_t::sst_t> initial, next;
+    zg.initial(initial, tchecker::STATE_OK);
+    REQUIRE(initial.size() == 1);
+
+    zg.next(tchecker::zg::const_state_sptr_t{zg.state(initial[0])}, next, tchecker::STATE_OK);
+    REQUIRE(next.size() == 3);
+
+    // Successors where P1 or P2 enters cs are equal, P3 is not symmetric
+    std::size_t p1_p2_successors = 0;
+    for (tchecker::zg::zg_t::sst_t const & sst : next) {
+      tchecker::zg::state_sptr_t s = zg.state(sst);
+      if (s->vloc()[P3] == system->location(P3, "cs")->id())
+        continue;
+      ++p1_p2_successors;
+      REQUIRE(s->vloc()[P1] == system->location(P1, "cs")->id());
+      REQUIRE(s->vloc()[P2] == system->location(P2, "idle")->id());
+      REQUIRE(s->intval()[system->intvar_id("i1")] == 1);
+      REQUIRE(s->intval()[system->intvar_id("i2")] == 0);
+    }
+    REQUIRE(p1_p2_successors == 2);
+    REQUIRE(*zg.state(next[0]) == *zg.state(next[1]));
+    REQUIRE(symmetry->permuted_states() == 1);
+  }
+
+  delete sysdecl;
+}
+
+TEST_CASE("declared symmetry groups", "[symmetry]")
+{
+  std::string declarations = "system:declared_symmetry_groups \n\
+  event:a \n\
+  \n\
+  process:P1{symmetry: G} \n\
+  location:P1:l0{initial:} \n\
+  location:P1:l1 \n\
+  edge:P1:l0:l1:a \n\
+  \n\
+  process:P2{symmetry: G} \n\
+  location:P2:l0{initial:} \n\
+  location:P2:l1{labels: l1} \n\
+  edge:P2:l0:l1:a \n\
+  \n\
+  process:P3 \n\
+  location:P3:l0{initial:} \n\
+  location:P3:l1 \n\
+  edge:P3:l0:l1:a \n\
+  ";
+
+  tchecker::parsing::system_declaration_t const * sysdecl = tchecker::test::parse(declarations);
+
+  REQUIRE(sysdecl != nullptr);
+
+  tchecker::ta::system_t system(*sysdecl);
+
+  // P2 has a label that P1 does not have
+  REQUIRE_THROWS_AS(tchecker::ta::symmetry_groups(system), std::invalid_argument);
+
+  delete sysdecl;
+}
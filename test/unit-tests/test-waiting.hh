@@ -5,9 +5,15 @@
  *
  */
 
+#include <algorithm>
 #include <vector>
 
+#include "tchecker/utils/ring_buffer.hh"
+#include "tchecker/waiting/factory.hh"
+#include "tchecker/waiting/priority.hh"
 #include "tchecker/waiting/queue.hh"
+#include "tchecker/waiting/random_stack.hh"
+#include "tchecker/waiting/ring.hh"
 #include "tchecker/waiting/stack.hh"
 #include "tchecker/waiting/waiting.hh"
 
@@ -37,6 +43,14 @@ TEST_CASE("waiting queue", "[waiting]")
     REQUIRE_FALSE(non_empty_queue.empty());
   }
 
+  SECTION("size")
+  {
+    REQUIRE(empty_queue.size() == 0);
+    REQUIRE(non_empty_queue.size() == 3);
+    non_empty_queue.remove_first();
+    REQUIRE(non_empty_queue.size() == 2);
+  }
+
   SECTION("insert in empty queue")
   {
     empty_queue.insert(2);
@@ -176,6 +190,16 @@ TEST_CASE("fast remove waiting queue", "[waiting]")
     REQUIRE_FALSE(non_empty_queue.empty());
   }
 
+  SECTION("size")
+  {
+    REQUIRE(empty_queue.size() == 0);
+    REQUIRE(non_empty_queue.size() == 4);
+    non_empty_queue.remove(v[1]);
+    REQUIRE(non_empty_queue.size() == 3);
+    non_empty_queue.remove_first();
+    REQUIRE(non_empty_queue.size() == 2);
+  }
+
   SECTION("insert in empty queue")
   {
     int_sptr_t x{new int_element_t{290}};
@@ -636,4 +660,315 @@ TEST_CASE("fast remove waiting stack", "[waiting]")
     non_empty_stack.remove_first();
     REQUIRE(non_empty_stack.empty());
   }
-}
\ No newline at end of file
+}
+TEST_CASE("waiting priority queue", "[waiting]")
+{
+  tchecker::waiting::priority_queue_t<int> by_value{[](int const & x, std::size_t) { return static_cast<std::size_t>(x); }};
+  tchecker::waiting::priority_queue_t<int> by_depth{[](int const &, std::size_t depth) { return depth; }};
+
+  SECTION("elements come out by increasing priority")
+  {
+    by_value.insert(7);
+    by_value.insert(2);
+    by_value.insert(11);
+    by_value.insert(5);
+    std::vector<int> out;
+    while (!by_value.empty()) {
+      out.push_back(by_value.first());
+      by_value.remove_first();
+    }
+    REQUIRE(out == std::vector<int>{2, 5, 7, 11});
+  }
+
+  SECTION("elements with equal priorities come out last-in first-out")
+  {
+    by_depth.insert(1);
+    by_depth.insert(2);
+    REQUIRE(by_depth.first() == 2);
+    by_depth.remove_first();
+    REQUIRE(by_depth.first() == 1);
+  }
+
+  SECTION("depth is one plus the depth of the last removed element")
+  {
+    by_depth.insert(1); // depth 0
+    by_depth.remove_first();
+    by_depth.insert(2); // depth 1
+    by_depth.insert(3); // depth 1
+    by_depth.remove_first();
+    by_depth.insert(4); // depth 2
+    REQUIRE(by_depth.first() == 2);
+    by_depth.remove_first();
+    REQUIRE(by_depth.first() == 4);
+  }
+
+  SECTION("remove")
+  {
+    by_value.insert(3);
+    by_value.insert(1);
+    by_value.insert(2);
+    by_value.remove(1);
+    REQUIRE(by_value.first() == 2);
+    by_value.remove(4);
+    by_value.remove_first();
+    REQUIRE(by_value.first() == 3);
+    by_value.remove_first();
+    REQUIRE(by_value.empty());
+  }
+
+  SECTION("clear")
+  {
+    by_value.insert(3);
+    by_value.clear();
+    REQUIRE(by_value.empty());
+  }
+}
+
+TEST_CASE("waiting fast remove priority queue", "[waiting]")
+{
+  using int_sptr_t = std::shared_ptr<int_element_t>;
+
+  tchecker::waiting::fast_remove_priority_queue_t<int_sptr_t> waiting{
+      [](int_sptr_t const & e, std::size_t) { return static_cast<std::size_t>(e->x()); }};
+
+  std::vector<int_sptr_t> v;
+  for (int x : {4, 1, 3, 2})
+    v.push_back(int_sptr_t{new int_element_t{x}});
+  for (int_sptr_t const & e : v)
+    waiting.insert(e);
+
+  waiting.remove(v[1]);
+  waiting.remove(v[2]);
+  REQUIRE(waiting.first()->x() == 2);
+  waiting.remove_first();
+  REQUIRE(waiting.first()->x() == 4);
+  waiting.remove_first();
+  REQUIRE(waiting.empty());
+}
+
+TEST_CASE("waiting random stack", "[waiting]")
+{
+  tchecker::waiting::random_stack_t<int> no_restart{0}, restart{1};
+
+  SECTION("all elements come out exactly once")
+  {
+    for (int x = 0; x < 100; ++x)
+      no_restart.insert(x);
+    std::vector<int> out;
+    while (!no_restart.empty()) {
+      out.push_back(no_restart.first());
+      no_restart.remove_first();
+    }
+    std::sort(out.begin(), out.end());
+    REQUIRE(out.size() == 100);
+    for (int x = 0; x < 100; ++x)
+      REQUIRE(out[x] == x);
+  }
+
+  SECTION("elements inserted before last removal stay below new elements without restart")
+  {
+    no_restart.insert(1);
+    no_restart.insert(2);
+    no_restart.remove_first();
+    no_restart.insert(3);
+    no_restart.insert(4);
+    int top = no_restart.first();
+    REQUIRE((top == 3 || top == 4));
+    no_restart.remove_first();
+    top = no_restart.first();
+    REQUIRE((top == 3 || top == 4));
+    no_restart.remove_first();
+    REQUIRE((no_restart.first() == 1 || no_restart.first() == 2));
+  }
+
+  SECTION("first is stable until removal")
+  {
+    for (int x = 0; x < 10; ++x)
+      restart.insert(x);
+    for (int i = 0; i < 5; ++i) {
+      int top = restart.first();
+      REQUIRE(restart.first() == top);
+      restart.remove_first();
+    }
+    REQUIRE(restart.restarts() > 0);
+  }
+
+  SECTION("remove")
+  {
+    no_restart.insert(1);
+    no_restart.insert(2);
+    no_restart.remove(1);
+    REQUIRE(no_restart.first() == 2);
+    no_restart.remove_first();
+    REQUIRE(no_restart.empty());
+  }
+}
+
+TEST_CASE("chunked ring buffer", "[waiting]")
+{
+  tchecker::chunked_ring_buffer_t<int, 4> rb;
+
+  SECTION("empty buffer")
+  {
+    REQUIRE(rb.empty());
+    REQUIRE(rb.size() == 0);
+    REQUIRE(rb.capacity() == 0);
+  }
+
+  SECTION("growth preserves order when the buffer wraps around")
+  {
+    int next_in = 0, next_out = 0;
+    for (int i = 0; i < 3; ++i)
+      rb.push_back(next_in++);
+    for (int i = 0; i < 2; ++i) {
+      REQUIRE(rb.front() == next_out++);
+      rb.pop_front();
+    }
+    // The buffer is now full with its first element in the middle of a chunk
+    for (int i = 0; i < 3; ++i)
+      rb.push_back(next_in++);
+    REQUIRE(rb.size() == rb.capacity());
+    for (int i = 0; i < 20; ++i)
+      rb.push_back(next_in++);
+    REQUIRE(rb.capacity() == 32);
+    for (std::size_t i = 0; i < rb.size(); ++i)
+      REQUIRE(rb[i] == next_out + static_cast<int>(i));
+    while (!rb.empty()) {
+      REQUIRE(rb.front() == next_out++);
+      rb.pop_front();
+    }
+    REQUIRE(next_out == next_in);
+  }
+
+  SECTION("pop back")
+  {
+    for (int i = 0; i < 10; ++i)
+      rb.push_back(i);
+    for (int i = 9; i >= 0; --i) {
+      REQUIRE(rb.back() == i);
+      rb.pop_back();
+    }
+    REQUIRE(rb.empty());
+  }
+
+  SECTION("remove_if preserves order")
+  {
+    for (int i = 0; i < 10; ++i)
+      rb.push_back(i);
+    rb.remove_if([](int x) { return x % 3 == 0; });
+    REQUIRE(rb.size() == 6);
+    std::vector<int> out;
+    while (!rb.empty()) {
+      out.push_back(rb.front());
+      rb.pop_front();
+    }
+    REQUIRE(out == std::vector<int>{1, 2, 4, 5, 7, 8});
+  }
+
+  SECTION("clear keeps capacity")
+  {
+    for (int i = 0; i < 10; ++i)
+      rb.push_back(i);
+    std::size_t capacity = rb.capacity();
+    rb.clear();
+    REQUIRE(rb.empty());
+    REQUIRE(rb.capacity() == capacity);
+  }
+}
+
+TEST_CASE("waiting ring queue and stack", "[waiting]")
+{
+  tchecker::waiting::ring_queue_t<int> queue;
+  tchecker::waiting::ring_stack_t<int> stack;
+  for (int x : {1, 2367, 47, 2367}) {
+    queue.insert(x);
+    stack.insert(x);
+  }
+
+  SECTION("queue is fifo")
+  {
+    REQUIRE(queue.first() == 1);
+    queue.remove_first();
+    REQUIRE(queue.first() == 2367);
+  }
+
+  SECTION("stack is lifo")
+  {
+    REQUIRE(stack.first() == 2367);
+    stack.remove_first();
+    REQUIRE(stack.first() == 47);
+  }
+
+  SECTION("remove all occurrences")
+  {
+    queue.remove(2367);
+    REQUIRE(queue.first() == 1);
+    queue.remove_first();
+    REQUIRE(queue.first() == 47);
+    queue.remove_first();
+    REQUIRE(queue.empty());
+  }
+}
+
+TEST_CASE("waiting static dispatch", "[waiting]")
+{
+  using int_sptr_t = std::shared_ptr<int_element_t>;
+
+  std::vector<int_sptr_t> v;
+  for (int x : {1, 2, 3})
+    v.push_back(int_sptr_t{new int_element_t{x}});
+
+  auto first_after_remove = [&](auto & waiting) {
+    for (int_sptr_t const & e : v)
+      waiting.insert(e);
+    waiting.remove(v[0]);
+    waiting.remove(v[2]);
+    return waiting.first()->x();
+  };
+
+  REQUIRE(tchecker::waiting::static_dispatch<int_sptr_t>(tchecker::waiting::QUEUE, first_after_remove) == 2);
+  REQUIRE(tchecker::waiting::static_dispatch<int_sptr_t>(tchecker::waiting::FAST_REMOVE_QUEUE, first_after_remove) == 2);
+  REQUIRE(tchecker::waiting::static_dispatch<int_sptr_t>(tchecker::waiting::STACK, first_after_remove) == 2);
+  REQUIRE(tchecker::waiting::static_dispatch<int_sptr_t>(tchecker::waiting::FAST_REMOVE_STACK, first_after_remove) == 2);
+}
+
+TEST_CASE("waiting fast remove tombstones and compaction", "[waiting]")
+{
+  using int_sptr_t = std::shared_ptr<int_element_t>;
+
+  tchecker::waiting::fast_remove_ring_queue_t<int_sptr_t> waiting;
+  waiting.compaction_threshold(2);
+
+  std::vector<int_sptr_t> v;
+  for (int x = 0; x < 8; ++x) {
+    v.push_back(int_sptr_t{new int_element_t{x}});
+    waiting.insert(v.back());
+  }
+
+  SECTION("removing non-waiting elements creates no tombstone")
+  {
+    waiting.remove_first();
+    waiting.remove(v[0]);
+    REQUIRE(waiting.removed() == 0);
+  }
+
+  SECTION("removed elements are counted and compacted past the threshold")
+  {
+    waiting.remove(v[3]);
+    waiting.remove(v[5]);
+    REQUIRE(waiting.removed() == 2);
+    REQUIRE(waiting.compactions() == 0);
+    waiting.remove(v[6]);
+    waiting.remove(v[7]);
+    waiting.remove(v[1]);
+    REQUIRE(waiting.removed() == 5);
+    REQUIRE(waiting.compactions() == 1);
+
+    std::vector<int> out;
+    while (!waiting.empty()) {
+      out.push_back(waiting.first()->x());
+      waiting.remove_first();
+    }
+    REQUIRE(out == std::vector<int>{0, 2, 4});
+  }
+}
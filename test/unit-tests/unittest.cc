@@ -8,17 +8,35 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_test_macros.hpp>
 
+#include "test-binary-certificate.hh"
 #include "test-cache.hh"
+#include "test-checkpoint.hh"
+#include "test-clockbounds-cache.hh"
 #include "test-db.hh"
 #include "test-dbm.hh"
 #include "test-delay_allowed.hh"
 #include "test-extract_variables.hh"
 #include "test-finite-path.hh"
+#include "test-for-each-next.hh"
+#include "test-frozen-graph.hh"
 #include "test-guard_weak_sync.hh"
 #include "test-hashtable.hh"
+#include "test-heuristics.hh"
 #include "test-labels.hh"
+#include "test-live-clocks.hh"
+#include "test-live-intvars.hh"
+#include "test-loc-edges-maps.hh"
+#include "test-memory-limit.hh"
 #include "test-ordering.hh"
+#include "test-packed-intvars.hh"
+#include "test-por.hh"
+#include "test-pool.hh"
+#include "test-profiling.hh"
+#include "test-progress.hh"
 #include "test-refdbm.hh"
 #include "test-reference_clock_variables.hh"
+#include "test-server.hh"
+#include "test-stop.hh"
+#include "test-symmetry.hh"
 #include "test-variables-access.hh"
 #include "test-waiting.hh"